@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/batchpathfinder.hpp>
+#include <components/detournavigator/navigator.hpp>
+#include <components/detournavigator/navigatorutils.hpp>
+#include <components/detournavigator/settings.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    constexpr std::size_t requestsCount = 1000;
+    const AgentBounds agentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+    const osg::Vec3f playerPosition{ 4096, 4096, 0 };
+
+    Settings makeSettings()
+    {
+        Settings result;
+        result.mEnableWriteRecastMeshToFile = false;
+        result.mEnableWriteNavMeshToFile = false;
+        result.mEnableRecastMeshFileNameRevision = false;
+        result.mEnableNavMeshFileNameRevision = false;
+        result.mRecast.mBorderSize = 16;
+        result.mRecast.mCellHeight = 0.2f;
+        result.mRecast.mCellSize = 0.2f;
+        result.mRecast.mDetailSampleDist = 6;
+        result.mRecast.mDetailSampleMaxError = 1;
+        result.mRecast.mMaxClimb = 34;
+        result.mRecast.mMaxSimplificationError = 1.3f;
+        result.mRecast.mMaxSlope = 49;
+        result.mRecast.mRecastScaleFactor = 0.017647058823529415f;
+        result.mRecast.mSwimHeightScale = 0.89999997615814208984375f;
+        result.mRecast.mMaxEdgeLen = 12;
+        result.mDetour.mMaxNavMeshQueryNodes = 2048;
+        result.mRecast.mMaxVertsPerPoly = 6;
+        result.mRecast.mRegionMergeArea = 400;
+        result.mRecast.mRegionMinArea = 64;
+        result.mRecast.mTileSize = 64;
+        result.mWaitUntilMinDistanceToPlayer = std::numeric_limits<int>::max();
+        result.mAsyncNavMeshUpdaterThreads = 4;
+        result.mBatchPathFinderThreads = 0;
+        result.mMaxNavMeshTilesCacheSize = 64 * 1024 * 1024;
+        result.mMaxNavMeshTileLayersCacheSize = 0;
+        result.mDetour.mMaxPolygonPathSize = 1024;
+        result.mDetour.mMaxSmoothPathSize = 1024;
+        result.mDetour.mMaxPolys = 4096;
+        result.mMaxTilesNumber = 128;
+        result.mMinUpdateInterval = std::chrono::milliseconds(50);
+        result.mWriteToNavMeshDb = false;
+        return result;
+    }
+
+    std::vector<float> generateHeights(auto& random)
+    {
+        std::uniform_real_distribution<float> distribution(0, 100);
+        std::vector<float> result(ESM::Land::LAND_NUM_VERTS);
+        for (float& height : result)
+            height = distribution(random);
+        return result;
+    }
+
+    std::vector<PathRequest> generateRequests(auto& random)
+    {
+        std::uniform_real_distribution<float> distribution(-1500, 1500);
+        std::vector<PathRequest> result;
+        result.reserve(requestsCount);
+        for (std::size_t i = 0; i < requestsCount; ++i)
+            result.push_back(PathRequest{
+                .mAgentBounds = agentBounds,
+                .mStart = playerPosition + osg::Vec3f(distribution(random), distribution(random), 0),
+                .mEnd = playerPosition + osg::Vec3f(distribution(random), distribution(random), 0),
+                .mIncludeFlags = Flag_walk,
+                .mAreaCosts = AreaCosts{},
+                .mEndTolerance = 0,
+                .mCheckpoints = {},
+            });
+        return result;
+    }
+
+    struct Scene
+    {
+        std::minstd_rand mRandom;
+        std::vector<float> mHeights = generateHeights(mRandom);
+        std::unique_ptr<Navigator> mNavigator = makeNavigator(makeSettings(), {});
+        std::vector<PathRequest> mRequests = generateRequests(mRandom);
+
+        Scene()
+        {
+            const auto [minHeight, maxHeight] = std::minmax_element(mHeights.begin(), mHeights.end());
+            const HeightfieldSurface surface{
+                .mHeights = mHeights.data(),
+                .mSize = static_cast<std::size_t>(ESM::Land::LAND_SIZE),
+                .mMinHeight = *minHeight,
+                .mMaxHeight = *maxHeight,
+            };
+            mNavigator->addAgent(agentBounds);
+            mNavigator->updateBounds(ESM::RefId::stringRefId("sys::default"), std::nullopt, playerPosition, nullptr);
+            mNavigator->addHeightfield(osg::Vec2i(0, 0), ESM::Land::REAL_SIZE, surface, nullptr);
+            mNavigator->update(playerPosition, nullptr);
+            Loading::Listener listener;
+            mNavigator->wait(WaitConditionType::allJobsDone, &listener);
+        }
+    };
+
+    const Scene& getScene()
+    {
+        static const Scene scene;
+        return scene;
+    }
+
+    void findPathSequentially(benchmark::State& state)
+    {
+        const Scene& scene = getScene();
+        std::vector<osg::Vec3f> path;
+
+        for (auto _ : state)
+        {
+            for (const PathRequest& request : scene.mRequests)
+            {
+                path.clear();
+                const Status status = findPath(*scene.mNavigator, request.mAgentBounds, request.mStart, request.mEnd,
+                    request.mIncludeFlags, request.mAreaCosts, request.mEndTolerance, request.mCheckpoints,
+                    std::back_inserter(path));
+                benchmark::DoNotOptimize(status);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(scene.mRequests.size()));
+    }
+
+    void findPathsInBatch(benchmark::State& state)
+    {
+        const Scene& scene = getScene();
+        BatchPathFinder finder(static_cast<std::size_t>(state.range(0)),
+            scene.mNavigator->getSettings().mDetour.mMaxNavMeshQueryNodes);
+        std::vector<PathResult> results(scene.mRequests.size());
+
+        for (auto _ : state)
+        {
+            finder.findPaths(*scene.mNavigator, scene.mRequests, results);
+            benchmark::DoNotOptimize(results.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(scene.mRequests.size()));
+    }
+}
+
+BENCHMARK(findPathSequentially)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(findPathsInBatch)->Arg(0)->Arg(1)->Arg(3)->Arg(7)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/navmeshdb.hpp>
+#include <components/files/conversion.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    constexpr std::size_t tilesCount = 256;
+    constexpr std::size_t inputSize = 4 * 1024;
+    constexpr std::size_t dataSize = 16 * 1024;
+    const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+
+    struct Tile
+    {
+        TilePosition mTilePosition;
+        std::vector<std::byte> mInput;
+        std::vector<std::byte> mData;
+    };
+
+    std::vector<std::byte> generateBytes(std::size_t size, auto& random)
+    {
+        // Bytes from a small range are compressible like serialized tiles
+        std::uniform_int_distribution<int> distribution(0, 15);
+        std::vector<std::byte> result(size);
+        for (std::byte& value : result)
+            value = static_cast<std::byte>(distribution(random));
+        return result;
+    }
+
+    std::vector<Tile> generateTiles(auto& random)
+    {
+        std::vector<Tile> result;
+        result.reserve(tilesCount);
+        for (std::size_t i = 0; i < tilesCount; ++i)
+            result.push_back(Tile{
+                .mTilePosition = TilePosition(static_cast<int>(i % 16), static_cast<int>(i / 16)),
+                .mInput = generateBytes(inputSize, random),
+                .mData = generateBytes(dataSize, random),
+            });
+        return result;
+    }
+
+    const std::vector<Tile>& getTiles()
+    {
+        static const std::vector<Tile> tiles = [] {
+            std::minstd_rand random;
+            return generateTiles(random);
+        }();
+        return tiles;
+    }
+
+    class TempDbFile
+    {
+    public:
+        TempDbFile()
+            : mPath(std::filesystem::temp_directory_path() / "openmw_navmeshdb_benchmark.db")
+        {
+            remove();
+        }
+
+        ~TempDbFile() { remove(); }
+
+        std::string getPath() const { return Files::pathToUnicodeString(mPath); }
+
+        void remove() const
+        {
+            std::error_code ec;
+            for (const char* suffix : { "", "-wal", "-shm", "-journal" })
+                std::filesystem::remove(std::filesystem::path(mPath).concat(suffix), ec);
+        }
+
+    private:
+        std::filesystem::path mPath;
+    };
+
+    void insertTiles(NavMeshDb& db, std::size_t batchSize)
+    {
+        const std::vector<Tile>& tiles = getTiles();
+        std::optional<Sqlite3::Transaction> transaction;
+        for (std::size_t i = 0; i < tiles.size(); ++i)
+        {
+            if (!transaction.has_value() && batchSize > 1)
+                transaction.emplace(db.startTransaction(Sqlite3::TransactionMode::Immediate));
+            db.insertTile(TileId(static_cast<std::int64_t>(i + 1)), worldspace, tiles[i].mTilePosition,
+                TileVersion(1), tiles[i].mInput, tiles[i].mData);
+            if (transaction.has_value() && (i + 1) % batchSize == 0)
+            {
+                transaction->commit();
+                transaction.reset();
+            }
+        }
+        if (transaction.has_value())
+            transaction->commit();
+    }
+
+    void writeTiles(benchmark::State& state)
+    {
+        const std::size_t batchSize = static_cast<std::size_t>(state.range(0));
+        const TempDbFile file;
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            file.remove();
+            NavMeshDb db(file.getPath(), std::numeric_limits<std::uint64_t>::max());
+            state.ResumeTiming();
+
+            insertTiles(db, batchSize);
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tilesCount));
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(tilesCount * (inputSize + dataSize)));
+    }
+
+    void readTiles(benchmark::State& state)
+    {
+        const std::size_t maxTileDataCacheSize = static_cast<std::size_t>(state.range(0));
+        const TempDbFile file;
+        NavMeshDb db(file.getPath(), std::numeric_limits<std::uint64_t>::max(), NavMeshDb::defaultWalAutoCheckpoint,
+            maxTileDataCacheSize);
+        insertTiles(db, tilesCount);
+        const std::vector<Tile>& tiles = getTiles();
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution(0, tiles.size() - 1);
+
+        for (auto _ : state)
+        {
+            const Tile& tile = tiles[distribution(random)];
+            const std::optional<TileData> result = db.getTileData(worldspace, tile.mTilePosition, tile.mInput);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(dataSize));
+    }
+}
+
+BENCHMARK(writeTiles)->Arg(1)->Arg(16)->Arg(64)->Arg(256)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(readTiles)->Arg(0)->Arg(1024 * 1024)->Arg(64 * 1024 * 1024);
+
+BENCHMARK_MAIN();
@@ -227,6 +227,50 @@ namespace
         getFromFilledCache<64 * 1024 * 1024, 70>(state);
     }
 
+    struct FilledCache
+    {
+        NavMeshTilesCache mCache;
+        std::vector<Key> mKeys;
+
+        FilledCache(std::size_t maxCacheSize, int hitPercentage)
+            : mCache(maxCacheSize)
+        {
+            std::minstd_rand random;
+            fillCache(std::back_inserter(mKeys), random, mCache);
+            generateKeys(std::back_inserter(mKeys), mKeys.size() * (100 - hitPercentage) / 100, random);
+            std::shuffle(mKeys.begin(), mKeys.end(), random);
+        }
+    };
+
+    template <std::size_t maxCacheSize, int hitPercentage>
+    void getFromFilledCacheConcurrently(benchmark::State& state)
+    {
+        static FilledCache filled(maxCacheSize, hitPercentage);
+        const std::vector<Key>& keys = filled.mKeys;
+        std::size_t n = static_cast<std::size_t>(state.thread_index()) * keys.size() / std::max(state.threads(), 1);
+        std::size_t hits = 0;
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            const auto& key = keys[n++ % keys.size()];
+            auto result = filled.mCache.get(key.mAgentBounds, key.mTilePosition, key.mRecastMesh);
+            hits += static_cast<bool>(result);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["hit rate"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+    }
+
+    void getFromFilledCacheConcurrently_16m_100hit(benchmark::State& state)
+    {
+        getFromFilledCacheConcurrently<16 * 1024 * 1024, 100>(state);
+    }
+
+    void getFromFilledCacheConcurrently_16m_70hit(benchmark::State& state)
+    {
+        getFromFilledCacheConcurrently<16 * 1024 * 1024, 70>(state);
+    }
+
     template <std::size_t maxCacheSize>
     void setToBoundedNonEmptyCache(benchmark::State& state)
     {
@@ -276,6 +320,8 @@ BENCHMARK(getFromFilledCache_1m_70hit);
 BENCHMARK(getFromFilledCache_4m_70hit);
 BENCHMARK(getFromFilledCache_16m_70hit);
 BENCHMARK(getFromFilledCache_64m_70hit);
+BENCHMARK(getFromFilledCacheConcurrently_16m_100hit)->Threads(1)->Threads(2)->Threads(4)->Threads(8);
+BENCHMARK(getFromFilledCacheConcurrently_16m_70hit)->Threads(1)->Threads(2)->Threads(4)->Threads(8);
 BENCHMARK(setToBoundedNonEmptyCache_1m);
 BENCHMARK(setToBoundedNonEmptyCache_4m);
 BENCHMARK(setToBoundedNonEmptyCache_16m);
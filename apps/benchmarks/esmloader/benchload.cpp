@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include "components/esm3/esmwriter.hpp"
+#include "components/esm3/loadcell.hpp"
+#include "components/esm3/loadgmst.hpp"
+#include "components/esm3/loadstat.hpp"
+#include "components/esm3/readerscache.hpp"
+#include "components/esmloader/esmdata.hpp"
+#include "components/esmloader/load.hpp"
+#include "components/files/collections.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t contentFilesCount = 64;
+    constexpr std::size_t staticsPerFile = 4000;
+    constexpr std::size_t cellsPerFile = 256;
+    constexpr std::size_t gameSettingsPerFile = 256;
+
+    template <class T>
+    void writeRecord(ESM::ESMWriter& writer, const T& record)
+    {
+        writer.startRecord(T::sRecordId);
+        record.save(writer);
+        writer.endRecord(T::sRecordId);
+    }
+
+    // Each file overrides a part of records from the previous one to make merging non trivial
+    void writeContentFile(const std::filesystem::path& path, std::size_t index)
+    {
+        std::ofstream stream(path, std::ios::binary);
+        ESM::ESMWriter writer;
+        writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+        writer.save(stream);
+
+        for (std::size_t i = 0; i < gameSettingsPerFile; ++i)
+        {
+            ESM::GameSetting record;
+            record.blank();
+            record.mId = ESM::RefId::stringRefId(std::format("fSetting{}", i + index * gameSettingsPerFile / 2));
+            record.mValue.setType(ESM::VT_Float);
+            record.mValue.setFloat(static_cast<float>(i));
+            writeRecord(writer, record);
+        }
+
+        for (std::size_t i = 0; i < staticsPerFile; ++i)
+        {
+            ESM::Static record;
+            record.blank();
+            record.mId = ESM::RefId::stringRefId(std::format("static_{}", i + index * staticsPerFile / 2));
+            record.mModel = std::format("meshes/x/static_{}.nif", i);
+            writeRecord(writer, record);
+        }
+
+        for (std::size_t i = 0; i < cellsPerFile; ++i)
+        {
+            ESM::Cell record;
+            record.blank();
+            const int position = static_cast<int>(i + index * cellsPerFile / 2);
+            record.mData.mX = position % 64;
+            record.mData.mY = position / 64;
+            record.mWater = static_cast<float>(i);
+            record.mHasWaterHeightSub = true;
+            writeRecord(writer, record);
+        }
+
+        writer.close();
+    }
+
+    const std::filesystem::path& getDataDir()
+    {
+        static const std::filesystem::path dataDir = [] {
+            const std::filesystem::path result = std::filesystem::temp_directory_path() / "openmw"
+                / "benchmarks" / "esmloader"
+                / std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+            std::filesystem::create_directories(result);
+            for (std::size_t i = 0; i < contentFilesCount; ++i)
+                writeContentFile(result / std::format("plugin{}.esp", i), i);
+            return result;
+        }();
+        return dataDir;
+    }
+
+    std::vector<std::string> getContentFiles()
+    {
+        std::vector<std::string> result;
+        for (std::size_t i = 0; i < contentFilesCount; ++i)
+            result.push_back(std::format("plugin{}.esp", i));
+        return result;
+    }
+
+    void loadEsmData(benchmark::State& state)
+    {
+        const Files::Collections fileCollections(Files::PathContainer{ getDataDir() });
+        const std::vector<std::string> contentFiles = getContentFiles();
+        EsmLoader::Query query;
+        query.mLoadCells = true;
+        query.mLoadGameSettings = true;
+        query.mLoadStatics = true;
+        const std::size_t threads = static_cast<std::size_t>(state.range(0));
+        std::size_t bytes = 0;
+        for (const std::string& file : contentFiles)
+            bytes += std::filesystem::file_size(getDataDir() / file);
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ESM::ReadersCache readers;
+            const EsmLoader::EsmData data
+                = EsmLoader::loadEsmData(query, contentFiles, fileCollections, readers, nullptr, nullptr, threads);
+            benchmark::DoNotOptimize(data);
+        }
+        state.SetItemsProcessed(state.iterations() * contentFilesCount);
+        state.SetBytesProcessed(state.iterations() * bytes);
+    }
+}
+
+BENCHMARK(loadEsmData)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
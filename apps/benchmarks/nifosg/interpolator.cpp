@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+
+#include <components/nif/nifkey.hpp>
+#include <components/nifosg/controller.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t tracksCount = 100;
+    constexpr std::size_t keysCount = 200;
+    constexpr float keysPerSecond = 30;
+    constexpr float frameDuration = 1.0f / 60;
+    constexpr std::size_t framesCount = 100;
+
+    std::shared_ptr<const Nif::FloatKeyMap> makeKeys(auto& random)
+    {
+        std::uniform_real_distribution<float> value(-1, 1);
+        auto result = std::make_shared<Nif::FloatKeyMap>();
+        result->mInterpolationType = Nif::InterpolationType_Linear;
+        for (std::size_t i = 0; i < keysCount; ++i)
+            result->mKeys.emplace_back(static_cast<float>(i) / keysPerSecond, Nif::KeyT<float>{ value(random), 0, 0 });
+        return result;
+    }
+
+    float getDuration()
+    {
+        return static_cast<float>(keysCount - 1) / keysPerSecond;
+    }
+
+    // Looped playback with a fixed frame rate
+    std::vector<float> makePlaybackTimes()
+    {
+        std::vector<float> result;
+        result.reserve(framesCount);
+        float time = 0;
+        for (std::size_t i = 0; i < framesCount; ++i)
+        {
+            result.push_back(time);
+            time += frameDuration;
+            if (time > getDuration())
+                time = 0;
+        }
+        return result;
+    }
+
+    std::vector<float> makeRandomTimes()
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> time(0, getDuration());
+        std::vector<float> result;
+        result.reserve(framesCount);
+        for (std::size_t i = 0; i < framesCount; ++i)
+            result.push_back(time(random));
+        return result;
+    }
+
+    // NifOsg::ValueInterpolator implementation before keys were stored in structure of arrays layout
+    class ArrayOfStructuresInterpolator
+    {
+    public:
+        explicit ArrayOfStructuresInterpolator(std::shared_ptr<const Nif::FloatKeyMap> keys)
+            : mKeys(std::move(keys))
+            , mLastLowKey(mKeys->mKeys.end())
+            , mLastHighKey(mKeys->mKeys.end())
+        {
+        }
+
+        float interpKey(float time) const
+        {
+            const Nif::FloatKeyMap::MapType& keys = mKeys->mKeys;
+
+            if (time <= keys.front().first)
+                return keys.front().second.mValue;
+
+            Nif::FloatKeyMap::MapType::const_iterator it = retrieveKey(time);
+
+            if (it != keys.end())
+            {
+                mLastHighKey = it;
+                mLastLowKey = --it;
+
+                const float highTime = mLastHighKey->first;
+                const float lowTime = mLastLowKey->first;
+                if (highTime == lowTime)
+                    return mLastLowKey->second.mValue;
+
+                const float a = (time - lowTime) / (highTime - lowTime);
+                return mLastLowKey->second.mValue + (mLastHighKey->second.mValue - mLastLowKey->second.mValue) * a;
+            }
+
+            return keys.back().second.mValue;
+        }
+
+    private:
+        std::shared_ptr<const Nif::FloatKeyMap> mKeys;
+        mutable Nif::FloatKeyMap::MapType::const_iterator mLastLowKey;
+        mutable Nif::FloatKeyMap::MapType::const_iterator mLastHighKey;
+
+        Nif::FloatKeyMap::MapType::const_iterator retrieveKey(float time) const
+        {
+            if (mLastHighKey != mKeys->mKeys.end())
+            {
+                if (time > mLastHighKey->first)
+                {
+                    ++mLastLowKey;
+                    ++mLastHighKey;
+                }
+                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
+                    return mLastHighKey;
+            }
+
+            return std::lower_bound(mKeys->mKeys.begin(), mKeys->mKeys.end(), time,
+                [](const Nif::FloatKeyMap::MapType::value_type& key, float t) { return key.first < t; });
+        }
+    };
+
+    // Every frame all tracks of an animation like bones of a skeleton are evaluated for the same time
+    template <class Interpolator>
+    void evaluate(benchmark::State& state, const std::vector<float>& times)
+    {
+        std::minstd_rand random;
+        std::vector<Interpolator> interpolators;
+        interpolators.reserve(tracksCount);
+        for (std::size_t i = 0; i < tracksCount; ++i)
+            interpolators.emplace_back(makeKeys(random));
+
+        for (auto _ : state)
+        {
+            for (float time : times)
+                for (const Interpolator& interpolator : interpolators)
+                    benchmark::DoNotOptimize(interpolator.interpKey(time));
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(times.size() * tracksCount));
+    }
+
+    void interpKeyPlayback(benchmark::State& state)
+    {
+        evaluate<NifOsg::FloatInterpolator>(state, makePlaybackTimes());
+    }
+
+    void interpKeyPlaybackWithArrayOfStructures(benchmark::State& state)
+    {
+        evaluate<ArrayOfStructuresInterpolator>(state, makePlaybackTimes());
+    }
+
+    void interpKeyRandom(benchmark::State& state)
+    {
+        evaluate<NifOsg::FloatInterpolator>(state, makeRandomTimes());
+    }
+
+    void interpKeyRandomWithArrayOfStructures(benchmark::State& state)
+    {
+        evaluate<ArrayOfStructuresInterpolator>(state, makeRandomTimes());
+    }
+}
+
+BENCHMARK(interpKeyPlayback);
+BENCHMARK(interpKeyPlaybackWithArrayOfStructures);
+BENCHMARK(interpKeyRandom);
+BENCHMARK(interpKeyRandomWithArrayOfStructures);
+
+BENCHMARK_MAIN();
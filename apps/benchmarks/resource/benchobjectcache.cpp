@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include "components/resource/objectcache.hpp"
+#include "components/resource/resourcemanager.hpp"
+
+#include <osg/Object>
+
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t keysCount = 10 * 1000;
+
+    struct Object : osg::Object
+    {
+        Object() = default;
+
+        Object(const Object& other, const osg::CopyOp& copyOp = osg::CopyOp())
+            : osg::Object(other, copyOp)
+        {
+        }
+
+        META_Object(ResourceBenchmark, Object)
+    };
+
+    const std::vector<std::string>& getKeys()
+    {
+        static const std::vector<std::string> keys = [] {
+            std::vector<std::string> result;
+            result.reserve(keysCount);
+            for (std::size_t i = 0; i < keysCount; ++i)
+                result.push_back(std::format("meshes/dir_{}/file_{}.nif", i % 97, i));
+            return result;
+        }();
+        return keys;
+    }
+
+    template <class Cache>
+    osg::ref_ptr<Cache> makeCache(std::size_t shardsCount)
+    {
+        osg::ref_ptr<Cache> result(new Cache(shardsCount));
+        for (const std::string& key : getKeys())
+            result->addEntryToObjectCache(key, new Object);
+        return result;
+    }
+
+    template <class Cache>
+    void getFromObjectCache(benchmark::State& state, Cache& cache)
+    {
+        const std::vector<std::string>& keys = getKeys();
+        std::minstd_rand random(static_cast<std::minstd_rand::result_type>(state.thread_index()) + 1);
+        std::uniform_int_distribution<std::size_t> distribution(0, keys.size() - 1);
+        for ([[maybe_unused]] auto _ : state)
+            benchmark::DoNotOptimize(cache.getRefFromObjectCache(keys[distribution(random)]));
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void getFromSingleShardObjectCache(benchmark::State& state)
+    {
+        using Cache = Resource::GenericObjectCache<std::string>;
+        static const osg::ref_ptr<Cache> cache = makeCache<Cache>(1);
+        getFromObjectCache(state, *cache);
+    }
+
+    void getFromShardedObjectCache(benchmark::State& state)
+    {
+        using Cache = Resource::GenericObjectCache<std::string, Resource::PathShardHash>;
+        static const osg::ref_ptr<Cache> cache = makeCache<Cache>(Resource::resourceCacheShardsCount);
+        getFromObjectCache(state, *cache);
+    }
+}
+
+BENCHMARK(getFromSingleShardObjectCache)->Threads(1)->Threads(2)->Threads(4)->Threads(8);
+BENCHMARK(getFromShardedObjectCache)->Threads(1)->Threads(2)->Threads(4)->Threads(8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include <components/sceneutil/skinning.hpp>
+
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+#include <osg/Vec4f>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace SceneUtil;
+
+    constexpr std::size_t verticesCount = 5000;
+    constexpr std::size_t bonesCount = 60;
+    constexpr std::size_t weightsPerVertex = 4;
+
+    struct Mesh
+    {
+        std::vector<BoneWeights> mInfluences;
+        std::vector<osg::Matrixf> mBoneMatrices;
+        std::vector<osg::Vec3f> mPositions;
+        std::vector<osg::Vec3f> mNormals;
+        std::vector<osg::Vec4f> mTangents;
+    };
+
+    Mesh generateMesh(auto& random)
+    {
+        std::uniform_real_distribution<float> coordinate(-1, 1);
+        std::uniform_real_distribution<float> angle(0, osg::PIf);
+        std::uniform_int_distribution<std::size_t> bone(0, bonesCount - 1);
+        // Weights are quantized like in real meshes to make some vertices share them
+        std::uniform_int_distribution<int> weight(1, 4);
+
+        Mesh result;
+        result.mBoneMatrices.reserve(bonesCount);
+        for (std::size_t i = 0; i < bonesCount; ++i)
+            result.mBoneMatrices.push_back(
+                osg::Matrixf::rotate(angle(random), osg::Vec3f(coordinate(random), coordinate(random), 1))
+                * osg::Matrixf::translate(coordinate(random), coordinate(random), coordinate(random)));
+
+        result.mInfluences.resize(verticesCount);
+        for (BoneWeights& weights : result.mInfluences)
+        {
+            float sum = 0;
+            for (std::size_t i = 0; i < weightsPerVertex; ++i)
+            {
+                const float value = static_cast<float>(weight(random));
+                weights.emplace_back(bone(random), value);
+                sum += value;
+            }
+            for (BoneWeight& v : weights)
+                v.second /= sum;
+        }
+
+        for (std::size_t i = 0; i < verticesCount; ++i)
+        {
+            result.mPositions.emplace_back(coordinate(random), coordinate(random), coordinate(random));
+            result.mNormals.emplace_back(coordinate(random), coordinate(random), coordinate(random));
+            result.mTangents.emplace_back(coordinate(random), coordinate(random), coordinate(random), 1);
+        }
+
+        return result;
+    }
+
+    const Mesh& getMesh()
+    {
+        static const Mesh mesh = [] {
+            std::minstd_rand random;
+            return generateMesh(random);
+        }();
+        return mesh;
+    }
+
+    void skinMesh(benchmark::State& state)
+    {
+        const Mesh& mesh = getMesh();
+        const SkinningData data = makeSkinningData(mesh.mInfluences);
+        std::vector<osg::Vec3f> positions(verticesCount);
+        std::vector<osg::Vec3f> normals(verticesCount);
+        std::vector<osg::Vec4f> tangents(verticesCount);
+        const SkinningArrays arrays{
+            .mSourcePositions = mesh.mPositions,
+            .mPositions = positions,
+            .mSourceNormals = mesh.mNormals,
+            .mNormals = normals,
+            .mSourceTangents = mesh.mTangents,
+            .mTangents = tangents,
+        };
+        const osg::Matrixf transform = osg::Matrixf::translate(1, 2, 3);
+
+        for (auto _ : state)
+        {
+            skin(data, mesh.mBoneMatrices, transform, arrays);
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(verticesCount));
+    }
+
+    // Per vertex osg::Matrixf based implementation used by RigGeometry before SceneUtil::skin
+    void skinMeshWithOsgMatrix(benchmark::State& state)
+    {
+        const Mesh& mesh = getMesh();
+        std::vector<osg::Vec3f> positions(verticesCount);
+        std::vector<osg::Vec3f> normals(verticesCount);
+        std::vector<osg::Vec4f> tangents(verticesCount);
+        const osg::Matrixf transform = osg::Matrixf::translate(1, 2, 3);
+
+        for (auto _ : state)
+        {
+            for (std::size_t vertex = 0; vertex < verticesCount; ++vertex)
+            {
+                osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+
+                for (const auto& [index, weight] : mesh.mInfluences[vertex])
+                {
+                    const float* boneMatPtr = mesh.mBoneMatrices[index].ptr();
+                    float* resultMatPtr = resultMat.ptr();
+                    for (int i = 0; i < 16; ++i, ++resultMatPtr, ++boneMatPtr)
+                        if (i % 4 != 3)
+                            *resultMatPtr += *boneMatPtr * weight;
+                }
+
+                resultMat *= transform;
+
+                positions[vertex] = resultMat.preMult(mesh.mPositions[vertex]);
+                normals[vertex] = osg::Matrixf::transform3x3(mesh.mNormals[vertex], resultMat);
+                const osg::Vec4f& srcTangent = mesh.mTangents[vertex];
+                const osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(
+                    osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
+                tangents[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
+            }
+            benchmark::DoNotOptimize(positions.data());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(verticesCount));
+    }
+}
+
+BENCHMARK(skinMesh);
+BENCHMARK(skinMeshWithOsgMatrix);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include "components/vfs/archive.hpp"
+#include "components/vfs/fileindex.hpp"
+#include "components/vfs/filemap.hpp"
+#include "components/vfs/manager.hpp"
+#include "components/vfs/pathutil.hpp"
+#include "components/vfs/recursivedirectoryiterator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t pathsCount = 500 * 1000;
+
+    const std::string_view rootDirs[] = { "meshes", "textures", "icons", "sound", "music", "bookart", "splash" };
+    const std::string_view extensions[] = { "nif", "dds", "kf", "tga", "wav", "mp3" };
+
+    template <class Random>
+    std::vector<std::string> generatePaths(Random& random)
+    {
+        std::uniform_int_distribution<std::size_t> rootDistribution(0, std::size(rootDirs) - 1);
+        std::uniform_int_distribution<std::size_t> dirDistribution(0, 999);
+        std::uniform_int_distribution<std::size_t> subDirDistribution(0, 31);
+        std::uniform_int_distribution<std::size_t> extensionDistribution(0, std::size(extensions) - 1);
+        std::vector<std::string> result;
+        result.reserve(pathsCount);
+        for (std::size_t i = 0; i < pathsCount; ++i)
+            result.push_back(std::format("{}/Dir_{}/Sub{}/File_{}.{}", rootDirs[rootDistribution(random)],
+                dirDistribution(random), subDirDistribution(random), i, extensions[extensionDistribution(random)]));
+        return result;
+    }
+
+    const std::vector<std::string>& getPaths()
+    {
+        static const std::vector<std::string> paths = [] {
+            std::minstd_rand random;
+            return generatePaths(random);
+        }();
+        return paths;
+    }
+
+    std::vector<VFS::Path::Normalized> getShuffledNormalizedPaths()
+    {
+        std::vector<VFS::Path::Normalized> result(getPaths().begin(), getPaths().end());
+        std::minstd_rand random;
+        std::shuffle(result.begin(), result.end(), random);
+        return result;
+    }
+
+    VFS::File* getFile(std::size_t index)
+    {
+        return reinterpret_cast<VFS::File*>(index + 1);
+    }
+
+    struct SyntheticArchive final : VFS::Archive
+    {
+        void listResources(VFS::FileIndex& out) override
+        {
+            const std::vector<std::string>& paths = getPaths();
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                out.insert(paths[i], getFile(i));
+        }
+
+        bool contains(VFS::Path::NormalizedView /*file*/) const override { return false; }
+
+        std::string getDescription() const override { return "Synthetic"; }
+    };
+
+    std::unique_ptr<VFS::Manager> makeManager()
+    {
+        auto result = std::make_unique<VFS::Manager>();
+        result->addArchive(std::make_unique<SyntheticArchive>());
+        result->buildIndex();
+        return result;
+    }
+
+    void buildFileIndex(benchmark::State& state)
+    {
+        getPaths();
+        VFS::Manager manager;
+        manager.addArchive(std::make_unique<SyntheticArchive>());
+        for ([[maybe_unused]] auto _ : state)
+            manager.buildIndex();
+        state.SetItemsProcessed(state.iterations() * pathsCount);
+    }
+
+    void buildFileMap(benchmark::State& state)
+    {
+        const std::vector<std::string>& paths = getPaths();
+        for ([[maybe_unused]] auto _ : state)
+        {
+            VFS::FileMap map;
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                map[VFS::Path::Normalized(paths[i])] = getFile(i);
+            benchmark::DoNotOptimize(map);
+        }
+        state.SetItemsProcessed(state.iterations() * pathsCount);
+    }
+
+    void findInFileIndex(benchmark::State& state)
+    {
+        const std::unique_ptr<VFS::Manager> manager = makeManager();
+        const std::vector<VFS::Path::Normalized> paths = getShuffledNormalizedPaths();
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(manager->exists(paths[i]));
+            if (++i >= paths.size())
+                i = 0;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void findInFileMap(benchmark::State& state)
+    {
+        const std::vector<std::string>& sourcePaths = getPaths();
+        VFS::FileMap map;
+        for (std::size_t i = 0; i < sourcePaths.size(); ++i)
+            map[VFS::Path::Normalized(sourcePaths[i])] = getFile(i);
+        const std::vector<VFS::Path::Normalized> paths = getShuffledNormalizedPaths();
+        std::size_t i = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            benchmark::DoNotOptimize(map.find(paths[i]) != map.end());
+            if (++i >= paths.size())
+                i = 0;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void iterateDirectory(benchmark::State& state)
+    {
+        constexpr VFS::Path::NormalizedView meshes("meshes/");
+        const std::unique_ptr<VFS::Manager> manager = makeManager();
+        std::size_t count = 0;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (VFS::Path::NormalizedView path : manager->getRecursiveDirectoryIterator(meshes))
+            {
+                benchmark::DoNotOptimize(path);
+                ++count;
+            }
+        }
+        state.SetItemsProcessed(count);
+    }
+}
+
+BENCHMARK(buildFileIndex)->Unit(benchmark::kMillisecond);
+BENCHMARK(buildFileMap)->Unit(benchmark::kMillisecond);
+BENCHMARK(findInFileIndex);
+BENCHMARK(findInFileMap);
+BENCHMARK(iterateDirectory)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
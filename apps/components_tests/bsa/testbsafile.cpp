@@ -14,7 +14,10 @@
 #include <format>
 #include <fstream>
 #include <memory>
+#include <optional>
+#include <span>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 namespace Bsa
@@ -219,6 +222,86 @@ namespace Bsa
                 }));
         }
 
+        TEST(BSAFileTest, shouldProvideFileContentFromMemoryMappedArchive)
+        {
+            const std::filesystem::path path = makeOutputPath();
+            constexpr std::string_view content = "memory mapped";
+
+            {
+                std::ofstream stream;
+                stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+                stream.open(path, std::ios::binary);
+
+                const Header header{
+                    .mFormat = static_cast<std::uint32_t>(BsaVersion::Uncompressed),
+                    .mDirSize = 14,
+                    .mFileCount = 1,
+                };
+
+                const Archive archive{
+                    .mHeader = header,
+                    .mOffsets = { static_cast<std::uint32_t>(content.size()), 0, 0 },
+                    .mStringBuffer = { 'a', '\0' },
+                    .mHashes = { BSAFile::Hash{ .mLow = 0xaaaabbbb, .mHigh = 0xccccdddd } },
+                    .mTailSize = 0,
+                };
+
+                writeArchive(archive, stream);
+                stream.write(content.data(), content.size());
+            }
+
+            BSAFile file;
+            file.open(path, true);
+
+            ASSERT_TRUE(file.isMemoryMapped());
+            ASSERT_EQ(file.getList().size(), 1);
+
+            const std::optional<std::span<const char>> data = file.getFileData(&file.getList().front());
+            ASSERT_TRUE(data.has_value());
+            EXPECT_EQ(std::string_view(data->data(), data->size()), content);
+
+            const Files::IStreamPtr fileStream = file.getFile(&file.getList().front());
+            std::string read(content.size() + 1, '\0');
+            fileStream->read(read.data(), read.size());
+            EXPECT_EQ(std::string_view(read.data(), fileStream->gcount()), content);
+        }
+
+        TEST(BSAFileTest, shouldNotProvideFileContentWhenNotMemoryMapped)
+        {
+            const std::filesystem::path path = makeOutputPath();
+
+            {
+                std::ofstream stream;
+                stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+                stream.open(path, std::ios::binary);
+
+                const Header header{
+                    .mFormat = static_cast<std::uint32_t>(BsaVersion::Uncompressed),
+                    .mDirSize = 14,
+                    .mFileCount = 1,
+                };
+
+                const Archive archive{
+                    .mHeader = header,
+                    .mOffsets = { 42, 0, 0 },
+                    .mStringBuffer = { 'a', '\0' },
+                    .mHashes = { BSAFile::Hash{ .mLow = 0xaaaabbbb, .mHigh = 0xccccdddd } },
+                    .mTailSize = 42,
+                };
+
+                writeArchive(archive, stream);
+            }
+
+            BSAFile file;
+            file.open(path);
+
+            EXPECT_FALSE(file.isMemoryMapped());
+            ASSERT_EQ(file.getList().size(), 1);
+            EXPECT_FALSE(file.getFileData(&file.getList().front()).has_value());
+        }
+
         TEST(BSAFileTest, shouldHandleTwoFiles)
         {
             const std::filesystem::path path = makeOutputPath();
@@ -157,6 +157,37 @@ namespace
         EXPECT_EQ(tile->mVersion, navMeshFormatVersion);
     }
 
+    TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_should_insert_tile_when_shared_tile_from_db_is_not_used)
+    {
+        mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
+        addHeightFieldPlane(mRecastMeshManager);
+        auto db = std::make_unique<NavMeshDb>(":memory:", std::numeric_limits<std::uint64_t>::max());
+        NavMeshDb* const dbPtr = db.get();
+        const TilePosition tilePosition{ 0, 0 };
+        const auto recastMesh = mRecastMeshManager.getMesh(mWorldspace, tilePosition);
+        ASSERT_NE(recastMesh, nullptr);
+        ShapeId nextShapeId{ 1 };
+        const std::vector<DbRefGeometryObject> objects = makeDbRefGeometryObjects(recastMesh->getMeshSources(),
+            [&](const MeshSource& v) { return resolveMeshSource(*dbPtr, v, nextShapeId); });
+        const std::vector<std::byte> input = serialize(mSettings.mRecast, mAgentBounds, *recastMesh, objects);
+        const ESM::RefId otherWorldspace = ESM::RefId::stringRefId("other");
+        const std::vector<std::byte> brokenData(16, std::byte{ 0xff });
+        dbPtr->insertTile(TileId{ 1 }, otherWorldspace, tilePosition, TileVersion{ navMeshFormatVersion }, input,
+            brokenData);
+        AsyncNavMeshUpdater updater(mSettings, mRecastMeshManager, mOffMeshConnectionsManager, std::move(db));
+        const auto navMeshCacheItem = std::make_shared<GuardedNavMeshCacheItem>(1, mSettings);
+        const std::map<TilePosition, ChangeType> changedTiles{ { tilePosition, ChangeType::add } };
+        updater.post(mAgentBounds, navMeshCacheItem, mPlayerTile, mWorldspace, changedTiles);
+        updater.wait(WaitConditionType::allJobsDone, &mListener);
+        updater.stop();
+        const auto tile = dbPtr->findTile(mWorldspace, tilePosition, input);
+        ASSERT_TRUE(tile.has_value());
+        EXPECT_EQ(tile->mTileId, 2);
+        const auto otherTile = dbPtr->getTileData(otherWorldspace, tilePosition, input);
+        ASSERT_TRUE(otherTile.has_value());
+        EXPECT_EQ(otherTile->mData, brokenData);
+    }
+
     TEST_F(DetourNavigatorAsyncNavMeshUpdaterTest, post_when_writing_to_db_disabled_should_not_write_tiles)
     {
         mRecastMeshManager.setWorldspace(mWorldspace, nullptr);
@@ -0,0 +1,166 @@
+#include "settings.hpp"
+
+#include <components/detournavigator/makenavmesh.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/tilelayerscache.hpp>
+
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace DetourNavigator;
+    using namespace DetourNavigator::Tests;
+
+    struct DetourNavigatorMakeNavMeshTest : Test
+    {
+        const Settings mSettings = makeSettings();
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const TilePosition mTilePosition{ 0, 0 };
+        const ESM::RefId mWorldspace = ESM::RefId::stringRefId("sys::default");
+        const btBoxShape mBox{ btVector3(50, 50, 20) };
+        const btBoxShape mStaticBox{ btVector3(100, 20, 40) };
+
+        std::shared_ptr<RecastMesh> makeRecastMesh(const btVector3& boxPosition) const
+        {
+            RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings.mRecast, mTilePosition));
+            builder.addHeightfield(osg::Vec2i(0, 0), 8192, 0);
+            builder.addObject(mStaticBox, btTransform(btQuaternion::getIdentity(), btVector3(300, 600, 0)),
+                AreaType_ground);
+            builder.addObject(mBox, btTransform(btQuaternion::getIdentity(), boxPosition), AreaType_ground);
+            return std::move(builder).create(Version{ 1, 1 });
+        }
+
+        std::unique_ptr<PreparedNavMeshData> prepare(
+            const RecastMesh& recastMesh, const TileLayer* previousLayer = nullptr, TileLayer* layer = nullptr) const
+        {
+            return prepareNavMeshTileData(
+                recastMesh, mWorldspace, mTilePosition, mAgentBounds, mSettings.mRecast, previousLayer, layer);
+        }
+    };
+
+    TEST_F(DetourNavigatorMakeNavMeshTest, prepare_should_fill_layer)
+    {
+        const std::shared_ptr<RecastMesh> recastMesh = makeRecastMesh(btVector3(200, 200, 0));
+        TileLayer layer;
+        ASSERT_NE(prepare(*recastMesh, nullptr, &layer), nullptr);
+        EXPECT_FALSE(layer.mSpans.empty());
+        EXPECT_EQ(layer.mWidth, mSettings.mRecast.mTileSize + 2 * mSettings.mRecast.mBorderSize);
+        EXPECT_EQ(layer.mHeight, layer.mWidth);
+        EXPECT_EQ(layer.mMesh, recastMesh->getMesh());
+        EXPECT_EQ(layer.mHeightfields, recastMesh->getHeightfields());
+    }
+
+    TEST_F(DetourNavigatorMakeNavMeshTest, prepare_with_layer_for_same_recast_mesh_should_give_same_result)
+    {
+        const std::shared_ptr<RecastMesh> recastMesh = makeRecastMesh(btVector3(200, 200, 0));
+        TileLayer layer;
+        const std::unique_ptr<PreparedNavMeshData> expected = prepare(*recastMesh, nullptr, &layer);
+        ASSERT_NE(expected, nullptr);
+        const std::unique_ptr<PreparedNavMeshData> result = prepare(*recastMesh, &layer);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(*result, *expected);
+    }
+
+    TEST_F(DetourNavigatorMakeNavMeshTest, prepare_with_layer_for_changed_object_should_give_same_result_as_full)
+    {
+        TileLayer layer;
+        ASSERT_NE(prepare(*makeRecastMesh(btVector3(200, 200, 0)), nullptr, &layer), nullptr);
+        const std::shared_ptr<RecastMesh> recastMesh = makeRecastMesh(btVector3(260, 230, 10));
+        const std::unique_ptr<PreparedNavMeshData> expected = prepare(*recastMesh);
+        ASSERT_NE(expected, nullptr);
+        TileLayer nextLayer;
+        const std::unique_ptr<PreparedNavMeshData> result = prepare(*recastMesh, &layer, &nextLayer);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(*result, *expected);
+        TileLayer expectedLayer;
+        ASSERT_NE(prepare(*recastMesh, nullptr, &expectedLayer), nullptr);
+        EXPECT_EQ(nextLayer.mSpans, expectedLayer.mSpans);
+    }
+
+    TEST_F(DetourNavigatorMakeNavMeshTest, prepare_with_layer_for_changed_water_should_give_same_result_as_full)
+    {
+        TileLayer layer;
+        ASSERT_NE(prepare(*makeRecastMesh(btVector3(200, 200, 0)), nullptr, &layer), nullptr);
+        RecastMeshBuilder builder(makeRealTileBoundsWithBorder(mSettings.mRecast, mTilePosition));
+        builder.addHeightfield(osg::Vec2i(0, 0), 8192, 0);
+        builder.addWater(osg::Vec2i(0, 0), Water{ 8192, 100 });
+        const std::shared_ptr<RecastMesh> recastMesh = std::move(builder).create(Version{ 1, 2 });
+        const std::unique_ptr<PreparedNavMeshData> expected = prepare(*recastMesh);
+        ASSERT_NE(expected, nullptr);
+        const std::unique_ptr<PreparedNavMeshData> result = prepare(*recastMesh, &layer);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(*result, *expected);
+    }
+
+    struct DetourNavigatorTileLayersCacheTest : Test
+    {
+        const AgentBounds mAgentBounds{ CollisionShapeType::Aabb, { 29, 29, 66 } };
+        const TilePosition mTilePosition{ 0, 0 };
+
+        static std::shared_ptr<const TileLayer> makeLayer(std::size_t spansSize)
+        {
+            auto result = std::make_shared<TileLayer>();
+            result->mSpans.resize(spansSize);
+            return result;
+        }
+    };
+
+    TEST_F(DetourNavigatorTileLayersCacheTest, get_for_empty_cache_should_return_nullptr)
+    {
+        TileLayersCache cache(1024);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), nullptr);
+        EXPECT_EQ(cache.getStats().mGetCount, 1u);
+        EXPECT_EQ(cache.getStats().mHitCount, 0u);
+    }
+
+    TEST_F(DetourNavigatorTileLayersCacheTest, get_should_return_set_value)
+    {
+        TileLayersCache cache(1024);
+        const std::shared_ptr<const TileLayer> layer = makeLayer(1);
+        cache.set(mAgentBounds, mTilePosition, layer);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), layer);
+        EXPECT_EQ(cache.getStats().mHitCount, 1u);
+        EXPECT_EQ(cache.getStats().mLayers, 1u);
+        EXPECT_EQ(cache.getStats().mSize, getSize(*layer));
+    }
+
+    TEST_F(DetourNavigatorTileLayersCacheTest, set_should_replace_value_for_same_tile)
+    {
+        TileLayersCache cache(1024);
+        cache.set(mAgentBounds, mTilePosition, makeLayer(1));
+        const std::shared_ptr<const TileLayer> layer = makeLayer(2);
+        cache.set(mAgentBounds, mTilePosition, layer);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), layer);
+        EXPECT_EQ(cache.getStats().mLayers, 1u);
+        EXPECT_EQ(cache.getStats().mSize, getSize(*layer));
+    }
+
+    TEST_F(DetourNavigatorTileLayersCacheTest, set_should_not_store_value_larger_than_max_size)
+    {
+        const std::shared_ptr<const TileLayer> layer = makeLayer(1024);
+        TileLayersCache cache(getSize(*layer) - 1);
+        cache.set(mAgentBounds, mTilePosition, layer);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), nullptr);
+        EXPECT_EQ(cache.getStats().mSize, 0u);
+    }
+
+    TEST_F(DetourNavigatorTileLayersCacheTest, set_should_evict_least_recently_used_value)
+    {
+        const std::shared_ptr<const TileLayer> layer = makeLayer(1);
+        TileLayersCache cache(2 * getSize(*layer));
+        const TilePosition tilePosition1(1, 0);
+        const TilePosition tilePosition2(2, 0);
+        cache.set(mAgentBounds, mTilePosition, layer);
+        cache.set(mAgentBounds, tilePosition1, layer);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), layer);
+        cache.set(mAgentBounds, tilePosition2, layer);
+        EXPECT_EQ(cache.get(mAgentBounds, mTilePosition), layer);
+        EXPECT_EQ(cache.get(mAgentBounds, tilePosition1), nullptr);
+        EXPECT_EQ(cache.get(mAgentBounds, tilePosition2), layer);
+    }
+}
@@ -23,10 +23,12 @@
 #include <array>
 #include <condition_variable>
 #include <deque>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 MATCHER_P3(Vec3fEq, x, y, z, "")
 {
@@ -82,6 +84,10 @@ namespace
         0, -25, -100, -100, -100, // row 4
     } };
 
+    constexpr std::size_t flatHeightfieldSize = 17;
+
+    constexpr std::array<float, flatHeightfieldSize * flatHeightfieldSize> flatHeightfieldData{};
+
     template <class T, std::size_t size>
     std::pair<T, T> getMinMaxHeight(const std::array<T, size>& values)
     {
@@ -206,6 +212,116 @@ namespace
         EXPECT_THAT(mPath, ElementsAre(Vec3fEq(56.66666412353515625, 460, 1.99998295307159423828125))) << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_paths_should_return_same_results_as_find_path)
+    {
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(defaultHeightfieldData);
+        const int cellSize = heightfieldTileSize * static_cast<int>(surface.mSize - 1);
+
+        ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+        auto updateGuard = mNavigator->makeUpdateGuard();
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface, updateGuard.get());
+        mNavigator->update(mPlayerPosition, updateGuard.get());
+        updateGuard.reset();
+        mNavigator->wait(WaitConditionType::requiredTilesPresent, &mListener);
+
+        const AgentBounds otherAgentBounds{ CollisionShapeType::Cylinder, { 29, 29, 66 } };
+        std::vector<PathRequest> requests;
+        for (int i = 0; i < 10; ++i)
+            requests.push_back(PathRequest{
+                .mAgentBounds = i == 5 ? otherAgentBounds : mAgentBounds,
+                .mStart = mStart + osg::Vec3f(10.0f * i, 0, 0),
+                .mEnd = i % 2 == 0 ? mEnd : mStart,
+                .mIncludeFlags = Flag_walk,
+                .mAreaCosts = mAreaCosts,
+                .mEndTolerance = mEndTolerance,
+                .mCheckpoints = {},
+            });
+        std::vector<PathResult> results(requests.size());
+
+        mNavigator->findPaths(requests, results);
+
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            std::vector<osg::Vec3f> expectedPath;
+            const Status expectedStatus = findPath(*mNavigator, requests[i].mAgentBounds, requests[i].mStart,
+                requests[i].mEnd, Flag_walk, mAreaCosts, mEndTolerance, {}, std::back_inserter(expectedPath));
+            EXPECT_EQ(results[i].mStatus, expectedStatus) << i;
+            EXPECT_EQ(results[i].mPath, expectedPath) << i;
+        }
+        EXPECT_EQ(results[5].mStatus, Status::NavMeshNotFound);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTest, find_tile_route_for_empty_should_return_navmesh_not_found)
+    {
+        std::vector<osg::Vec3f> route;
+        EXPECT_EQ(findTileRoute(*mNavigator, mAgentBounds, mStart, mEnd, Flag_walk, route), Status::NavMeshNotFound);
+        EXPECT_THAT(route, IsEmpty());
+    }
+
+    struct DetourNavigatorNavigatorTileRouteTest : DetourNavigatorNavigatorTest
+    {
+        const int mCellSize = heightfieldTileSize * static_cast<int>(flatHeightfieldSize - 1);
+
+        void SetUp() override
+        {
+            const HeightfieldSurface surface = makeSquareHeightfieldSurface(flatHeightfieldData);
+            const osg::Vec3f playerPosition(mCellSize / 2.0f, mCellSize / 2.0f, 0);
+            ASSERT_TRUE(mNavigator->addAgent(mAgentBounds));
+            auto updateGuard = mNavigator->makeUpdateGuard();
+            mNavigator->addHeightfield(mCellPosition, mCellSize, surface, updateGuard.get());
+            mNavigator->update(playerPosition, updateGuard.get());
+            updateGuard.reset();
+            mNavigator->wait(WaitConditionType::allJobsDone, &mListener);
+        }
+    };
+
+    TEST_F(DetourNavigatorNavigatorTileRouteTest, find_tile_route_should_return_points_between_start_and_end)
+    {
+        const osg::Vec3f start(100, 100, 1);
+        const osg::Vec3f end(mCellSize - 100.0f, mCellSize - 100.0f, 1);
+        std::vector<osg::Vec3f> route;
+        ASSERT_EQ(findTileRoute(*mNavigator, mAgentBounds, start, end, Flag_walk, route), Status::Success);
+        ASSERT_GE(route.size(), 2u);
+        for (const osg::Vec3f& point : route)
+        {
+            EXPECT_GT(point.x(), start.x()) << point;
+            EXPECT_GT(point.y(), start.y()) << point;
+            EXPECT_LT(point.x(), end.x()) << point;
+            EXPECT_LT(point.y(), end.y()) << point;
+        }
+    }
+
+    TEST_F(DetourNavigatorNavigatorTileRouteTest, find_tile_route_should_return_same_route_for_same_tiles)
+    {
+        const osg::Vec3f end(mCellSize - 100.0f, mCellSize - 100.0f, 1);
+        std::vector<osg::Vec3f> route1;
+        ASSERT_EQ(findTileRoute(*mNavigator, mAgentBounds, osg::Vec3f(100, 100, 1), end, Flag_walk, route1),
+            Status::Success);
+        std::vector<osg::Vec3f> route2;
+        ASSERT_EQ(findTileRoute(*mNavigator, mAgentBounds, osg::Vec3f(110, 90, 1), end, Flag_walk, route2),
+            Status::Success);
+        EXPECT_EQ(route1, route2);
+        EXPECT_EQ(mNavigator->getNavMesh(mAgentBounds)->lock()->getTileGraph().getCachedRoutesCount(), 1u);
+    }
+
+    TEST_F(DetourNavigatorNavigatorTileRouteTest, find_tile_route_to_unreachable_end_should_return_partial_route)
+    {
+        const osg::Vec3f start(100, 100, 1);
+        const osg::Vec3f end(10 * mCellSize, 10 * mCellSize, 1);
+        std::vector<osg::Vec3f> route;
+        EXPECT_EQ(findTileRoute(*mNavigator, mAgentBounds, start, end, Flag_walk, route), Status::PartialPath);
+        EXPECT_THAT(route, Not(IsEmpty()));
+    }
+
+    TEST_F(DetourNavigatorNavigatorTileRouteTest, find_tile_route_with_not_matching_flags_should_return_partial_route)
+    {
+        const osg::Vec3f start(100, 100, 1);
+        const osg::Vec3f end(mCellSize - 100.0f, mCellSize - 100.0f, 1);
+        std::vector<osg::Vec3f> route;
+        EXPECT_EQ(findTileRoute(*mNavigator, mAgentBounds, start, end, Flag_swim, route), Status::PartialPath);
+        EXPECT_THAT(route, IsEmpty());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         mSettings.mWaitUntilMinDistanceToPlayer = 0;
@@ -47,6 +47,17 @@ namespace
         }
     };
 
+    TEST_F(DetourNavigatorNavMeshDbTest, get_db_id_should_return_same_value_for_same_db)
+    {
+        EXPECT_EQ(mDb.getDbId(), mDb.getDbId());
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_db_id_should_return_different_values_for_different_dbs)
+    {
+        NavMeshDb other(":memory:", std::numeric_limits<std::uint64_t>::max());
+        EXPECT_NE(mDb.getDbId(), other.getDbId());
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, get_max_tile_id_for_empty_db_should_return_zero)
     {
         EXPECT_EQ(mDb.getMaxTileId(), TileId{ 0 });
@@ -84,6 +95,26 @@ namespace
         EXPECT_EQ(row->mData, data);
     }
 
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_data_by_input_should_return_tile_from_any_worldspace)
+    {
+        const TileId tileId{ 13 };
+        const TileVersion version{ 1 };
+        const auto [worldspace, tilePosition, input, data] = insertTile(tileId, version);
+        const ESM::RefId otherWorldspace = ESM::RefId::stringRefId("other");
+        EXPECT_FALSE(mDb.getTileData(otherWorldspace, tilePosition, input).has_value());
+        const auto row = mDb.getTileDataByInput(tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mTileId, tileId);
+        EXPECT_EQ(row->mVersion, version);
+        EXPECT_EQ(row->mData, data);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_data_by_input_should_not_return_tile_at_other_position)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 13 }, TileVersion{ 1 });
+        EXPECT_FALSE(mDb.getTileDataByInput(tilePosition + TilePosition(1, 0), input).has_value());
+    }
+
     TEST_F(DetourNavigatorNavMeshDbTest, on_inserted_duplicate_should_throw_exception)
     {
         const TileId tileId{ 53 };
@@ -176,4 +207,91 @@ namespace
         };
         EXPECT_THROW(f(), std::runtime_error);
     }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, get_tile_data_should_return_cached_tile_on_repeated_read)
+    {
+        mDb = NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max(), NavMeshDb::defaultWalAutoCheckpoint,
+            std::numeric_limits<std::size_t>::max());
+        const TileId tileId{ 13 };
+        const TileVersion version{ 1 };
+        const auto [worldspace, tilePosition, input, data] = insertTile(tileId, version);
+        ASSERT_TRUE(mDb.getTileData(worldspace, tilePosition, input).has_value());
+        const auto row = mDb.getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mTileId, tileId);
+        EXPECT_EQ(row->mVersion, version);
+        EXPECT_EQ(row->mData, data);
+        EXPECT_EQ(mDb.getStats().mTileDataCacheGetCount, 2u);
+        EXPECT_EQ(mDb.getStats().mTileDataCacheHitCount, 1u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, updated_tile_should_not_be_returned_from_cache_with_old_data)
+    {
+        mDb = NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max(), NavMeshDb::defaultWalAutoCheckpoint,
+            std::numeric_limits<std::size_t>::max());
+        const TileId tileId{ 13 };
+        const TileVersion version{ 1 };
+        auto [worldspace, tilePosition, input, data] = insertTile(tileId, version);
+        ASSERT_TRUE(mDb.getTileData(worldspace, tilePosition, input).has_value());
+        generateRange(data.begin(), data.end(), mRandom);
+        ASSERT_EQ(mDb.updateTile(tileId, TileVersion{ 2 }, data), 1);
+        const auto row = mDb.getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mVersion, TileVersion{ 2 });
+        EXPECT_EQ(row->mData, data);
+        EXPECT_EQ(mDb.getStats().mTileDataCacheHitCount, 0u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, deleted_tile_should_not_be_returned_from_cache)
+    {
+        mDb = NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max(), NavMeshDb::defaultWalAutoCheckpoint,
+            std::numeric_limits<std::size_t>::max());
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 13 }, TileVersion{ 1 });
+        ASSERT_TRUE(mDb.getTileData(worldspace, tilePosition, input).has_value());
+        ASSERT_EQ(mDb.deleteTilesAt(worldspace, tilePosition), 1);
+        EXPECT_FALSE(mDb.getTileData(worldspace, tilePosition, input).has_value());
+        EXPECT_EQ(mDb.getStats().mTileDataCacheSize, 0u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tile_data_cache_should_not_store_tiles_when_disabled)
+    {
+        const auto [worldspace, tilePosition, input, data] = insertTile(TileId{ 13 }, TileVersion{ 1 });
+        ASSERT_TRUE(mDb.getTileData(worldspace, tilePosition, input).has_value());
+        ASSERT_TRUE(mDb.getTileData(worldspace, tilePosition, input).has_value());
+        EXPECT_EQ(mDb.getStats().mTileDataCacheHitCount, 0u);
+        EXPECT_EQ(mDb.getStats().mTileDataCacheSize, 0u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, compressible_tile_data_should_be_stored_compressed)
+    {
+        const TileId tileId{ 13 };
+        const TileVersion version{ 1 };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data(1024, std::byte{ 42 });
+        ASSERT_EQ(mDb.insertTile(tileId, worldspace, tilePosition, version, input, data), 1);
+        EXPECT_LT(mDb.getStats().mEncodedDataSize, data.size());
+        const auto row = mDb.getTileData(worldspace, tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mData, data);
+        EXPECT_EQ(mDb.getStats().mDecodeCount, 1u);
+    }
+
+    TEST_F(DetourNavigatorNavMeshDbTest, tile_data_written_without_compression_should_be_read)
+    {
+        mDb = NavMeshDb(":memory:", std::numeric_limits<std::uint64_t>::max(), NavMeshDb::defaultWalAutoCheckpoint, 0,
+            false);
+        const TileId tileId{ 13 };
+        const TileVersion version{ 1 };
+        const ESM::RefId worldspace = ESM::RefId::stringRefId("sys::default");
+        const TilePosition tilePosition{ 3, 4 };
+        const std::vector<std::byte> input = generateData();
+        const std::vector<std::byte> data(1024, std::byte{ 42 });
+        ASSERT_EQ(mDb.insertTile(tileId, worldspace, tilePosition, version, input, data), 1);
+        EXPECT_EQ(mDb.getStats().mEncodedDataSize, data.size());
+        const auto row = mDb.getTileDataByInput(tilePosition, input);
+        ASSERT_TRUE(row.has_value());
+        EXPECT_EQ(row->mData, data);
+    }
 }
@@ -162,6 +162,20 @@ namespace
         EXPECT_EQ(result.get(), *copy);
     }
 
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, get_should_return_cached_value_for_equal_recast_mesh)
+    {
+        const std::size_t maxSize = mRecastMeshSize + mPreparedNavMeshDataSize;
+        NavMeshTilesCache cache(maxSize);
+        const auto copy = clone(*mPreparedNavMeshData);
+        const RecastMesh equalRecastMesh(
+            Version{ 1, 1 }, makeMesh(), mWater, mHeightfields, mFlatHeightfields, mSources);
+
+        cache.set(mAgentBounds, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData));
+        const auto result = cache.get(mAgentBounds, mTilePosition, equalRecastMesh);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result.get(), *copy);
+    }
+
     TEST_F(DetourNavigatorNavMeshTilesCacheTest, get_for_cache_miss_by_agent_half_extents_should_return_empty_value)
     {
         const std::size_t maxSize = 1;
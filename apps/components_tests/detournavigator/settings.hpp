@@ -35,13 +35,16 @@ namespace DetourNavigator
             result.mRecast.mTileSize = 64;
             result.mWaitUntilMinDistanceToPlayer = std::numeric_limits<int>::max();
             result.mAsyncNavMeshUpdaterThreads = 1;
+            result.mBatchPathFinderThreads = 1;
             result.mMaxNavMeshTilesCacheSize = 1024 * 1024;
+            result.mMaxNavMeshTileLayersCacheSize = 1024 * 1024;
             result.mDetour.mMaxPolygonPathSize = 1024;
             result.mDetour.mMaxSmoothPathSize = 1024;
             result.mDetour.mMaxPolys = 4096;
             result.mMaxTilesNumber = 1024;
             result.mMinUpdateInterval = std::chrono::milliseconds(50);
             result.mWriteToNavMeshDb = true;
+            result.mDbWriteBatchSize = 64;
             return result;
         }
     }
@@ -1,3 +1,4 @@
+#include <components/esm3/esmwriter.hpp>
 #include <components/esm3/loadacti.hpp>
 #include <components/esm3/loadcell.hpp>
 #include <components/esm3/loadcont.hpp>
@@ -6,14 +7,19 @@
 #include <components/esm3/loadland.hpp>
 #include <components/esm3/loadstat.hpp>
 #include <components/esm3/readerscache.hpp>
+#include <components/esmloader/cache.hpp>
 #include <components/esmloader/esmdata.hpp>
 #include <components/esmloader/load.hpp>
 #include <components/files/collections.hpp>
 #include <components/files/multidircollection.hpp>
+#include <components/testing/util.hpp>
 #include <components/toutf8/toutf8.hpp>
 
 #include <gtest/gtest.h>
 
+#include <format>
+#include <fstream>
+
 #ifndef OPENMW_DATA_DIR
 #error "OPENMW_DATA_DIR is not defined"
 #endif
@@ -133,4 +139,120 @@ namespace
         EXPECT_EQ(esmData.mLands.size(), 0);
         EXPECT_EQ(esmData.mStatics.size(), 0);
     }
+
+    struct EsmLoaderMultipleFilesTest : TestWithParam<std::size_t>
+    {
+        const std::filesystem::path mDataDir = TestingOpenMW::outputDirPath("EsmLoaderMultipleFilesTest");
+        const Files::Collections mFileCollections{ Files::PathContainer{ mDataDir } };
+        std::vector<std::string> mContentFiles;
+
+        template <class T>
+        static void writeRecord(ESM::ESMWriter& writer, const T& record)
+        {
+            writer.startRecord(T::sRecordId);
+            record.save(writer);
+            writer.endRecord(T::sRecordId);
+        }
+
+        EsmLoaderMultipleFilesTest()
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                const std::string name = std::format("plugin{}.omwaddon", i);
+                std::ofstream stream(mDataDir / name, std::ios::binary);
+                ESM::ESMWriter writer;
+                writer.setFormatVersion(ESM::CurrentContentFormatVersion);
+                writer.save(stream);
+
+                ESM::Static stat;
+                stat.blank();
+                stat.mId = ESM::RefId::stringRefId("static");
+                stat.mModel = std::format("model{}.nif", i);
+                writeRecord(writer, stat);
+
+                ESM::Cell cell;
+                cell.blank();
+                cell.mName = "Interior";
+                cell.mData.mFlags = ESM::Cell::Interior;
+                cell.mWater = static_cast<float>(i);
+                cell.mHasWaterHeightSub = i % 2 == 0;
+                writeRecord(writer, cell);
+
+                writer.close();
+                mContentFiles.push_back(name);
+            }
+        }
+    };
+
+    TEST_P(EsmLoaderMultipleFilesTest, loadEsmDataShouldMergeFilesInLoadOrder)
+    {
+        Query query;
+        query.mLoadCells = true;
+        query.mLoadStatics = true;
+        ESM::ReadersCache readers;
+        const EsmData esmData
+            = loadEsmData(query, mContentFiles, mFileCollections, readers, nullptr, nullptr, GetParam());
+        ASSERT_EQ(esmData.mStatics.size(), 1);
+        EXPECT_EQ(esmData.mStatics[0].mModel, "model3.nif");
+        ASSERT_EQ(esmData.mCells.size(), 1);
+        EXPECT_EQ(esmData.mCells[0].mWater, 2);
+        ASSERT_EQ(esmData.mCells[0].mContextList.size(), 4);
+        for (std::size_t i = 0; i < 4; ++i)
+            EXPECT_EQ(esmData.mCells[0].mContextList[i].index, static_cast<int>(i));
+    }
+
+    INSTANTIATE_TEST_SUITE_P(Threads, EsmLoaderMultipleFilesTest, Values(1, 2, 4));
+
+    TEST_F(EsmLoaderMultipleFilesTest, loadCachedEsmDataShouldReturnSameDataAsLoadEsmData)
+    {
+        Query query;
+        query.mLoadCells = true;
+        query.mLoadStatics = true;
+        const std::filesystem::path cachePath = TestingOpenMW::currentTestDirPath() / "esmdata.bin";
+        std::filesystem::remove(cachePath);
+        {
+            ESM::ReadersCache readers;
+            loadCachedEsmData(cachePath, query, mContentFiles, mFileCollections, readers, nullptr);
+        }
+        ASSERT_TRUE(std::filesystem::exists(cachePath));
+        ESM::ReadersCache readers;
+        const EsmData esmData = loadCachedEsmData(cachePath, query, mContentFiles, mFileCollections, readers, nullptr);
+        ASSERT_EQ(esmData.mStatics.size(), 1);
+        EXPECT_EQ(esmData.mStatics[0].mId, ESM::RefId::stringRefId("static"));
+        EXPECT_EQ(esmData.mStatics[0].mModel, "model3.nif");
+        ASSERT_EQ(esmData.mCells.size(), 1);
+        EXPECT_EQ(esmData.mCells[0].mName, "Interior");
+        EXPECT_EQ(esmData.mCells[0].mWater, 2);
+        ASSERT_EQ(esmData.mCells[0].mContextList.size(), 4);
+        EXPECT_EQ(esmData.mCells[0].mContextList[3].filename, mDataDir / "plugin3.omwaddon");
+        ASSERT_EQ(esmData.mRefIdTypes.size(), 1);
+        EXPECT_EQ(esmData.mRefIdTypes[0].mType, ESM::REC_STAT);
+    }
+
+    TEST(EsmLoaderCacheTest, deserializeShouldReturnNulloptForDifferentKey)
+    {
+        CacheKey key;
+        key.mContentFiles.push_back(ContentFileState{ .mPath = "plugin.esp", .mSize = 1, .mLastModified = 2 });
+        EsmData data;
+        data.mStatics.emplace_back().mModel = "model.nif";
+        const std::vector<std::byte> serialized = serialize(key, data);
+        EXPECT_TRUE(deserialize(serialized, key).has_value());
+        CacheKey modified = key;
+        modified.mContentFiles[0].mLastModified = 3;
+        EXPECT_FALSE(deserialize(serialized, modified).has_value());
+        CacheKey otherQuery = key;
+        otherQuery.mQuery.mLoadStatics = true;
+        EXPECT_FALSE(deserialize(serialized, otherQuery).has_value());
+        CacheKey otherEncoding = key;
+        otherEncoding.mEncoding = ToUTF8::WINDOWS_1251;
+        EXPECT_FALSE(deserialize(serialized, otherEncoding).has_value());
+    }
+
+    TEST(EsmLoaderCacheTest, deserializeShouldReturnNulloptForBrokenData)
+    {
+        const CacheKey key;
+        std::vector<std::byte> serialized = serialize(key, EsmData{});
+        serialized.resize(serialized.size() / 2);
+        EXPECT_FALSE(deserialize(serialized, key).has_value());
+    }
 }
@@ -0,0 +1,119 @@
+#include <components/nif/niffile.hpp>
+#include <components/nif/nifstream.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Nif
+{
+    namespace
+    {
+        using namespace testing;
+
+        constexpr VFS::Path::NormalizedView path("test");
+
+        template <class T>
+        void append(const T& value, std::string& buffer)
+        {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        struct NifNIFStreamTest : Test
+        {
+            NIFFile mFile{ path };
+            Reader mReader{ mFile, nullptr };
+            std::string mBuffer;
+        };
+
+        TEST_F(NifNIFStreamTest, shouldReadValuesFromBuffer)
+        {
+            append(std::uint32_t{ 42 }, mBuffer);
+            append(std::array<float, 3>{ 1, 2, 3 }, mBuffer);
+            NIFStream stream(mReader, mBuffer, nullptr);
+            EXPECT_EQ(stream.get<std::uint32_t>(), 42u);
+            EXPECT_EQ(stream.get<osg::Vec3f>(), osg::Vec3f(1, 2, 3));
+            EXPECT_EQ(stream.getSizeLeft(), 0u);
+        }
+
+        TEST_F(NifNIFStreamTest, shouldReadVectorFromBuffer)
+        {
+            const std::array<std::uint16_t, 3> values{ 1, 2, 3 };
+            append(values, mBuffer);
+            NIFStream stream(mReader, mBuffer, nullptr);
+            std::vector<std::uint16_t> result;
+            stream.readVector(result, values.size());
+            EXPECT_EQ(result, std::vector<std::uint16_t>(values.begin(), values.end()));
+        }
+
+        TEST_F(NifNIFStreamTest, readShouldThrowExceptionWhenThereIsNotEnoughData)
+        {
+            append(std::uint16_t{ 1 }, mBuffer);
+            NIFStream stream(mReader, mBuffer, nullptr);
+            EXPECT_THROW(stream.get<std::uint32_t>(), std::runtime_error);
+            EXPECT_EQ(stream.getSizeLeft(), sizeof(std::uint16_t));
+        }
+
+        TEST_F(NifNIFStreamTest, readShouldThrowExceptionAfterSkipPastTheEnd)
+        {
+            append(std::uint32_t{ 1 }, mBuffer);
+            NIFStream stream(mReader, mBuffer, nullptr);
+            stream.skip(8);
+            EXPECT_EQ(stream.getSizeLeft(), 0u);
+            EXPECT_THROW(stream.get<std::uint8_t>(), std::runtime_error);
+        }
+
+        TEST_F(NifNIFStreamTest, getSizedStringShouldStopAtNullTerminator)
+        {
+            append(std::uint32_t{ 4 }, mBuffer);
+            mBuffer += std::string("ab\0c", 4);
+            append(std::uint8_t{ 7 }, mBuffer);
+            NIFStream stream(mReader, mBuffer, nullptr);
+            EXPECT_EQ(stream.getSizedString(), "ab");
+            EXPECT_EQ(stream.get<std::uint8_t>(), 7);
+        }
+
+        TEST_F(NifNIFStreamTest, getVersionStringShouldReadUntilNewLine)
+        {
+            mBuffer = "NetImmerse File Format, Version 4.0.0.2\n";
+            append(std::uint32_t{ 0x04000002 }, mBuffer);
+            NIFStream stream(mReader, mBuffer, nullptr);
+            EXPECT_EQ(stream.getVersionString(), "NetImmerse File Format, Version 4.0.0.2");
+            EXPECT_EQ(stream.get<std::uint32_t>(), 0x04000002u);
+        }
+
+        TEST_F(NifNIFStreamTest, getVersionStringShouldThrowExceptionForEmptyBuffer)
+        {
+            NIFStream stream(mReader, mBuffer, nullptr);
+            EXPECT_THROW(stream.getVersionString(), std::runtime_error);
+        }
+
+        TEST(NifReaderTest, parseShouldGiveSameResultForBufferAndStream)
+        {
+            std::string buffer = "NetImmerse File Format, Version 4.0.0.2\n";
+            append(std::uint32_t{ NIFFile::VER_MW }, buffer);
+            constexpr std::uint32_t recordsCount = 0;
+            append(recordsCount, buffer);
+            constexpr std::uint32_t rootsCount = 0;
+            append(rootsCount, buffer);
+
+            NIFFile fromBuffer(path);
+            Reader(fromBuffer, nullptr).parse(std::span<const char>(buffer));
+
+            NIFFile fromStream(path);
+            Reader(fromStream, nullptr).parse(std::make_unique<std::istringstream>(buffer));
+
+            EXPECT_EQ(fromBuffer.mVersion, NIFFile::VER_MW);
+            EXPECT_EQ(fromStream.mVersion, NIFFile::VER_MW);
+            EXPECT_FALSE(fromBuffer.mHash.empty());
+            EXPECT_EQ(fromBuffer.mHash, fromStream.mHash);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#include <components/nifosg/compiledtrack.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    float getAngle(const osg::Quat& lhs, const osg::Quat& rhs)
+    {
+        const double dot = lhs.x() * rhs.x() + lhs.y() * rhs.y() + lhs.z() * rhs.z() + lhs.w() * rhs.w();
+        return static_cast<float>(2 * std::acos(std::min(std::abs(dot) / (lhs.length() * rhs.length()), 1.0)));
+    }
+
+    osg::Quat slerp(float fraction, const osg::Quat& from, const osg::Quat& to)
+    {
+        osg::Quat result;
+        result.slerp(fraction, from, to);
+        return result;
+    }
+
+    struct NifOsgCompiledTrackTest : Test
+    {
+        const std::vector<float> mKeyTimes{ 0, 0.5f, 2 };
+        const CompiledTrackSettings mSettings;
+
+        static osg::Quat getRotation(float time)
+        {
+            const osg::Quat first(0, osg::Vec3f(0, 0, 1));
+            const osg::Quat second(1, osg::Vec3f(0, 1, 1));
+            const osg::Quat third(-2, osg::Vec3f(1, 0, 0));
+            if (time <= 0)
+                return first;
+            if (time <= 0.5f)
+                return slerp(time / 0.5f, first, second);
+            if (time <= 2)
+                return slerp((time - 0.5f) / 1.5f, second, third);
+            return third;
+        }
+
+        static osg::Vec3f getTranslation(float time)
+        {
+            const float clamped = std::min(std::max(time, 0.0f), 2.0f);
+            return osg::Vec3f(100 * clamped, -20 * clamped, 5);
+        }
+    };
+
+    TEST_F(NifOsgCompiledTrackTest, compiledRotationShouldBeWithinErrorBound)
+    {
+        const std::optional<CompiledRotationTrack> track = compileRotationTrack(mKeyTimes, getRotation, mSettings);
+        ASSERT_TRUE(track.has_value());
+        EXPECT_EQ(track->mSamples.size(), 61);
+        EXPECT_LE(track->mMaxError, mSettings.mMaxRotationError);
+        for (float time = -0.5f; time <= 2.5f; time += 0.01f)
+            EXPECT_LE(getAngle(track->get(time), getRotation(time)), mSettings.mMaxRotationError) << "time=" << time;
+    }
+
+    TEST_F(NifOsgCompiledTrackTest, compiledTranslationShouldBeWithinErrorBound)
+    {
+        const std::optional<CompiledTranslationTrack> track
+            = compileTranslationTrack(mKeyTimes, getTranslation, mSettings);
+        ASSERT_TRUE(track.has_value());
+        EXPECT_LE(track->mMaxError, mSettings.mMaxTranslationError);
+        for (float time = -0.5f; time <= 2.5f; time += 0.01f)
+            EXPECT_LE((track->get(time) - getTranslation(time)).length(), mSettings.mMaxTranslationError)
+                << "time=" << time;
+    }
+
+    TEST_F(NifOsgCompiledTrackTest, compileShouldFailWhenSampleRateIsTooLowForSource)
+    {
+        const CompiledTrackSettings settings{ .mSampleRate = 1 };
+        const auto source = [](float time) { return osg::Vec3f(std::sin(time * 10) * 100, 0, 0); };
+        EXPECT_FALSE(compileTranslationTrack(mKeyTimes, source, settings).has_value());
+    }
+
+    TEST_F(NifOsgCompiledTrackTest, singleKeyShouldGiveSingleSample)
+    {
+        const std::vector<float> keyTimes{ 1 };
+        const std::optional<CompiledTranslationTrack> track
+            = compileTranslationTrack(keyTimes, getTranslation, mSettings);
+        ASSERT_TRUE(track.has_value());
+        EXPECT_EQ(track->mSamples.size(), 1);
+        EXPECT_LE((track->get(5) - getTranslation(1)).length(), mSettings.mMaxTranslationError);
+    }
+}
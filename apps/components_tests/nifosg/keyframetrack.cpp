@@ -0,0 +1,95 @@
+#include <components/nifosg/controller.hpp>
+#include <components/nifosg/keyframetrack.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    std::shared_ptr<const Nif::FloatKeyMap> makeKeys(
+        std::uint32_t interpolationType, const std::vector<std::pair<float, float>>& values)
+    {
+        auto result = std::make_shared<Nif::FloatKeyMap>();
+        result->mInterpolationType = interpolationType;
+        for (const auto& [time, value] : values)
+            result->mKeys.emplace_back(time, Nif::KeyT<float>{ value, 0, 0 });
+        return result;
+    }
+
+    TEST(NifOsgFindKeyTest, shouldReturnSameIndexAsLowerBound)
+    {
+        const std::vector<float> times{ 0, 1, 1, 2, 3, 5, 8, 13 };
+        for (float time = 0.25f; time <= times.back(); time += 0.25f)
+            EXPECT_EQ(findKey(times, time), std::lower_bound(times.begin(), times.end(), time) - times.begin())
+                << "time=" << time;
+    }
+
+    TEST(NifOsgGetKeyframeTrackTest, shouldReturnSameTrackForSameKeys)
+    {
+        const auto keys = makeKeys(Nif::InterpolationType_Linear, { { 0, 1 }, { 1, 2 } });
+        const auto track = getKeyframeTrack(keys);
+        EXPECT_EQ(getKeyframeTrack(keys), track);
+    }
+
+    TEST(NifOsgGetKeyframeTrackTest, shouldReturnDifferentTracksForDifferentKeys)
+    {
+        const auto keys = makeKeys(Nif::InterpolationType_Linear, { { 0, 1 }, { 1, 2 } });
+        const auto other = makeKeys(Nif::InterpolationType_Linear, { { 0, 1 }, { 1, 2 } });
+        const auto track = getKeyframeTrack(keys);
+        const auto otherTrack = getKeyframeTrack(other);
+        EXPECT_NE(otherTrack, track);
+        EXPECT_EQ(otherTrack->mTimes, track->mTimes);
+        EXPECT_EQ(otherTrack->mValues, track->mValues);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, shouldClampTimeOutsideOfKeys)
+    {
+        const FloatInterpolator interpolator(
+            makeKeys(Nif::InterpolationType_Linear, { { 1, 10 }, { 2, 20 }, { 4, 0 } }), 42);
+        EXPECT_EQ(interpolator.interpKey(0), 10);
+        EXPECT_EQ(interpolator.interpKey(1), 10);
+        EXPECT_EQ(interpolator.interpKey(4), 0);
+        EXPECT_EQ(interpolator.interpKey(5), 0);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, shouldNotDependOnPreviousEvaluations)
+    {
+        const auto keys = makeKeys(Nif::InterpolationType_Linear, { { 0, 0 }, { 1, 10 }, { 2, 20 }, { 4, 0 } });
+        const std::vector<std::pair<float, float>> expected{
+            { 0.5f, 5 },
+            { 1.5f, 15 },
+            { 3, 10 },
+            { 0.25f, 2.5f },
+            { 0.75f, 7.5f },
+            { 3.5f, 5 },
+            { 2, 20 },
+            { 1, 10 },
+        };
+        const FloatInterpolator interpolator(keys);
+        for (const auto& [time, value] : expected)
+            EXPECT_FLOAT_EQ(interpolator.interpKey(time), value) << "time=" << time;
+    }
+
+    TEST(NifOsgValueInterpolatorTest, constantInterpolationShouldSwitchToNextKeyInTheMiddle)
+    {
+        const FloatInterpolator interpolator(makeKeys(Nif::InterpolationType_Constant, { { 0, 1 }, { 2, 3 } }));
+        EXPECT_EQ(interpolator.interpKey(0.9f), 1);
+        EXPECT_EQ(interpolator.interpKey(1.1f), 3);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, emptyKeysShouldGiveDefaultValue)
+    {
+        const FloatInterpolator interpolator(makeKeys(Nif::InterpolationType_Linear, {}), 42);
+        EXPECT_TRUE(interpolator.empty());
+        EXPECT_EQ(interpolator.interpKey(1), 42);
+    }
+}
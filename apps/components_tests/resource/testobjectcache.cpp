@@ -3,6 +3,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <osg/Image>
 #include <osg/Object>
 
 namespace Resource
@@ -373,5 +374,199 @@ namespace Resource
             cache->addEntryToObjectCache(key, value);
             EXPECT_TRUE(cache->checkInObjectCache(std::string_view("key"), 0));
         }
+
+        osg::ref_ptr<osg::Image> makeImage()
+        {
+            osg::ref_ptr<osg::Image> result(new osg::Image);
+            result->allocateImage(4, 4, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+            return result;
+        }
+
+        TEST(ResourceGenericObjectCacheTest, getStatsShouldReturnZeroMemoryWhenNotTracked)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+
+            cache->addEntryToObjectCache(1, makeImage());
+
+            EXPECT_EQ(cache->getStats().mMemory, 0);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, getStatsShouldReturnMemoryUsedByItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setTrackMemoryUsage(true);
+
+            const osg::ref_ptr<osg::Image> image = makeImage();
+            cache->addEntryToObjectCache(1, image);
+            cache->addEntryToObjectCache(2, new Object);
+
+            EXPECT_EQ(cache->getStats().mMemory, estimateObjectSize(*image));
+        }
+
+        TEST(ResourceGenericObjectCacheTest, removeFromObjectCacheShouldReduceMemoryUsage)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setTrackMemoryUsage(true);
+
+            cache->addEntryToObjectCache(1, makeImage());
+            cache->removeFromObjectCache(1);
+
+            EXPECT_EQ(cache->getStats().mMemory, 0);
+        }
+
+        TEST(ResourceGenericObjectCacheTest, addEntryToObjectCacheShouldReplaceMemoryUsageOfExistingItem)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setTrackMemoryUsage(true);
+
+            const osg::ref_ptr<osg::Image> image = makeImage();
+            cache->addEntryToObjectCache(1, makeImage());
+            cache->addEntryToObjectCache(1, image);
+
+            EXPECT_EQ(cache->getStats().mMemory, estimateObjectSize(*image));
+        }
+
+        TEST(ResourceGenericObjectCacheTest, collectEvictionCandidatesShouldSkipReferencedItems)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setTrackMemoryUsage(true);
+
+            const osg::ref_ptr<osg::Image> image = makeImage();
+            cache->addEntryToObjectCache(1, image, 1);
+            cache->addEntryToObjectCache(2, makeImage(), 2);
+
+            std::vector<EvictionCandidate> candidates;
+            cache->collectEvictionCandidates(candidates);
+
+            ASSERT_EQ(candidates.size(), 1);
+            EXPECT_EQ(candidates[0].mLastUsage, 2);
+            EXPECT_EQ(candidates[0].mSize, estimateObjectSize(*image));
+        }
+
+        TEST(ResourceGenericObjectCacheTest, collectEvictionCandidatesShouldSkipItemsWithUninitializedTimestamp)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setTrackMemoryUsage(true);
+
+            cache->addEntryToObjectCache(1, makeImage());
+
+            std::vector<EvictionCandidate> candidates;
+            cache->collectEvictionCandidates(candidates);
+
+            EXPECT_THAT(candidates, IsEmpty());
+        }
+
+        TEST(ResourceGenericObjectCacheTest, evictShouldRemoveUnreferencedItemsNotUsedAfterGivenTime)
+        {
+            osg::ref_ptr<GenericObjectCache<int>> cache(new GenericObjectCache<int>);
+            cache->setTrackMemoryUsage(true);
+
+            const osg::ref_ptr<osg::Image> image = makeImage();
+            cache->addEntryToObjectCache(1, makeImage(), 1);
+            cache->addEntryToObjectCache(2, makeImage(), 2);
+            cache->addEntryToObjectCache(3, image, 1);
+
+            cache->evict(1);
+
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(1), std::nullopt);
+            EXPECT_NE(cache->getRefFromObjectCacheOrNone(2), std::nullopt);
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(3), Optional(image));
+            EXPECT_EQ(cache->getStats().mEvicted, 1);
+            EXPECT_EQ(cache->getStats().mMemory, 2 * estimateObjectSize(*image));
+        }
+
+        using ShardedObjectCache = GenericObjectCache<int, std::hash<int>>;
+
+        TEST(ResourceShardedObjectCacheTest, shouldStoreValuesInDifferentShards)
+        {
+            osg::ref_ptr<ShardedObjectCache> cache(new ShardedObjectCache(4));
+            osg::ref_ptr<Object> value1(new Object);
+            osg::ref_ptr<Object> value2(new Object);
+            cache->addEntryToObjectCache(1, value1);
+            cache->addEntryToObjectCache(2, value2);
+            EXPECT_EQ(cache->getRefFromObjectCache(1), value1);
+            EXPECT_EQ(cache->getRefFromObjectCache(2), value2);
+            EXPECT_EQ(cache->getStats().mSize, 2);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, updateShouldRemoveExpiredItemsFromSingleShardPerCall)
+        {
+            osg::ref_ptr<ShardedObjectCache> cache(new ShardedObjectCache(2));
+
+            const double referenceTime = 1;
+            const double expiryDelay = 1;
+
+            cache->addEntryToObjectCache(0, nullptr, referenceTime);
+            cache->addEntryToObjectCache(1, nullptr, referenceTime);
+
+            cache->update(referenceTime + expiryDelay, expiryDelay);
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(0), std::nullopt);
+            EXPECT_THAT(cache->getRefFromObjectCacheOrNone(1), Optional(nullptr));
+
+            cache->update(referenceTime + expiryDelay, expiryDelay);
+            EXPECT_EQ(cache->getRefFromObjectCacheOrNone(1), std::nullopt);
+            EXPECT_EQ(cache->getStats().mExpired, 2);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, getRefFromObjectCacheShouldUpdateLastUsageInNotUpdatedShard)
+        {
+            osg::ref_ptr<ShardedObjectCache> cache(new ShardedObjectCache(2));
+            cache->setTrackMemoryUsage(true);
+
+            cache->addEntryToObjectCache(1, makeImage(), 1);
+
+            cache->update(10, 100);
+            cache->getRefFromObjectCache(1);
+
+            std::vector<EvictionCandidate> candidates;
+            cache->collectEvictionCandidates(candidates);
+
+            ASSERT_EQ(candidates.size(), 1);
+            EXPECT_EQ(candidates[0].mLastUsage, 10);
+        }
+
+        TEST(ResourceShardedObjectCacheTest, lowerBoundShouldReturnFirstNotLessThatGivenKeyOverAllShards)
+        {
+            osg::ref_ptr<ShardedObjectCache> cache(new ShardedObjectCache(4));
+
+            osg::ref_ptr<Object> value1(new Object);
+            osg::ref_ptr<Object> value2(new Object);
+            osg::ref_ptr<Object> value3(new Object);
+            cache->addEntryToObjectCache(1, value1);
+            cache->addEntryToObjectCache(6, value2);
+            cache->addEntryToObjectCache(4, value3);
+
+            EXPECT_THAT(cache->lowerBound(2), Optional(Pair(4, value3)));
+        }
+
+        TEST(ResourceShardedObjectCacheTest, callShouldIterateOverAllShards)
+        {
+            osg::ref_ptr<ShardedObjectCache> cache(new ShardedObjectCache(4));
+
+            osg::ref_ptr<Object> value1(new Object);
+            osg::ref_ptr<Object> value2(new Object);
+            cache->addEntryToObjectCache(1, value1);
+            cache->addEntryToObjectCache(2, value2);
+
+            std::vector<std::pair<int, osg::Object*>> actual;
+            cache->call([&](int key, osg::Object* value) { actual.emplace_back(key, value); });
+
+            EXPECT_THAT(actual, UnorderedElementsAre(Pair(1, value1.get()), Pair(2, value2.get())));
+        }
+
+        TEST(ResourceShardedObjectCacheTest, getStatsShouldSumGetsAndHitsOverAllShards)
+        {
+            osg::ref_ptr<ShardedObjectCache> cache(new ShardedObjectCache(4));
+
+            osg::ref_ptr<Object> value(new Object);
+            cache->addEntryToObjectCache(13, value);
+            cache->getRefFromObjectCache(13);
+            cache->getRefFromObjectCache(42);
+
+            const CacheStats stats = cache->getStats();
+
+            EXPECT_EQ(stats.mGet, 2);
+            EXPECT_EQ(stats.mHit, 1);
+        }
     }
 }
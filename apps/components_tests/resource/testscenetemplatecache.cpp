@@ -0,0 +1,126 @@
+#include <components/misc/osguservalues.hpp>
+#include <components/nifosg/matrixtransform.hpp>
+#include <components/resource/scenetemplatecache.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/testing/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/Group>
+#include <osg/Material>
+#include <osg/NodeCallback>
+#include <osg/ValueObject>
+#include <osgDB/Options>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    constexpr VFS::Path::NormalizedView path("meshes/test.nif");
+    constexpr std::array<std::uint64_t, 2> fileHash{ 1, 2 };
+
+    // Doesn't have own META macro so can't be read back as is
+    class CustomCallback : public osg::NodeCallback
+    {
+    };
+
+    osg::ref_ptr<osg::Node> makeTemplate()
+    {
+        osg::ref_ptr<osg::Group> root = new osg::Group;
+        root->setName("Root");
+        root->setUserValue(Misc::OsgUserValues::sFileHash, std::string("hash"));
+
+        osg::ref_ptr<NifOsg::MatrixTransform> transform = new NifOsg::MatrixTransform;
+        transform->setName("Transform");
+        transform->mRotationScale.mValues[0][1] = 2;
+        transform->setScale(3);
+        transform->setTranslation(osg::Vec3f(4, 5, 6));
+
+        osg::StateSet* const stateSet = transform->getOrCreateStateSet();
+        stateSet->setAttributeAndModes(new SceneUtil::AutoDepth(osg::Depth::ALWAYS), osg::StateAttribute::ON);
+        stateSet->setAttributeAndModes(new osg::Material, osg::StateAttribute::ON);
+
+        root->addChild(transform);
+        return root;
+    }
+
+    struct ResourceSceneTemplateCacheTest : Test
+    {
+        const std::filesystem::path mPath = TestingOpenMW::currentTestDirPath();
+        SceneTemplateCache mCache{ mPath };
+        const osg::ref_ptr<osgDB::Options> mOptions = new osgDB::Options;
+    };
+
+    TEST_F(ResourceSceneTemplateCacheTest, read_should_return_nullptr_when_there_is_no_entry)
+    {
+        EXPECT_EQ(mCache.read(path, fileHash, *mOptions), nullptr);
+        EXPECT_EQ(mCache.getHits(), 0u);
+        EXPECT_EQ(mCache.getMisses(), 1u);
+    }
+
+    TEST_F(ResourceSceneTemplateCacheTest, read_should_return_written_template)
+    {
+        mCache.write(path, fileHash, *makeTemplate());
+
+        const osg::ref_ptr<osg::Node> result = mCache.read(path, fileHash, *mOptions);
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(mCache.getHits(), 1u);
+        EXPECT_EQ(mCache.getMisses(), 0u);
+
+        const osg::Group* const root = result->asGroup();
+        ASSERT_NE(root, nullptr);
+        EXPECT_EQ(root->getName(), "Root");
+        std::string hash;
+        EXPECT_TRUE(root->getUserValue(Misc::OsgUserValues::sFileHash, hash));
+        EXPECT_EQ(hash, "hash");
+        ASSERT_EQ(root->getNumChildren(), 1u);
+
+        const auto* const transform = dynamic_cast<const NifOsg::MatrixTransform*>(root->getChild(0));
+        ASSERT_NE(transform, nullptr);
+        EXPECT_EQ(transform->getName(), "Transform");
+        EXPECT_EQ(transform->mScale, 3);
+        EXPECT_EQ(transform->mRotationScale.mValues[0][1], 2);
+        EXPECT_EQ(transform->getMatrix().getTrans(), osg::Vec3d(4, 5, 6));
+
+        const osg::StateSet* const stateSet = transform->getStateSet();
+        ASSERT_NE(stateSet, nullptr);
+        const auto* const depth
+            = dynamic_cast<const SceneUtil::AutoDepth*>(stateSet->getAttribute(osg::StateAttribute::DEPTH));
+        ASSERT_NE(depth, nullptr);
+        EXPECT_EQ(depth->getFunction(), osg::Depth::ALWAYS);
+        EXPECT_NE(stateSet->getAttribute(osg::StateAttribute::MATERIAL), nullptr);
+    }
+
+    TEST_F(ResourceSceneTemplateCacheTest, read_should_return_nullptr_for_different_file_hash)
+    {
+        mCache.write(path, fileHash, *makeTemplate());
+        EXPECT_EQ(mCache.read(path, std::array<std::uint64_t, 2>{ 1, 3 }, *mOptions), nullptr);
+        EXPECT_EQ(mCache.getMisses(), 1u);
+    }
+
+    TEST_F(ResourceSceneTemplateCacheTest, write_should_skip_not_storable_template)
+    {
+        const osg::ref_ptr<osg::Node> node = makeTemplate();
+        node->setUpdateCallback(new CustomCallback);
+        mCache.write(path, fileHash, *node);
+        EXPECT_EQ(mCache.read(path, fileHash, *mOptions), nullptr);
+    }
+
+    TEST(ResourceIsStorableTemplateTest, should_return_true_for_supported_objects)
+    {
+        EXPECT_TRUE(isStorableTemplate(*makeTemplate()));
+    }
+
+    TEST(ResourceIsStorableTemplateTest, should_return_false_for_callback_without_serializer)
+    {
+        const osg::ref_ptr<osg::Node> node = makeTemplate();
+        node->asGroup()->getChild(0)->setCullCallback(new CustomCallback);
+        EXPECT_FALSE(isStorableTemplate(*node));
+    }
+}
@@ -0,0 +1,73 @@
+#include <components/sceneutil/deformationqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct CountingJob : DeformationJob
+    {
+        std::atomic_int mCount{ 0 };
+        std::thread::id mThreadId;
+
+        void deform() override
+        {
+            mThreadId = std::this_thread::get_id();
+            ++mCount;
+        }
+    };
+
+    TEST(SceneUtilDeformationQueueTest, submitShouldRunJobImmediatelyWithoutQueue)
+    {
+        osg::ref_ptr<CountingJob> job = new CountingJob;
+        DeformationQueue::submit(job);
+        EXPECT_EQ(job->mCount, 1);
+        EXPECT_EQ(job->mThreadId, std::this_thread::get_id());
+    }
+
+    TEST(SceneUtilDeformationQueueTest, submitShouldRunJobImmediatelyForQueueWithoutThreads)
+    {
+        DeformationQueue queue(0);
+        osg::ref_ptr<CountingJob> job = new CountingJob;
+        DeformationQueue::submit(job);
+        EXPECT_EQ(job->mCount, 1);
+    }
+
+    TEST(SceneUtilDeformationQueueTest, waitShouldReturnAfterJobIsDoneByWorker)
+    {
+        DeformationQueue queue(2);
+        osg::ref_ptr<CountingJob> job = new CountingJob;
+        for (int i = 0; i < 100; ++i)
+        {
+            DeformationQueue::submit(job);
+            job->wait();
+            EXPECT_EQ(job->mCount, i + 1);
+        }
+    }
+
+    TEST(SceneUtilDeformationQueueTest, waitShouldRunQueuedJobWhenQueueIsDestroyed)
+    {
+        osg::ref_ptr<CountingJob> job = new CountingJob;
+        {
+            DeformationQueue queue(1);
+            DeformationQueue::submit(job);
+        }
+        job->wait();
+        EXPECT_EQ(job->mCount, 1);
+    }
+
+    TEST(SceneUtilDeformationQueueTest, getInstanceShouldReturnExistingQueue)
+    {
+        EXPECT_EQ(DeformationQueue::getInstance(), nullptr);
+        {
+            DeformationQueue queue(1);
+            EXPECT_EQ(DeformationQueue::getInstance(), &queue);
+        }
+        EXPECT_EQ(DeformationQueue::getInstance(), nullptr);
+    }
+}
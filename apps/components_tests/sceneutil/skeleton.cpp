@@ -0,0 +1,51 @@
+#include <components/sceneutil/skeleton.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    const AnimationLodSettings lodSettings{ .mEnabled = true, .mHalfRateSize = 0.2f, .mQuarterRateSize = 0.05f };
+
+    TEST(SceneUtilAnimationLodTest, getAnimationLodShouldReturnFullForSizeNotLessThanHalfRateSize)
+    {
+        EXPECT_EQ(getAnimationLod(0.2f, lodSettings), AnimationLod::Full);
+        EXPECT_EQ(getAnimationLod(1.0f, lodSettings), AnimationLod::Full);
+    }
+
+    TEST(SceneUtilAnimationLodTest, getAnimationLodShouldReturnHalfForSizeBetweenQuarterAndHalfRateSizes)
+    {
+        EXPECT_EQ(getAnimationLod(0.05f, lodSettings), AnimationLod::Half);
+        EXPECT_EQ(getAnimationLod(0.1f, lodSettings), AnimationLod::Half);
+    }
+
+    TEST(SceneUtilAnimationLodTest, getAnimationLodShouldReturnQuarterForSizeLessThanQuarterRateSize)
+    {
+        EXPECT_EQ(getAnimationLod(0.01f, lodSettings), AnimationLod::Quarter);
+        EXPECT_EQ(getAnimationLod(0, lodSettings), AnimationLod::Quarter);
+    }
+
+    TEST(SceneUtilAnimationLodTest, isSkippedByAnimationLodShouldReturnFalseForFull)
+    {
+        for (unsigned int frame = 0; frame < 8; ++frame)
+            EXPECT_FALSE(isSkippedByAnimationLod(AnimationLod::Full, 3, frame)) << frame;
+    }
+
+    TEST(SceneUtilAnimationLodTest, isSkippedByAnimationLodShouldSkipAllButEveryIntervalFrame)
+    {
+        for (unsigned int frame = 0; frame < 8; ++frame)
+        {
+            EXPECT_EQ(isSkippedByAnimationLod(AnimationLod::Half, 0, frame), frame % 2 != 0) << frame;
+            EXPECT_EQ(isSkippedByAnimationLod(AnimationLod::Quarter, 0, frame), frame % 4 != 0) << frame;
+        }
+    }
+
+    TEST(SceneUtilAnimationLodTest, isSkippedByAnimationLodShouldShiftUpdatedFramesByPhase)
+    {
+        EXPECT_TRUE(isSkippedByAnimationLod(AnimationLod::Quarter, 1, 0));
+        EXPECT_FALSE(isSkippedByAnimationLod(AnimationLod::Quarter, 1, 3));
+        EXPECT_FALSE(isSkippedByAnimationLod(AnimationLod::Quarter, 1, 7));
+    }
+}
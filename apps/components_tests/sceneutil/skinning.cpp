@@ -0,0 +1,154 @@
+#include <components/sceneutil/skinning.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    osg::Matrixf skinningMatrix(const BoneWeights& weights, const std::vector<osg::Matrixf>& boneMatrices,
+        const osg::Matrixf& transform)
+    {
+        osg::Matrixf result(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+        for (const auto& [index, weight] : weights)
+        {
+            const float* bone = boneMatrices[index].ptr();
+            float* value = result.ptr();
+            for (int i = 0; i < 16; ++i)
+                if (i % 4 != 3)
+                    value[i] += bone[i] * weight;
+        }
+        return result * transform;
+    }
+
+    void expectNear(const osg::Vec3f& actual, const osg::Vec3f& expected)
+    {
+        EXPECT_NEAR(actual.x(), expected.x(), 1e-5f);
+        EXPECT_NEAR(actual.y(), expected.y(), 1e-5f);
+        EXPECT_NEAR(actual.z(), expected.z(), 1e-5f);
+    }
+
+    struct SceneUtilSkinningTest : Test
+    {
+        const std::vector<osg::Matrixf> mBoneMatrices{
+            osg::Matrixf::rotate(osg::PI_2f, osg::Vec3f(0, 0, 1)) * osg::Matrixf::translate(1, 2, 3),
+            osg::Matrixf::scale(2, 3, 4),
+            osg::Matrixf::rotate(0.5f, osg::Vec3f(1, 0, 0)) * osg::Matrixf::translate(-1, 0, 5),
+        };
+        const osg::Matrixf mTransform = osg::Matrixf::translate(10, 20, 30);
+        const std::vector<BoneWeights> mInfluences{
+            { { 0, 1.0f } },
+            { { 0, 0.5f }, { 1, 0.5f } },
+            {},
+            { { 0, 1.0f } },
+            { { 0, 0.25f }, { 1, 0.25f }, { 2, 0.5f } },
+        };
+        const std::vector<osg::Vec3f> mSourcePositions{
+            osg::Vec3f(1, 0, 0),
+            osg::Vec3f(0, 1, 0),
+            osg::Vec3f(0, 0, 1),
+            osg::Vec3f(1, 2, 3),
+            osg::Vec3f(-3, 2, -1),
+        };
+        const std::vector<osg::Vec3f> mSourceNormals{
+            osg::Vec3f(0, 0, 1),
+            osg::Vec3f(1, 0, 0),
+            osg::Vec3f(0, 1, 0),
+            osg::Vec3f(0, 1, 0),
+            osg::Vec3f(1, 1, 0),
+        };
+        const std::vector<osg::Vec4f> mSourceTangents{
+            osg::Vec4f(1, 0, 0, 1),
+            osg::Vec4f(0, 1, 0, -1),
+            osg::Vec4f(0, 0, 1, 1),
+            osg::Vec4f(1, 0, 0, -1),
+            osg::Vec4f(0, 1, 1, 1),
+        };
+    };
+
+    TEST_F(SceneUtilSkinningTest, makeSkinningDataShouldGroupVerticesWithEqualWeights)
+    {
+        const SkinningData data = makeSkinningData(mInfluences);
+        EXPECT_EQ(data.getGroupsCount(), 3);
+        EXPECT_EQ(data.mVertices.size(), 4);
+        EXPECT_THAT(data.mVertices, Not(Contains(2u)));
+    }
+
+    TEST_F(SceneUtilSkinningTest, skinShouldTransformAllAttributesLikeOsgMatrix)
+    {
+        const SkinningData data = makeSkinningData(mInfluences);
+        std::vector<osg::Vec3f> positions(mSourcePositions.size());
+        std::vector<osg::Vec3f> normals(mSourceNormals.size());
+        std::vector<osg::Vec4f> tangents(mSourceTangents.size());
+
+        skin(data, mBoneMatrices, mTransform,
+            SkinningArrays{
+                .mSourcePositions = mSourcePositions,
+                .mPositions = positions,
+                .mSourceNormals = mSourceNormals,
+                .mNormals = normals,
+                .mSourceTangents = mSourceTangents,
+                .mTangents = tangents,
+            });
+
+        for (std::size_t i = 0; i < mInfluences.size(); ++i)
+        {
+            if (mInfluences[i].empty())
+            {
+                EXPECT_EQ(positions[i], osg::Vec3f());
+                continue;
+            }
+            const osg::Matrixf matrix = skinningMatrix(mInfluences[i], mBoneMatrices, mTransform);
+            const osg::Vec4f& tangent = mSourceTangents[i];
+            expectNear(positions[i], matrix.preMult(mSourcePositions[i]));
+            expectNear(normals[i], osg::Matrixf::transform3x3(mSourceNormals[i], matrix));
+            expectNear(osg::Vec3f(tangents[i].x(), tangents[i].y(), tangents[i].z()),
+                osg::Matrixf::transform3x3(osg::Vec3f(tangent.x(), tangent.y(), tangent.z()), matrix));
+            EXPECT_EQ(tangents[i].w(), tangent.w());
+        }
+    }
+
+    TEST_F(SceneUtilSkinningTest, skinShouldIgnoreWeightOfZeroBoneMatrix)
+    {
+        std::vector<osg::Matrixf> boneMatrices = mBoneMatrices;
+        boneMatrices[1] = osg::Matrixf(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        const std::vector<BoneWeights> influences{ { { 0, 0.5f }, { 1, 0.5f } } };
+        const std::vector<osg::Vec3f> sourcePositions{ osg::Vec3f(1, 2, 3) };
+        std::vector<osg::Vec3f> positions(1);
+
+        skin(makeSkinningData(influences), boneMatrices, mTransform,
+            SkinningArrays{ .mSourcePositions = sourcePositions, .mPositions = positions });
+
+        const BoneWeights expectedWeights{ { 0, 0.5f } };
+        expectNear(positions[0], skinningMatrix(expectedWeights, boneMatrices, mTransform).preMult(sourcePositions[0]));
+    }
+
+    TEST_F(SceneUtilSkinningTest, isSameSkinningPoseShouldReturnTrueForEqualMatricesAndTransform)
+    {
+        const std::vector<osg::Matrixf> boneMatrices = mBoneMatrices;
+        EXPECT_TRUE(isSameSkinningPose(mBoneMatrices, mTransform, boneMatrices, mTransform));
+    }
+
+    TEST_F(SceneUtilSkinningTest, isSameSkinningPoseShouldReturnFalseForChangedBoneMatrix)
+    {
+        std::vector<osg::Matrixf> boneMatrices = mBoneMatrices;
+        boneMatrices[1](3, 0) += 1e-3f;
+        EXPECT_FALSE(isSameSkinningPose(mBoneMatrices, mTransform, boneMatrices, mTransform));
+    }
+
+    TEST_F(SceneUtilSkinningTest, isSameSkinningPoseShouldReturnFalseForDifferentBonesCount)
+    {
+        const std::vector<osg::Matrixf> boneMatrices(mBoneMatrices.begin(), mBoneMatrices.end() - 1);
+        EXPECT_FALSE(isSameSkinningPose(mBoneMatrices, mTransform, boneMatrices, mTransform));
+    }
+
+    TEST_F(SceneUtilSkinningTest, isSameSkinningPoseShouldReturnFalseForChangedTransform)
+    {
+        const osg::Matrixf transform = mTransform * osg::Matrixf::translate(0, 0, 1);
+        EXPECT_FALSE(isSameSkinningPose(mBoneMatrices, mTransform, mBoneMatrices, transform));
+    }
+}
@@ -0,0 +1,190 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct BlockingWorkItem : WorkItem
+    {
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mStarted = false;
+        bool mReleased = false;
+
+        void doWork() override
+        {
+            std::unique_lock lock(mMutex);
+            mStarted = true;
+            mCondition.notify_all();
+            mCondition.wait(lock, [&] { return mReleased; });
+        }
+
+        void waitStarted()
+        {
+            std::unique_lock lock(mMutex);
+            mCondition.wait(lock, [&] { return mStarted; });
+        }
+
+        void release()
+        {
+            {
+                const std::lock_guard lock(mMutex);
+                mReleased = true;
+            }
+            mCondition.notify_all();
+        }
+    };
+
+    struct RecordingWorkItem : WorkItem
+    {
+        std::mutex& mMutex;
+        std::vector<int>& mOrder;
+        int mValue;
+
+        explicit RecordingWorkItem(std::mutex& mutex, std::vector<int>& order, int value,
+            WorkCategory category = WorkCategory::Other)
+            : WorkItem(category)
+            , mMutex(mutex)
+            , mOrder(order)
+            , mValue(value)
+        {
+        }
+
+        void doWork() override
+        {
+            const std::lock_guard lock(mMutex);
+            mOrder.push_back(mValue);
+        }
+    };
+
+    struct SceneUtilWorkQueueTest : Test
+    {
+        std::mutex mMutex;
+        std::vector<int> mOrder;
+
+        osg::ref_ptr<RecordingWorkItem> makeItem(int value, WorkCategory category = WorkCategory::Other)
+        {
+            return new RecordingWorkItem(mMutex, mOrder, value, category);
+        }
+    };
+
+    TEST_F(SceneUtilWorkQueueTest, shouldDoWorkForAddedItem)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(2));
+        const osg::ref_ptr<RecordingWorkItem> item = makeItem(1);
+        queue->addWorkItem(item);
+        item->waitTillDone();
+        EXPECT_THAT(mOrder, ElementsAre(1));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, shouldDoWorkForItemsAddedWhenThreadsAreWaiting)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(4));
+        for (int i = 0; i < 10; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            const osg::ref_ptr<RecordingWorkItem> item = makeItem(i);
+            queue->addWorkItem(item);
+            item->waitTillDone();
+        }
+        EXPECT_EQ(mOrder.size(), 10);
+        EXPECT_EQ(queue->getNumItems(), 0);
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, shouldTakeItemsWithHigherPriorityFirst)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        const osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem);
+        queue->addWorkItem(blocking);
+        blocking->waitStarted();
+
+        const osg::ref_ptr<RecordingWorkItem> low = makeItem(1);
+        queue->addWorkItem(low, WorkPriority::Low);
+        queue->addWorkItem(makeItem(2), WorkPriority::Normal);
+        queue->addWorkItem(makeItem(3), WorkPriority::High);
+        queue->addWorkItem(makeItem(4), WorkPriority::Normal);
+        queue->addWorkItem(makeItem(5), WorkPriority::High);
+
+        blocking->release();
+        low->waitTillDone();
+
+        EXPECT_THAT(mOrder, ElementsAre(3, 5, 2, 4, 1));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, shouldSkipCancelledItemsAndSignalDone)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        const osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem);
+        queue->addWorkItem(blocking);
+        blocking->waitStarted();
+
+        const osg::ref_ptr<RecordingWorkItem> cancelled = makeItem(1);
+        const osg::ref_ptr<RecordingWorkItem> last = makeItem(2);
+        queue->addWorkItem(cancelled);
+        queue->addWorkItem(last);
+        cancelled->cancel();
+
+        blocking->release();
+        last->waitTillDone();
+
+        EXPECT_TRUE(cancelled->isDone());
+        EXPECT_THAT(mOrder, ElementsAre(2));
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, shouldProcessAllItemsWithMultipleThreads)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(4));
+        std::vector<osg::ref_ptr<RecordingWorkItem>> items;
+        for (int i = 0; i < 100; ++i)
+        {
+            items.push_back(makeItem(i));
+            queue->addWorkItem(items.back(), static_cast<WorkPriority>(i % workPrioritiesCount));
+        }
+        for (const osg::ref_ptr<RecordingWorkItem>& item : items)
+            item->waitTillDone();
+        EXPECT_EQ(mOrder.size(), 100);
+        EXPECT_EQ(queue->getNumItems(), 0);
+    }
+
+    TEST_F(SceneUtilWorkQueueTest, getStatsShouldReturnCountersPerCategory)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        const osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem);
+        queue->addWorkItem(blocking);
+        blocking->waitStarted();
+
+        const osg::ref_ptr<RecordingWorkItem> preload = makeItem(1, WorkCategory::Preload);
+        const osg::ref_ptr<RecordingWorkItem> map = makeItem(2, WorkCategory::Map);
+        queue->addWorkItem(preload);
+        queue->addWorkItem(map);
+        map->cancel();
+
+        {
+            const WorkQueueStats stats = queue->getStats();
+            EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkCategory::Preload)].mQueued, 1);
+            EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkCategory::Map)].mQueued, 1);
+        }
+
+        blocking->release();
+        preload->waitTillDone();
+        map->waitTillDone();
+        blocking->waitTillDone();
+
+        const WorkQueueStats stats = queue->getStats();
+        EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkCategory::Other)].mDone, 1);
+        EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkCategory::Preload)].mQueued, 0);
+        EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkCategory::Preload)].mDone, 1);
+        EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkCategory::Map)].mDone, 0);
+        EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkCategory::Map)].mCancelled, 1);
+    }
+}
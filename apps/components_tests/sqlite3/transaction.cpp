@@ -64,4 +64,15 @@ namespace
         }
         EXPECT_THAT(getIds(), ElementsAre(std::tuple(42)));
     }
+
+    TEST_F(Sqlite3TransactionTest, rollbackShouldRollbackTransaction)
+    {
+        {
+            Transaction transaction(*mDb);
+            insertId();
+            transaction.rollback();
+            insertId();
+        }
+        EXPECT_THAT(getIds(), ElementsAre(std::tuple(42)));
+    }
 }
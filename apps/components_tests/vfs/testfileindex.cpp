@@ -0,0 +1,133 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/fileindex.hpp>
+#include <components/vfs/manager.hpp>
+#include <components/vfs/recursivedirectoryiterator.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        File* const fileA = reinterpret_cast<File*>(0x1);
+        File* const fileB = reinterpret_cast<File*>(0x2);
+        File* const fileC = reinterpret_cast<File*>(0x3);
+
+        TEST(VFSFileIndexTest, findShouldReturnNullptrForEmptyIndex)
+        {
+            FileIndex index;
+            index.build();
+            EXPECT_EQ(index.find("foo"), nullptr);
+        }
+
+        TEST(VFSFileIndexTest, findShouldReturnNullptrWhenNotBuilt)
+        {
+            FileIndex index;
+            index.insert("foo", fileA);
+            EXPECT_EQ(index.find("foo"), nullptr);
+        }
+
+        TEST(VFSFileIndexTest, findShouldReturnInsertedFile)
+        {
+            FileIndex index;
+            index.insert("foo/bar", fileA);
+            index.insert("foo/baz", fileB);
+            index.build();
+            EXPECT_EQ(index.find("foo/bar"), fileA);
+            EXPECT_EQ(index.find("foo/baz"), fileB);
+            EXPECT_EQ(index.find("foo"), nullptr);
+        }
+
+        TEST(VFSFileIndexTest, insertShouldNormalizePath)
+        {
+            FileIndex index;
+            index.insert("\\Foo\\\\Bar.NIF", fileA);
+            index.build();
+            ASSERT_EQ(index.size(), 1);
+            EXPECT_EQ(index.getPath(0), "foo/bar.nif");
+            EXPECT_EQ(index.find("foo/bar.nif"), fileA);
+        }
+
+        TEST(VFSFileIndexTest, lastInsertedFileShouldOverridePrevious)
+        {
+            FileIndex index;
+            index.insert("foo", fileA);
+            index.insert("bar", fileB);
+            index.insert("Foo", fileC);
+            index.build();
+            ASSERT_EQ(index.size(), 2);
+            EXPECT_EQ(index.find("foo"), fileC);
+            EXPECT_EQ(index.find("bar"), fileB);
+        }
+
+        TEST(VFSFileIndexTest, buildShouldSortFilesByPath)
+        {
+            FileIndex index;
+            index.insert("c", fileA);
+            index.insert("a/b", fileB);
+            index.insert("a", fileC);
+            index.build();
+            ASSERT_EQ(index.size(), 3);
+            EXPECT_EQ(index.getPath(0), "a");
+            EXPECT_EQ(index.getFile(0), fileC);
+            EXPECT_EQ(index.getPath(1), "a/b");
+            EXPECT_EQ(index.getFile(1), fileB);
+            EXPECT_EQ(index.getPath(2), "c");
+            EXPECT_EQ(index.getFile(2), fileA);
+        }
+
+        TEST(VFSFileIndexTest, lowerBoundShouldReturnPositionOfFirstNotLessPath)
+        {
+            FileIndex index;
+            index.insert("a", fileA);
+            index.insert("b/c", fileB);
+            index.insert("d", fileC);
+            index.build();
+            EXPECT_EQ(index.lowerBound(""), 0);
+            EXPECT_EQ(index.lowerBound("a"), 0);
+            EXPECT_EQ(index.lowerBound("b"), 1);
+            EXPECT_EQ(index.lowerBound("b/c"), 1);
+            EXPECT_EQ(index.lowerBound("c"), 2);
+            EXPECT_EQ(index.lowerBound("e"), 3);
+        }
+
+        TEST(VFSManagerTest, getRecursiveDirectoryIteratorShouldReturnFilesWithPrefix)
+        {
+            TestingOpenMW::VFSTestFile file("");
+            const std::unique_ptr<Manager> vfs = TestingOpenMW::createTestVFS({
+                { Path::NormalizedView("meshes/a.nif"), &file },
+                { Path::NormalizedView("meshes/b/c.nif"), &file },
+                { Path::NormalizedView("meshesx/d.nif"), &file },
+                { Path::NormalizedView("textures/e.dds"), &file },
+            });
+            std::vector<std::string> paths;
+            for (Path::NormalizedView path : vfs->getRecursiveDirectoryIterator(Path::NormalizedView("meshes/")))
+                paths.emplace_back(path.value());
+            EXPECT_THAT(paths, ElementsAre("meshes/a.nif", "meshes/b/c.nif"));
+        }
+
+        TEST(VFSManagerTest, getRecursiveDirectoryIteratorShouldReturnEmptyRangeForMissingPrefix)
+        {
+            TestingOpenMW::VFSTestFile file("");
+            const std::unique_ptr<Manager> vfs
+                = TestingOpenMW::createTestVFS({ { Path::NormalizedView("meshes/a.nif"), &file } });
+            const RecursiveDirectoryRange range = vfs->getRecursiveDirectoryIterator("Sound");
+            EXPECT_EQ(range.begin(), range.end());
+        }
+
+        TEST(VFSManagerTest, existsShouldReturnTrueForIndexedFile)
+        {
+            TestingOpenMW::VFSTestFile file("");
+            const std::unique_ptr<Manager> vfs
+                = TestingOpenMW::createTestVFS({ { Path::NormalizedView("meshes/a.nif"), &file } });
+            EXPECT_TRUE(vfs->exists(Path::NormalizedView("meshes/a.nif")));
+            EXPECT_FALSE(vfs->exists(Path::NormalizedView("meshes/b.nif")));
+        }
+    }
+}
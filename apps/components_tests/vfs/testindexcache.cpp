@@ -0,0 +1,99 @@
+#include <components/testing/util.hpp>
+#include <components/vfs/indexcache.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace VFS
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct VFSIndexCacheTest : Test
+        {
+            const std::filesystem::path mDir = TestingOpenMW::currentTestDirPath();
+            const std::filesystem::path mDataDir = mDir / "data";
+            const std::filesystem::path mCachePath = mDir / "cache" / "vfsindex.bin";
+
+            VFSIndexCacheTest()
+            {
+                std::filesystem::remove_all(mDataDir);
+                std::filesystem::create_directories(mDataDir / "meshes");
+                std::ofstream(mDataDir / "meshes" / "a.nif");
+                std::ofstream(mDataDir / "b.esp");
+            }
+        };
+
+        TEST_F(VFSIndexCacheTest, indexDataDirectoryShouldListFilesAndDirectories)
+        {
+            const DataDirectoryIndex index = indexDataDirectory(mDataDir);
+            EXPECT_THAT(index.mFiles, UnorderedElementsAre("meshes/a.nif", "b.esp"));
+            ASSERT_EQ(index.mDirectories.size(), 2);
+            EXPECT_EQ(index.mDirectories[0].mPath, "");
+            EXPECT_EQ(index.mDirectories[1].mPath, "meshes");
+        }
+
+        TEST_F(VFSIndexCacheTest, findShouldReturnNullptrForEmptyCache)
+        {
+            IndexCache cache(mCachePath);
+            EXPECT_EQ(cache.find(mDataDir), nullptr);
+        }
+
+        TEST_F(VFSIndexCacheTest, findShouldReturnSavedIndex)
+        {
+            {
+                IndexCache cache(mCachePath);
+                cache.insert(indexDataDirectory(mDataDir));
+                cache.save();
+            }
+            IndexCache cache(mCachePath);
+            const DataDirectoryIndex* const index = cache.find(mDataDir);
+            ASSERT_NE(index, nullptr);
+            EXPECT_THAT(index->mFiles, UnorderedElementsAre("meshes/a.nif", "b.esp"));
+        }
+
+        TEST_F(VFSIndexCacheTest, findShouldReturnNullptrWhenDirectoryIsModified)
+        {
+            {
+                IndexCache cache(mCachePath);
+                cache.insert(indexDataDirectory(mDataDir));
+                cache.save();
+            }
+            const std::filesystem::path meshes = mDataDir / "meshes";
+            std::ofstream(meshes / "c.nif");
+            std::filesystem::last_write_time(
+                meshes, std::filesystem::last_write_time(meshes) + std::chrono::seconds(1));
+            IndexCache cache(mCachePath);
+            EXPECT_EQ(cache.find(mDataDir), nullptr);
+        }
+
+        TEST_F(VFSIndexCacheTest, saveShouldDropNotUsedIndices)
+        {
+            {
+                IndexCache cache(mCachePath);
+                cache.insert(indexDataDirectory(mDataDir));
+                cache.save();
+            }
+            {
+                IndexCache cache(mCachePath);
+                cache.save();
+            }
+            IndexCache cache(mCachePath);
+            EXPECT_EQ(cache.find(mDataDir), nullptr);
+        }
+
+        TEST_F(VFSIndexCacheTest, findShouldReturnNullptrForBrokenCacheFile)
+        {
+            std::filesystem::create_directories(mCachePath.parent_path());
+            std::ofstream(mCachePath) << "broken";
+            IndexCache cache(mCachePath);
+            EXPECT_EQ(cache.find(mDataDir), nullptr);
+        }
+    }
+}
@@ -347,6 +347,14 @@ namespace VFS::Path
             EXPECT_THROW([] { NormalizedView("Foo\\Bar/baz"); }(), std::invalid_argument);
         }
 
+        TEST(VFSPathNormalizedViewTest, fromNormalizedShouldReferToGivenValue)
+        {
+            constexpr std::string_view value = "foo/bar.a";
+            const NormalizedView view = NormalizedView::fromNormalized(value);
+            EXPECT_EQ(view.value().data(), value.data());
+            EXPECT_EQ(view.value(), value);
+        }
+
         TEST(VFSPathNormalizedViewTest, shouldSupportOperatorDiv)
         {
             const NormalizedView a("foo/bar");
@@ -1,12 +1,16 @@
 #include "navmesh.hpp"
+#include "progress.hpp"
 #include "worldspacedata.hpp"
 
 #include <components/debug/debugging.hpp>
 #include <components/debug/debuglog.hpp>
 #include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/collisionshapetype.hpp>
+#include <components/detournavigator/dbrefgeometryobject.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
 #include <components/detournavigator/recastglobalallocator.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/serialization.hpp>
 #include <components/detournavigator/settings.hpp>
 #include <components/esm3/readerscache.hpp>
 #include <components/esm3/variant.hpp>
@@ -18,6 +22,7 @@
 #include <components/files/configurationmanager.hpp>
 #include <components/files/conversion.hpp>
 #include <components/files/multidircollection.hpp>
+#include <components/misc/strings/conversion.hpp>
 #include <components/platform/platform.hpp>
 #include <components/resource/bgsmfilemanager.hpp>
 #include <components/resource/bulletshapemanager.hpp>
@@ -35,13 +40,17 @@
 
 #include <boost/program_options.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <regex>
+#include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -123,6 +132,13 @@ namespace NavMeshTool
             addOption("collect-stats", bpo::value<bool>()->implicit_value(true)->default_value(false),
                 "collect statistics for generated navmesh tiles including existing ones stored in database");
 
+            addOption("cache-esm-data", bpo::value<bool>()->implicit_value(true)->default_value(false),
+                "store loaded content files data in the cache directory and reuse it while content files are not "
+                "changed");
+
+            addOption("resume", bpo::value<bool>()->implicit_value(true)->default_value(true),
+                "skip worldspaces completed by previous interrupted run with the same content files and settings");
+
             addOption("worldspace-filter", bpo::value<std::string>()->default_value(".*"),
                 "Regular expression to filter in specified worldspaces in modified ECMAScript grammar (see "
                 "https://en.cppreference.com/w/cpp/regex/ecmascript.html)");
@@ -132,6 +148,38 @@ namespace NavMeshTool
             return result;
         }
 
+        // Includes everything that makes tiles generated by previous run reusable without gathering worldspace data
+        std::string makeProgressKey(std::string_view dbPath, std::int64_t dbId,
+            const std::vector<std::string>& contentFiles, const Files::Collections& fileCollections,
+            const DetourNavigator::RecastSettings& settings, const DetourNavigator::AgentBounds& agentBounds,
+            bool removeUnusedTiles)
+        {
+            std::ostringstream stream;
+            // Db id changes when the db is removed or replaced so worldspaces done by previous run are not skipped
+            stream << "db " << dbPath << ' ' << dbId << '\n';
+            for (const std::string& file : contentFiles)
+            {
+                stream << "content " << file;
+                if (fileCollections.doesExist(file))
+                {
+                    const std::filesystem::path path = fileCollections.getPath(file);
+                    stream << ' ' << Files::pathToUnicodeString(path) << ' ' << std::filesystem::file_size(path) << ' '
+                           << std::filesystem::last_write_time(path).time_since_epoch().count();
+                }
+                stream << '\n';
+            }
+            const std::shared_ptr<DetourNavigator::RecastMesh> emptyMesh
+                = DetourNavigator::RecastMeshBuilder(DetourNavigator::TileBounds{}).create(DetourNavigator::Version{});
+            const std::vector<std::byte> serializedSettings
+                = DetourNavigator::serialize(settings, agentBounds, *emptyMesh, {});
+            stream << "settings "
+                   << Misc::StringUtils::toHex(std::string_view(
+                          reinterpret_cast<const char*>(serializedSettings.data()), serializedSettings.size()))
+                   << '\n';
+            stream << "remove unused tiles " << removeUnusedTiles << '\n';
+            return stream.str();
+        }
+
         int runNavMeshTool(int argc, char* argv[])
         {
             Platform::init();
@@ -188,6 +236,8 @@ namespace NavMeshTool
             const bool removeUnusedTiles = variables["remove-unused-tiles"].as<bool>();
             const bool writeBinaryLog = variables["write-binary-log"].as<bool>();
             const bool collectStats = variables["collect-stats"].as<bool>();
+            const bool cacheEsmData = variables["cache-esm-data"].as<bool>();
+            const bool resume = variables["resume"].as<bool>();
 
             const std::regex worldspaceFilter(variables["worldspace-filter"].as<std::string>());
 
@@ -209,11 +259,13 @@ namespace NavMeshTool
                 Settings::game().mDefaultActorPathfindHalfExtents,
             };
             const std::uint64_t maxDbFileSize = Settings::navigator().mMaxNavmeshdbFileSize;
-            const auto dbPath = Files::pathToUnicodeString(config.getUserDataPath() / "navmesh.db");
+            const std::filesystem::path dbFilePath = config.getUserDataPath() / "navmesh.db";
+            const auto dbPath = Files::pathToUnicodeString(dbFilePath);
 
             Log(Debug::Info) << "Using navmeshdb at " << dbPath;
 
-            DetourNavigator::NavMeshDb db(dbPath, maxDbFileSize);
+            DetourNavigator::NavMeshDb db(dbPath, maxDbFileSize, Settings::navigator().mNavmeshdbWalAutocheckpoint, 0,
+                Settings::navigator().mCompressNavmeshdbTiles);
 
             ESM::ReadersCache readers;
             EsmLoader::Query query;
@@ -224,8 +276,11 @@ namespace NavMeshTool
             query.mLoadGameSettings = true;
             query.mLoadLands = true;
             query.mLoadStatics = true;
-            const EsmLoader::EsmData esmData
-                = EsmLoader::loadEsmData(query, contentFiles, fileCollections, readers, &encoder);
+            const EsmLoader::EsmData esmData = cacheEsmData
+                ? EsmLoader::loadCachedEsmData(config.getCachePath() / "navmeshtool-esmdata.bin", query, contentFiles,
+                    fileCollections, readers, &encoder, nullptr, threadsNumber)
+                : EsmLoader::loadEsmData(
+                    query, contentFiles, fileCollections, readers, &encoder, nullptr, threadsNumber);
 
             constexpr double expiryDelay = 0;
 
@@ -243,13 +298,26 @@ namespace NavMeshTool
             const std::unordered_map<ESM::RefId, std::vector<std::size_t>> worldspaceCells
                 = collectWorldspaceCells(esmData, processInteriorCells, worldspaceFilter);
 
+            Progress progress(config.getCachePath() / "navmeshtool-progress.txt",
+                makeProgressKey(dbPath, db.getDbId(), contentFiles, fileCollections, navigatorSettings.mRecast,
+                    agentBounds, removeUnusedTiles));
+
+            if (!resume)
+                progress.remove();
+            else if (progress.getDoneCount() > 0)
+                Log(Debug::Info) << "Resuming interrupted navmesh generation with " << progress.getDoneCount()
+                                 << " worldspaces done";
+
             Status status = Status::Ok;
             std::size_t provided = 0;
             std::size_t inserted = 0;
             std::size_t updated = 0;
             std::size_t deleted = 0;
             std::size_t count = 0;
+            std::size_t skipped = 0;
             GenerateTilesStats stats;
+            std::chrono::steady_clock::duration gatherDuration{};
+            std::chrono::steady_clock::duration generateDuration{};
 
             {
                 SceneUtil::WorkQueue workQueue(threadsNumber);
@@ -258,8 +326,22 @@ namespace NavMeshTool
 
                 for (const auto& [worldspace, cells] : worldspaceCells)
                 {
+                    if (progress.isDone(worldspace))
+                    {
+                        ++count;
+                        ++skipped;
+                        Log(Debug::Info) << "Skipped worldspace (" << count << "/" << worldspaceCells.size() << ") "
+                                         << worldspace << " done by previous run";
+                        continue;
+                    }
+
+                    const auto gatherStart = std::chrono::steady_clock::now();
+
                     const WorldspaceData worldspaceData = gatherWorldspaceData(navigatorSettings, readers, vfs,
-                        bulletShapeManager, esmData, writeBinaryLog, worldspace, cells);
+                        bulletShapeManager, esmData, writeBinaryLog, worldspace, cells, workQueue);
+
+                    const auto generateStart = std::chrono::steady_clock::now();
+                    gatherDuration += generateStart - gatherStart;
 
                     const GenerateAllNavMeshTilesOptions generateAllNavMeshTilesOptions{
                         .mRemoveUnusedTiles = removeUnusedTiles,
@@ -270,6 +352,8 @@ namespace NavMeshTool
                     const GenerateTilesResult result = generateAllNavMeshTiles(
                         agentBounds, navigatorSettings, generateAllNavMeshTilesOptions, worldspaceData, db, workQueue);
 
+                    generateDuration += std::chrono::steady_clock::now() - generateStart;
+
                     ++count;
 
                     Log(Debug::Info) << "Processed worldspace (" << count << "/" << worldspaceCells.size() << ") "
@@ -289,12 +373,26 @@ namespace NavMeshTool
 
                     if (status != Status::Ok)
                         break;
+
+                    progress.markAsDone(worldspace);
                 }
             }
 
             Log(Debug::Info) << "Generated navmesh for " << provided << " tiles: " << inserted << " inserted, "
                              << updated << " updated, " << deleted << " deleted";
 
+            {
+                using Seconds = std::chrono::duration<double>;
+                const double generateSeconds = std::chrono::duration_cast<Seconds>(generateDuration).count();
+                Log(Debug::Info) << "Gathered worldspaces data in "
+                                 << std::chrono::duration_cast<Seconds>(gatherDuration).count() << " s";
+                Log(Debug::Info) << "Generated tiles in " << generateSeconds << " s ("
+                                 << (generateSeconds > 0 ? static_cast<double>(provided) / generateSeconds : 0)
+                                 << " tiles/s)";
+                if (skipped > 0)
+                    Log(Debug::Info) << "Skipped " << skipped << " worldspaces done by previous run";
+            }
+
             if (collectStats)
             {
                 Log(Debug::Info) << "Stats:";
@@ -307,6 +405,13 @@ namespace NavMeshTool
                 db.vacuum();
             }
 
+            if (status == Status::Ok)
+                progress.remove();
+
+            std::error_code ec;
+            if (const std::uintmax_t dbSize = std::filesystem::file_size(dbFilePath, ec); !ec)
+                Log(Debug::Info) << "Navmesh db size: " << dbSize << " bytes";
+
             switch (status)
             {
                 case Status::Ok:
@@ -0,0 +1,84 @@
+#include "progress.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace NavMeshTool
+{
+    Progress::Progress(std::filesystem::path path, std::string key)
+        : mPath(std::move(path))
+        , mKey(std::move(key))
+    {
+        if (!std::filesystem::exists(mPath))
+            return;
+
+        try
+        {
+            std::ifstream stream(mPath, std::ios::binary);
+            stream.exceptions(std::ios::badbit);
+            const std::string content{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+            if (!content.starts_with(mKey))
+            {
+                Log(Debug::Info) << "Ignoring navmesh generation progress " << mPath
+                                 << " made for different content files or settings";
+                return;
+            }
+
+            std::istringstream worldspaces(content.substr(mKey.size()));
+            for (std::string line; std::getline(worldspaces, line);)
+                if (!line.empty())
+                    mDone.insert(ESM::RefId::deserializeText(line));
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read navmesh generation progress " << mPath << ": " << e.what();
+            mDone.clear();
+        }
+    }
+
+    void Progress::markAsDone(ESM::RefId worldspace)
+    {
+        if (!mDone.insert(worldspace).second)
+            return;
+
+        try
+        {
+            write();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write navmesh generation progress " << mPath << ": " << e.what();
+        }
+    }
+
+    void Progress::remove()
+    {
+        mDone.clear();
+        std::error_code ec;
+        std::filesystem::remove(mPath, ec);
+        if (ec)
+            Log(Debug::Warning) << "Failed to remove navmesh generation progress " << mPath << ": " << ec.message();
+    }
+
+    void Progress::write() const
+    {
+        std::filesystem::create_directories(mPath.parent_path());
+        std::filesystem::path tmpPath = mPath;
+        tmpPath += ".tmp";
+        {
+            std::ofstream stream(tmpPath, std::ios::binary);
+            stream.exceptions(std::ios::failbit | std::ios::badbit);
+            stream << mKey;
+            for (const ESM::RefId& worldspace : mDone)
+                stream << worldspace.serializeText() << '\n';
+        }
+        // Rename is atomic so the file is never left half written when the process is killed
+        std::filesystem::rename(tmpPath, mPath);
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef OPENMW_NAVMESHTOOL_PROGRESS_H
+#define OPENMW_NAVMESHTOOL_PROGRESS_H
+
+#include <components/esm/refid.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <set>
+#include <string>
+
+namespace NavMeshTool
+{
+    /// Worldspaces with all navmesh tiles generated and committed to the db. Stored in a file after each worldspace
+    /// so a run interrupted in the middle skips them when started again. Saved worldspaces are ignored when the key
+    /// built from the inputs affecting generated tiles has changed.
+    class Progress
+    {
+    public:
+        explicit Progress(std::filesystem::path path, std::string key);
+
+        std::size_t getDoneCount() const { return mDone.size(); }
+
+        bool isDone(ESM::RefId worldspace) const { return mDone.contains(worldspace); }
+
+        void markAsDone(ESM::RefId worldspace);
+
+        void remove();
+
+    private:
+        const std::filesystem::path mPath;
+        const std::string mKey;
+        std::set<ESM::RefId> mDone;
+
+        void write() const;
+    };
+}
+
+#endif
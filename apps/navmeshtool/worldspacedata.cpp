@@ -23,6 +23,7 @@
 #include <components/misc/strings/lower.hpp>
 #include <components/navmeshtool/protocol.hpp>
 #include <components/resource/bulletshapemanager.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/settings/settings.hpp>
 #include <components/vfs/manager.hpp>
 
@@ -32,6 +33,8 @@
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <exception>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
@@ -131,15 +134,18 @@ namespace NavMeshTool
             return result;
         }
 
-        template <class F>
-        void forEachObject(const ESM::Cell& cell, const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
-            Resource::BulletShapeManager& bulletShapeManager, ESM::ReadersCache& readers, F&& f)
+        struct LoadedObject
         {
-            std::vector<CellRef> cellRefs = loadCellRefs(cell, esmData, readers);
+            BulletObject mObject;
+            CellRef mCellRef;
+        };
 
-            Log(Debug::Debug) << "Prepared " << cellRefs.size() << " unique cell refs";
+        std::vector<LoadedObject> loadObjects(std::vector<CellRef>&& cellRefs, const EsmLoader::EsmData& esmData,
+            const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager)
+        {
+            std::vector<LoadedObject> result;
 
-            for (const CellRef& cellRef : cellRefs)
+            for (CellRef& cellRef : cellRefs)
             {
                 VFS::Path::Normalized model(getModel(esmData, cellRef.mRefId, cellRef.mType));
                 if (model.empty())
@@ -173,12 +179,17 @@ namespace NavMeshTool
                     case ESM::REC_CONT:
                     case ESM::REC_DOOR:
                     case ESM::REC_STAT:
-                        f(BulletObject(std::move(shapeInstance), cellRef.mPos, cellRef.mScale), cellRef);
+                        result.push_back(LoadedObject{
+                            .mObject = BulletObject(std::move(shapeInstance), cellRef.mPos, cellRef.mScale),
+                            .mCellRef = std::move(cellRef),
+                        });
                         break;
                     default:
                         break;
                 }
             }
+
+            return result;
         }
 
         struct GetXY
@@ -215,11 +226,11 @@ namespace NavMeshTool
             initialized = true;
         }
 
-        std::tuple<HeightfieldShape, float, float> makeHeightfieldShape(const std::optional<ESM::Land>& land,
+        std::tuple<HeightfieldShape, float, float> makeHeightfieldShape(const ESM::Land* land,
             const osg::Vec2i& cellPosition, std::vector<std::vector<float>>& heightfields,
             std::vector<std::unique_ptr<ESM::Land::LandData>>& landDatas)
         {
-            if (!land.has_value() || osg::Vec2i(land->mX, land->mY) != cellPosition
+            if (land == nullptr || osg::Vec2i(land->mX, land->mY) != cellPosition
                 || (land->mDataTypes & ESM::Land::DATA_VHGT) == 0)
                 return { HeightfieldPlane{ static_cast<float>(ESM::Land::DEFAULT_HEIGHT) },
                     static_cast<float>(ESM::Land::DEFAULT_HEIGHT), static_cast<float>(ESM::Land::DEFAULT_HEIGHT) };
@@ -235,6 +246,65 @@ namespace NavMeshTool
             return { surface, landData.mMinHeight, landData.mMaxHeight };
         }
 
+        struct LoadedCell
+        {
+            std::tuple<HeightfieldShape, float, float> mHeightfield;
+            std::vector<std::vector<float>> mHeightfields;
+            std::vector<std::unique_ptr<ESM::Land::LandData>> mLandData;
+            std::vector<LoadedObject> mObjects;
+        };
+
+        // Loads bullet shapes and height data for a single cell. Does not touch ESM readers and the recast mesh
+        // manager so cells can be loaded in parallel and added to the manager in the original order.
+        class LoadCell final : public SceneUtil::WorkItem
+        {
+        public:
+            explicit LoadCell(const ESM::Cell& cell, const ESM::Land* land, std::vector<CellRef>&& cellRefs,
+                const EsmLoader::EsmData& esmData, const VFS::Manager& vfs,
+                Resource::BulletShapeManager& bulletShapeManager)
+                : mCell(cell)
+                , mLand(land)
+                , mCellRefs(std::move(cellRefs))
+                , mEsmData(esmData)
+                , mVfs(vfs)
+                , mBulletShapeManager(bulletShapeManager)
+            {
+            }
+
+            void doWork() final
+            {
+                try
+                {
+                    if (mCell.isExterior())
+                        mResult.mHeightfield = makeHeightfieldShape(mLand, osg::Vec2i(mCell.mData.mX, mCell.mData.mY),
+                            mResult.mHeightfields, mResult.mLandData);
+                    mResult.mObjects = loadObjects(std::move(mCellRefs), mEsmData, mVfs, mBulletShapeManager);
+                }
+                catch (...)
+                {
+                    mError = std::current_exception();
+                }
+            }
+
+            LoadedCell takeResult()
+            {
+                waitTillDone();
+                if (mError != nullptr)
+                    std::rethrow_exception(mError);
+                return std::move(mResult);
+            }
+
+        private:
+            const ESM::Cell& mCell;
+            const ESM::Land* const mLand;
+            std::vector<CellRef> mCellRefs;
+            const EsmLoader::EsmData& mEsmData;
+            const VFS::Manager& mVfs;
+            Resource::BulletShapeManager& mBulletShapeManager;
+            LoadedCell mResult;
+            std::exception_ptr mError;
+        };
+
         template <class T>
         void serializeToStderr(const T& value)
         {
@@ -387,7 +457,8 @@ namespace NavMeshTool
 
     WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, ESM::ReadersCache& readers,
         const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
-        bool writeBinaryLog, ESM::RefId worldspace, std::span<const std::size_t> cells)
+        bool writeBinaryLog, ESM::RefId worldspace, std::span<const std::size_t> cells,
+        SceneUtil::WorkQueue& workQueue)
     {
         Log(Debug::Info) << "Processing " << cells.size() << " cells from worldspace " << worldspace << "...";
 
@@ -404,6 +475,28 @@ namespace NavMeshTool
         std::size_t objectsCounter = 0;
         std::vector<AddedCellRef> addedCellRefs;
 
+        // ESM readers are not thread safe so cell refs are read here while loading shapes is done by the work queue
+        std::vector<osg::ref_ptr<LoadCell>> loadCells;
+        loadCells.reserve(cells.size());
+
+        for (const std::size_t cellIndex : cells)
+        {
+            const ESM::Cell& cell = esmData.mCells[cellIndex];
+            const ESM::Land* land = nullptr;
+
+            if (cell.isExterior())
+            {
+                const auto it = std::lower_bound(esmData.mLands.begin(), esmData.mLands.end(),
+                    osg::Vec2i(cell.mData.mX, cell.mData.mY), LessByXY{});
+                if (it != esmData.mLands.end())
+                    land = &*it;
+            }
+
+            loadCells.emplace_back(new LoadCell(
+                cell, land, loadCellRefs(cell, esmData, readers), esmData, vfs, bulletShapeManager));
+            workQueue.addWorkItem(loadCells.back());
+        }
+
         for (std::size_t i = 0; i < cells.size(); ++i)
         {
             const ESM::Cell& cell = esmData.mCells[cells[i]];
@@ -412,22 +505,26 @@ namespace NavMeshTool
             Log(Debug::Debug) << "Processing " << (exterior ? "exterior" : "interior") << " cell (" << (i + 1) << "/"
                               << cells.size() << ") \"" << cell.getDescription() << "\"";
 
+            LoadedCell loadedCell = loadCells[i]->takeResult();
+            loadCells[i] = nullptr;
+
             const osg::Vec2i cellPosition(cell.mData.mX, cell.mData.mY);
             const std::size_t cellObjectsBegin = data.mTilesData->mObjects.size();
 
             if (exterior)
             {
-                const auto it
-                    = std::lower_bound(esmData.mLands.begin(), esmData.mLands.end(), cellPosition, LessByXY{});
-                const auto [heightfieldShape, minHeight, maxHeight]
-                    = makeHeightfieldShape(it == esmData.mLands.end() ? std::optional<ESM::Land>() : *it, cellPosition,
-                        data.mTilesData->mHeightfields, data.mTilesData->mLandData);
+                const auto& [heightfieldShape, minHeight, maxHeight] = loadedCell.mHeightfield;
 
                 mergeOrAssign(getAabb(cellPosition, minHeight, maxHeight), data.mAabb, data.mAabbInitialized);
 
                 manager.addHeightfield(cellPosition, ESM::Land::REAL_SIZE, heightfieldShape, guard.get());
 
                 manager.addWater(cellPosition, ESM::Land::REAL_SIZE, -1, guard.get());
+
+                std::move(loadedCell.mHeightfields.begin(), loadedCell.mHeightfields.end(),
+                    std::back_inserter(data.mTilesData->mHeightfields));
+                std::move(loadedCell.mLandData.begin(), loadedCell.mLandData.end(),
+                    std::back_inserter(data.mTilesData->mLandData));
             }
             else
             {
@@ -435,44 +532,43 @@ namespace NavMeshTool
                     manager.addWater(cellPosition, std::numeric_limits<int>::max(), cell.mWater, guard.get());
             }
 
-            forEachObject(
-                cell, esmData, vfs, bulletShapeManager, readers, [&](BulletObject object, const CellRef& cellRef) {
-                    if (object.getShapeInstance()->mVisualCollisionType != Resource::VisualCollisionType::None)
-                        return;
+            for (auto& [object, cellRef] : loadedCell.mObjects)
+            {
+                if (object.getShapeInstance()->mVisualCollisionType != Resource::VisualCollisionType::None)
+                    continue;
 
-                    const btTransform& transform = object.getCollisionObject().getWorldTransform();
-                    const btAABB aabb
-                        = BulletHelpers::getAabb(*object.getCollisionObject().getCollisionShape(), transform);
-                    mergeOrAssign(aabb, data.mAabb, data.mAabbInitialized);
-                    if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
-                        data.mAabb.merge(BulletHelpers::getAabb(*avoid, transform));
+                const btTransform& transform = object.getCollisionObject().getWorldTransform();
+                const btAABB aabb = BulletHelpers::getAabb(*object.getCollisionObject().getCollisionShape(), transform);
+                mergeOrAssign(aabb, data.mAabb, data.mAabbInitialized);
+                if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
+                    data.mAabb.merge(BulletHelpers::getAabb(*avoid, transform));
 
-                    const ObjectId objectId(++objectsCounter);
-                    const CollisionShape shape(object.getShapeInstance(),
-                        *object.getCollisionObject().getCollisionShape(), object.getObjectTransform());
+                const ObjectId objectId(++objectsCounter);
+                const CollisionShape shape(object.getShapeInstance(), *object.getCollisionObject().getCollisionShape(),
+                    object.getObjectTransform());
 
-                    if (!manager.addObject(objectId, shape, transform, DetourNavigator::AreaType_ground, guard.get()))
-                        throw std::logic_error(
-                            makeAddObjectErrorMessage(objectId, DetourNavigator::AreaType_ground, shape));
+                if (!manager.addObject(objectId, shape, transform, DetourNavigator::AreaType_ground, guard.get()))
+                    throw std::logic_error(
+                        makeAddObjectErrorMessage(objectId, DetourNavigator::AreaType_ground, shape));
 
-                    addedCellRefs.push_back(AddedCellRef{
-                        .mCell = cell.getDescription(),
-                        .mCellRef = cellRef,
-                        .mRange = makeTilesPositionsRange(shape.getShape(), transform, settings.mRecast),
-                    });
+                addedCellRefs.push_back(AddedCellRef{
+                    .mCell = cell.getDescription(),
+                    .mCellRef = cellRef,
+                    .mRange = makeTilesPositionsRange(shape.getShape(), transform, settings.mRecast),
+                });
 
-                    if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
-                    {
-                        const ObjectId avoidObjectId(++objectsCounter);
-                        const CollisionShape avoidShape(object.getShapeInstance(), *avoid, object.getObjectTransform());
-                        if (!manager.addObject(
-                                avoidObjectId, avoidShape, transform, DetourNavigator::AreaType_null, guard.get()))
-                            throw std::logic_error(
-                                makeAddObjectErrorMessage(avoidObjectId, DetourNavigator::AreaType_null, avoidShape));
-                    }
+                if (const btCollisionShape* avoid = object.getShapeInstance()->mAvoidCollisionShape.get())
+                {
+                    const ObjectId avoidObjectId(++objectsCounter);
+                    const CollisionShape avoidShape(object.getShapeInstance(), *avoid, object.getObjectTransform());
+                    if (!manager.addObject(
+                            avoidObjectId, avoidShape, transform, DetourNavigator::AreaType_null, guard.get()))
+                        throw std::logic_error(
+                            makeAddObjectErrorMessage(avoidObjectId, DetourNavigator::AreaType_null, avoidShape));
+                }
 
-                    data.mTilesData->mObjects.emplace_back(std::move(object));
-                });
+                data.mTilesData->mObjects.emplace_back(std::move(object));
+            }
 
             if (writeBinaryLog)
                 serializeToStderr(ProcessedCells{ static_cast<std::uint64_t>(i + 1) });
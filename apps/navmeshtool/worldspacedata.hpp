@@ -38,6 +38,11 @@ namespace EsmLoader
     struct EsmData;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace NavMeshTool
 {
     using DetourNavigator::ObjectTransform;
@@ -99,7 +104,8 @@ namespace NavMeshTool
 
     WorldspaceData gatherWorldspaceData(const DetourNavigator::Settings& settings, ESM::ReadersCache& readers,
         const VFS::Manager& vfs, Resource::BulletShapeManager& bulletShapeManager, const EsmLoader::EsmData& esmData,
-        bool writeBinaryLog, ESM::RefId worldspace, std::span<const std::size_t> cells);
+        bool writeBinaryLog, ESM::RefId worldspace, std::span<const std::size_t> cells,
+        SceneUtil::WorkQueue& workQueue);
 }
 
 #endif
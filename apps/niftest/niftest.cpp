@@ -1,10 +1,23 @@
 /// Program to test .nif files both on the FileSystem and in BSA archives.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <exception>
 #include <filesystem>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -12,6 +25,7 @@
 #include <components/files/configurationmanager.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/utils.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/nif/niffile.hpp>
 #include <components/vfs/archive.hpp>
@@ -25,6 +39,68 @@
 // Create local aliases for brevity
 namespace bpo = boost::program_options;
 
+struct Options
+{
+    bool mWriteDebugLog = false;
+    bool mQuiet = false;
+    bool mBenchmark = false;
+    bool mProfile = false;
+    std::size_t mJobs = 1;
+};
+
+struct FileProfile
+{
+    std::string mPath;
+    std::size_t mSize = 0;
+    std::chrono::steady_clock::duration mParseTime{};
+};
+
+/// Collected from all threads parsing files
+struct ParseStats
+{
+    std::mutex mMutex;
+    std::size_t mBytes = 0;
+    std::chrono::steady_clock::duration mParseTime{};
+    std::vector<FileProfile> mFiles;
+    std::map<std::string, std::size_t, std::less<>> mRecordTypes;
+};
+
+constexpr std::size_t slowestFilesCount = 50;
+
+std::mutex outputMutex;
+
+/// Write the whole line at once to not mix output from different threads
+template <class... Args>
+void printLine(std::ostream& stream, const Args&... args)
+{
+    std::ostringstream line;
+    (line << ... << args);
+    const std::lock_guard lock(outputMutex);
+    stream << line.str() << std::endl;
+}
+
+/// Call function for each index in [0, count) using up to given number of threads including the current one
+template <class Function>
+void runInParallel(std::size_t jobs, std::size_t count, Function&& function)
+{
+    std::atomic_size_t next{ 0 };
+    const auto run = [&] {
+        for (std::size_t i = next++; i < count; i = next++)
+            function(i);
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < std::min(jobs, count); ++i)
+        threads.emplace_back(run);
+    run();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+double toMilliseconds(std::chrono::steady_clock::duration value)
+{
+    return std::chrono::duration<double, std::milli>(value).count();
+}
+
 enum class FileType
 {
     BSA,
@@ -119,21 +195,67 @@ std::unique_ptr<VFS::Archive> makeArchive(const std::filesystem::path& path)
     return nullptr;
 }
 
-bool readFile(
-    const std::filesystem::path& source, const std::filesystem::path& path, const VFS::Manager* vfs, bool quiet)
+std::vector<char> readAll(std::istream& stream)
+{
+    std::vector<char> result(static_cast<std::size_t>(Files::getStreamSizeLeft(stream)));
+    stream.read(result.data(), static_cast<std::streamsize>(result.size()));
+    if (stream.fail())
+        throw std::runtime_error("Failed to read file");
+    return result;
+}
+
+/// Parse the file from memory to measure only the parsing time. Uses the same code as the engine.
+std::chrono::steady_clock::duration readNif(
+    const std::filesystem::path& fullPath, const std::string& pathStr, const VFS::Manager* vfs, ParseStats& stats)
+{
+    std::vector<char> buffer;
+    std::optional<std::span<const char>> data;
+    if (vfs != nullptr)
+        data = vfs->getData(VFS::Path::Normalized(pathStr));
+    if (!data.has_value())
+    {
+        buffer = readAll(*(vfs != nullptr ? vfs->get(pathStr) : Files::openConstrainedFileStream(fullPath)));
+        data = buffer;
+    }
+
+    Nif::NIFFile file(VFS::Path::Normalized(Files::pathToUnicodeString(fullPath)));
+    Nif::Reader reader(file, nullptr);
+    const auto start = std::chrono::steady_clock::now();
+    reader.parse(*data);
+    const auto parseTime = std::chrono::steady_clock::now() - start;
+
+    std::map<std::string_view, std::size_t> recordTypes;
+    for (const std::unique_ptr<Nif::Record>& record : file.mRecords)
+        ++recordTypes[record->mRecordName];
+
+    const std::lock_guard lock(stats.mMutex);
+    stats.mBytes += data->size();
+    stats.mParseTime += parseTime;
+    stats.mFiles.push_back(FileProfile{ Files::pathToUnicodeString(fullPath), data->size(), parseTime });
+    for (const auto& [type, count] : recordTypes)
+    {
+        const auto it = stats.mRecordTypes.find(type);
+        if (it == stats.mRecordTypes.end())
+            stats.mRecordTypes.emplace(type, count);
+        else
+            it->second += count;
+    }
+    return parseTime;
+}
+
+bool readFile(const std::filesystem::path& source, const std::filesystem::path& path, const VFS::Manager* vfs,
+    const Options& options, ParseStats& stats)
 {
     const auto [fileType, fileClass] = classifyFile(path);
     if (fileClass != FileClass::NIF && fileClass != FileClass::Material)
         return false;
 
     const std::string pathStr = Files::pathToUnicodeString(path);
-    if (!quiet)
-    {
-        std::cout << "Reading " << getFileTypeName(fileType) << " file '" << pathStr << "'";
-        if (!source.empty())
-            std::cout << " from '" << Files::pathToUnicodeString(isBSA(source) ? source.filename() : source) << "'";
-        std::cout << std::endl;
-    }
+    std::string sourceStr;
+    if (!source.empty())
+        sourceStr = " from '" + Files::pathToUnicodeString(isBSA(source) ? source.filename() : source) + "'";
+    if (!options.mQuiet && !options.mProfile)
+        printLine(std::cout, "Reading ", getFileTypeName(fileType), " file '", pathStr, "'", sourceStr);
     const std::filesystem::path fullPath = !source.empty() ? source / path : path;
     try
     {
@@ -141,12 +263,10 @@ bool readFile(
         {
             case FileClass::NIF:
             {
-                Nif::NIFFile file(VFS::Path::Normalized(Files::pathToUnicodeString(fullPath)));
-                Nif::Reader reader(file, nullptr);
-                if (vfs != nullptr)
-                    reader.parse(vfs->get(pathStr));
-                else
-                    reader.parse(Files::openConstrainedFileStream(fullPath));
+                const auto parseTime = readNif(fullPath, pathStr, vfs, stats);
+                if (!options.mQuiet && options.mProfile)
+                    printLine(std::cout, "Read ", getFileTypeName(fileType), " file '", pathStr, "'", sourceStr,
+                        " in ", std::fixed, std::setprecision(3), toMilliseconds(parseTime), " ms");
                 break;
             }
             case FileClass::Material:
@@ -163,29 +283,32 @@ bool readFile(
     }
     catch (std::exception& e)
     {
-        std::cerr << "Failed to read '" << pathStr << "':" << std::endl << e.what() << std::endl;
+        printLine(std::cerr, "Failed to read '", pathStr, "':\n", e.what());
     }
     return true;
 }
 
 /// Check all the nif files in a given VFS::Archive
 /// \note Can not read a bsa file inside of a bsa file.
-void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath, bool quiet)
+void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::path& archivePath,
+    const Options& options, ParseStats& stats)
 {
     if (archive == nullptr)
         return;
 
-    if (!quiet)
+    if (!options.mQuiet)
         std::cout << "Reading data source '" << Files::pathToUnicodeString(archivePath) << "'" << std::endl;
 
     VFS::Manager vfs;
     vfs.addArchive(std::move(archive));
     vfs.buildIndex();
 
+    std::vector<std::string> names;
     for (const auto& name : vfs.getRecursiveDirectoryIterator())
-    {
-        readFile(archivePath, name.value(), &vfs, quiet);
-    }
+        names.emplace_back(name.value());
+
+    runInParallel(options.mJobs, names.size(),
+        [&](std::size_t i) { readFile(archivePath, names[i], &vfs, options, stats); });
 
     if (!archivePath.empty() && !isBSA(archivePath))
     {
@@ -198,7 +321,7 @@ void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::pat
             {
                 try
                 {
-                    readVFS(VFS::makeBsaArchive(file.second, nullptr), file.second, quiet);
+                    readVFS(VFS::makeBsaArchive(file.second, nullptr), file.second, options, stats);
                 }
                 catch (const std::exception& e)
                 {
@@ -210,8 +333,44 @@ void readVFS(std::unique_ptr<VFS::Archive>&& archive, const std::filesystem::pat
     }
 }
 
-bool parseOptions(int argc, char** argv, Files::PathContainer& files, Files::PathContainer& archives,
-    bool& writeDebugLog, bool& quiet)
+void printReport(const Options& options, ParseStats& stats, std::chrono::steady_clock::duration wallTime)
+{
+    std::cout << std::fixed << std::setprecision(3);
+
+    if (options.mProfile)
+    {
+        std::vector<std::pair<std::string_view, std::size_t>> recordTypes(
+            stats.mRecordTypes.begin(), stats.mRecordTypes.end());
+        std::stable_sort(recordTypes.begin(), recordTypes.end(),
+            [](const auto& l, const auto& r) { return l.second > r.second; });
+        std::cout << "Record types:" << std::endl;
+        for (const auto& [type, count] : recordTypes)
+            std::cout << "  " << std::setw(10) << count << ' ' << type << std::endl;
+
+        const std::size_t slowestCount = std::min(slowestFilesCount, stats.mFiles.size());
+        std::partial_sort(stats.mFiles.begin(), stats.mFiles.begin() + slowestCount, stats.mFiles.end(),
+            [](const FileProfile& l, const FileProfile& r) { return l.mParseTime > r.mParseTime; });
+        std::cout << "Slowest " << slowestCount << " files:" << std::endl;
+        for (std::size_t i = 0; i < slowestCount; ++i)
+        {
+            const FileProfile& file = stats.mFiles[i];
+            std::cout << "  " << std::setw(10) << toMilliseconds(file.mParseTime) << " ms " << std::setw(10)
+                      << file.mSize << " bytes '" << file.mPath << "'" << std::endl;
+        }
+    }
+
+    // Parse time is summed over all threads so throughput is per thread
+    const double seconds = std::chrono::duration<double>(stats.mParseTime).count();
+    const double megabytes = static_cast<double>(stats.mBytes) / (1024 * 1024);
+    std::cout << "Parsed " << stats.mFiles.size() << " NIF files, " << megabytes << " MB in " << seconds
+              << " s: " << (seconds > 0 ? megabytes / seconds : 0) << " MB/s";
+    if (options.mJobs > 1)
+        std::cout << " per thread, wall time " << std::chrono::duration<double>(wallTime).count() << " s with "
+                  << options.mJobs << " jobs";
+    std::cout << std::endl;
+}
+
+bool parseOptions(int argc, char** argv, Files::PathContainer& files, Files::PathContainer& archives, Options& options)
 {
     bpo::options_description desc(
         R"(Ensure that OpenMW can use the provided NIF, KF, BTO/BTR, RDT, PSA, BGEM/BGSM and BSA/BA2 files
@@ -225,6 +384,10 @@ Allowed options)");
     addOption("help,h", "print help message.");
     addOption("write-debug-log,v", "write debug log for unsupported nif files");
     addOption("quiet,q", "do not log read archives/files");
+    addOption("benchmark,b", "report NIF parsing throughput, file reading is not included");
+    addOption("profile,p", "report NIF parsing time for each file, record types histogram and slowest files");
+    addOption("jobs,j", bpo::value<std::size_t>()->default_value(1),
+        "number of threads to parse files, 0 to use all hardware threads");
     addOption("archives", bpo::value<Files::MaybeQuotedPathContainer>(), "path to archive files to provide files");
     addOption("input-file", bpo::value<Files::MaybeQuotedPathContainer>(), "input file");
 
@@ -243,8 +406,13 @@ Allowed options)");
             std::cout << desc << std::endl;
             return false;
         }
-        writeDebugLog = variables.count("write-debug-log") > 0;
-        quiet = variables.count("quiet") > 0;
+        options.mWriteDebugLog = variables.count("write-debug-log") > 0;
+        options.mQuiet = variables.count("quiet") > 0;
+        options.mBenchmark = variables.count("benchmark") > 0;
+        options.mProfile = variables.count("profile") > 0;
+        options.mJobs = variables["jobs"].as<std::size_t>();
+        if (options.mJobs == 0)
+            options.mJobs = std::max(1u, std::thread::hardware_concurrency());
         if (variables.count("input-file"))
         {
             files = asPathContainer(variables["input-file"].as<Files::MaybeQuotedPathContainer>());
@@ -267,13 +435,12 @@ Allowed options)");
 int main(int argc, char** argv)
 {
     Files::PathContainer files, sources;
-    bool writeDebugLog = false;
-    bool quiet = false;
-    if (!parseOptions(argc, argv, files, sources, writeDebugLog, quiet))
+    Options options;
+    if (!parseOptions(argc, argv, files, sources, options))
         return 1;
 
     Nif::Reader::setLoadUnsupportedFiles(true);
-    Nif::Reader::setWriteNifDebugLog(writeDebugLog);
+    Nif::Reader::setWriteNifDebugLog(options.mWriteDebugLog);
 
     std::unique_ptr<VFS::Manager> vfs;
     if (!sources.empty())
@@ -282,7 +449,7 @@ int main(int argc, char** argv)
         for (const std::filesystem::path& path : sources)
         {
             const std::string pathStr = Files::pathToUnicodeString(path);
-            if (!quiet)
+            if (!options.mQuiet)
                 std::cout << "Adding data source '" << pathStr << "'" << std::endl;
 
             try
@@ -301,23 +468,37 @@ int main(int argc, char** argv)
         vfs->buildIndex();
     }
 
+    const auto start = std::chrono::steady_clock::now();
+
+    // Separate files are read in parallel, archives and directories are read one by one with parallel reading inside
+    std::vector<std::filesystem::path> separateFiles;
+    std::vector<std::filesystem::path> other;
     for (const auto& path : files)
+    {
+        const FileClass fileClass = classifyFile(path).second;
+        if (fileClass == FileClass::NIF || fileClass == FileClass::Material)
+            separateFiles.push_back(path);
+        else
+            other.push_back(path);
+    }
+
+    ParseStats stats;
+    runInParallel(options.mJobs, separateFiles.size(),
+        [&](std::size_t i) { readFile({}, separateFiles[i], vfs.get(), options, stats); });
+
+    for (const auto& path : other)
     {
         const std::string pathStr = Files::pathToUnicodeString(path);
         try
         {
-            const bool isFile = readFile({}, path, vfs.get(), quiet);
-            if (!isFile)
+            if (auto archive = makeArchive(path))
             {
-                if (auto archive = makeArchive(path))
-                {
-                    readVFS(std::move(archive), path, quiet);
-                }
-                else
-                {
-                    std::cerr << "Error: '" << pathStr << "' is not a NIF file, material file, archive, or directory"
-                              << std::endl;
-                }
+                readVFS(std::move(archive), path, options, stats);
+            }
+            else
+            {
+                std::cerr << "Error: '" << pathStr << "' is not a NIF file, material file, archive, or directory"
+                          << std::endl;
             }
         }
         catch (std::exception& e)
@@ -325,5 +506,9 @@ int main(int argc, char** argv)
             std::cerr << "Failed to read '" << pathStr << "':  " << e.what() << std::endl;
         }
     }
+
+    if (options.mBenchmark || options.mProfile)
+        printReport(options, stats, std::chrono::steady_clock::now() - start);
+
     return 0;
 }
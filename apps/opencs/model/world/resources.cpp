@@ -28,9 +28,9 @@ void CSMWorld::Resources::recreate(const VFS::Manager* vfs, const char* const* e
 
     size_t baseSize = mBaseDirectory.size();
 
-    for (const auto& filepath : vfs->getRecursiveDirectoryIterator())
+    for (VFS::Path::NormalizedView filepath : vfs->getRecursiveDirectoryIterator())
     {
-        const std::string_view view = filepath.view();
+        const std::string_view view = filepath.value();
         if (view.size() < baseSize + 1 || !view.starts_with(mBaseDirectory) || view[baseSize] != '/')
             continue;
 
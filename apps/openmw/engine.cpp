@@ -3,6 +3,7 @@
 #include <cerrno>
 #include <chrono>
 #include <future>
+#include <optional>
 #include <system_error>
 
 #include <osgDB/ReaderWriter>
@@ -17,12 +18,14 @@
 #include <components/misc/rng.hpp>
 #include <components/misc/strings/format.hpp>
 
+#include <components/vfs/indexcache.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/registerarchives.hpp>
 
 #include <components/sdlutil/imagetosurface.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 
+#include <components/resource/keyframemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
@@ -329,6 +332,7 @@ bool OMW::Engine::frame(unsigned frameNumber, float frametime)
 
         stats->setAttribute(frameNumber, "WorkQueue", static_cast<double>(mWorkQueue->getNumItems()));
         stats->setAttribute(frameNumber, "WorkThread", static_cast<double>(mWorkQueue->getNumActiveThreads()));
+        SceneUtil::reportStats(mWorkQueue->getStats(), frameNumber, *stats);
 
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
@@ -736,16 +740,28 @@ void OMW::Engine::prepareEngine()
 
     mVFS = std::make_unique<VFS::Manager>();
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder());
+    std::optional<VFS::IndexCache> vfsIndexCache;
+    if (Settings::general().mCacheDataDirectories)
+        vfsIndexCache.emplace(mCfgMgr.getCachePath() / "vfsindex.bin");
+
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, &mEncoder.get()->getStatelessEncoder(),
+        Settings::general().mMemoryMapArchives, vfsIndexCache ? &*vfsIndexCache : nullptr);
+
+    if (vfsIndexCache.has_value())
+        vfsIndexCache->save();
 
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(
         mVFS.get(), Settings::cells().mCacheExpiryDelay, &mEncoder.get()->getStatelessEncoder());
+    mResourceSystem->setMemoryBudget(static_cast<std::size_t>(Settings::cells().mCacheMemoryBudget.get()));
     mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
         false); // keep to Off for now to allow better state sharing
     mResourceSystem->getSceneManager()->setFilterSettings(Settings::general().mTextureMagFilter,
         Settings::general().mTextureMinFilter, Settings::general().mTextureMipmap,
         static_cast<float>(Settings::general().mAnisotropy));
+    if (Settings::models().mCacheSceneTemplates)
+        mResourceSystem->getSceneManager()->setTemplateCachePath(mCfgMgr.getCachePath() / "scenetemplates");
+    mResourceSystem->getKeyframeManager()->setCompileClips(Settings::game().mCompileAnimationClips);
     mEnvironment.setResourceSystem(*mResourceSystem);
 
     mWorkQueue = new SceneUtil::WorkQueue(Settings::cells().mPreloadNumThreads);
@@ -63,6 +63,7 @@ namespace MWPhysics
 {
     class RayCastingResult;
     class RayCastingInterface;
+    struct LineOfSightRequest;
 }
 
 namespace MWRender
@@ -394,6 +395,11 @@ namespace MWBase
             = 0; ///< @return true if the player is colliding with \a object
         virtual bool getActorCollidingWith(const MWWorld::ConstPtr& object)
             = 0; ///< @return true if any actor is colliding with \a object
+        virtual void getActorsInRange(
+            const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& actors) const = 0;
+        ///< get actors in the scene within \a radius from \a position in unspecified order
+        virtual bool isAnyActorInRange(const osg::Vec3f& position, float radius) const = 0;
+        ///< @return true if there is an actor in the scene within \a radius from \a position
         virtual void hurtStandingActors(const MWWorld::ConstPtr& object, float dmgPerSecond) = 0;
         ///< Apply a health difference to any actors standing on \a object.
         /// To hurt actors, healthPerSecond should be a positive value. For a negative value, actors will be healed.
@@ -411,6 +417,9 @@ namespace MWBase
         virtual bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) = 0;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        virtual std::vector<bool> getLOS(std::span<const MWPhysics::LineOfSightRequest> requests) = 0;
+        ///< get Line of Sight for all requests at once, cheaper than doing it one by one
+
         virtual float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false)
             = 0;
@@ -66,10 +66,10 @@ namespace MWGui
         };
 
         constexpr VFS::Path::NormalizedView splash("splash/");
-        for (const auto& name : mResourceSystem->getVFS()->getRecursiveDirectoryIterator(splash))
+        for (VFS::Path::NormalizedView name : mResourceSystem->getVFS()->getRecursiveDirectoryIterator(splash))
         {
-            if (isSupportedExtension(Misc::getFileExtension(name)))
-                mSplashScreens.push_back(name);
+            if (isSupportedExtension(Misc::getFileExtension(name.value())))
+                mSplashScreens.emplace_back(name.value());
         }
         if (mSplashScreens.empty())
             Log(Debug::Warning) << "Warning: no splash screens found!";
@@ -410,7 +410,7 @@ namespace MWGui
         std::vector<std::string> availableLanguages;
         const VFS::Manager* vfs = MWBase::Environment::get().getResourceSystem()->getVFS();
         constexpr VFS::Path::NormalizedView l10n("l10n/");
-        for (const auto& path : vfs->getRecursiveDirectoryIterator(l10n))
+        for (VFS::Path::NormalizedView path : vfs->getRecursiveDirectoryIterator(l10n))
         {
             if (path.extension() == "yaml")
             {
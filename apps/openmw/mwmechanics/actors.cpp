@@ -1,5 +1,6 @@
 #include "actors.hpp"
 
+#include <algorithm>
 #include <array>
 #include <optional>
 
@@ -38,6 +39,8 @@
 
 #include "../mwmechanics/aibreathe.hpp"
 
+#include "../mwphysics/raycasting.hpp"
+
 #include "../mwrender/vismask.hpp"
 
 #include "../mwsound/constants.hpp"
@@ -1533,6 +1536,7 @@ namespace MWMechanics
                     player.getClass().getCreatureStats(player).setHitAttemptActor({});
             }
             const int actorsProcessingRange = Settings::game().mActorsProcessingRange;
+            std::vector<MWWorld::Ptr> neighbors;
 
             // AI and magic effects update
             for (Actor& actor : mActors)
@@ -1595,17 +1599,21 @@ namespace MWMechanics
                     {
                         if (engageCombatTimerStatus == Misc::TimerStatus::Elapsed)
                         {
+                            // player is not AI-controlled
                             if (!isPlayer)
+                            {
                                 adjustCommandedActor(actor.getPtr());
 
-                            for (const Actor& otherActor : mActors)
-                            {
-                                if (otherActor.isInvalid())
-                                    continue;
-                                if (otherActor.getPtr() == actor.getPtr() || isPlayer) // player is not AI-controlled
-                                    continue;
-                                engageCombat(
-                                    actor.getPtr(), otherActor.getPtr(), cachedAllies, otherActor.getPtr() == player);
+                                // engageCombat ignores actors outside of processing range
+                                neighbors.clear();
+                                getObjectsInRange(actor.getPtr().getRefData().getPosition().asVec3(),
+                                    static_cast<float>(actorsProcessingRange), neighbors);
+                                for (const MWWorld::Ptr& otherActor : neighbors)
+                                {
+                                    if (otherActor == actor.getPtr())
+                                        continue;
+                                    engageCombat(actor.getPtr(), otherActor, cachedAllies, otherActor == player);
+                                }
                             }
                         }
                         if (mTimerUpdateHeadTrack == 0)
@@ -1956,15 +1964,22 @@ namespace MWMechanics
             std::set<MWWorld::Ptr> sidingActors;
             getActorsSidingWith(player, sidingActors);
 
+            std::erase_if(observers, [&](const MWWorld::Ptr& observer) {
+                return observer == player || observer.getClass().getCreatureStats(observer).isDead()
+                    || sidingActors.find(observer) != sidingActors.cend();
+            });
+
+            std::vector<MWPhysics::LineOfSightRequest> requests;
+            requests.reserve(observers.size());
             for (const MWWorld::Ptr& observer : observers)
-            {
-                if (observer == player || observer.getClass().getCreatureStats(observer).isDead())
-                    continue;
+                requests.push_back(MWPhysics::LineOfSightRequest{ player, observer });
 
-                if (sidingActors.find(observer) != sidingActors.cend())
-                    continue;
+            const std::vector<bool> los = world->getLOS(requests);
 
-                if (world->getLOS(player, observer))
+            for (std::size_t i = 0; i < observers.size(); ++i)
+            {
+                const MWWorld::Ptr& observer = observers[i];
+                if (los[i])
                 {
                     if (MWBase::Environment::get().getMechanicsManager()->awarenessCheck(player, observer))
                     {
@@ -2100,26 +2115,21 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if (actor.isInvalid())
-                continue;
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                out.push_back(actor.getPtr());
-        }
+        // Use actors grid to avoid iterating over all actors, result order is unspecified
+        const std::size_t begin = out.size();
+        MWBase::Environment::get().getWorld()->getActorsInRange(position, radius, out);
+        const auto isNotProcessed = [&](const MWWorld::Ptr& ptr) {
+            const auto it = mIndex.find(ptr.mRef);
+            return it == mIndex.end() || it->second->isInvalid()
+                || (ptr.getRefData().getPosition().asVec3() - position).length2() > radius * radius;
+        };
+        out.erase(std::remove_if(out.begin() + begin, out.end(), isNotProcessed), out.end());
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius) const
     {
-        for (const Actor& actor : mActors)
-        {
-            if (actor.isInvalid())
-                continue;
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                return true;
-        }
-
-        return false;
+        // Actors grid contains the same actors as mActors, stop on the first one found
+        return MWBase::Environment::get().getWorld()->isAnyActorInRange(position, radius);
     }
 
     std::vector<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actorPtr, bool excludeInfighting) const
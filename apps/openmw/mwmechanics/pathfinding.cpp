@@ -2,6 +2,8 @@
 
 #include <iterator>
 #include <limits>
+#include <optional>
+#include <vector>
 
 #include <osg/io_utils>
 
@@ -115,6 +117,24 @@ namespace
                 && std::abs((position.value() - start).length2() - (end - start).length2()) <= 1;
         }
     };
+
+    // Returns the farthest coarse route point reachable by moving along the route no more than maxDistance
+    std::optional<osg::Vec3f> getLimitedRouteEnd(
+        const std::vector<osg::Vec3f>& route, const osg::Vec3f& startPoint, float maxDistance)
+    {
+        if (route.empty())
+            return std::nullopt;
+        osg::Vec3f result = route.front();
+        float distance = (route.front() - startPoint).length();
+        for (auto it = std::next(route.begin()); it != route.end(); ++it)
+        {
+            distance += (*it - *std::prev(it)).length();
+            if (distance > maxDistance)
+                break;
+            result = *it;
+        }
+        return result;
+    }
 }
 
 namespace MWMechanics
@@ -454,6 +474,19 @@ namespace MWMechanics
         if (distance <= maxDistance)
             return buildPath(
                 actor, startPoint, endPoint, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
+        // Follow coarse route over navmesh tiles and build a detailed path only for the part near the actor. Routes
+        // are cached by the navigator so rebuilding the path while the actor moves is cheap.
+        if (!actor.getClass().isPureWaterCreature(actor) && !actor.getClass().isPureFlyingCreature(actor))
+        {
+            std::vector<osg::Vec3f> route;
+            const DetourNavigator::Status status
+                = DetourNavigator::findTileRoute(*navigator, agentBounds, startPoint, endPoint, flags, route);
+            const std::optional<osg::Vec3f> routeEnd = getLimitedRouteEnd(route, startPoint, maxDistance);
+            if ((status == DetourNavigator::Status::Success || status == DetourNavigator::Status::PartialPath)
+                && routeEnd.has_value())
+                return buildPath(actor, startPoint, *routeEnd, pathgridGraph, agentBounds, flags, areaCosts,
+                    endTolerance, pathType);
+        }
         const auto end = startPoint + startToEnd * maxDistance / distance;
         buildPath(actor, startPoint, end, pathgridGraph, agentBounds, flags, areaCosts, endTolerance, pathType);
     }
@@ -0,0 +1,151 @@
+#include "actorgrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <components/misc/hash.hpp>
+
+namespace MWPhysics
+{
+    std::size_t ActorGrid::CellHash::operator()(const osg::Vec2i& value) const noexcept
+    {
+        return Misc::hash2dCoord(value.x(), value.y());
+    }
+
+    ActorGrid::ActorGrid(float cellSize)
+        : mCellSize(cellSize)
+    {
+        if (cellSize <= 0)
+            throw std::invalid_argument("Actor grid cell size should be positive");
+    }
+
+    template <class Function>
+    bool ActorGrid::forEachInRange(const osg::Vec3f& position, float radius, Function&& function) const
+    {
+        const float radius2 = radius * radius;
+        const auto visit = [&](const Cell& cell) {
+            for (const Entry* entry : cell)
+                if ((entry->mPosition - position).length2() <= radius2 && function(*entry))
+                    return true;
+            return false;
+        };
+
+        const float cellsPerSide = 2 * radius / mCellSize + 1;
+        if (cellsPerSide * cellsPerSide > static_cast<float>(mCells.size()))
+        {
+            // Looking up each cell in range is more expensive than checking all existing cells
+            for (const auto& [_, cell] : mCells)
+                if (visit(cell))
+                    return true;
+            return false;
+        }
+
+        const osg::Vec2i min = getCell(position - osg::Vec3f(radius, radius, 0));
+        const osg::Vec2i max = getCell(position + osg::Vec3f(radius, radius, 0));
+
+        for (int x = min.x(); x <= max.x(); ++x)
+        {
+            for (int y = min.y(); y <= max.y(); ++y)
+            {
+                const auto it = mCells.find(osg::Vec2i(x, y));
+                if (it != mCells.end() && visit(it->second))
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ActorGrid::insert(const MWWorld::Ptr& ptr, const osg::Vec3f& position)
+    {
+        const auto [it, inserted] = mEntries.emplace(ptr.mRef, Entry{ ptr, position, getCell(position) });
+        if (!inserted)
+        {
+            it->second.mPtr = ptr;
+            updatePosition(ptr, position);
+            return;
+        }
+        addToCell(it->second);
+    }
+
+    void ActorGrid::updatePosition(const MWWorld::ConstPtr& ptr, const osg::Vec3f& position)
+    {
+        const auto it = mEntries.find(ptr.mRef);
+        if (it == mEntries.end())
+            return;
+        Entry& entry = it->second;
+        entry.mPosition = position;
+        const osg::Vec2i cell = getCell(position);
+        if (cell == entry.mCell)
+            return;
+        removeFromCell(entry);
+        entry.mCell = cell;
+        addToCell(entry);
+    }
+
+    void ActorGrid::updatePtr(const MWWorld::ConstPtr& old, const MWWorld::Ptr& updated)
+    {
+        const auto it = mEntries.find(old.mRef);
+        if (it == mEntries.end())
+            return;
+        const osg::Vec3f position = it->second.mPosition;
+        erase(old);
+        insert(updated, position);
+    }
+
+    void ActorGrid::erase(const MWWorld::ConstPtr& ptr)
+    {
+        const auto it = mEntries.find(ptr.mRef);
+        if (it == mEntries.end())
+            return;
+        removeFromCell(it->second);
+        mEntries.erase(it);
+    }
+
+    void ActorGrid::clear()
+    {
+        mEntries.clear();
+        mCells.clear();
+    }
+
+    void ActorGrid::getInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
+    {
+        forEachInRange(position, radius, [&](const Entry& entry) {
+            out.push_back(entry.mPtr);
+            return false;
+        });
+    }
+
+    bool ActorGrid::isAnyInRange(const osg::Vec3f& position, float radius) const
+    {
+        return forEachInRange(position, radius, [](const Entry& /*entry*/) { return true; });
+    }
+
+    osg::Vec2i ActorGrid::getCell(const osg::Vec3f& position) const
+    {
+        return osg::Vec2i(static_cast<int>(std::floor(position.x() / mCellSize)),
+            static_cast<int>(std::floor(position.y() / mCellSize)));
+    }
+
+    void ActorGrid::addToCell(const Entry& entry)
+    {
+        mCells[entry.mCell].push_back(&entry);
+    }
+
+    void ActorGrid::removeFromCell(const Entry& entry)
+    {
+        const auto it = mCells.find(entry.mCell);
+        if (it == mCells.end())
+            return;
+        Cell& cell = it->second;
+        const auto entryIt = std::find(cell.begin(), cell.end(), &entry);
+        if (entryIt != cell.end())
+        {
+            *entryIt = cell.back();
+            cell.pop_back();
+        }
+        if (cell.empty())
+            mCells.erase(it);
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef OPENMW_MWPHYSICS_ACTORGRID_H
+#define OPENMW_MWPHYSICS_ACTORGRID_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <osg/Vec2i>
+#include <osg/Vec3f>
+
+#include "../mwworld/ptr.hpp"
+
+namespace MWPhysics
+{
+    /// @brief Uniform grid over horizontal plane to find actors near a given position without iterating over all of
+    /// them. Positions are set by the owner, grid does not read them from the actors.
+    class ActorGrid
+    {
+    public:
+        explicit ActorGrid(float cellSize);
+
+        std::size_t size() const { return mEntries.size(); }
+
+        void insert(const MWWorld::Ptr& ptr, const osg::Vec3f& position);
+
+        /// Does nothing if ptr is not present.
+        void updatePosition(const MWWorld::ConstPtr& ptr, const osg::Vec3f& position);
+
+        void updatePtr(const MWWorld::ConstPtr& old, const MWWorld::Ptr& updated);
+
+        void erase(const MWWorld::ConstPtr& ptr);
+
+        void clear();
+
+        /// Append to out actors which positions are within radius from given position in unspecified order.
+        void getInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const;
+
+        bool isAnyInRange(const osg::Vec3f& position, float radius) const;
+
+    private:
+        struct Entry
+        {
+            MWWorld::Ptr mPtr;
+            osg::Vec3f mPosition;
+            osg::Vec2i mCell;
+        };
+
+        struct CellHash
+        {
+            std::size_t operator()(const osg::Vec2i& value) const noexcept;
+        };
+
+        using Cell = std::vector<const Entry*>;
+
+        const float mCellSize;
+        std::unordered_map<const MWWorld::LiveCellRefBase*, Entry> mEntries;
+        std::unordered_map<osg::Vec2i, Cell, CellHash> mCells;
+
+        osg::Vec2i getCell(const osg::Vec3f& position) const;
+
+        void addToCell(const Entry& entry);
+
+        void removeFromCell(const Entry& entry);
+
+        template <class Function>
+        bool forEachInRange(const osg::Vec3f& position, float radius, Function&& function) const;
+    };
+}
+
+#endif
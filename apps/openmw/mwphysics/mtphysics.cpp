@@ -2,10 +2,12 @@
 
 #include <cassert>
 #include <functional>
+#include <limits>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <stdexcept>
+#include <unordered_map>
 #include <variant>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
@@ -17,6 +19,7 @@
 #include "components/debug/debuglog.hpp"
 #include "components/misc/convert.hpp"
 #include <components/misc/barrier.hpp>
+#include <components/misc/hash.hpp>
 #include <components/settings/values.hpp>
 
 #include "../mwmechanics/actorutil.hpp"
@@ -341,8 +344,41 @@ namespace MWPhysics
             throw std::runtime_error("Unsupported LockingPolicy: "
                 + std::to_string(static_cast<std::underlying_type_t<LockingPolicy>>(lockingPolicy)));
         }
+
+        // Collision world has to be locked by the caller
+        bool hasLineOfSight(const btCollisionWorld& collisionWorld, const Actor& actor1, const Actor& actor2)
+        {
+            btVector3 pos1 = Misc::Convert::toBullet(actor1.getCollisionObjectPosition()
+                + osg::Vec3f(0, 0, actor1.getHalfExtents().z() * 0.9f)); // eye level
+            btVector3 pos2 = Misc::Convert::toBullet(
+                actor2.getCollisionObjectPosition() + osg::Vec3f(0, 0, actor2.getHalfExtents().z() * 0.9f));
+
+            btCollisionWorld::ClosestRayResultCallback resultCallback(pos1, pos2);
+            resultCallback.m_collisionFilterGroup = CollisionType_AnyPhysical;
+            resultCallback.m_collisionFilterMask = CollisionType_World | CollisionType_HeightMap | CollisionType_Door;
+
+            collisionWorld.rayTest(pos1, pos2, resultCallback);
+
+            return !resultCallback.hasHit();
+        }
     }
 
+    struct PhysicsTaskScheduler::Batch
+    {
+        const std::size_t mSize;
+        const std::function<void(std::size_t)>* const mJob;
+        std::atomic_size_t mNext{ 0 };
+        std::size_t mDone = 0;
+        std::mutex mDoneMutex;
+        std::condition_variable mAllDone;
+
+        explicit Batch(std::size_t size, const std::function<void(std::size_t)>& job)
+            : mSize(size)
+            , mJob(&job)
+        {
+        }
+    };
+
     class PhysicsTaskScheduler::WorkersSync
     {
     public:
@@ -374,14 +410,43 @@ namespace MWPhysics
             mWorkersDone.notify_all();
         }
 
-        template <class F>
-        void runWorker(F&& f) noexcept
+        void postBatch(const std::shared_ptr<Batch>& batch)
+        {
+            const std::lock_guard lock(mHasJobMutex);
+            mBatch = batch;
+            ++mBatchCounter;
+            mHasJob.notify_all();
+        }
+
+        void dropBatch(const std::shared_ptr<Batch>& batch)
+        {
+            const std::lock_guard lock(mHasJobMutex);
+            if (mBatch == batch)
+                mBatch = nullptr;
+        }
+
+        template <class F, class B>
+        void runWorker(F&& f, B&& processBatch) noexcept
         {
             std::size_t lastFrame = 0;
+            std::size_t lastBatch = 0;
             std::unique_lock lock(mHasJobMutex);
             while (!mShouldStop)
             {
-                mHasJob.wait(lock, [&] { return mShouldStop || mFrameCounter != lastFrame; });
+                mHasJob.wait(lock,
+                    [&] { return mShouldStop || mFrameCounter != lastFrame || mBatchCounter != lastBatch; });
+                if (!mShouldStop && mBatchCounter != lastBatch)
+                {
+                    // Batch is processed by the posting thread too so it's fine to pick it up late or not at all
+                    lastBatch = mBatchCounter;
+                    std::shared_ptr<Batch> batch = mBatch;
+                    lock.unlock();
+                    if (batch != nullptr)
+                        processBatch(*batch);
+                    batch = nullptr;
+                    lock.lock();
+                    continue;
+                }
                 lastFrame = mFrameCounter;
                 lock.unlock();
                 f();
@@ -396,6 +461,8 @@ namespace MWPhysics
         std::condition_variable mHasJob;
         bool mShouldStop = false;
         std::size_t mFrameCounter = 0;
+        std::size_t mBatchCounter = 0;
+        std::shared_ptr<Batch> mBatch;
         std::mutex mHasJobMutex;
     };
 
@@ -684,15 +751,115 @@ namespace MWPhysics
         MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
 
         auto req = LOSRequest(actor1, actor2);
-        auto result = std::find(mLOSCache.begin(), mLOSCache.end(), req);
-        if (result == mLOSCache.end())
+        const auto it = mLOSCacheIndex.find(req.mRawActors);
+        if (it == mLOSCacheIndex.end())
         {
             req.mResult = hasLineOfSight(actor1.get(), actor2.get());
+            mLOSCacheIndex.emplace(req.mRawActors, mLOSCache.size());
             mLOSCache.push_back(req);
             return req.mResult;
         }
-        result->mAge = 0;
-        return result->mResult;
+        LOSRequest& cached = mLOSCache[it->second];
+        cached.mAge = 0;
+        return cached.mResult;
+    }
+
+    void PhysicsTaskScheduler::getLinesOfSight(std::span<LOSRequest> requests)
+    {
+        constexpr std::size_t noMiss = std::numeric_limits<std::size_t>::max();
+        // Requests missing in the cache, each distinct pair of actors is present only once
+        std::vector<std::size_t> misses;
+        std::vector<std::size_t> missIndices(requests.size(), noMiss);
+
+        {
+            MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
+            std::unordered_map<std::array<const Actor*, 2>, std::size_t, LOSCacheKeyHash> missesIndex;
+            for (std::size_t i = 0; i < requests.size(); ++i)
+            {
+                LOSRequest& req = requests[i];
+                if (const auto it = mLOSCacheIndex.find(req.mRawActors); it != mLOSCacheIndex.end())
+                {
+                    LOSRequest& cached = mLOSCache[it->second];
+                    cached.mAge = 0;
+                    req.mResult = cached.mResult;
+                    continue;
+                }
+                const auto [missIt, inserted] = missesIndex.emplace(req.mRawActors, misses.size());
+                if (inserted)
+                    misses.push_back(i);
+                missIndices[i] = missIt->second;
+            }
+        }
+
+        if (misses.empty())
+            return;
+
+        // Actors are owned by PhysicsSystem and can't be removed while this function is running
+        runBatch(misses.size(), [&](std::size_t index) {
+            LOSRequest& req = requests[misses[index]];
+            req.mResult = MWPhysics::hasLineOfSight(*mCollisionWorld, *req.mRawActors[0], *req.mRawActors[1]);
+        });
+
+        MaybeExclusiveLock lock(mLOSCacheMutex, mLockingPolicy);
+        for (const std::size_t index : misses)
+        {
+            const LOSRequest& req = requests[index];
+            if (mLOSCacheIndex.emplace(req.mRawActors, mLOSCache.size()).second)
+                mLOSCache.push_back(req);
+        }
+        for (std::size_t i = 0; i < requests.size(); ++i)
+            if (missIndices[i] != noMiss)
+                requests[i].mResult = requests[misses[missIndices[i]]].mResult;
+    }
+
+    void PhysicsTaskScheduler::runBatch(std::size_t count, const std::function<void(std::size_t)>& job) const
+    {
+        if (count == 0)
+            return;
+        const auto batch = std::make_shared<Batch>(count, job);
+        if (mWorkersSync != nullptr && count > 1)
+            mWorkersSync->postBatch(batch);
+        processBatch(*batch);
+        if (mWorkersSync != nullptr)
+            mWorkersSync->dropBatch(batch);
+        std::unique_lock lock(batch->mDoneMutex);
+        batch->mAllDone.wait(lock, [&] { return batch->mDone == batch->mSize; });
+    }
+
+    void PhysicsTaskScheduler::processBatch(Batch& batch) const
+    {
+        std::size_t done = 0;
+        {
+            MaybeLock lock(mCollisionWorldMutex, mLockingPolicy);
+            std::size_t index = 0;
+            while ((index = batch.mNext.fetch_add(1, std::memory_order_relaxed)) < batch.mSize)
+            {
+                (*batch.mJob)(index);
+                ++done;
+            }
+        }
+        if (done == 0)
+            return;
+        const std::lock_guard lock(batch.mDoneMutex);
+        batch.mDone += done;
+        if (batch.mDone == batch.mSize)
+            batch.mAllDone.notify_all();
+    }
+
+    std::size_t PhysicsTaskScheduler::LOSCacheKeyHash::operator()(
+        const std::array<const Actor*, 2>& value) const noexcept
+    {
+        std::size_t seed = 0;
+        Misc::hashCombine(seed, value[0]);
+        Misc::hashCombine(seed, value[1]);
+        return seed;
+    }
+
+    void PhysicsTaskScheduler::rebuildLOSCacheIndex()
+    {
+        mLOSCacheIndex.clear();
+        for (std::size_t i = 0; i < mLOSCache.size(); ++i)
+            mLOSCacheIndex.emplace(mLOSCache[i].mRawActors, i);
     }
 
     void PhysicsTaskScheduler::refreshLOSCache()
@@ -746,10 +913,12 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::worker()
     {
-        mWorkersSync->runWorker([this] {
-            std::shared_lock lock(mSimulationMutex);
-            doSimulation();
-        });
+        mWorkersSync->runWorker(
+            [this] {
+                std::shared_lock lock(mSimulationMutex);
+                doSimulation();
+            },
+            [this](Batch& batch) { processBatch(batch); });
     }
 
     void PhysicsTaskScheduler::updateActorsPositions()
@@ -763,19 +932,8 @@ namespace MWPhysics
 
     bool PhysicsTaskScheduler::hasLineOfSight(const Actor* actor1, const Actor* actor2)
     {
-        btVector3 pos1 = Misc::Convert::toBullet(
-            actor1->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor1->getHalfExtents().z() * 0.9f)); // eye level
-        btVector3 pos2 = Misc::Convert::toBullet(
-            actor2->getCollisionObjectPosition() + osg::Vec3f(0, 0, actor2->getHalfExtents().z() * 0.9f));
-
-        btCollisionWorld::ClosestRayResultCallback resultCallback(pos1, pos2);
-        resultCallback.m_collisionFilterGroup = CollisionType_AnyPhysical;
-        resultCallback.m_collisionFilterMask = CollisionType_World | CollisionType_HeightMap | CollisionType_Door;
-
         MaybeLock lockColWorld(mCollisionWorldMutex, mLockingPolicy);
-        mCollisionWorld->rayTest(pos1, pos2, resultCallback);
-
-        return !resultCallback.hasHit();
+        return MWPhysics::hasLineOfSight(*mCollisionWorld, *actor1, *actor2);
     }
 
     void PhysicsTaskScheduler::doSimulation()
@@ -866,6 +1024,7 @@ namespace MWPhysics
             mLOSCache.erase(
                 std::remove_if(mLOSCache.begin(), mLOSCache.end(), [](const LOSRequest& req) { return req.mStale; }),
                 mLOSCache.end());
+            rebuildLOSCacheIndex();
         }
         mTimeEnd = mTimer->tick();
         if (mWorkersSync != nullptr)
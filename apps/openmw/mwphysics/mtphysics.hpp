@@ -1,13 +1,17 @@
 #ifndef OPENMW_MWPHYSICS_MTPHYSICS_H
 #define OPENMW_MWPHYSICS_MTPHYSICS_H
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <set>
 #include <shared_mutex>
+#include <span>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
@@ -67,6 +71,11 @@ namespace MWPhysics
         void removeCollisionObject(btCollisionObject* collisionObject);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// @brief set mResult for each request, each distinct request missing in the cache is performed once
+        void getLinesOfSight(std::span<LOSRequest> requests);
+        /// @brief call job for each index in [0, count) using calling thread and idle physics threads
+        /// @note collision world is locked while job is called, job must not use thread safe wrappers
+        void runBatch(std::size_t count, const std::function<void(std::size_t)>& job) const;
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -74,12 +83,20 @@ namespace MWPhysics
 
     private:
         class WorkersSync;
+        struct Batch;
+
+        struct LOSCacheKeyHash
+        {
+            std::size_t operator()(const std::array<const Actor*, 2>& value) const noexcept;
+        };
 
         void doSimulation();
         void worker();
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
         void refreshLOSCache();
+        void rebuildLOSCacheIndex();
+        void processBatch(Batch& batch) const;
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
@@ -101,6 +118,7 @@ namespace MWPhysics
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
         std::vector<LOSRequest> mLOSCache;
+        std::unordered_map<std::array<const Actor*, 2>, std::size_t, LOSCacheKeyHash> mLOSCacheIndex;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
         // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
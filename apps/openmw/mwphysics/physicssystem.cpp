@@ -58,6 +58,9 @@
 
 namespace
 {
+    // Actors queries usually have radius around a few thousands units
+    constexpr float actorGridCellSize = 2048;
+
     void handleJump(const MWWorld::Ptr& ptr)
     {
         if (!ptr.getClass().isActor())
@@ -98,6 +101,7 @@ namespace MWPhysics
               resourceSystem->getSceneManager(), resourceSystem->getNifFileManager(),
               Settings::cells().mCacheExpiryDelay))
         , mResourceSystem(resourceSystem)
+        , mActorGrid(actorGridCellSize)
         , mDebugDrawEnabled(false)
         , mTimeAccum(0.0f)
         , mProjectileId(0)
@@ -145,6 +149,7 @@ namespace MWPhysics
         mHeightFields.clear();
         mObjects.clear();
         mActors.clear();
+        mActorGrid.clear();
         mProjectiles.clear();
     }
 
@@ -290,6 +295,40 @@ namespace MWPhysics
         return mTaskScheduler->getLineOfSight(it1->second, it2->second);
     }
 
+    std::vector<bool> PhysicsSystem::getLinesOfSight(std::span<const LineOfSightRequest> requests) const
+    {
+        std::vector<bool> result(requests.size(), false);
+        std::vector<LOSRequest> losRequests;
+        std::vector<std::size_t> indices;
+        losRequests.reserve(requests.size());
+        indices.reserve(requests.size());
+
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            const LineOfSightRequest& request = requests[i];
+            if (request.mActor == request.mTarget)
+            {
+                result[i] = true;
+                continue;
+            }
+
+            const auto it1 = mActors.find(request.mActor.mRef);
+            const auto it2 = mActors.find(request.mTarget.mRef);
+            if (it1 == mActors.end() || it2 == mActors.end())
+                continue;
+
+            losRequests.emplace_back(it1->second, it2->second);
+            indices.push_back(i);
+        }
+
+        mTaskScheduler->getLinesOfSight(losRequests);
+
+        for (std::size_t i = 0; i < losRequests.size(); ++i)
+            result[indices[i]] = losRequests[i].mResult;
+
+        return result;
+    }
+
     bool PhysicsSystem::isOnGround(const MWWorld::Ptr& actor)
     {
         Actor* physactor = getActor(actor);
@@ -450,6 +489,7 @@ namespace MWPhysics
         else if (auto foundActor = mActors.find(ptr.mRef); foundActor != mActors.end())
         {
             mActors.erase(foundActor);
+            mActorGrid.erase(ptr);
         }
     }
 
@@ -465,7 +505,10 @@ namespace MWPhysics
         if (auto foundObject = mObjects.find(old.mRef); foundObject != mObjects.end())
             foundObject->second->updatePtr(updated);
         else if (auto foundActor = mActors.find(old.mRef); foundActor != mActors.end())
+        {
             foundActor->second->updatePtr(updated);
+            mActorGrid.updatePtr(old, updated);
+        }
 
         for (auto& [_, actor] : mActors)
         {
@@ -558,6 +601,21 @@ namespace MWPhysics
         }
     }
 
+    void PhysicsSystem::updateActorGridPosition(const MWWorld::ConstPtr& ptr, const osg::Vec3f& position)
+    {
+        mActorGrid.updatePosition(ptr, position);
+    }
+
+    void PhysicsSystem::getActorsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
+    {
+        mActorGrid.getInRange(position, radius, out);
+    }
+
+    bool PhysicsSystem::isAnyActorInRange(const osg::Vec3f& position, float radius) const
+    {
+        return mActorGrid.isAnyInRange(position, radius);
+    }
+
     void PhysicsSystem::addActor(const MWWorld::Ptr& ptr, VFS::Path::NormalizedView mesh)
     {
         const VFS::Path::Normalized animationMesh
@@ -584,6 +642,7 @@ namespace MWPhysics
             ptr, shape, mTaskScheduler.get(), canWaterWalk, Settings::game().mActorCollisionShapeType);
 
         mActors.emplace(ptr.mRef, std::move(actor));
+        mActorGrid.insert(ptr, ptr.getRefData().getPosition().asVec3());
     }
 
     int PhysicsSystem::addProjectile(
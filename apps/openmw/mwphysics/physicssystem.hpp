@@ -20,6 +20,7 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include "actorgrid.hpp"
 #include "collisiontype.hpp"
 #include "raycasting.hpp"
 
@@ -186,6 +187,15 @@ namespace MWPhysics
         void updateRotation(const MWWorld::Ptr& ptr, osg::Quat rotate);
         void updatePosition(const MWWorld::Ptr& ptr);
 
+        /// Keep actors grid in sync with the actor position. Should be called on each actor position change.
+        /// @note Actors grid contains only actors added with addActor.
+        void updateActorGridPosition(const MWWorld::ConstPtr& ptr, const osg::Vec3f& position);
+
+        /// Append to out actors in the scene within radius from given position in unspecified order.
+        void getActorsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const;
+
+        bool isAnyActorInRange(const osg::Vec3f& position, float radius) const;
+
         void addHeightField(const float* heights, int x, int y, int size, int verts, float minH, float maxH,
             const osg::Object* holdObject);
 
@@ -222,6 +232,8 @@ namespace MWPhysics
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
+        std::vector<bool> getLinesOfSight(std::span<const LineOfSightRequest> requests) const override;
+
         bool isOnGround(const MWWorld::Ptr& actor);
 
         bool canMoveToWaterSurface(const MWWorld::ConstPtr& actor, const float waterlevel);
@@ -310,6 +322,8 @@ namespace MWPhysics
 
         ActorMap mActors;
 
+        ActorGrid mActorGrid;
+
         using ProjectileMap = std::map<int, std::shared_ptr<Projectile>>;
         ProjectileMap mProjectiles;
 
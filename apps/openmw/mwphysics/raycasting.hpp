@@ -1,6 +1,9 @@
 #ifndef OPENMW_MWPHYSICS_RAYCASTING_H
 #define OPENMW_MWPHYSICS_RAYCASTING_H
 
+#include <span>
+#include <vector>
+
 #include <osg/Vec3f>
 
 #include "../mwworld/ptr.hpp"
@@ -18,6 +21,12 @@ namespace MWPhysics
         MWWorld::Ptr mHitObject;
     };
 
+    struct LineOfSightRequest
+    {
+        MWWorld::ConstPtr mActor;
+        MWWorld::ConstPtr mTarget;
+    };
+
     class RayCastingInterface
     {
     public:
@@ -39,6 +48,10 @@ namespace MWPhysics
 
         /// Return true if actor1 can see actor2.
         virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
+
+        /// Perform all requests at once. Equal requests are performed only once.
+        /// @return true for each request in the same order if actor can see target.
+        virtual std::vector<bool> getLinesOfSight(std::span<const LineOfSightRequest> requests) const = 0;
     };
 }
 
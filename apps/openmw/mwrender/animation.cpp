@@ -645,9 +645,9 @@ namespace MWRender
         path.replace(extensionStart, path.size() - extensionStart, "/");
 
         constexpr VFS::Path::ExtensionView kf("kf");
-        for (const VFS::Path::Normalized& name : mResourceSystem->getVFS()->getRecursiveDirectoryIterator(path))
+        for (VFS::Path::NormalizedView name : mResourceSystem->getVFS()->getRecursiveDirectoryIterator(path))
             if (name.extension() == kf)
-                addSingleAnimSource(name, baseModel);
+                addSingleAnimSource(std::string(name.value()), baseModel);
     }
 
     void Animation::addAnimSource(std::string_view model, const std::string& baseModel)
@@ -1497,9 +1497,9 @@ namespace MWRender
         }
         animationPath.replace(animationPath.size() - 4, 4, "/");
 
-        for (const VFS::Path::Normalized& name : resourceSystem->getVFS()->getRecursiveDirectoryIterator(animationPath))
+        for (VFS::Path::NormalizedView name : resourceSystem->getVFS()->getRecursiveDirectoryIterator(animationPath))
         {
-            if (Misc::getFileExtension(name) == "nif")
+            if (Misc::getFileExtension(name.value()) == "nif")
                 loadBonesFromFile(node, name, resourceSystem);
         }
     }
@@ -1640,6 +1640,13 @@ namespace MWRender
             mInsert->addChild(mObjectRoot);
         }
 
+        if (mSkeleton)
+            mSkeleton->setLodSettings(SceneUtil::AnimationLodSettings{
+                .mEnabled = Settings::game().mAnimationLod,
+                .mHalfRateSize = Settings::game().mAnimationLodHalfRateSize,
+                .mQuarterRateSize = Settings::game().mAnimationLodQuarterRateSize,
+            });
+
         // osgAnimation formats with skeletons should have their nodemap be bone instances
         // FIXME: better way to detect osgAnimation here instead of relying on extension?
         mRequiresBoneMap = mSkeleton != nullptr && !Misc::StringUtils::ciEndsWith(model, ".nif");
@@ -339,6 +339,8 @@ namespace MWRender
 
         osg::Group* getObjectRoot();
 
+        const SceneUtil::Skeleton* getSkeleton() const { return mSkeleton; }
+
         /**
          * @brief Add an effect mesh attached to a bone or the insert scene node
          * @param model
@@ -127,7 +127,8 @@ namespace MWRender
     public:
         CreateMapWorkItem(int width, int height, int minX, int minY, int maxX, int maxY, int cellSize,
             const MWWorld::Store<ESM::Land>& landStore, osg::ref_ptr<osg::Image> colorLut)
-            : mWidth(width)
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::Map)
+            , mWidth(width)
             , mHeight(height)
             , mMinX(minX)
             , mMinY(minY)
@@ -233,7 +234,8 @@ namespace MWRender
         std::vector<char> mImageData;
 
         explicit WritePng(osg::ref_ptr<const osg::Image> overlayImage)
-            : mOverlayImage(std::move(overlayImage))
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::Map)
+            , mOverlayImage(std::move(overlayImage))
         {
         }
 
@@ -637,6 +639,6 @@ namespace MWRender
             return;
         // Use deep copy to avoid any sychronization
         mWritePng = new WritePng(new osg::Image(*mOverlayImage, osg::CopyOp::DEEP_COPY_ALL));
-        mWorkQueue->addWorkItem(mWritePng, /*front=*/true);
+        mWorkQueue->addWorkItem(mWritePng, SceneUtil::WorkPriority::High);
     }
 }
@@ -84,7 +84,8 @@ namespace MWRender
             const osg::ref_ptr<osg::StateSet>& groupStateSet, const osg::ref_ptr<osg::StateSet>& debugDrawStateSet,
             const DetourNavigator::Settings& settings, const std::map<DetourNavigator::TilePosition, Tile>& tiles,
             Settings::NavMeshRenderMode mode)
-            : mId(id)
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::NavMesh)
+            , mId(id)
             , mVersion(version)
             , mNavMesh(std::move(navMesh))
             , mGroupStateSet(groupStateSet)
@@ -184,7 +185,8 @@ namespace MWRender
         osg::ref_ptr<NavMesh::CreateNavMeshTileGroups> mWorkItem;
 
         explicit DeallocateCreateNavMeshTileGroups(osg::ref_ptr<NavMesh::CreateNavMeshTileGroups>&& workItem)
-            : mWorkItem(std::move(workItem))
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::Unref)
+            , mWorkItem(std::move(workItem))
         {
         }
     };
@@ -206,7 +208,7 @@ namespace MWRender
         if (mEnabled)
             disable();
         for (const auto& workItem : mWorkItems)
-            workItem->abort();
+            workItem->cancel();
     }
 
     bool NavMesh::toggle()
@@ -319,7 +321,7 @@ namespace MWRender
     void NavMesh::reset()
     {
         for (auto& workItem : mWorkItems)
-            workItem->abort();
+            workItem->cancel();
         mWorkItems.clear();
         for (auto& [position, tile] : mTiles)
             mRootNode->removeChild(tile.mGroup);
@@ -1,13 +1,17 @@
 #include "objects.hpp"
 
 #include <osg/Group>
+#include <osg/Stats>
 #include <osg/UserDataContainer>
 
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
+#include <components/sceneutil/skeleton.hpp>
 #include <components/sceneutil/unrefqueue.hpp>
 
+#include <array>
+
 #include "../mwworld/class.hpp"
 #include "../mwworld/ptr.hpp"
 
@@ -251,4 +255,22 @@ namespace MWRender
         return nullptr;
     }
 
+    void Objects::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        std::array<std::size_t, SceneUtil::animationLodCount> lods{};
+        std::size_t skipped = 0;
+        for (const auto& [ref, animation] : mObjects)
+        {
+            const SceneUtil::Skeleton* const skeleton = animation->getSkeleton();
+            if (skeleton == nullptr)
+                continue;
+            ++lods[static_cast<std::size_t>(skeleton->getLod())];
+            if (skeleton->isUpdateSkipped())
+                ++skipped;
+        }
+        stats.setAttribute(frameNumber, "Animation Full", static_cast<double>(lods[0]));
+        stats.setAttribute(frameNumber, "Animation Half", static_cast<double>(lods[1]));
+        stats.setAttribute(frameNumber, "Animation Quarter", static_cast<double>(lods[2]));
+        stats.setAttribute(frameNumber, "Animation Skipped", static_cast<double>(skipped));
+    }
 }
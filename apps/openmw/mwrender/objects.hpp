@@ -12,6 +12,7 @@
 namespace osg
 {
     class Group;
+    class Stats;
 }
 
 namespace Resource
@@ -89,6 +90,8 @@ namespace MWRender
         /// Updates containing cell for object rendering data
         void updatePtr(const MWWorld::Ptr& old, const MWWorld::Ptr& cur);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
     private:
         void operator=(const Objects&);
         Objects(const Objects&);
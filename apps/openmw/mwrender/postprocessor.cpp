@@ -250,9 +250,9 @@ namespace MWRender
 
     void PostProcessor::populateTechniqueFiles()
     {
-        for (const auto& path : mVFS->getRecursiveDirectoryIterator(Fx::Technique::sSubdir))
+        for (VFS::Path::NormalizedView path : mVFS->getRecursiveDirectoryIterator(Fx::Technique::sSubdir))
         {
-            std::string_view fileExt = Misc::getFileExtension(path);
+            std::string_view fileExt = Misc::getFileExtension(path.value());
             if (path.parent().parent().empty() && fileExt == Fx::Technique::sExt)
             {
                 mTechniqueFiles.emplace(path);
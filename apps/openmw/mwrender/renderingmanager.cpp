@@ -32,6 +32,7 @@
 #include <components/settings/values.hpp>
 
 #include <components/sceneutil/cullsafeboundsvisitor.hpp>
+#include <components/sceneutil/deformationqueue.hpp>
 #include <components/sceneutil/depth.hpp>
 #include <components/sceneutil/lightmanager.hpp>
 #include <components/sceneutil/positionattitudetransform.hpp>
@@ -90,7 +91,8 @@ namespace MWRender
     {
     public:
         PreloadCommonAssetsWorkItem(Resource::ResourceSystem* resourceSystem)
-            : mResourceSystem(resourceSystem)
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::Preload)
+            , mResourceSystem(resourceSystem)
         {
         }
 
@@ -186,6 +188,9 @@ namespace MWRender
             indoorShadowCastingTraversalMask, Mask_Terrain | Mask_Object | Mask_Static, Settings::shadows(),
             mResourceSystem->getSceneManager()->getShaderManager());
 
+        mDeformationQueue = std::make_unique<SceneUtil::DeformationQueue>(
+            static_cast<std::size_t>(Settings::game().mSkinningThreads));
+
         Shader::ShaderManager::DefineMap globalDefines = Shader::getDefaultDefines();
         Shader::ShaderManager::DefineMap shadowDefines = mShadowManager->getShadowDefines(Settings::shadows());
         Shader::ShaderManager::DefineMap lightDefines = sceneRoot->getLightDefines();
@@ -1273,6 +1278,7 @@ namespace MWRender
         if (stats->collectStats("resource"))
         {
             mTerrain->reportStats(frameNumber, stats);
+            mObjects->reportStats(frameNumber, *stats);
         }
     }
 
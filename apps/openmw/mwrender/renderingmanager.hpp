@@ -60,6 +60,7 @@ namespace Fallback
 namespace SceneUtil
 {
     class ShadowManager;
+    class DeformationQueue;
     class WorkQueue;
     class LightManager;
     class UnrefQueue;
@@ -340,6 +341,7 @@ namespace MWRender
         std::unique_ptr<ScreenshotManager> mScreenshotManager;
         std::unique_ptr<EffectManager> mEffectManager;
         std::unique_ptr<SceneUtil::ShadowManager> mShadowManager;
+        std::unique_ptr<SceneUtil::DeformationQueue> mDeformationQueue;
         osg::ref_ptr<PostProcessor> mPostProcessor;
         osg::ref_ptr<NpcAnimation> mPlayerAnimation;
         osg::ref_ptr<SceneUtil::PositionAttitudeTransform> mPlayerNode;
@@ -70,7 +70,8 @@ namespace MWWorld
         explicit PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager,
             Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager,
             Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances)
-            : mIsExterior(cell->getCell()->isExterior())
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::Preload)
+            , mIsExterior(cell->getCell()->isExterior())
             , mCellLocation(cell->getCell()->getExteriorCellLocation())
             , mCellId(cell->getCell()->getId())
             , mSceneManager(sceneManager)
@@ -171,7 +172,8 @@ namespace MWWorld
     public:
         explicit TerrainPreloadItem(const std::vector<osg::ref_ptr<Terrain::View>>& views, Terrain::World* world,
             std::span<const PositionCellGrid> preloadPositions)
-            : mAbort(false)
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::TerrainPreload)
+            , mAbort(false)
             , mTerrainViews(views)
             , mWorld(world)
             , mPreloadPositions(preloadPositions.begin(), preloadPositions.end())
@@ -236,7 +238,7 @@ namespace MWWorld
         clearAllTasks();
     }
 
-    void CellPreloader::preload(CellStore& cell, double timestamp)
+    void CellPreloader::preload(CellStore& cell, double timestamp, SceneUtil::WorkPriority priority)
     {
         if (!mWorkQueue)
         {
@@ -274,7 +276,7 @@ namespace MWWorld
 
             if (oldestTimestamp + threshold < timestamp)
             {
-                oldestCell->second.mWorkItem->abort();
+                oldestCell->second.mWorkItem->cancel();
                 mPreloadCells.erase(oldestCell);
                 ++mEvicted;
             }
@@ -284,7 +286,7 @@ namespace MWWorld
 
         osg::ref_ptr<PreloadItem> item(new PreloadItem(&cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
             mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
-        mWorkQueue->addWorkItem(item);
+        mWorkQueue->addWorkItem(item, priority);
 
         mPreloadCells.emplace(&cell, PreloadEntry(timestamp, item));
         ++mAdded;
@@ -297,7 +299,7 @@ namespace MWWorld
         {
             if (found->second.mWorkItem)
             {
-                found->second.mWorkItem->abort();
+                found->second.mWorkItem->cancel();
                 found->second.mWorkItem = nullptr;
             }
 
@@ -312,7 +314,7 @@ namespace MWWorld
         {
             if (it->second.mWorkItem)
             {
-                it->second.mWorkItem->abort();
+                it->second.mWorkItem->cancel();
                 it->second.mWorkItem = nullptr;
             }
 
@@ -328,7 +330,7 @@ namespace MWWorld
             {
                 if (it->second.mWorkItem)
                 {
-                    it->second.mWorkItem->abort();
+                    it->second.mWorkItem->cancel();
                     it->second.mWorkItem = nullptr;
                 }
                 mPreloadCells.erase(it++);
@@ -343,7 +345,7 @@ namespace MWWorld
             // the resource cache is cleared from the worker thread so that we're not holding up the main thread with
             // delete operations
             mUpdateCacheItem = new UpdateCacheItem(mResourceSystem, timestamp);
-            mWorkQueue->addWorkItem(mUpdateCacheItem, true);
+            mWorkQueue->addWorkItem(mUpdateCacheItem, SceneUtil::WorkPriority::High);
             mLastResourceCacheUpdate = timestamp;
         }
 
@@ -381,7 +383,7 @@ namespace MWWorld
             return;
         if (mTerrainPreloadItem && !mTerrainPreloadItem->isDone())
         {
-            mTerrainPreloadItem->abort();
+            mTerrainPreloadItem->cancel();
             mTerrainPreloadItem->waitTillDone();
         }
         setTerrainPreloadPositions({});
@@ -436,7 +438,7 @@ namespace MWWorld
     {
         if (mTerrainPreloadItem)
         {
-            mTerrainPreloadItem->abort();
+            mTerrainPreloadItem->cancel();
             mTerrainPreloadItem->waitTillDone();
             mTerrainPreloadItem = nullptr;
         }
@@ -448,7 +450,7 @@ namespace MWWorld
         }
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
-            it->second.mWorkItem->abort();
+            it->second.mWorkItem->cancel();
 
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
             it->second.mWorkItem->waitTillDone();
@@ -51,7 +51,9 @@ namespace MWWorld
 
         /// Ask a background thread to preload rendering meshes and collision shapes for objects in this cell.
         /// @note The cell itself must be in State_Loaded or State_Preloaded.
-        void preload(MWWorld::CellStore& cell, double timestamp);
+        /// @param priority Use High for cells the player is about to enter and Low for speculative preloading.
+        void preload(MWWorld::CellStore& cell, double timestamp,
+            SceneUtil::WorkPriority priority = SceneUtil::WorkPriority::Normal);
 
         void notifyLoaded(MWWorld::CellStore* cell);
 
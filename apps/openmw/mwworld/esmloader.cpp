@@ -1,8 +1,10 @@
 #include "esmloader.hpp"
 #include "esmstore.hpp"
 
+#include <chrono>
 #include <fstream>
 
+#include <components/debug/debuglog.hpp>
 #include <components/esm/format.hpp>
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/readerscache.hpp>
@@ -30,6 +32,7 @@ namespace MWWorld
 
     void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
     {
+        const auto start = std::chrono::steady_clock::now();
 
         auto stream = Files::openBinaryInputFileStream(filepath);
         const ESM::Format format = ESM::readFormat(*stream);
@@ -75,6 +78,12 @@ namespace MWWorld
             }
         }
         mNameToIndex[Misc::StringUtils::lowerCase(Files::pathToUnicodeString(filepath.filename()))] = index;
+
+        Log(Debug::Info) << "Loaded content file " << filepath.filename() << " in "
+                         << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count()
+                         << " ms";
     }
 
 } /* namespace MWWorld */
@@ -911,7 +911,7 @@ namespace MWWorld
     Scene::~Scene()
     {
         for (const osg::ref_ptr<SceneUtil::WorkItem>& v : mWorkItems)
-            v->abort();
+            v->cancel();
 
         for (const osg::ref_ptr<SceneUtil::WorkItem>& v : mWorkItems)
             v->waitTillDone();
@@ -1087,7 +1087,8 @@ namespace MWWorld
     {
     public:
         explicit PreloadMeshItem(VFS::Path::NormalizedView mesh, Resource::SceneManager* sceneManager)
-            : mMesh(mesh)
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::Preload)
+            , mMesh(mesh)
             , mSceneManager(sceneManager)
         {
         }
@@ -1190,7 +1191,8 @@ namespace MWWorld
             {
                 try
                 {
-                    preloadCellWithSurroundings(mWorld.getWorldModel().getCell(door.getCellRef().getDestCell()));
+                    preloadCellWithSurroundings(mWorld.getWorldModel().getCell(door.getCellRef().getDestCell()),
+                        SceneUtil::WorkPriority::Low);
                 }
                 catch (const std::exception& e)
                 {
@@ -1233,16 +1235,16 @@ namespace MWWorld
                 float loadDist = cellSize / 2 + cellSize - mCellLoadingThreshold + mPreloadDistance;
 
                 if (dist < loadDist)
-                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex));
+                    preloadCell(mWorld.getWorldModel().getExterior(cellIndex), SceneUtil::WorkPriority::High);
             }
         }
     }
 
-    void Scene::preloadCellWithSurroundings(CellStore& cell)
+    void Scene::preloadCellWithSurroundings(CellStore& cell, SceneUtil::WorkPriority priority)
     {
         if (!cell.isExterior())
         {
-            mPreloader->preload(cell, mRendering.getReferenceTime());
+            mPreloader->preload(cell, mRendering.getReferenceTime(), priority);
             return;
         }
 
@@ -1272,12 +1274,12 @@ namespace MWWorld
         const ESM::RefId worldspace = cell.getCell()->getWorldSpace();
         for (const auto& [x, y] : cells)
             mPreloader->preload(mWorld.getWorldModel().getExterior(ESM::ExteriorCellLocation(x, y, worldspace)),
-                mRendering.getReferenceTime());
+                mRendering.getReferenceTime(), priority);
     }
 
-    void Scene::preloadCell(CellStore& cell)
+    void Scene::preloadCell(CellStore& cell, SceneUtil::WorkPriority priority)
     {
-        mPreloader->preload(cell, mRendering.getReferenceTime());
+        mPreloader->preload(cell, mRendering.getReferenceTime(), priority);
     }
 
     void Scene::preloadTerrain(const osg::Vec3f& pos, ESM::RefId worldspace, bool sync)
@@ -1349,13 +1351,14 @@ namespace MWWorld
         for (ESM::Transport::Dest& dest : listVisitor.mList)
         {
             if (!dest.mCellName.empty())
-                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName));
+                preloadCell(mWorld.getWorldModel().getInterior(dest.mCellName), SceneUtil::WorkPriority::Low);
             else
             {
                 osg::Vec3f pos = dest.mPos.asVec3();
                 const ESM::ExteriorCellLocation cellIndex
                     = ESM::positionToExteriorCellLocation(pos.x(), pos.y(), extWorldspace);
-                preloadCellWithSurroundings(mWorld.getWorldModel().getExterior(cellIndex));
+                preloadCellWithSurroundings(
+                    mWorld.getWorldModel().getExterior(cellIndex), SceneUtil::WorkPriority::Low);
                 exteriorPositions.push_back(PositionCellGrid{ pos, gridCenterToBounds(getNewGridCenter(pos)) });
             }
         }
@@ -8,6 +8,7 @@
 #include "positioncellgrid.hpp"
 #include "ptr.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <set>
@@ -57,6 +58,7 @@ namespace MWPhysics
 namespace SceneUtil
 {
     class WorkItem;
+    enum class WorkPriority : std::uint8_t;
 }
 
 namespace MWWorld
@@ -129,8 +131,8 @@ namespace MWWorld
         void preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos);
         void preloadFastTravelDestinations(
             const osg::Vec3f& playerPos, std::vector<PositionCellGrid>& exteriorPositions);
-        void preloadCellWithSurroundings(MWWorld::CellStore& cell);
-        void preloadCell(MWWorld::CellStore& cell);
+        void preloadCellWithSurroundings(MWWorld::CellStore& cell, SceneUtil::WorkPriority priority);
+        void preloadCell(MWWorld::CellStore& cell, SceneUtil::WorkPriority priority);
         void preloadTerrain(const osg::Vec3f& pos, ESM::RefId worldspace, bool sync = false);
 
         osg::Vec4i gridCenterToBounds(const osg::Vec2i& centerCell) const;
@@ -1083,6 +1083,7 @@ namespace MWWorld
         if (haveToMove && newPtr.getRefData().getBaseNode())
         {
             mRendering->moveObject(newPtr, position);
+            mPhysics->updateActorGridPosition(newPtr, position);
             if (movePhysics)
             {
                 mPhysics->updatePosition(newPtr);
@@ -2377,6 +2378,16 @@ namespace MWWorld
         return mPhysics->isObjectCollidingWith(object, MWPhysics::ScriptedCollisionType_Actor);
     }
 
+    void World::getActorsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& actors) const
+    {
+        mPhysics->getActorsInRange(position, radius, actors);
+    }
+
+    bool World::isAnyActorInRange(const osg::Vec3f& position, float radius) const
+    {
+        return mPhysics->isAnyActorInRange(position, radius);
+    }
+
     void World::hurtStandingActors(const ConstPtr& object, float healthPerSecond)
     {
         if (MWBase::Environment::get().getWindowManager()->isGuiMode())
@@ -2527,6 +2538,35 @@ namespace MWWorld
         return mPhysics->getLineOfSight(actor, targetActor);
     }
 
+    std::vector<bool> World::getLOS(std::span<const MWPhysics::LineOfSightRequest> requests)
+    {
+        const auto canHaveLOS = [](const MWWorld::ConstPtr& ptr) {
+            // cannot get LOS unless both NPC's are enabled and in active cell
+            return ptr.getRefData().isEnabled() && ptr.getRefData().getBaseNode() != nullptr;
+        };
+
+        std::vector<bool> result(requests.size(), false);
+        std::vector<MWPhysics::LineOfSightRequest> physicsRequests;
+        std::vector<std::size_t> indices;
+        physicsRequests.reserve(requests.size());
+        indices.reserve(requests.size());
+
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            if (!canHaveLOS(requests[i].mActor) || !canHaveLOS(requests[i].mTarget))
+                continue;
+            physicsRequests.push_back(requests[i]);
+            indices.push_back(i);
+        }
+
+        const std::vector<bool> physicsResult = mPhysics->getLinesOfSight(physicsRequests);
+
+        for (std::size_t i = 0; i < indices.size(); ++i)
+            result[indices[i]] = physicsResult[i];
+
+        return result;
+    }
+
     float World::getDistToNearestRayHit(const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater)
     {
         osg::Vec3f to(dir);
@@ -486,6 +486,9 @@ namespace MWWorld
             const MWWorld::ConstPtr& object) override; ///< @return true if the player is colliding with \a object
         bool getActorCollidingWith(
             const MWWorld::ConstPtr& object) override; ///< @return true if any actor is colliding with \a object
+        void getActorsInRange(
+            const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& actors) const override;
+        bool isAnyActorInRange(const osg::Vec3f& position, float radius) const override;
         void hurtStandingActors(const MWWorld::ConstPtr& object, float dmgPerSecond) override;
         ///< Apply a health difference to any actors standing on \a object.
         /// To hurt actors, healthPerSecond should be a positive value. For a negative value, actors will be healed.
@@ -503,6 +506,9 @@ namespace MWWorld
         bool getLOS(const MWWorld::ConstPtr& actor, const MWWorld::ConstPtr& targetActor) override;
         ///< get Line of Sight (morrowind stupid implementation)
 
+        std::vector<bool> getLOS(std::span<const MWPhysics::LineOfSightRequest> requests) override;
+        ///< get Line of Sight for all requests at once, cheaper than doing it one by one
+
         float getDistToNearestRayHit(
             const osg::Vec3f& from, const osg::Vec3f& dir, float maxDist, bool includeWater = false) override;
 
@@ -0,0 +1,110 @@
+#include "apps/openmw/mwphysics/actorgrid.hpp"
+#include "apps/openmw/mwworld/livecellref.hpp"
+#include "apps/openmw/mwworld/ptr.hpp"
+
+#include <components/esm3/loadnpc.hpp>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <limits>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct MWPhysicsActorGridTest : Test
+        {
+            const float mCellSize = 100;
+            ESM::NPC mNpc;
+            std::deque<MWWorld::LiveCellRef<ESM::NPC>> mRefs;
+            ActorGrid mGrid{ mCellSize };
+
+            MWPhysicsActorGridTest() { mNpc.blank(); }
+
+            MWWorld::Ptr makePtr()
+            {
+                ESM::CellRef cellRef;
+                cellRef.blank();
+                return MWWorld::Ptr(&mRefs.emplace_back(cellRef, &mNpc));
+            }
+        };
+
+        TEST_F(MWPhysicsActorGridTest, getInRangeShouldReturnNothingForEmptyGrid)
+        {
+            std::vector<MWWorld::Ptr> result;
+            mGrid.getInRange(osg::Vec3f(0, 0, 0), 1000, result);
+            EXPECT_THAT(result, IsEmpty());
+        }
+
+        TEST_F(MWPhysicsActorGridTest, getInRangeShouldReturnActorsWithinRadius)
+        {
+            const MWWorld::Ptr near = makePtr();
+            const MWWorld::Ptr neighbourCell = makePtr();
+            const MWWorld::Ptr far = makePtr();
+            const MWWorld::Ptr above = makePtr();
+            mGrid.insert(near, osg::Vec3f(10, 10, 0));
+            mGrid.insert(neighbourCell, osg::Vec3f(-40, 10, 0));
+            mGrid.insert(far, osg::Vec3f(500, 10, 0));
+            mGrid.insert(above, osg::Vec3f(10, 10, 200));
+            std::vector<MWWorld::Ptr> result;
+            mGrid.getInRange(osg::Vec3f(0, 0, 0), 60, result);
+            EXPECT_THAT(result, UnorderedElementsAre(near, neighbourCell));
+        }
+
+        TEST_F(MWPhysicsActorGridTest, getInRangeShouldUseUpdatedPosition)
+        {
+            const MWWorld::Ptr ptr = makePtr();
+            mGrid.insert(ptr, osg::Vec3f(10, 10, 0));
+            mGrid.updatePosition(ptr, osg::Vec3f(1010, 10, 0));
+            std::vector<MWWorld::Ptr> result;
+            mGrid.getInRange(osg::Vec3f(0, 0, 0), 60, result);
+            EXPECT_THAT(result, IsEmpty());
+            mGrid.getInRange(osg::Vec3f(1000, 0, 0), 60, result);
+            EXPECT_THAT(result, ElementsAre(ptr));
+        }
+
+        TEST_F(MWPhysicsActorGridTest, getInRangeShouldNotReturnErasedActors)
+        {
+            const MWWorld::Ptr ptr = makePtr();
+            const MWWorld::Ptr other = makePtr();
+            mGrid.insert(ptr, osg::Vec3f(10, 10, 0));
+            mGrid.insert(other, osg::Vec3f(20, 10, 0));
+            mGrid.erase(ptr);
+            std::vector<MWWorld::Ptr> result;
+            mGrid.getInRange(osg::Vec3f(0, 0, 0), 60, result);
+            EXPECT_THAT(result, ElementsAre(other));
+            EXPECT_EQ(mGrid.size(), 1);
+        }
+
+        TEST_F(MWPhysicsActorGridTest, getInRangeShouldReturnUpdatedPtr)
+        {
+            const MWWorld::Ptr ptr = makePtr();
+            const MWWorld::Ptr updated = makePtr();
+            mGrid.insert(ptr, osg::Vec3f(10, 10, 0));
+            mGrid.updatePtr(ptr, updated);
+            std::vector<MWWorld::Ptr> result;
+            mGrid.getInRange(osg::Vec3f(0, 0, 0), 60, result);
+            EXPECT_THAT(result, ElementsAre(updated));
+        }
+
+        TEST_F(MWPhysicsActorGridTest, getInRangeShouldSupportLargeRadius)
+        {
+            const MWWorld::Ptr ptr = makePtr();
+            mGrid.insert(ptr, osg::Vec3f(1e6f, -1e6f, 0));
+            std::vector<MWWorld::Ptr> result;
+            mGrid.getInRange(osg::Vec3f(0, 0, 0), std::numeric_limits<float>::max(), result);
+            EXPECT_THAT(result, ElementsAre(ptr));
+        }
+
+        TEST_F(MWPhysicsActorGridTest, isAnyInRangeShouldReturnTrueOnlyWhenThereIsActorWithinRadius)
+        {
+            mGrid.insert(makePtr(), osg::Vec3f(150, 0, 0));
+            EXPECT_FALSE(mGrid.isAnyInRange(osg::Vec3f(0, 0, 0), 100));
+            EXPECT_TRUE(mGrid.isAnyInRange(osg::Vec3f(0, 0, 0), 200));
+        }
+    }
+}
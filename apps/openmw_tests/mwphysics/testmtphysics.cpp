@@ -0,0 +1,74 @@
+#include "apps/openmw/mwphysics/mtphysics.hpp"
+
+#include <components/settings/values.hpp>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        using namespace testing;
+
+        struct MWPhysicsTaskSchedulerTest : TestWithParam<int>
+        {
+            const int mAsyncNumThreads = Settings::physics().mAsyncNumThreads;
+            btDefaultCollisionConfiguration mCollisionConfiguration;
+            btCollisionDispatcher mDispatcher{ &mCollisionConfiguration };
+            btDbvtBroadphase mBroadphase;
+            btCollisionWorld mCollisionWorld{ &mDispatcher, &mBroadphase, &mCollisionConfiguration };
+
+            MWPhysicsTaskSchedulerTest() { Settings::physics().mAsyncNumThreads.set(GetParam()); }
+
+            ~MWPhysicsTaskSchedulerTest() override { Settings::physics().mAsyncNumThreads.set(mAsyncNumThreads); }
+
+            std::unique_ptr<PhysicsTaskScheduler> makeScheduler()
+            {
+                return std::make_unique<PhysicsTaskScheduler>(1.0f / 60.0f, &mCollisionWorld, nullptr);
+            }
+        };
+
+        TEST_P(MWPhysicsTaskSchedulerTest, runBatchShouldCallJobForEachIndexOnce)
+        {
+            const auto scheduler = makeScheduler();
+            std::vector<std::atomic_int> calls(1000);
+
+            scheduler->runBatch(calls.size(), [&](std::size_t index) { ++calls[index]; });
+
+            for (std::size_t i = 0; i < calls.size(); ++i)
+                EXPECT_EQ(calls[i], 1) << i;
+        }
+
+        TEST_P(MWPhysicsTaskSchedulerTest, runBatchShouldReturnAfterAllResultsAreSet)
+        {
+            const auto scheduler = makeScheduler();
+            std::vector<std::size_t> results(1000);
+
+            scheduler->runBatch(results.size(), [&](std::size_t index) { results[index] = 2 * index; });
+
+            for (std::size_t i = 0; i < results.size(); ++i)
+                EXPECT_EQ(results[i], 2 * i) << i;
+        }
+
+        TEST_P(MWPhysicsTaskSchedulerTest, runBatchShouldSupportEmptyBatch)
+        {
+            const auto scheduler = makeScheduler();
+            bool called = false;
+
+            scheduler->runBatch(0, [&](std::size_t) { called = true; });
+
+            EXPECT_FALSE(called);
+        }
+
+        INSTANTIATE_TEST_SUITE_P(AsyncNumThreads, MWPhysicsTaskSchedulerTest, Values(0, 1, 4));
+    }
+}
@@ -610,7 +610,8 @@ namespace Bsa
 
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(textureSize);
         char* buff = memoryStreamPtr->getRawData();
-        std::vector<char> inputBuffer(maxPackedChunkSize);
+        // Memory mapped archive is read directly without intermediate buffers
+        std::vector<char> inputBuffer(isMemoryMapped() ? 0 : maxPackedChunkSize);
 
         uint32_t dds = ESM::fourCC("DDS ");
         buff = (char*)std::memcpy(buff, &dds, sizeof(uint32_t)) + sizeof(uint32_t);
@@ -621,21 +622,31 @@ namespace Bsa
         for (const auto& c : fileRecord.texturesChunks)
         {
             const uint32_t inputSize = c.packedSize != 0 ? c.packedSize : c.size;
-            Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, inputSize);
+            char* const output = memoryStreamPtr->getRawData() + offset;
+            const char* input = nullptr;
+            if (isMemoryMapped())
+                input = getMappedRegion(c.offset, inputSize).data();
+            else
+            {
+                Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, c.offset, inputSize);
+                // uncompressed chunk is read straight into the output
+                char* const readBuffer = c.packedSize != 0 ? inputBuffer.data() : output;
+                streamPtr->read(readBuffer, inputSize);
+                input = readBuffer;
+            }
             if (c.packedSize != 0)
             {
-                streamPtr->read(inputBuffer.data(), c.packedSize);
                 uLongf destSize = static_cast<uLongf>(c.size);
-                int ec = ::uncompress(reinterpret_cast<Bytef*>(memoryStreamPtr->getRawData() + offset), &destSize,
-                    reinterpret_cast<Bytef*>(inputBuffer.data()), static_cast<uLong>(c.packedSize));
+                int ec = ::uncompress(reinterpret_cast<Bytef*>(output), &destSize,
+                    reinterpret_cast<const Bytef*>(input), static_cast<uLong>(c.packedSize));
 
                 if (ec != Z_OK)
                     fail("zlib uncompress failed: " + std::string(::zError(ec)));
             }
             // uncompressed chunk
-            else
+            else if (input != output)
             {
-                streamPtr->read(memoryStreamPtr->getRawData() + offset, c.size);
+                std::memcpy(output, input, c.size);
             }
             offset += c.size;
         }
@@ -51,6 +51,7 @@ namespace Bsa
         using BSAFile::getFilename;
         using BSAFile::getList;
         using BSAFile::getPath;
+        using BSAFile::isMemoryMapped;
         using BSAFile::open;
 
         BA2DX10File();
@@ -60,6 +61,13 @@ namespace Bsa
         void readHeader(std::istream& stream) override;
 
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+
+        /// Textures are always prefixed with a generated DDS header so they can't be provided without copying.
+        std::optional<std::span<const char>> getFileData(const FileStruct* /*fileStruct*/) const
+        {
+            return std::nullopt;
+        }
+
         void addFile(const std::string& filename, std::istream& file);
     };
 }
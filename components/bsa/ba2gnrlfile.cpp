@@ -8,7 +8,7 @@
 #include <zlib.h>
 
 #include <components/esm/fourcc.hpp>
-#include <components/files/constrainedfilestream.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/vfs/pathutil.hpp>
 
@@ -171,10 +171,26 @@ namespace Bsa
         fail("Add file is not implemented for compressed BSA: " + filename);
     }
 
+    std::optional<std::span<const char>> BA2GNRLFile::getFileData(const FileStruct* file) const
+    {
+        if (!isMemoryMapped())
+            return std::nullopt;
+        const FileRecord fileRec = getFileRecord(file->name());
+        if (!fileRec.isValid())
+            fail("File not found: " + std::string(file->name()));
+        if (fileRec.packedSize)
+            return std::nullopt;
+        return getMappedRegion(fileRec.offset, fileRec.size);
+    }
+
     Files::IStreamPtr BA2GNRLFile::getFile(const FileRecord& fileRecord)
     {
+        // Memory mapped archive provides uncompressed data without copying it
+        if (!fileRecord.packedSize && isMemoryMapped())
+            return openRegion(fileRecord.offset, fileRecord.size);
+
         const uint32_t inputSize = fileRecord.packedSize ? fileRecord.packedSize : fileRecord.size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, inputSize);
+        Files::IStreamPtr streamPtr = openRegion(fileRecord.offset, inputSize);
         auto memoryStreamPtr = std::make_unique<MemoryInputStream>(fileRecord.size);
         if (fileRecord.packedSize)
         {
@@ -39,6 +39,7 @@ namespace Bsa
         using BSAFile::getFilename;
         using BSAFile::getList;
         using BSAFile::getPath;
+        using BSAFile::isMemoryMapped;
         using BSAFile::open;
 
         BA2GNRLFile();
@@ -48,6 +49,7 @@ namespace Bsa
         void readHeader(std::istream& input) override;
 
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+        std::optional<std::span<const char>> getFileData(const FileStruct* fileStruct) const;
         void addFile(const std::string& filename, std::istream& file);
     };
 }
@@ -35,7 +35,9 @@
 
 #include <components/esm/fourcc.hpp>
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/mappedfilestream.hpp>
 #include <components/files/utils.hpp>
+#include <components/platform/file.hpp>
 
 using namespace Bsa;
 
@@ -257,7 +259,7 @@ void Bsa::BSAFile::writeHeader()
 }
 
 /// Open an archive file.
-void BSAFile::open(const std::filesystem::path& file)
+void BSAFile::open(const std::filesystem::path& file, bool memoryMapped)
 {
     if (mIsLoaded)
         close();
@@ -267,6 +269,8 @@ void BSAFile::open(const std::filesystem::path& file)
     {
         std::ifstream input(mFilepath, std::ios_base::binary);
         readHeader(input);
+        if (memoryMapped)
+            mMappedFile = std::make_shared<Platform::File::MappedFile>(mFilepath);
         mIsLoaded = true;
     }
     else
@@ -287,12 +291,37 @@ void Bsa::BSAFile::close()
 
     mFiles.clear();
     mStringBuf.clear();
+    mMappedFile.reset();
     mIsLoaded = false;
 }
 
+std::span<const char> Bsa::BSAFile::getMappedRegion(std::size_t offset, std::size_t size) const
+{
+    assert(mMappedFile != nullptr);
+    const std::span<const char> data = mMappedFile->getData();
+    if (offset > data.size() || size > data.size() - offset)
+        fail(std::format("region at offset {} with size {} is out of archive bounds ({} bytes)", offset, size,
+            data.size()));
+    return data.subspan(offset, size);
+}
+
+Files::IStreamPtr Bsa::BSAFile::openRegion(std::size_t offset, std::size_t size) const
+{
+    if (mMappedFile != nullptr)
+        return std::make_unique<Files::MappedFileStream>(mMappedFile, getMappedRegion(offset, size));
+    return Files::openConstrainedFileStream(mFilepath, offset, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
-    return Files::openConstrainedFileStream(mFilepath, file->mOffset, file->mFileSize);
+    return openRegion(file->mOffset, file->mFileSize);
+}
+
+std::optional<std::span<const char>> Bsa::BSAFile::getFileData(const FileStruct* file) const
+{
+    if (mMappedFile == nullptr)
+        return std::nullopt;
+    return getMappedRegion(file->mOffset, file->mFileSize);
 }
 
 void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
@@ -301,6 +330,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
         fail("Unable to add file " + filename + " the archive is not opened");
 
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
+    // The archive is going to be modified so the mapping doesn't represent its content anymore
+    mMappedFile.reset();
+
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
 
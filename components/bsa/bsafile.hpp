@@ -27,12 +27,20 @@
 #include <cstdint>
 #include <filesystem>
 #include <iosfwd>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
 
+namespace Platform::File
+{
+    class MappedFile;
+}
+
 namespace Bsa
 {
 
@@ -92,6 +100,9 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Whole archive mapped into memory, only present when the archive is opened as memory mapped
+        std::shared_ptr<const Platform::File::MappedFile> mMappedFile;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
@@ -99,6 +110,12 @@ namespace Bsa
         virtual void readHeader(std::istream& input);
         virtual void writeHeader();
 
+        /// Get a region of the memory mapped archive
+        std::span<const char> getMappedRegion(std::size_t offset, std::size_t size) const;
+
+        /// Open a stream for a region of the archive. Doesn't copy the data if the archive is memory mapped.
+        Files::IStreamPtr openRegion(std::size_t offset, std::size_t size) const;
+
     public:
         /* -----------------------------------
          * BSA management methods
@@ -111,7 +128,8 @@ namespace Bsa
         }
 
         /// Open an archive file.
-        void open(const std::filesystem::path& file);
+        /// @param memoryMapped map an existing archive into memory to read contained files without extra copies
+        void open(const std::filesystem::path& file, bool memoryMapped = false);
 
         void close();
 
@@ -125,6 +143,13 @@ namespace Bsa
          */
         Files::IStreamPtr getFile(const FileStruct* file);
 
+        /** Get contents of a file contained in the archive without copying it.
+         * @return nothing when the archive is not memory mapped or the file is not stored as is.
+         * @note The result is valid until the archive is closed.
+         * @note Thread safe.
+         */
+        std::optional<std::span<const char>> getFileData(const FileStruct* file) const;
+
         void addFile(const std::string& filename, std::istream& file);
 
         /// Get a list of all files
@@ -144,6 +169,11 @@ namespace Bsa
             return mFilepath;
         }
 
+        bool isMemoryMapped() const
+        {
+            return mMappedFile != nullptr;
+        }
+
         // checks version of BSA from file header
         static BsaVersion detectVersion(const std::filesystem::path& filePath);
     };
@@ -34,8 +34,9 @@
 #include <lz4frame.h>
 #include <zlib.h>
 
-#include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/mappedfilestream.hpp>
+#include <components/files/streamwithbuffer.hpp>
 #include <components/files/utils.hpp>
 #include <components/misc/pathhelpers.hpp>
 #include <components/vfs/pathutil.hpp>
@@ -262,12 +263,53 @@ namespace Bsa
         fail("Add file is not implemented for compressed BSA: " + filename);
     }
 
+    std::optional<std::span<const char>> CompressedBSAFile::getFileData(const FileStruct* file) const
+    {
+        if (!isMemoryMapped())
+            return std::nullopt;
+        const FileRecord fileRec = getFileRecord(file->name());
+        if (fileRec.mOffset == std::numeric_limits<uint32_t>::max())
+            fail("File not found: " + std::string(file->name()));
+        if (isCompressed(fileRec))
+            return std::nullopt;
+        return getMappedData(fileRec);
+    }
+
+    bool CompressedBSAFile::isCompressed(const FileRecord& fileRecord) const
+    {
+        const uint32_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
+        return (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
+    }
+
+    std::span<const char> CompressedBSAFile::getMappedData(const FileRecord& fileRecord) const
+    {
+        std::span<const char> data
+            = getMappedRegion(fileRecord.mOffset, fileRecord.mSize & (~FileSizeFlag_Compression));
+        if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
+        {
+            // Skip over the embedded file name
+            const std::size_t length = data.empty() ? 0 : static_cast<uint8_t>(data.front()) + sizeof(uint8_t);
+            if (length > data.size())
+            {
+                std::string message = "Embedded file name is out of bounds for file ";
+                message.append(fileRecord.mName.begin(), fileRecord.mName.end());
+                fail(message);
+            }
+            data = data.subspan(length);
+        }
+        return data;
+    }
+
     Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
     {
+        const bool compressed = isCompressed(fileRecord);
+        // Memory mapped archive provides uncompressed data without copying it
+        if (!compressed && isMemoryMapped())
+            return std::make_unique<Files::MappedFileStream>(mMappedFile, getMappedData(fileRecord));
+
         size_t size = fileRecord.mSize & (~FileSizeFlag_Compression);
         size_t resultSize = size;
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.mOffset, size);
-        bool compressed = (fileRecord.mSize != size) == ((mHeader.mFlags & ArchiveFlag_Compress) == 0);
+        Files::IStreamPtr streamPtr = openRegion(fileRecord.mOffset, size);
         if ((mHeader.mFlags & ArchiveFlag_EmbeddedNames) != 0)
         {
             // Skip over the embedded file name
@@ -110,6 +110,10 @@ namespace Bsa
 
         FileRecord getFileRecord(std::string_view str) const;
 
+        bool isCompressed(const FileRecord& fileRecord) const;
+
+        std::span<const char> getMappedData(const FileRecord& fileRecord) const;
+
         /// \brief Normalizes given filename or folder and generates format-compatible hash.
         static std::uint64_t generateHash(std::string_view stem, std::string_view extension);
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
@@ -118,6 +122,7 @@ namespace Bsa
         using BSAFile::getFilename;
         using BSAFile::getList;
         using BSAFile::getPath;
+        using BSAFile::isMemoryMapped;
         using BSAFile::open;
 
         CompressedBSAFile() = default;
@@ -127,6 +132,7 @@ namespace Bsa
         void readHeader(std::istream& input) override;
 
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
+        std::optional<std::span<const char>> getFileData(const FileStruct* fileStruct) const;
         void addFile(const std::string& filename, std::istream& file);
     };
 }
@@ -62,7 +62,7 @@ namespace DetourNavigator
             if (db == nullptr)
                 return nullptr;
             return std::make_unique<DbWorker>(updater, std::move(db), TileVersion(navMeshFormatVersion),
-                settings.mRecast, settings.mWriteToNavMeshDb);
+                settings.mRecast, settings.mWriteToNavMeshDb, settings.mDbWriteBatchSize);
         }
 
         std::size_t getNextJobId()
@@ -279,6 +279,7 @@ namespace DetourNavigator
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
         , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mTileLayersCache(settings.mMaxNavMeshTileLayersCacheSize)
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -443,6 +444,7 @@ namespace DetourNavigator
         if (mDbWorker != nullptr)
             result.mDb = mDbWorker->getStats();
         result.mCache = mNavMeshTilesCache.getStats();
+        result.mLayers = mTileLayersCache.getStats();
         result.mDbGetTileHits = mDbGetTileHits.load(std::memory_order_relaxed);
         result.mPosted = mPostedCount.load(std::memory_order_relaxed);
         return result;
@@ -579,8 +581,7 @@ namespace DetourNavigator
                 return JobStatus::MemoryCacheMiss;
             }
 
-            preparedNavMeshData = prepareNavMeshTileData(
-                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareTileData(job, recastMesh);
 
             if (preparedNavMeshData == nullptr)
             {
@@ -613,6 +614,27 @@ namespace DetourNavigator
         return handleUpdateNavMeshStatus(status, job, navMeshCacheItem, *recastMesh);
     }
 
+    std::unique_ptr<PreparedNavMeshData> AsyncNavMeshUpdater::prepareTileData(
+        const Job& job, const std::shared_ptr<RecastMesh>& recastMesh)
+    {
+        // Storing the layer requires copying spans and geometry, don't do it when there is nowhere to keep it
+        if (mSettings.get().mMaxNavMeshTileLayersCacheSize == 0)
+            return prepareNavMeshTileData(
+                *recastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+
+        const std::shared_ptr<const TileLayer> previousLayer
+            = mTileLayersCache.get(job.mAgentBounds, job.mChangedTile);
+        const auto layer = std::make_shared<TileLayer>();
+
+        std::unique_ptr<PreparedNavMeshData> result = prepareNavMeshTileData(*recastMesh, job.mWorldspace,
+            job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast, previousLayer.get(), layer.get());
+
+        if (!layer->mSpans.empty())
+            mTileLayersCache.set(job.mAgentBounds, job.mChangedTile, layer);
+
+        return result;
+    }
+
     JobStatus AsyncNavMeshUpdater::processJobWithDbResult(Job& job, GuardedNavMeshCacheItem& navMeshCacheItem)
     {
         Log(Debug::Debug) << "Processing job with db result " << job.mId;
@@ -631,8 +653,7 @@ namespace DetourNavigator
 
         if (preparedNavMeshData == nullptr)
         {
-            preparedNavMeshData = prepareNavMeshTileData(
-                *job.mRecastMesh, job.mWorldspace, job.mChangedTile, job.mAgentBounds, mSettings.get().mRecast);
+            preparedNavMeshData = prepareTileData(job, job.mRecastMesh);
             generatedNavMeshData = true;
         }
 
@@ -833,6 +854,18 @@ namespace DetourNavigator
         return job;
     }
 
+    void DbJobQueue::popWriting(std::size_t maxCount, std::vector<JobIt>& jobs)
+    {
+        const std::lock_guard lock(mMutex);
+        if (mShouldStop || mReading.size() > 0)
+            return;
+        for (std::size_t i = 0; i < maxCount && !mWriting.empty(); ++i)
+        {
+            jobs.push_back(mWriting.front());
+            mWriting.pop_front();
+        }
+    }
+
     void DbJobQueue::update(TilePosition playerTile)
     {
         const std::lock_guard lock(mMutex);
@@ -858,12 +891,13 @@ namespace DetourNavigator
     }
 
     DbWorker::DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-        const RecastSettings& recastSettings, bool writeToDb)
+        const RecastSettings& recastSettings, bool writeToDb, std::size_t writeBatchSize)
         : mUpdater(updater)
         , mRecastSettings(recastSettings)
         , mDb(std::move(db))
         , mVersion(version)
         , mWriteToDb(writeToDb)
+        , mWriteBatchSize(std::max<std::size_t>(writeBatchSize, 1))
         , mNextTileId(mDb->getMaxTileId() + 1)
         , mNextShapeId(mDb->getMaxShapeId() + 1)
         , mThread([this] { run(); })
@@ -886,6 +920,9 @@ namespace DetourNavigator
         return DbWorkerStats{
             .mJobs = mQueue.getStats(),
             .mGetTileCount = mGetTileCount.load(std::memory_order_relaxed),
+            .mGetSharedTileCount = mGetSharedTileCount.load(std::memory_order_relaxed),
+            .mWriteTransactionCount = mWriteTransactionCount.load(std::memory_order_relaxed),
+            .mNavMeshDb = *mDbStats.lockConst(),
         };
     }
 
@@ -904,7 +941,13 @@ namespace DetourNavigator
             try
             {
                 if (const auto job = mQueue.pop())
-                    processJob(*job);
+                {
+                    if (isWritingDbJob(**job))
+                        processWritingJobs(*job);
+                    else
+                        processJob(*job);
+                    *mDbStats.lock() = mDb->getStats();
+                }
             }
             catch (const std::exception& e)
             {
@@ -913,62 +956,129 @@ namespace DetourNavigator
         }
     }
 
-    void DbWorker::processJob(JobIt job)
+    bool DbWorker::processJob(JobIt job)
     {
         const auto process = [&](auto f) {
             try
             {
                 f(job);
+                return true;
             }
             catch (const std::exception& e)
             {
                 Log(Debug::Error) << "DbWorker exception while processing job " << job->mId << ": " << e.what();
-                if (mWriteToDb)
-                {
-                    const std::string_view message(e.what());
-                    if (message.find("database or disk is full") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
-                    }
-                    else if (message.find("database is locked") != std::string_view::npos)
-                    {
-                        mWriteToDb = false;
-                        Log(Debug::Warning)
-                            << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
-                    }
-                    else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
-                    {
-                        Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
-                                               "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
-                                            << mNextTileId;
-                        try
-                        {
-                            mNextTileId = TileId(mDb->getMaxTileId() + 1);
-                            Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
-                        }
-                        catch (const std::exception& exception)
-                        {
-                            mWriteToDb = false;
-                            Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: "
-                                                << exception.what();
-                        }
-                    }
-                }
+                handleException(e);
+                return false;
             }
         };
 
         if (isWritingDbJob(*job))
         {
-            process([&](JobIt it) { processWritingJob(it); });
+            const bool result = process([&](JobIt it) { processWritingJob(it); });
             mUpdater.removeJob(job);
-            return;
+            return result;
         }
 
-        process([&](JobIt it) { processReadingJob(it); });
+        const bool result = process([&](JobIt it) { processReadingJob(it); });
         job->mState = JobState::WithDbResult;
         mUpdater.enqueueJob(job);
+        return result;
+    }
+
+    void DbWorker::processWritingJobs(JobIt job)
+    {
+        mWritingJobs.clear();
+        mWritingJobs.push_back(job);
+        mQueue.popWriting(mWriteBatchSize - 1, mWritingJobs);
+
+        Log(Debug::Debug) << "Processing " << mWritingJobs.size() << " db write jobs";
+
+        // Group commit of all tiles in a batch requires a single disk sync instead of one per tile
+        std::optional<Sqlite3::Transaction> transaction;
+        if (mWriteToDb)
+        {
+            try
+            {
+                transaction.emplace(mDb->startTransaction(Sqlite3::TransactionMode::Immediate));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "DbWorker exception while starting transaction: " << e.what();
+                handleException(e);
+            }
+        }
+
+        bool failed = false;
+        for (const JobIt it : mWritingJobs)
+            failed = !processJob(it) || failed;
+
+        if (!transaction.has_value())
+            return;
+
+        if (failed)
+        {
+            // Don't commit a partially written batch, tile ids used by the batch are not in the db anymore
+            try
+            {
+                transaction->rollback();
+                mNextTileId = TileId(mDb->getMaxTileId() + 1);
+            }
+            catch (const std::exception& e)
+            {
+                mWriteToDb = false;
+                Log(Debug::Warning) << "Failed to rollback transaction, writes to navmeshdb are disabled: "
+                                    << e.what();
+            }
+            return;
+        }
+
+        try
+        {
+            transaction->commit();
+            ++mWriteTransactionCount;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "DbWorker exception while committing transaction: " << e.what();
+            handleException(e);
+        }
+    }
+
+    void DbWorker::handleException(const std::exception& e)
+    {
+        if (!mWriteToDb)
+            return;
+
+        const std::string_view message(e.what());
+        if (message.find("database or disk is full") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled because file size limit is reached or disk is full";
+        }
+        else if (message.find("database is locked") != std::string_view::npos)
+        {
+            mWriteToDb = false;
+            Log(Debug::Warning)
+                << "Writes to navmeshdb are disabled to avoid concurrent writes from multiple processes";
+        }
+        else if (message.find("UNIQUE constraint failed: tiles.tile_id") != std::string_view::npos)
+        {
+            Log(Debug::Warning) << "Found duplicate navmeshdb tile_id, please report the "
+                                   "issue to https://gitlab.com/OpenMW/openmw/-/issues, attach openmw.log: "
+                                << mNextTileId;
+            try
+            {
+                mNextTileId = TileId(mDb->getMaxTileId() + 1);
+                Log(Debug::Info) << "Updated navmeshdb tile_id to: " << mNextTileId;
+            }
+            catch (const std::exception& exception)
+            {
+                mWriteToDb = false;
+                Log(Debug::Warning) << "Failed to update next tile_id, writes to navmeshdb are disabled: "
+                                    << exception.what();
+            }
+        }
     }
 
     void DbWorker::processReadingJob(JobIt job)
@@ -1017,6 +1127,19 @@ namespace DetourNavigator
         }
 
         job->mCachedTileData = mDb->getTileData(job->mWorldspace, job->mChangedTile, job->mInput);
+
+        if (job->mCachedTileData.has_value())
+            return;
+
+        // Tile from other worldspace is used only as is, outdated one is regenerated and inserted for this worldspace
+        if (auto shared = mDb->getTileDataByInput(job->mChangedTile, job->mInput);
+            shared.has_value() && shared->mVersion == mVersion)
+        {
+            Log(Debug::Debug) << "Found db tile from other worldspace for job " << job->mId;
+            ++mGetSharedTileCount;
+            job->mCachedTileData = std::move(shared);
+            job->mCachedTileDataShared = true;
+        }
     }
 
     void DbWorker::processWritingJob(JobIt job)
@@ -1038,7 +1161,8 @@ namespace DetourNavigator
             job->mInput = serialize(mRecastSettings, job->mAgentBounds, *job->mRecastMesh, objects);
         }
 
-        if (const auto& cachedTileData = job->mCachedTileData)
+        const auto& cachedTileData = job->mCachedTileData;
+        if (cachedTileData.has_value() && !job->mCachedTileDataShared)
         {
             Log(Debug::Debug) << "Update db tile by job " << job->mId;
             job->mGeneratedNavMeshData->mUserId = static_cast<unsigned>(cachedTileData->mTileId);
@@ -11,6 +11,7 @@
 #include "sharednavmeshcacheitem.hpp"
 #include "stats.hpp"
 #include "tilecachedrecastmeshmanager.hpp"
+#include "tilelayerscache.hpp"
 #include "tileposition.hpp"
 #include "waitconditiontype.hpp"
 
@@ -29,6 +30,7 @@
 #include <set>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 class dtNavMesh;
 
@@ -58,6 +60,8 @@ namespace DetourNavigator
         std::vector<std::byte> mInput;
         std::shared_ptr<RecastMesh> mRecastMesh;
         std::optional<TileData> mCachedTileData;
+        // Cached tile data is found for the same input in other worldspace and can't be updated by this job
+        bool mCachedTileDataShared = false;
         std::unique_ptr<PreparedNavMeshData> mGeneratedNavMeshData;
 
         Job(const AgentBounds& agentBounds, std::weak_ptr<GuardedNavMeshCacheItem> navMeshCacheItem,
@@ -136,6 +140,9 @@ namespace DetourNavigator
 
         std::optional<JobIt> pop();
 
+        // Appends up to maxCount writing jobs without waiting. Nothing is appended while there are reading jobs.
+        void popWriting(std::size_t maxCount, std::vector<JobIt>& jobs);
+
         void update(TilePosition playerTile);
 
         void stop();
@@ -157,7 +164,7 @@ namespace DetourNavigator
     {
     public:
         DbWorker(AsyncNavMeshUpdater& updater, std::unique_ptr<NavMeshDb>&& db, TileVersion version,
-            const RecastSettings& recastSettings, bool writeToDb);
+            const RecastSettings& recastSettings, bool writeToDb, std::size_t writeBatchSize);
 
         ~DbWorker();
 
@@ -175,16 +182,25 @@ namespace DetourNavigator
         const std::unique_ptr<NavMeshDb> mDb;
         const TileVersion mVersion;
         bool mWriteToDb;
+        const std::size_t mWriteBatchSize;
         TileId mNextTileId;
         ShapeId mNextShapeId;
         DbJobQueue mQueue;
+        std::vector<JobIt> mWritingJobs;
         std::atomic_bool mShouldStop{ false };
         std::atomic_size_t mGetTileCount{ 0 };
+        std::atomic_size_t mGetSharedTileCount{ 0 };
+        std::atomic_size_t mWriteTransactionCount{ 0 };
+        Misc::ScopeGuarded<NavMeshDbStats> mDbStats;
         std::thread mThread;
 
         inline void run() noexcept;
 
-        inline void processJob(JobIt job);
+        inline bool processJob(JobIt job);
+
+        inline void processWritingJobs(JobIt job);
+
+        inline void handleException(const std::exception& e);
 
         inline void processReadingJob(JobIt job);
 
@@ -226,6 +242,7 @@ namespace DetourNavigator
         std::set<std::tuple<AgentBounds, TilePosition>> mPushed;
         Misc::ScopeGuarded<TilePosition> mPlayerTile;
         NavMeshTilesCache mNavMeshTilesCache;
+        TileLayersCache mTileLayersCache;
         Misc::ScopeGuarded<std::set<std::tuple<AgentBounds, TilePosition>>> mProcessingTiles;
         std::map<std::tuple<AgentBounds, TilePosition>, std::chrono::steady_clock::time_point> mLastUpdates;
         std::set<std::tuple<AgentBounds, TilePosition>> mPresentTiles;
@@ -242,6 +259,9 @@ namespace DetourNavigator
 
         inline JobStatus processJobWithDbResult(Job& job, GuardedNavMeshCacheItem& navMeshCacheItem);
 
+        inline std::unique_ptr<PreparedNavMeshData> prepareTileData(
+            const Job& job, const std::shared_ptr<RecastMesh>& recastMesh);
+
         inline JobStatus handleUpdateNavMeshStatus(UpdateNavMeshStatus status, const Job& job,
             const GuardedNavMeshCacheItem& navMeshCacheItem, const RecastMesh& recastMesh);
 
@@ -0,0 +1,171 @@
+#include "batchpathfinder.hpp"
+#include "findsmoothpath.hpp"
+#include "navigator.hpp"
+#include "navmeshcacheitem.hpp"
+#include "settings.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/guarded.hpp>
+
+#include <DetourNavMeshQuery.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <numeric>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        // Navmesh can't be updated while it's locked so keep the lock only for a few requests per thread
+        constexpr std::size_t requestsPerThreadPerLock = 4;
+
+        void findPath(const dtNavMeshQuery& query, const Settings& settings, const PathRequest& request,
+            PathResult& result)
+        {
+            result.mPath.clear();
+            auto out = std::back_inserter(result.mPath);
+            FromNavMeshCoordinatesIterator outTransform(out, settings.mRecast);
+            result.mStatus = findSmoothPath(query,
+                toNavMeshCoordinates(settings.mRecast, request.mAgentBounds.mHalfExtents),
+                toNavMeshCoordinates(settings.mRecast, request.mStart),
+                toNavMeshCoordinates(settings.mRecast, request.mEnd), request.mIncludeFlags, request.mAreaCosts,
+                settings.mDetour, request.mEndTolerance,
+                ToNavMeshCoordinatesSpan(std::span(request.mCheckpoints), settings.mRecast), outTransform);
+        }
+    }
+
+    BatchPathFinder::BatchPathFinder(std::size_t threadsCount, int maxNavMeshQueryNodes)
+        : mThreadsCount(threadsCount)
+        , mMaxNavMeshQueryNodes(maxNavMeshQueryNodes)
+    {
+        for (std::size_t i = 0; i <= threadsCount; ++i)
+            mQueries.push_back(std::make_unique<dtNavMeshQuery>());
+    }
+
+    BatchPathFinder::~BatchPathFinder()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasJob.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    void BatchPathFinder::findPaths(
+        const Navigator& navigator, std::span<const PathRequest> requests, std::span<PathResult> results)
+    {
+        assert(requests.size() == results.size());
+
+        const std::lock_guard batchLock(mBatchMutex);
+        const Settings& settings = navigator.getSettings();
+
+        if (requests.size() > 1)
+            startThreads();
+
+        std::vector<std::size_t> order(requests.size());
+        std::iota(order.begin(), order.end(), std::size_t{ 0 });
+        std::stable_sort(order.begin(), order.end(),
+            [&](std::size_t l, std::size_t r) { return requests[l].mAgentBounds < requests[r].mAgentBounds; });
+
+        for (auto begin = order.begin(); begin != order.end();)
+        {
+            const AgentBounds& agentBounds = requests[*begin].mAgentBounds;
+            const auto end = std::find_if(
+                begin, order.end(), [&](std::size_t i) { return requests[i].mAgentBounds != agentBounds; });
+            const std::span<const std::size_t> group(begin, end);
+            begin = end;
+
+            const SharedNavMeshCacheItem navMesh = navigator.getNavMesh(agentBounds);
+            if (navMesh == nullptr)
+            {
+                for (const std::size_t i : group)
+                    results[i] = PathResult{ .mStatus = Status::NavMeshNotFound, .mPath = {} };
+                continue;
+            }
+
+            const std::size_t chunkSize = (mThreads.size() + 1) * requestsPerThreadPerLock;
+            for (std::size_t chunkBegin = 0; chunkBegin < group.size(); chunkBegin += chunkSize)
+            {
+                const std::span<const std::size_t> chunk
+                    = group.subspan(chunkBegin, std::min(chunkSize, group.size() - chunkBegin));
+
+                // Navmesh is not modified while locked so it can be read by multiple queries in parallel
+                const auto locked = navMesh->lockConst();
+                std::atomic_size_t next{ 0 };
+
+                run([&](std::size_t worker) {
+                    dtNavMeshQuery& query = *mQueries[worker];
+                    const bool initialized = dtStatusSucceed(query.init(&locked->getImpl(), mMaxNavMeshQueryNodes));
+                    for (std::size_t i = next.fetch_add(1); i < chunk.size(); i = next.fetch_add(1))
+                    {
+                        PathResult& result = results[chunk[i]];
+                        if (!initialized)
+                        {
+                            result = PathResult{ .mStatus = Status::InitNavMeshQueryFailed, .mPath = {} };
+                            continue;
+                        }
+                        try
+                        {
+                            findPath(query, settings, requests[chunk[i]], result);
+                        }
+                        catch (const std::exception& e)
+                        {
+                            Log(Debug::Error) << "Failed to find path: " << e.what();
+                            result = PathResult{ .mStatus = Status::FindPathOverPolygonsFailed, .mPath = {} };
+                        }
+                    }
+                });
+            }
+        }
+    }
+
+    void BatchPathFinder::startThreads()
+    {
+        // Batches are processed under mBatchMutex so generation doesn't change until threads are started
+        for (std::size_t i = mThreads.size() + 1; i <= mThreadsCount; ++i)
+            mThreads.emplace_back([this, i, generation = mGeneration] { process(i, generation); });
+    }
+
+    void BatchPathFinder::run(std::function<void(std::size_t)> job)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mJob = std::move(job);
+            mActive = mThreads.size();
+            ++mGeneration;
+        }
+        mHasJob.notify_all();
+        mJob(0);
+        std::unique_lock lock(mMutex);
+        mDone.wait(lock, [&] { return mActive == 0; });
+        mJob = nullptr;
+    }
+
+    void BatchPathFinder::process(std::size_t worker, std::size_t generation) noexcept
+    {
+        Log(Debug::Debug) << "Start batch path finder thread=" << std::this_thread::get_id();
+        while (true)
+        {
+            {
+                std::unique_lock lock(mMutex);
+                mHasJob.wait(lock, [&] { return mShouldStop || mGeneration != generation; });
+                if (mShouldStop)
+                    break;
+                generation = mGeneration;
+            }
+            mJob(worker);
+            {
+                const std::lock_guard lock(mMutex);
+                --mActive;
+            }
+            mDone.notify_all();
+        }
+        Log(Debug::Debug) << "Stop batch path finder thread=" << std::this_thread::get_id();
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_BATCHPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_BATCHPATHFINDER_H
+
+#include "pathrequest.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+class dtNavMeshQuery;
+
+namespace DetourNavigator
+{
+    struct Navigator;
+
+    /// Finds paths for many requests at once. Requests for the same agent bounds are split into small chunks, each is
+    /// processed under a single navmesh lock by worker threads and the calling thread. Worker threads are started on
+    /// the first batch. Each thread has own dtNavMeshQuery reused by all batches.
+    class BatchPathFinder
+    {
+    public:
+        explicit BatchPathFinder(std::size_t threadsCount, int maxNavMeshQueryNodes);
+
+        ~BatchPathFinder();
+
+        void findPaths(
+            const Navigator& navigator, std::span<const PathRequest> requests, std::span<PathResult> results);
+
+    private:
+        const std::size_t mThreadsCount;
+        const int mMaxNavMeshQueryNodes;
+        // The first one is used by the calling thread
+        std::vector<std::unique_ptr<dtNavMeshQuery>> mQueries;
+        std::mutex mBatchMutex;
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::condition_variable mDone;
+        std::function<void(std::size_t)> mJob;
+        std::size_t mGeneration = 0;
+        std::size_t mActive = 0;
+        bool mShouldStop = false;
+        std::vector<std::thread> mThreads;
+
+        void startThreads();
+
+        void run(std::function<void(std::size_t)> job);
+
+        void process(std::size_t worker, std::size_t generation) noexcept;
+    };
+}
+
+#endif
@@ -38,7 +38,8 @@ namespace DetourNavigator
     GenerateNavMeshTile::GenerateNavMeshTile(ESM::RefId worldspace, const TilePosition& tilePosition,
         std::weak_ptr<const RecastMeshProvider> recastMeshProvider, const AgentBounds& agentBounds,
         const DetourNavigator::Settings& settings, bool collectStats, std::weak_ptr<NavMeshTileConsumer> consumer)
-        : mWorldspace(worldspace)
+        : SceneUtil::WorkItem(SceneUtil::WorkCategory::NavMesh)
+        , mWorldspace(worldspace)
         , mTilePosition(tilePosition)
         , mRecastMeshProvider(std::move(recastMeshProvider))
         , mAgentBounds(agentBounds)
@@ -11,8 +11,10 @@
 #include "recastparams.hpp"
 #include "settings.hpp"
 #include "settingsutils.hpp"
+#include "tilelayerscache.hpp"
 
 #include "components/debug/debuglog.hpp"
+#include "components/misc/compression.hpp"
 
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
@@ -20,6 +22,11 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
 
 namespace DetourNavigator
 {
@@ -33,6 +40,25 @@ namespace DetourNavigator
             float mHeight;
         };
 
+        // Half-open range of heightfield columns
+        struct ColumnsRange
+        {
+            int mMinX = 0;
+            int mMinY = 0;
+            int mMaxX = 0;
+            int mMaxY = 0;
+        };
+
+        bool isEmpty(const ColumnsRange& range)
+        {
+            return range.mMinX >= range.mMaxX || range.mMinY >= range.mMaxY;
+        }
+
+        bool contains(const ColumnsRange& range, int x, int y)
+        {
+            return range.mMinX <= x && x < range.mMaxX && range.mMinY <= y && y < range.mMaxY;
+        }
+
         std::vector<float> getOffMeshVerts(std::span<const OffMeshConnection> connections)
         {
             std::vector<float> result;
@@ -194,8 +220,41 @@ namespace DetourNavigator
             return std::all_of(begin, end, isSupportedCoordinate);
         }
 
+        bool isOverlapping(const TileBounds& bounds, std::span<const float> vertices, std::span<const int> triangle)
+        {
+            TileBounds triangleBounds{ osg::Vec2f(vertices[triangle[0] * 3], vertices[triangle[0] * 3 + 2]),
+                osg::Vec2f(vertices[triangle[0] * 3], vertices[triangle[0] * 3 + 2]) };
+            for (const int index : triangle.subspan(1))
+            {
+                const osg::Vec2f point(vertices[index * 3], vertices[index * 3 + 2]);
+                triangleBounds.mMin.x() = std::min(triangleBounds.mMin.x(), point.x());
+                triangleBounds.mMin.y() = std::min(triangleBounds.mMin.y(), point.y());
+                triangleBounds.mMax.x() = std::max(triangleBounds.mMax.x(), point.x());
+                triangleBounds.mMax.y() = std::max(triangleBounds.mMax.y(), point.y());
+            }
+            return bounds.mMin.x() <= triangleBounds.mMax.x() && triangleBounds.mMin.x() <= bounds.mMax.x()
+                && bounds.mMin.y() <= triangleBounds.mMax.y() && triangleBounds.mMin.y() <= bounds.mMax.y();
+        }
+
+        // Keeps original order of triangles because result of rasterization depends on it
+        void filterTriangles(const TileBounds& bounds, std::span<const float> vertices, std::span<const int> indices,
+            std::vector<int>& filteredIndices, std::vector<unsigned char>& areas)
+        {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < areas.size(); ++i)
+            {
+                const std::span<const int> triangle = indices.subspan(i * 3, 3);
+                if (!isOverlapping(bounds, vertices, triangle))
+                    continue;
+                filteredIndices.insert(filteredIndices.end(), triangle.begin(), triangle.end());
+                areas[count++] = areas[i];
+            }
+            areas.resize(count);
+        }
+
+        /// Rasterizes only triangles overlapping given bounds in navmesh coordinates when they are present.
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const Mesh& mesh, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+            const RecastParams& params, const std::optional<TileBounds>& bounds, rcHeightfield& solid)
         {
             std::vector<unsigned char> areas(mesh.getAreaTypes().begin(), mesh.getAreaTypes().end());
             std::vector<float> vertices = mesh.getVertices();
@@ -214,12 +273,21 @@ namespace DetourNavigator
                 std::swap(vertices[i + 1], vertices[i + 2]);
             }
 
+            std::span<const int> indices = mesh.getIndices();
+            std::vector<int> filteredIndices;
+
+            if (bounds.has_value())
+            {
+                filterTriangles(*bounds, vertices, indices, filteredIndices, areas);
+                indices = filteredIndices;
+            }
+
             rcClearUnwalkableTriangles(&context, settings.mMaxSlope, vertices.data(),
-                static_cast<int>(mesh.getVerticesCount()), mesh.getIndices().data(), static_cast<int>(areas.size()),
+                static_cast<int>(mesh.getVerticesCount()), indices.data(), static_cast<int>(areas.size()),
                 areas.data());
 
             return rcRasterizeTriangles(&context, vertices.data(), static_cast<int>(mesh.getVerticesCount()),
-                mesh.getIndices().data(), areas.data(), static_cast<int>(areas.size()), solid, params.mWalkableClimb);
+                indices.data(), areas.data(), static_cast<int>(areas.size()), solid, params.mWalkableClimb);
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const Rectangle& rectangle, AreaType areaType,
@@ -285,30 +353,245 @@ namespace DetourNavigator
         }
 
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const std::vector<Heightfield>& heightfields,
-            const RecastSettings& settings, const RecastParams& params, rcHeightfield& solid)
+            const RecastSettings& settings, const RecastParams& params, const std::optional<TileBounds>& bounds,
+            rcHeightfield& solid)
         {
             for (const Heightfield& heightfield : heightfields)
             {
                 const Mesh mesh = makeMesh(heightfield);
-                if (!rasterizeTriangles(context, mesh, settings, params, solid))
+                if (!rasterizeTriangles(context, mesh, settings, params, bounds, solid))
                     return false;
             }
             return true;
         }
 
+        /// Water and flat heightfields are rasterized completely even when bounds are present because they consist
+        /// of a few large triangles.
         [[nodiscard]] bool rasterizeTriangles(RecastContext& context, const TilePosition& tilePosition,
             float agentHalfExtentsZ, const RecastMesh& recastMesh, const RecastSettings& settings,
-            const RecastParams& params, rcHeightfield& solid)
+            const RecastParams& params, const std::optional<TileBounds>& bounds, rcHeightfield& solid)
         {
             const TileBounds realTileBounds = makeRealTileBoundsWithBorder(settings, tilePosition);
-            return rasterizeTriangles(context, recastMesh.getMesh(), settings, params, solid)
+            return rasterizeTriangles(context, recastMesh.getMesh(), settings, params, bounds, solid)
                 && rasterizeTriangles(
                     context, agentHalfExtentsZ, recastMesh.getWater(), settings, params, realTileBounds, solid)
-                && rasterizeTriangles(context, recastMesh.getHeightfields(), settings, params, solid)
+                && rasterizeTriangles(context, recastMesh.getHeightfields(), settings, params, bounds, solid)
                 && rasterizeTriangles(
                     context, realTileBounds, recastMesh.getFlatHeightfields(), settings, params, solid);
         }
 
+        osg::Vec3f getVertex(const Mesh& mesh, std::size_t triangle, std::size_t vertex)
+        {
+            const std::size_t index = static_cast<std::size_t>(mesh.getIndices()[triangle * 3 + vertex]) * 3;
+            const std::vector<float>& vertices = mesh.getVertices();
+            return osg::Vec3f(vertices[index], vertices[index + 1], vertices[index + 2]);
+        }
+
+        auto makeTriangleTuple(const Mesh& mesh, std::size_t triangle)
+        {
+            return std::make_tuple(mesh.getAreaTypes()[triangle], getVertex(mesh, triangle, 0),
+                getVertex(mesh, triangle, 1), getVertex(mesh, triangle, 2));
+        }
+
+        void addTriangleBounds(const Mesh& mesh, std::size_t triangle, std::optional<TileBounds>& bounds)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const osg::Vec3f vertex = getVertex(mesh, triangle, i);
+                const osg::Vec2f point(vertex.x(), vertex.y());
+                if (!bounds.has_value())
+                {
+                    bounds = TileBounds{ point, point };
+                    continue;
+                }
+                bounds->mMin.x() = std::min(bounds->mMin.x(), point.x());
+                bounds->mMin.y() = std::min(bounds->mMin.y(), point.y());
+                bounds->mMax.x() = std::max(bounds->mMax.x(), point.x());
+                bounds->mMax.y() = std::max(bounds->mMax.y(), point.y());
+            }
+        }
+
+        // RecastMeshBuilder sorts triangles so unchanged ones have the same order in both meshes. For not sorted
+        // meshes more triangles are considered changed but matched ones still have the same relative order.
+        std::optional<TileBounds> getChangedTrianglesBounds(const Mesh& previous, const Mesh& current)
+        {
+            std::optional<TileBounds> result;
+            const std::size_t previousCount = previous.getAreaTypes().size();
+            const std::size_t currentCount = current.getAreaTypes().size();
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < previousCount && j < currentCount)
+            {
+                const auto previousTriangle = makeTriangleTuple(previous, i);
+                const auto currentTriangle = makeTriangleTuple(current, j);
+                if (previousTriangle < currentTriangle)
+                    addTriangleBounds(previous, i++, result);
+                else if (currentTriangle < previousTriangle)
+                    addTriangleBounds(current, j++, result);
+                else
+                {
+                    ++i;
+                    ++j;
+                }
+            }
+            for (; i < previousCount; ++i)
+                addTriangleBounds(previous, i, result);
+            for (; j < currentCount; ++j)
+                addTriangleBounds(current, j, result);
+            return result;
+        }
+
+        // Returns columns which rasterization may differ from the previous layer. Returns nullopt when the layer
+        // can't be reused.
+        std::optional<ColumnsRange> getChangedColumns(const TileLayer& previousLayer, const RecastMesh& recastMesh,
+            const RecastSettings& settings, const rcHeightfield& solid)
+        {
+            if (previousLayer.mSpans.empty() || previousLayer.mWidth != solid.width
+                || previousLayer.mHeight != solid.height || previousLayer.mMinZ != solid.bmin[1]
+                || previousLayer.mMaxZ != solid.bmax[1])
+                return std::nullopt;
+
+            if (previousLayer.mWater != recastMesh.getWater()
+                || previousLayer.mHeightfields != recastMesh.getHeightfields()
+                || previousLayer.mFlatHeightfields != recastMesh.getFlatHeightfields())
+                return std::nullopt;
+
+            const std::optional<TileBounds> changed
+                = getChangedTrianglesBounds(previousLayer.mMesh, recastMesh.getMesh());
+            if (!changed.has_value())
+                return ColumnsRange{};
+
+            const TileBounds bounds = toNavMeshCoordinates(settings, *changed);
+            // One more column on each side to not depend on rounding
+            const auto toColumn = [&](float value, float min, int size, int shift) {
+                const float column = std::floor((value - min) / solid.cs) + static_cast<float>(shift);
+                return static_cast<int>(std::clamp(column, 0.0f, static_cast<float>(size)));
+            };
+            const ColumnsRange result{
+                .mMinX = toColumn(bounds.mMin.x(), solid.bmin[0], solid.width, -1),
+                .mMinY = toColumn(bounds.mMin.y(), solid.bmin[2], solid.height, -1),
+                .mMaxX = toColumn(bounds.mMax.x(), solid.bmin[0], solid.width, 2),
+                .mMaxY = toColumn(bounds.mMax.y(), solid.bmin[2], solid.height, 2),
+            };
+
+            // Copying spans doesn't give much when most of the tile has to be rasterized anyway
+            if (2 * (result.mMaxX - result.mMinX) * (result.mMaxY - result.mMinY) > solid.width * solid.height)
+                return std::nullopt;
+
+            return result;
+        }
+
+        template <class T>
+        void appendValue(T value, std::vector<std::byte>& data)
+        {
+            const std::size_t offset = data.size();
+            data.resize(offset + sizeof(value));
+            std::memcpy(data.data() + offset, &value, sizeof(value));
+        }
+
+        template <class T>
+        T readValue(const std::vector<std::byte>& data, std::size_t& offset)
+        {
+            if (data.size() - offset < sizeof(T))
+                throw std::runtime_error("Not enough tile layer data");
+            T value;
+            std::memcpy(&value, data.data() + offset, sizeof(value));
+            offset += sizeof(value);
+            return value;
+        }
+
+        void storeLayer(const RecastMesh& recastMesh, const rcHeightfield& solid, TileLayer& layer)
+        {
+            std::vector<std::byte> spans;
+            for (int i = 0, n = solid.width * solid.height; i < n; ++i)
+            {
+                std::uint16_t count = 0;
+                for (const rcSpan* span = solid.spans[i]; span != nullptr; span = span->next)
+                    ++count;
+                appendValue(count, spans);
+                for (const rcSpan* span = solid.spans[i]; span != nullptr; span = span->next)
+                {
+                    appendValue(static_cast<std::uint16_t>(span->smin), spans);
+                    appendValue(static_cast<std::uint16_t>(span->smax), spans);
+                    appendValue(static_cast<std::uint8_t>(span->area), spans);
+                }
+            }
+            layer.mMesh = recastMesh.getMesh();
+            layer.mWater = recastMesh.getWater();
+            layer.mHeightfields = recastMesh.getHeightfields();
+            layer.mFlatHeightfields = recastMesh.getFlatHeightfields();
+            layer.mMinZ = solid.bmin[1];
+            layer.mMaxZ = solid.bmax[1];
+            layer.mWidth = solid.width;
+            layer.mHeight = solid.height;
+            layer.mSpans = Misc::compress(spans);
+        }
+
+        [[nodiscard]] bool restoreLayer(RecastContext& context, const TileLayer& layer, const ColumnsRange& skip,
+            const RecastParams& params, rcHeightfield& solid)
+        {
+            const std::vector<std::byte> spans = Misc::decompress(layer.mSpans);
+            std::size_t offset = 0;
+            for (int y = 0; y < solid.height; ++y)
+            {
+                for (int x = 0; x < solid.width; ++x)
+                {
+                    const std::uint16_t count = readValue<std::uint16_t>(spans, offset);
+                    const bool skipped = contains(skip, x, y);
+                    for (std::uint16_t i = 0; i < count; ++i)
+                    {
+                        const std::uint16_t smin = readValue<std::uint16_t>(spans, offset);
+                        const std::uint16_t smax = readValue<std::uint16_t>(spans, offset);
+                        const std::uint8_t area = readValue<std::uint8_t>(spans, offset);
+                        if (!skipped && !rcAddSpan(&context, solid, x, y, smin, smax, area, params.mWalkableClimb))
+                            return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Gives the same heightfield as full rasterization. Spans of a column depend only on triangles overlapping
+        // it and their order, so columns not touched by changed triangles are copied from the previous layer.
+        [[nodiscard]] bool rasterizeChangedColumns(RecastContext& context, const TilePosition& tilePosition,
+            float agentHalfExtentsZ, const RecastMesh& recastMesh, const RecastSettings& settings,
+            const RecastParams& params, const TileLayer& previousLayer, const ColumnsRange& columns,
+            rcHeightfield& solid)
+        {
+            if (!restoreLayer(context, previousLayer, columns, params, solid))
+                return false;
+
+            if (isEmpty(columns))
+                return true;
+
+            rcHeightfield changed;
+            if (!rcCreateHeightfield(
+                    &context, changed, solid.width, solid.height, solid.bmin, solid.bmax, solid.cs, solid.ch))
+                return false;
+
+            // Triangles overlapping adjacent columns are rasterized too to not depend on rounding
+            const TileBounds bounds{
+                osg::Vec2f(solid.bmin[0] + static_cast<float>(columns.mMinX - 1) * solid.cs,
+                    solid.bmin[2] + static_cast<float>(columns.mMinY - 1) * solid.cs),
+                osg::Vec2f(solid.bmin[0] + static_cast<float>(columns.mMaxX + 1) * solid.cs,
+                    solid.bmin[2] + static_cast<float>(columns.mMaxY + 1) * solid.cs),
+            };
+
+            if (!rasterizeTriangles(context, tilePosition, agentHalfExtentsZ, recastMesh, settings, params, bounds,
+                    changed))
+                return false;
+
+            for (int y = columns.mMinY; y < columns.mMaxY; ++y)
+                for (int x = columns.mMinX; x < columns.mMaxX; ++x)
+                    for (const rcSpan* span = changed.spans[x + y * changed.width]; span != nullptr; span = span->next)
+                        if (!rcAddSpan(&context, solid, x, y, static_cast<std::uint16_t>(span->smin),
+                                static_cast<std::uint16_t>(span->smax), static_cast<std::uint8_t>(span->area),
+                                params.mWalkableClimb))
+                            return false;
+
+            return true;
+        }
+
         bool isValidWalkableHeight(int value)
         {
             return value >= 3;
@@ -518,6 +801,13 @@ namespace DetourNavigator
 
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
         const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings)
+    {
+        return prepareNavMeshTileData(recastMesh, worldspace, tilePosition, agentBounds, settings, nullptr, nullptr);
+    }
+
+    std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        const TileLayer* previousLayer, TileLayer* layer)
     {
         RecastContext context(worldspace, tilePosition, agentBounds, recastMesh.getVersion(), settings.mMaxLogLevel);
 
@@ -530,10 +820,23 @@ namespace DetourNavigator
 
         const RecastParams params = makeRecastParams(settings, agentBounds);
 
-        if (!rasterizeTriangles(
-                context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params, solid))
+        const std::optional<ColumnsRange> changedColumns = previousLayer == nullptr
+            ? std::nullopt
+            : getChangedColumns(*previousLayer, recastMesh, settings, solid);
+
+        if (changedColumns.has_value())
+        {
+            if (!rasterizeChangedColumns(context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings,
+                    params, *previousLayer, *changedColumns, solid))
+                return nullptr;
+        }
+        else if (!rasterizeTriangles(context, tilePosition, agentBounds.mHalfExtents.z(), recastMesh, settings, params,
+                     std::nullopt, solid))
             return nullptr;
 
+        if (layer != nullptr)
+            storeLayer(recastMesh, solid, *layer);
+
         rcFilterLowHangingWalkableObstacles(&context, params.mWalkableClimb, solid);
         rcFilterLedgeSpans(&context, params.mWalkableHeight, params.mWalkableClimb, solid);
         rcFilterWalkableLowHeightSpans(&context, params.mWalkableHeight, solid);
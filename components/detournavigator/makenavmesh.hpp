@@ -20,6 +20,7 @@ namespace DetourNavigator
     struct OffMeshConnection;
     struct AgentBounds;
     struct RecastSettings;
+    struct TileLayer;
 
     inline float getLength(const osg::Vec2i& value)
     {
@@ -46,6 +47,12 @@ namespace DetourNavigator
     std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
         const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings);
 
+    /// Rasterizes only columns affected by changed triangles when previousLayer is compatible with recastMesh and
+    /// copies the rest from it. Fills layer for the next call when it's not nullptr and rasterization succeeds.
+    std::unique_ptr<PreparedNavMeshData> prepareNavMeshTileData(const RecastMesh& recastMesh, ESM::RefId worldspace,
+        const TilePosition& tilePosition, const AgentBounds& agentBounds, const RecastSettings& settings,
+        const TileLayer* previousLayer, TileLayer* layer);
+
     NavMeshData makeNavMeshTileData(const PreparedNavMeshData& data,
         std::span<const OffMeshConnection> offMeshConnections, const AgentBounds& agentBounds, const TilePosition& tile,
         const RecastSettings& settings);
@@ -19,7 +19,8 @@ namespace DetourNavigator
             Log(Debug::Info) << "Using " << path << " to store navigation mesh cache";
             try
             {
-                db = std::make_unique<NavMeshDb>(path, settings.mMaxDbFileSize);
+                db = std::make_unique<NavMeshDb>(path, settings.mMaxDbFileSize, settings.mDbWalAutoCheckpoint,
+                    settings.mMaxDbTileCacheSize, settings.mCompressDbTiles);
             }
             catch (const std::exception& e)
             {
@@ -4,11 +4,13 @@
 #include <cassert>
 #include <filesystem>
 #include <optional>
+#include <span>
 
 #include "cellgridbounds.hpp"
 #include "heightfieldshape.hpp"
 #include "objectid.hpp"
 #include "objecttransform.hpp"
+#include "pathrequest.hpp"
 #include "recastmeshtiles.hpp"
 #include "sharednavmeshcacheitem.hpp"
 #include "updateguard.hpp"
@@ -197,6 +199,15 @@ namespace DetourNavigator
         virtual RecastMeshTiles getRecastMeshTiles() const = 0;
 
         virtual float getMaxNavmeshAreaRealRadius() const = 0;
+
+        /**
+         * @brief findPaths finds paths for multiple requests at once using worker threads.
+         * Requests for the same agent bounds share a single navmesh lock.
+         * @param requests define agent bounds, start, end and other parameters of each path.
+         * @param results has to have the same size as requests. Each result corresponds to the request at the same
+         * position.
+         */
+        virtual void findPaths(std::span<const PathRequest> requests, std::span<PathResult> results) const = 0;
     };
 
     std::unique_ptr<Navigator> makeNavigator(const Settings& settings, const std::filesystem::path& userDataPath);
@@ -12,6 +12,8 @@ namespace DetourNavigator
     NavigatorImpl::NavigatorImpl(const Settings& settings, std::unique_ptr<NavMeshDb>&& db)
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
+        , mBatchPathFinder(std::make_unique<BatchPathFinder>(
+              mSettings.mBatchPathFinderThreads, mSettings.mDetour.mMaxNavMeshQueryNodes))
     {
     }
 
@@ -212,4 +214,9 @@ namespace DetourNavigator
         const auto& settings = getSettings();
         return getRealTileSize(settings.mRecast) * getMaxNavmeshAreaRadius(settings);
     }
+
+    void NavigatorImpl::findPaths(std::span<const PathRequest> requests, std::span<PathResult> results) const
+    {
+        mBatchPathFinder->findPaths(*this, requests, results);
+    }
 }
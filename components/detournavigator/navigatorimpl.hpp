@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORIMPL_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVIGATORIMPL_H
 
+#include "batchpathfinder.hpp"
 #include "navigator.hpp"
 #include "navmeshmanager.hpp"
 #include "updateguard.hpp"
@@ -73,9 +74,12 @@ namespace DetourNavigator
 
         float getMaxNavmeshAreaRealRadius() const override;
 
+        void findPaths(std::span<const PathRequest> requests, std::span<PathResult> results) const override;
+
     private:
         Settings mSettings;
         NavMeshManager mNavMeshManager;
+        std::unique_ptr<BatchPathFinder> mBatchPathFinder;
         std::optional<TilePosition> mLastPlayerPosition;
         std::map<AgentBounds, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
@@ -88,6 +88,12 @@ namespace DetourNavigator
 
         float getMaxNavmeshAreaRealRadius() const override { return std::numeric_limits<float>::max(); }
 
+        void findPaths(std::span<const PathRequest> /*requests*/, std::span<PathResult> results) const override
+        {
+            for (PathResult& result : results)
+                result = PathResult{ .mStatus = Status::NavMeshNotFound, .mPath = {} };
+        }
+
     private:
         Settings mDefaultSettings{};
         SharedNavMeshCacheItem mEmptyNavMeshCacheItem;
@@ -6,6 +6,9 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <algorithm>
+#include <cstddef>
+
 namespace DetourNavigator
 {
     std::optional<osg::Vec3f> findRandomPointAroundCircle(const Navigator& navigator, const AgentBounds& agentBounds,
@@ -77,4 +80,24 @@ namespace DetourNavigator
 
         return fromNavMeshCoordinates(settings.mRecast, nearestNavMeshPos);
     }
+
+    Status findTileRoute(const Navigator& navigator, const AgentBounds& agentBounds, const osg::Vec3f& start,
+        const osg::Vec3f& end, const Flags includeFlags, std::vector<osg::Vec3f>& route)
+    {
+        const auto navMesh = navigator.getNavMesh(agentBounds);
+        if (navMesh == nullptr)
+            return Status::NavMeshNotFound;
+
+        const RecastSettings& settings = navigator.getSettings().mRecast;
+        const TilePosition startTile = getTilePosition(settings, toNavMeshCoordinates(settings, start));
+        const TilePosition endTile = getTilePosition(settings, toNavMeshCoordinates(settings, end));
+        const std::size_t begin = route.size();
+        const auto locked = navMesh->lock();
+        const Status status
+            = locked->getTileGraph().findRoute(locked->getImpl(), startTile, endTile, includeFlags, route);
+        std::transform(route.begin() + static_cast<std::ptrdiff_t>(begin), route.end(),
+            route.begin() + static_cast<std::ptrdiff_t>(begin),
+            [&](const osg::Vec3f& v) { return fromNavMeshCoordinates(settings, v); });
+        return status;
+    }
 }
@@ -12,6 +12,7 @@
 #include <iterator>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace DetourNavigator
 {
@@ -74,6 +75,19 @@ namespace DetourNavigator
      */
     std::optional<osg::Vec3f> findNearestNavMeshPosition(const Navigator& navigator, const AgentBounds& agentBounds,
         const osg::Vec3f& position, const osg::Vec3f& searchAreaHalfExtents, const Flags includeFlags);
+
+    /**
+     * @brief findTileRoute finds coarse route over navmesh tiles to be refined by findPath near the actor.
+     * Routes are cached by the navmesh until connectivity between tiles changes.
+     * @param agentBounds defines which navmesh to use.
+     * @param start of the route.
+     * @param end of the route.
+     * @param includeFlags setup allowed navmesh areas.
+     * @param route is filled with points on borders between consecutive tiles excluding start and end.
+     * @return Status. PartialPath when end is not reachable and route leads to the closest reachable tile.
+     */
+    Status findTileRoute(const Navigator& navigator, const AgentBounds& agentBounds, const osg::Vec3f& start,
+        const osg::Vec3f& end, const Flags includeFlags, std::vector<osg::Vec3f>& route);
 }
 
 #endif
@@ -111,6 +111,7 @@ namespace DetourNavigator
                 tile->second.mData = std::move(navMeshData);
             }
             ++mVersion.mRevision;
+            mTileGraph.invalidate(position);
             return UpdateNavMeshStatusBuilder().added(true).removed(removed).getResult();
         }
         else
@@ -119,6 +120,7 @@ namespace DetourNavigator
             {
                 mUsedTiles.erase(position);
                 ++mVersion.mRevision;
+                mTileGraph.invalidate(position);
             }
             return UpdateNavMeshStatusBuilder()
                 .removed(removed)
@@ -135,6 +137,7 @@ namespace DetourNavigator
         {
             mUsedTiles.erase(position);
             ++mVersion.mRevision;
+            mTileGraph.invalidate(position);
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
     }
@@ -147,6 +150,7 @@ namespace DetourNavigator
         {
             mUsedTiles.erase(position);
             ++mVersion.mRevision;
+            mTileGraph.invalidate(position);
         }
         return UpdateNavMeshStatusBuilder().removed(removed).getResult();
     }
@@ -3,6 +3,7 @@
 
 #include "navmeshdata.hpp"
 #include "navmeshtilescache.hpp"
+#include "tilegraph.hpp"
 #include "tileposition.hpp"
 #include "version.hpp"
 
@@ -112,6 +113,8 @@ namespace DetourNavigator
 
         dtNavMeshQuery& getQuery() { return mQuery; }
 
+        TileGraph& getTileGraph() { return mTileGraph; }
+
         const Version& getVersion() const { return mVersion; }
 
         UpdateNavMeshStatus updateTile(
@@ -151,6 +154,7 @@ namespace DetourNavigator
         Version mVersion;
         dtNavMesh mImpl;
         dtNavMeshQuery mQuery;
+        TileGraph mTileGraph;
         std::map<TilePosition, Tile> mUsedTiles;
         std::set<TilePosition> mEmptyTiles;
     };
@@ -1,4 +1,5 @@
 #include "navmeshdb.hpp"
+#include "gettilespositions.hpp"
 
 #include <components/debug/debuglog.hpp>
 #include <components/misc/compression.hpp>
@@ -9,9 +10,13 @@
 
 #include <sqlite3.h>
 
+#include <chrono>
 #include <cstddef>
 #include <format>
+#include <iterator>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 namespace DetourNavigator
@@ -29,7 +34,8 @@ namespace DetourNavigator
                 tile_position_y INTEGER NOT NULL,
                 version INTEGER NOT NULL,
                 input BLOB,
-                data BLOB
+                data BLOB,
+                data_compression INTEGER NOT NULL DEFAULT 1
             );
 
             CREATE UNIQUE INDEX IF NOT EXISTS index_unique_tiles_by_worldspace_and_tile_position_and_input
@@ -38,6 +44,9 @@ namespace DetourNavigator
             CREATE INDEX IF NOT EXISTS index_tiles_by_worldspace_and_tile_position
                 ON tiles (worldspace, tile_position_x, tile_position_y);
 
+            CREATE INDEX IF NOT EXISTS index_tiles_by_tile_position
+                ON tiles (tile_position_x, tile_position_y);
+
             CREATE TABLE IF NOT EXISTS shapes (
                 shape_id INTEGER PRIMARY KEY,
                 name TEXT NOT NULL,
@@ -48,9 +57,20 @@ namespace DetourNavigator
             CREATE UNIQUE INDEX IF NOT EXISTS index_unique_shapes_by_name_and_type_and_hash
                 ON shapes (name, type, hash);
 
+            CREATE TABLE IF NOT EXISTS meta (
+                meta_id INTEGER PRIMARY KEY CHECK (meta_id = 1),
+                db_id INTEGER NOT NULL
+            );
+
+            INSERT OR IGNORE INTO meta (meta_id, db_id) VALUES (1, random());
+
             COMMIT;
         )";
 
+        constexpr std::string_view getDbIdQuery = R"(
+            SELECT db_id FROM meta
+        )";
+
         constexpr std::string_view getMaxTileIdQuery = R"(
             SELECT max(tile_id) FROM tiles
         )";
@@ -65,7 +85,7 @@ namespace DetourNavigator
         )";
 
         constexpr std::string_view getTileDataQuery = R"(
-            SELECT tile_id, version, data
+            SELECT tile_id, version, data, data_compression
               FROM tiles
              WHERE worldspace = :worldspace
                AND tile_position_x = :tile_position_x
@@ -73,15 +93,27 @@ namespace DetourNavigator
                AND input = :input
         )";
 
+        constexpr std::string_view getTileDataByInputQuery = R"(
+            SELECT tile_id, version, data, data_compression
+              FROM tiles
+             WHERE tile_position_x = :tile_position_x
+               AND tile_position_y = :tile_position_y
+               AND input = :input
+             LIMIT 1
+        )";
+
         constexpr std::string_view insertTileQuery = R"(
-            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data)
-                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data)
+            INSERT INTO tiles ( tile_id,  worldspace,  version,  tile_position_x,  tile_position_y,  input,  data,
+                                data_compression)
+                   VALUES     (:tile_id, :worldspace, :version, :tile_position_x, :tile_position_y, :input, :data,
+                               :data_compression)
         )";
 
         constexpr std::string_view updateTileQuery = R"(
             UPDATE tiles
                SET version = :version,
                    data = :data,
+                   data_compression = :data_compression,
                    revision = revision + 1
              WHERE tile_id = :tile_id
         )";
@@ -132,6 +164,55 @@ namespace DetourNavigator
             VACUUM;
         )";
 
+        // Tiles written before data_compression column was added are always compressed with LZ4
+        constexpr const char addDataCompressionColumnQuery[] = R"(
+            ALTER TABLE tiles ADD COLUMN data_compression INTEGER NOT NULL DEFAULT 1;
+        )";
+
+        struct CountDataCompressionColumns
+        {
+            static std::string_view text() noexcept
+            {
+                return "SELECT count(*) FROM pragma_table_info('tiles') WHERE name = 'data_compression';";
+            }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        Sqlite3::Db makeDb(std::string_view path)
+        {
+            Sqlite3::Db db = Sqlite3::makeDb(path, schema);
+            std::int64_t count = 0;
+            {
+                Sqlite3::Statement<CountDataCompressionColumns> statement(*db);
+                request(*db, statement, &count, 1);
+            }
+            if (count != 0)
+                return db;
+            if (const int ec = sqlite3_exec(db.get(), addDataCompressionColumnQuery, nullptr, nullptr, nullptr);
+                ec != SQLITE_OK)
+                throw std::runtime_error(
+                    "Failed to add data_compression column: " + std::string(sqlite3_errmsg(db.get())));
+            return db;
+        }
+
+        struct EncodedTileData
+        {
+            TileDataCompression mCompression;
+            std::vector<std::byte> mData;
+        };
+
+        EncodedTileData encodeTileData(const std::vector<std::byte>& data, bool compress)
+        {
+            if (compress)
+            {
+                std::vector<std::byte> compressed = Misc::compress(data);
+                // Small tiles may become bigger after compression and it's cheaper to read them as is
+                if (compressed.size() < data.size())
+                    return EncodedTileData{ .mCompression = TileDataCompression::Lz4, .mData = std::move(compressed) };
+            }
+            return EncodedTileData{ .mCompression = TileDataCompression::None, .mData = data };
+        }
+
         struct GetPageSize
         {
             static std::string_view text() noexcept { return "pragma page_size;"; }
@@ -152,6 +233,36 @@ namespace DetourNavigator
             if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
                 throw std::runtime_error("Failed set max page count: " + std::string(sqlite3_errmsg(&db)));
         }
+
+        struct SetJournalModeWal
+        {
+            static std::string_view text() noexcept { return "pragma journal_mode = wal;"; }
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
+        bool setJournalModeWal(sqlite3& db)
+        {
+            Sqlite3::Statement<SetJournalModeWal> statement(db);
+            std::string value;
+            auto row = std::tie(value);
+            request(db, statement, &row, 1);
+            // In-memory database and database opened by other process in rollback journal mode keep own mode
+            return value == "wal";
+        }
+
+        void setWalAutoCheckpoint(sqlite3& db, int value)
+        {
+            // Full sync on each commit is not required in WAL mode to keep database consistent, only durability of
+            // the last transactions is lost on power failure which is fine for a cache.
+            const auto query = std::format("pragma wal_autocheckpoint = {}; pragma synchronous = normal;", value);
+            if (const int ec = sqlite3_exec(&db, query.c_str(), nullptr, nullptr, nullptr); ec != SQLITE_OK)
+                throw std::runtime_error("Failed set WAL autocheckpoint: " + std::string(sqlite3_errmsg(&db)));
+        }
+
+        std::size_t getSize(const std::vector<std::byte>& input, const TileData& value)
+        {
+            return sizeof(TileData) + input.size() + value.mData.size();
+        }
     }
 
     std::ostream& operator<<(std::ostream& stream, ShapeType value)
@@ -166,11 +277,14 @@ namespace DetourNavigator
         return stream << "unknown shape type (" << static_cast<std::underlying_type_t<ShapeType>>(value) << ")";
     }
 
-    NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize)
-        : mDb(Sqlite3::makeDb(path, schema))
+    NavMeshDb::NavMeshDb(std::string_view path, std::uint64_t maxFileSize, int walAutoCheckpoint,
+        std::size_t maxTileDataCacheSize, bool compressTileData)
+        : mDb(makeDb(path))
+        , mGetDbId(*mDb, DbQueries::GetDbId{})
         , mGetMaxTileId(*mDb, DbQueries::GetMaxTileId{})
         , mFindTile(*mDb, DbQueries::FindTile{})
         , mGetTileData(*mDb, DbQueries::GetTileData{})
+        , mGetTileDataByInput(*mDb, DbQueries::GetTileDataByInput{})
         , mInsertTile(*mDb, DbQueries::InsertTile{})
         , mUpdateTile(*mDb, DbQueries::UpdateTile{})
         , mDeleteTilesAt(*mDb, DbQueries::DeleteTilesAt{})
@@ -180,11 +294,17 @@ namespace DetourNavigator
         , mFindShapeId(*mDb, DbQueries::FindShapeId{})
         , mInsertShape(*mDb, DbQueries::InsertShape{})
         , mVacuum(*mDb, DbQueries::Vacuum{})
+        , mMaxTileDataCacheSize(maxTileDataCacheSize)
+        , mCompressTileData(compressTileData)
     {
         const std::uint64_t dbPageSize = getPageSize(*mDb);
         if (dbPageSize == 0)
             throw std::runtime_error("NavMeshDb page size is zero");
         setMaxPageCount(*mDb, maxFileSize / dbPageSize + static_cast<std::uint64_t>((maxFileSize % dbPageSize) != 0));
+        if (setJournalModeWal(*mDb))
+            setWalAutoCheckpoint(*mDb, walAutoCheckpoint);
+        else
+            Log(Debug::Debug) << "NavMeshDb is not in WAL journal mode";
     }
 
     Sqlite3::Transaction NavMeshDb::startTransaction(Sqlite3::TransactionMode mode)
@@ -192,6 +312,49 @@ namespace DetourNavigator
         return Sqlite3::Transaction(*mDb, mode);
     }
 
+    void NavMeshDb::cacheTileData(ESM::RefId worldspace, const TilePosition& tilePosition,
+        const std::vector<std::byte>& input, const TileData& value)
+    {
+        const std::size_t size = getSize(input, value);
+        if (size > mMaxTileDataCacheSize)
+            return;
+        while (!mTileDataCacheItems.empty() && mStats.mTileDataCacheSize + size > mMaxTileDataCacheSize)
+        {
+            const auto it = std::prev(mTileDataCacheItems.end());
+            mStats.mTileDataCacheSize -= it->mSize;
+            mTileDataCacheIndex.erase(it->mKey);
+            mTileDataCacheItems.erase(it);
+        }
+        mTileDataCacheItems.push_front(CachedTileData{ .mKey = {}, .mValue = value, .mSize = size });
+        mTileDataCacheItems.front().mKey
+            = mTileDataCacheIndex.emplace(std::make_tuple(worldspace, tilePosition, input), mTileDataCacheItems.begin())
+                  .first;
+        mStats.mTileDataCacheSize += size;
+    }
+
+    template <class Predicate>
+    void NavMeshDb::eraseCachedTileData(Predicate&& predicate)
+    {
+        for (auto it = mTileDataCacheItems.begin(); it != mTileDataCacheItems.end();)
+        {
+            if (!predicate(it->mKey->first, it->mValue))
+            {
+                ++it;
+                continue;
+            }
+            mStats.mTileDataCacheSize -= it->mSize;
+            mTileDataCacheIndex.erase(it->mKey);
+            it = mTileDataCacheItems.erase(it);
+        }
+    }
+
+    std::int64_t NavMeshDb::getDbId()
+    {
+        std::int64_t dbId = 0;
+        request(*mDb, mGetDbId, &dbId, 1);
+        return dbId;
+    }
+
     TileId NavMeshDb::getMaxTileId()
     {
         TileId tileId{ 0 };
@@ -213,12 +376,35 @@ namespace DetourNavigator
     std::optional<TileData> NavMeshDb::getTileData(
         ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input)
     {
+        ++mStats.mTileDataCacheGetCount;
+        if (const auto it = mTileDataCacheIndex.find(std::tie(worldspace, tilePosition, input));
+            it != mTileDataCacheIndex.end())
+        {
+            ++mStats.mTileDataCacheHitCount;
+            mTileDataCacheItems.splice(mTileDataCacheItems.begin(), mTileDataCacheItems, it->second);
+            return it->second->mValue;
+        }
         TileData result;
-        auto row = std::tie(result.mTileId, result.mVersion, result.mData);
+        std::int64_t compression = 0;
+        auto row = std::tie(result.mTileId, result.mVersion, result.mData, compression);
         const std::vector<std::byte> compressedInput = Misc::compress(input);
         if (&row == request(*mDb, mGetTileData, &row, 1, worldspace.serializeText(), tilePosition, compressedInput))
             return {};
-        result.mData = Misc::decompress(result.mData);
+        result.mData = decodeTileData(std::move(result.mData), compression);
+        cacheTileData(worldspace, tilePosition, input, result);
+        return result;
+    }
+
+    std::optional<TileData> NavMeshDb::getTileDataByInput(
+        const TilePosition& tilePosition, const std::vector<std::byte>& input)
+    {
+        TileData result;
+        std::int64_t compression = 0;
+        auto row = std::tie(result.mTileId, result.mVersion, result.mData, compression);
+        const std::vector<std::byte> compressedInput = Misc::compress(input);
+        if (&row == request(*mDb, mGetTileDataByInput, &row, 1, tilePosition, compressedInput))
+            return {};
+        result.mData = decodeTileData(std::move(result.mData), compression);
         return result;
     }
 
@@ -226,29 +412,44 @@ namespace DetourNavigator
         TileVersion version, const std::vector<std::byte>& input, const std::vector<std::byte>& data)
     {
         const std::vector<std::byte> compressedInput = Misc::compress(input);
-        const std::vector<std::byte> compressedData = Misc::compress(data);
+        const EncodedTileData encodedData = encodeTileData(data, mCompressTileData);
+        mStats.mEncodedDataSize += encodedData.mData.size();
+        mStats.mDecodedDataSize += data.size();
         return execute(*mDb, mInsertTile, tileId, worldspace.serializeText(), tilePosition, version, compressedInput,
-            compressedData);
+            encodedData.mData, encodedData.mCompression);
     }
 
     int NavMeshDb::updateTile(TileId tileId, TileVersion version, const std::vector<std::byte>& data)
     {
-        const std::vector<std::byte> compressedData = Misc::compress(data);
-        return execute(*mDb, mUpdateTile, tileId, version, compressedData);
+        const EncodedTileData encodedData = encodeTileData(data, mCompressTileData);
+        mStats.mEncodedDataSize += encodedData.mData.size();
+        mStats.mDecodedDataSize += data.size();
+        eraseCachedTileData([&](const auto& /*key*/, const TileData& value) { return value.mTileId == tileId; });
+        return execute(*mDb, mUpdateTile, tileId, version, encodedData.mData, encodedData.mCompression);
     }
 
     int NavMeshDb::deleteTilesAt(ESM::RefId worldspace, const TilePosition& tilePosition)
     {
+        eraseCachedTileData([&](const auto& key, const TileData& /*value*/) {
+            return std::get<0>(key) == worldspace && std::get<1>(key) == tilePosition;
+        });
         return execute(*mDb, mDeleteTilesAt, worldspace.serializeText(), tilePosition);
     }
 
     int NavMeshDb::deleteTilesAtExcept(ESM::RefId worldspace, const TilePosition& tilePosition, TileId excludeTileId)
     {
+        eraseCachedTileData([&](const auto& key, const TileData& value) {
+            return std::get<0>(key) == worldspace && std::get<1>(key) == tilePosition
+                && value.mTileId != excludeTileId;
+        });
         return execute(*mDb, mDeleteTilesAtExcept, worldspace.serializeText(), tilePosition, excludeTileId);
     }
 
     int NavMeshDb::deleteTilesOutsideRange(ESM::RefId worldspace, const TilesPositionsRange& range)
     {
+        eraseCachedTileData([&](const auto& key, const TileData& /*value*/) {
+            return std::get<0>(key) == worldspace && !isInTilesPositionsRange(range, std::get<1>(key));
+        });
         return execute(*mDb, mDeleteTilesOutsideRange, worldspace.serializeText(), range);
     }
 
@@ -277,8 +478,39 @@ namespace DetourNavigator
         execute(*mDb, mVacuum);
     }
 
+    NavMeshDbStats NavMeshDb::getStats() const
+    {
+        return mStats;
+    }
+
+    std::vector<std::byte> NavMeshDb::decodeTileData(std::vector<std::byte> data, std::int64_t compression)
+    {
+        const std::size_t encodedSize = data.size();
+        const auto start = std::chrono::steady_clock::now();
+        switch (static_cast<TileDataCompression>(compression))
+        {
+            case TileDataCompression::None:
+                break;
+            case TileDataCompression::Lz4:
+                data = Misc::decompress(data);
+                break;
+            default:
+                throw std::runtime_error("Unsupported navmeshdb tile data compression: " + std::to_string(compression));
+        }
+        mStats.mDecodeTime += std::chrono::steady_clock::now() - start;
+        ++mStats.mDecodeCount;
+        mStats.mEncodedDataSize += encodedSize;
+        mStats.mDecodedDataSize += data.size();
+        return data;
+    }
+
     namespace DbQueries
     {
+        std::string_view GetDbId::text() noexcept
+        {
+            return getDbIdQuery;
+        }
+
         std::string_view GetMaxTileId::text() noexcept
         {
             return getMaxTileIdQuery;
@@ -312,6 +544,19 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":input", input);
         }
 
+        std::string_view GetTileDataByInput::text() noexcept
+        {
+            return getTileDataByInputQuery;
+        }
+
+        void GetTileDataByInput::bind(sqlite3& db, sqlite3_stmt& statement, const TilePosition& tilePosition,
+            const std::vector<std::byte>& input)
+        {
+            Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
+            Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
+            Sqlite3::bindParameter(db, statement, ":input", input);
+        }
+
         std::string_view InsertTile::text() noexcept
         {
             return insertTileQuery;
@@ -319,7 +564,7 @@ namespace DetourNavigator
 
         void InsertTile::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
             const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-            const std::vector<std::byte>& data)
+            const std::vector<std::byte>& data, TileDataCompression dataCompression)
         {
             Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
             Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
@@ -328,6 +573,7 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":version", version);
             Sqlite3::bindParameter(db, statement, ":input", input);
             Sqlite3::bindParameter(db, statement, ":data", data);
+            Sqlite3::bindParameter(db, statement, ":data_compression", static_cast<int>(dataCompression));
         }
 
         std::string_view UpdateTile::text() noexcept
@@ -336,11 +582,12 @@ namespace DetourNavigator
         }
 
         void UpdateTile::bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, TileVersion version,
-            const std::vector<std::byte>& data)
+            const std::vector<std::byte>& data, TileDataCompression dataCompression)
         {
             Sqlite3::bindParameter(db, statement, ":tile_id", tileId);
             Sqlite3::bindParameter(db, statement, ":version", version);
             Sqlite3::bindParameter(db, statement, ":data", data);
+            Sqlite3::bindParameter(db, statement, ":data_compression", static_cast<int>(dataCompression));
         }
 
         std::string_view DeleteTilesAt::text() noexcept
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
 
+#include "stats.hpp"
 #include "tileposition.hpp"
 #include "tilespositionsrange.hpp"
 
@@ -13,8 +14,12 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
 #include <optional>
 #include <string_view>
+#include <tuple>
 #include <vector>
 
 struct sqlite3;
@@ -40,6 +45,12 @@ namespace DetourNavigator
         std::vector<std::byte> mData;
     };
 
+    enum class TileDataCompression
+    {
+        None = 0,
+        Lz4 = 1,
+    };
+
     enum class ShapeType
     {
         Collision = 1,
@@ -50,6 +61,12 @@ namespace DetourNavigator
 
     namespace DbQueries
     {
+        struct GetDbId
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3&, sqlite3_stmt&) {}
+        };
+
         struct GetMaxTileId
         {
             static std::string_view text() noexcept;
@@ -70,19 +87,26 @@ namespace DetourNavigator
                 const TilePosition& tilePosition, const std::vector<std::byte>& input);
         };
 
+        struct GetTileDataByInput
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, const TilePosition& tilePosition,
+                const std::vector<std::byte>& input);
+        };
+
         struct InsertTile
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, std::string_view worldspace,
                 const TilePosition& tilePosition, TileVersion version, const std::vector<std::byte>& input,
-                const std::vector<std::byte>& data);
+                const std::vector<std::byte>& data, TileDataCompression dataCompression);
         };
 
         struct UpdateTile
         {
             static std::string_view text() noexcept;
             static void bind(sqlite3& db, sqlite3_stmt& statement, TileId tileId, TileVersion version,
-                const std::vector<std::byte>& data);
+                const std::vector<std::byte>& data, TileDataCompression dataCompression);
         };
 
         struct DeleteTilesAt
@@ -136,10 +160,21 @@ namespace DetourNavigator
     class NavMeshDb
     {
     public:
-        explicit NavMeshDb(std::string_view path, std::uint64_t maxFileSize);
+        static constexpr int defaultWalAutoCheckpoint = 1000;
+
+        // Database is opened in WAL journal mode when possible. walAutoCheckpoint is a number of pages in the WAL file
+        // to run automatic checkpoint, zero disables automatic checkpoints. maxTileDataCacheSize limits memory used to
+        // keep recently fetched tiles by getTileData. compressTileData enables LZ4 compression for written tiles data,
+        // each tile is stored as is when compression doesn't reduce its size. Reading supports both.
+        explicit NavMeshDb(std::string_view path, std::uint64_t maxFileSize,
+            int walAutoCheckpoint = defaultWalAutoCheckpoint, std::size_t maxTileDataCacheSize = 0,
+            bool compressTileData = true);
 
         Sqlite3::Transaction startTransaction(Sqlite3::TransactionMode mode = Sqlite3::TransactionMode::Default);
 
+        // Random value generated on database creation. Allows to detect when the database file is replaced.
+        std::int64_t getDbId();
+
         TileId getMaxTileId();
 
         std::optional<Tile> findTile(
@@ -148,6 +183,11 @@ namespace DetourNavigator
         std::optional<TileData> getTileData(
             ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input);
 
+        // Input doesn't depend on worldspace so tile generated for one worldspace is valid for any other with the same
+        // input, for example for a copy of an interior cell.
+        std::optional<TileData> getTileDataByInput(
+            const TilePosition& tilePosition, const std::vector<std::byte>& input);
+
         int insertTile(TileId tileId, ESM::RefId worldspace, const TilePosition& tilePosition, TileVersion version,
             const std::vector<std::byte>& input, const std::vector<std::byte>& data);
 
@@ -167,11 +207,27 @@ namespace DetourNavigator
 
         void vacuum();
 
+        NavMeshDbStats getStats() const;
+
     private:
+        struct CachedTileData;
+
+        using TileDataCacheKey = std::tuple<ESM::RefId, TilePosition, std::vector<std::byte>>;
+        using TileDataCacheIndex = std::map<TileDataCacheKey, std::list<CachedTileData>::iterator, std::less<>>;
+
+        struct CachedTileData
+        {
+            TileDataCacheIndex::iterator mKey;
+            TileData mValue;
+            std::size_t mSize;
+        };
+
         Sqlite3::Db mDb;
+        Sqlite3::Statement<DbQueries::GetDbId> mGetDbId;
         Sqlite3::Statement<DbQueries::GetMaxTileId> mGetMaxTileId;
         Sqlite3::Statement<DbQueries::FindTile> mFindTile;
         Sqlite3::Statement<DbQueries::GetTileData> mGetTileData;
+        Sqlite3::Statement<DbQueries::GetTileDataByInput> mGetTileDataByInput;
         Sqlite3::Statement<DbQueries::InsertTile> mInsertTile;
         Sqlite3::Statement<DbQueries::UpdateTile> mUpdateTile;
         Sqlite3::Statement<DbQueries::DeleteTilesAt> mDeleteTilesAt;
@@ -181,6 +237,20 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
         Sqlite3::Statement<DbQueries::Vacuum> mVacuum;
+        std::size_t mMaxTileDataCacheSize;
+        bool mCompressTileData;
+        NavMeshDbStats mStats;
+        // Most recently used items are at the beginning
+        std::list<CachedTileData> mTileDataCacheItems;
+        TileDataCacheIndex mTileDataCacheIndex;
+
+        void cacheTileData(ESM::RefId worldspace, const TilePosition& tilePosition, const std::vector<std::byte>& input,
+            const TileData& value);
+
+        template <class Predicate>
+        void eraseCachedTileData(Predicate&& predicate);
+
+        std::vector<std::byte> decodeTileData(std::vector<std::byte> data, std::int64_t compression);
     };
 }
 
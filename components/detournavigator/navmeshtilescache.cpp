@@ -1,10 +1,28 @@
 #include "navmeshtilescache.hpp"
 #include "stats.hpp"
 
+#include <components/misc/hash.hpp>
+
+#include <algorithm>
 #include <cstring>
 
 namespace DetourNavigator
 {
+    namespace
+    {
+        std::size_t makeHash(
+            const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh)
+        {
+            std::size_t result = recastMesh.getHash();
+            Misc::hashCombine(result, static_cast<int>(agentBounds.mShapeType));
+            Misc::hashCombine(result, agentBounds.mHalfExtents.x());
+            Misc::hashCombine(result, agentBounds.mHalfExtents.y());
+            Misc::hashCombine(result, agentBounds.mHalfExtents.z());
+            Misc::hashCombine(result, Misc::hash2dCoord(changedTile.x(), changedTile.y()));
+            return result;
+        }
+    }
+
     NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize)
         : mMaxNavMeshDataSize(maxNavMeshDataSize)
         , mUsedNavMeshDataSize(0)
@@ -17,11 +35,13 @@ namespace DetourNavigator
     NavMeshTilesCache::Value NavMeshTilesCache::get(
         const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh)
     {
+        const std::size_t hash = makeHash(agentBounds, changedTile, recastMesh);
+
         const std::lock_guard<std::mutex> lock(mMutex);
 
         ++mGetCount;
 
-        const auto tile = mValues.find(std::tie(agentBounds, changedTile, recastMesh));
+        const auto tile = findUnsafe(hash, agentBounds, changedTile, recastMesh);
         if (tile == mValues.end())
             return Value();
 
@@ -37,30 +57,30 @@ namespace DetourNavigator
     {
         const auto itemSize = sizeof(RecastMesh) + getSize(recastMesh)
             + (value == nullptr ? 0 : sizeof(PreparedNavMeshData) + getSize(*value));
+        const std::size_t hash = makeHash(agentBounds, changedTile, recastMesh);
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
         if (itemSize > mFreeNavMeshDataSize + (mMaxNavMeshDataSize - mUsedNavMeshDataSize))
             return Value();
 
+        if (const auto existing = findUnsafe(hash, agentBounds, changedTile, recastMesh); existing != mValues.end())
+        {
+            acquireItemUnsafe(existing->second);
+            ++mGetCount;
+            ++mHitCount;
+            return Value(*this, existing->second);
+        }
+
         while (!mFreeItems.empty() && mUsedNavMeshDataSize + itemSize > mMaxNavMeshDataSize)
             removeLeastRecentlyUsed();
 
         RecastMeshData key{ recastMesh.getMesh(), recastMesh.getWater(), recastMesh.getHeightfields(),
             recastMesh.getFlatHeightfields() };
 
-        const auto iterator = mFreeItems.emplace(mFreeItems.end(), agentBounds, changedTile, std::move(key), itemSize);
-        const auto emplaced = mValues.emplace(
-            std::make_tuple(agentBounds, changedTile, std::cref(iterator->mRecastMeshData)), iterator);
-
-        if (!emplaced.second)
-        {
-            mFreeItems.erase(iterator);
-            acquireItemUnsafe(emplaced.first->second);
-            ++mGetCount;
-            ++mHitCount;
-            return Value(*this, emplaced.first->second);
-        }
+        const auto iterator
+            = mFreeItems.emplace(mFreeItems.end(), hash, agentBounds, changedTile, std::move(key), itemSize);
+        mValues.emplace(hash, iterator);
 
         iterator->mPreparedNavMeshData = std::move(value);
         ++iterator->mUseCount;
@@ -84,12 +104,25 @@ namespace DetourNavigator
         return result;
     }
 
+    NavMeshTilesCache::Values::const_iterator NavMeshTilesCache::findUnsafe(std::size_t hash,
+        const AgentBounds& agentBounds, const TilePosition& changedTile, const RecastMesh& recastMesh) const
+    {
+        const auto [begin, end] = mValues.equal_range(hash);
+        const auto it = std::find_if(begin, end, [&](const auto& v) {
+            const Item& item = *v.second;
+            return item.mAgentBounds == agentBounds && item.mChangedTile == changedTile
+                && item.mRecastMeshData == recastMesh;
+        });
+        return it == end ? mValues.end() : it;
+    }
+
     void NavMeshTilesCache::removeLeastRecentlyUsed()
     {
         const auto& item = mFreeItems.back();
 
-        const auto value = mValues.find(std::tie(item.mAgentBounds, item.mChangedTile, item.mRecastMeshData));
-        if (value == mValues.end())
+        const auto [begin, end] = mValues.equal_range(item.mHash);
+        const auto value = std::find_if(begin, end, [&](const auto& v) { return &*v.second == &item; });
+        if (value == end)
             return;
 
         mUsedNavMeshDataSize -= item.mSize;
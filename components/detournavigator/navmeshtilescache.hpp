@@ -10,8 +10,8 @@
 #include <cassert>
 #include <cstring>
 #include <list>
-#include <map>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace DetourNavigator
@@ -24,22 +24,10 @@ namespace DetourNavigator
         std::vector<FlatHeightfield> mFlatHeightfields;
     };
 
-    inline bool operator<(const RecastMeshData& lhs, const RecastMeshData& rhs)
+    inline bool operator==(const RecastMeshData& lhs, const RecastMesh& rhs)
     {
         return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields)
-            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields);
-    }
-
-    inline bool operator<(const RecastMeshData& lhs, const RecastMesh& rhs)
-    {
-        return std::tie(lhs.mMesh, lhs.mWater, lhs.mHeightfields, lhs.mFlatHeightfields)
-            < std::tie(rhs.getMesh(), rhs.getWater(), rhs.getHeightfields(), rhs.getFlatHeightfields());
-    }
-
-    inline bool operator<(const RecastMesh& lhs, const RecastMeshData& rhs)
-    {
-        return std::tie(lhs.getMesh(), lhs.getWater(), lhs.getHeightfields(), lhs.getFlatHeightfields())
-            < std::tie(rhs.mMesh, rhs.mWater, rhs.mHeightfields, rhs.mFlatHeightfields);
+            == std::tie(rhs.getMesh(), rhs.getWater(), rhs.getHeightfields(), rhs.getFlatHeightfields());
     }
 
     struct NavMeshTilesCacheStats;
@@ -50,15 +38,17 @@ namespace DetourNavigator
         struct Item
         {
             std::atomic<std::int64_t> mUseCount;
+            std::size_t mHash;
             AgentBounds mAgentBounds;
             TilePosition mChangedTile;
             RecastMeshData mRecastMeshData;
             std::unique_ptr<PreparedNavMeshData> mPreparedNavMeshData;
             std::size_t mSize;
 
-            Item(const AgentBounds& agentBounds, const TilePosition& changedTile, RecastMeshData&& recastMeshData,
-                std::size_t size)
+            Item(std::size_t hash, const AgentBounds& agentBounds, const TilePosition& changedTile,
+                RecastMeshData&& recastMeshData, std::size_t size)
                 : mUseCount(0)
+                , mHash(hash)
                 , mAgentBounds(agentBounds)
                 , mChangedTile(changedTile)
                 , mRecastMeshData(std::move(recastMeshData))
@@ -133,6 +123,8 @@ namespace DetourNavigator
         NavMeshTilesCacheStats getStats() const;
 
     private:
+        using Values = std::unordered_multimap<std::size_t, ItemIterator>;
+
         mutable std::mutex mMutex;
         std::size_t mMaxNavMeshDataSize;
         std::size_t mUsedNavMeshDataSize;
@@ -141,9 +133,12 @@ namespace DetourNavigator
         std::size_t mGetCount;
         std::list<Item> mBusyItems;
         std::list<Item> mFreeItems;
-        std::map<std::tuple<AgentBounds, TilePosition, std::reference_wrapper<const RecastMeshData>>, ItemIterator,
-            std::less<>>
-            mValues;
+        // Keyed by a hash of agent bounds, tile position and precomputed recast mesh hash to avoid full recast mesh
+        // comparison for each visited tree node. Full comparison is done only for the items with the same hash.
+        Values mValues;
+
+        Values::const_iterator findUnsafe(std::size_t hash, const AgentBounds& agentBounds,
+            const TilePosition& changedTile, const RecastMesh& recastMesh) const;
 
         void removeLeastRecentlyUsed();
 
@@ -0,0 +1,33 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHREQUEST_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_PATHREQUEST_H
+
+#include "agentbounds.hpp"
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "status.hpp"
+
+#include <osg/Vec3f>
+
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct PathRequest
+    {
+        AgentBounds mAgentBounds;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags = Flag_none;
+        AreaCosts mAreaCosts;
+        float mEndTolerance = 0;
+        std::vector<osg::Vec3f> mCheckpoints;
+    };
+
+    struct PathResult
+    {
+        Status mStatus = Status::Success;
+        std::vector<osg::Vec3f> mPath;
+    };
+}
+
+#endif
@@ -1,8 +1,30 @@
 #include "recastmesh.hpp"
 #include "exceptions.hpp"
 
+#include <components/misc/hash.hpp>
+
+#include <string_view>
+#include <type_traits>
+
 namespace DetourNavigator
 {
+    namespace
+    {
+        template <class T>
+        void hashCombineRange(std::size_t& seed, const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            Misc::hashCombine(seed,
+                std::string_view(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T)));
+        }
+
+        void hashCombine(std::size_t& seed, const osg::Vec2i& value)
+        {
+            Misc::hashCombine(seed, value.x());
+            Misc::hashCombine(seed, value.y());
+        }
+    }
+
     Mesh::Mesh(std::vector<int>&& indices, std::vector<float>&& vertices, std::vector<AreaType>&& areaTypes)
     {
         if (indices.size() / 3 != areaTypes.size())
@@ -25,10 +47,45 @@ namespace DetourNavigator
         , mHeightfields(std::move(heightfields))
         , mFlatHeightfields(std::move(flatHeightfields))
         , mMeshSources(std::move(meshSources))
+        , mHash(DetourNavigator::getHash(mMesh, mWater, mHeightfields, mFlatHeightfields))
     {
         mWater.shrink_to_fit();
         mHeightfields.shrink_to_fit();
         for (Heightfield& v : mHeightfields)
             v.mHeights.shrink_to_fit();
     }
+
+    std::size_t getHash(const Mesh& mesh, const std::vector<CellWater>& water,
+        const std::vector<Heightfield>& heightfields, const std::vector<FlatHeightfield>& flatHeightfields)
+    {
+        std::size_t result = 0;
+        hashCombineRange(result, mesh.getIndices());
+        hashCombineRange(result, mesh.getVertices());
+        hashCombineRange(result, mesh.getAreaTypes());
+        for (const CellWater& v : water)
+        {
+            hashCombine(result, v.mCellPosition);
+            Misc::hashCombine(result, v.mWater.mCellSize);
+            Misc::hashCombine(result, v.mWater.mLevel);
+        }
+        for (const Heightfield& v : heightfields)
+        {
+            hashCombine(result, v.mCellPosition);
+            Misc::hashCombine(result, v.mCellSize);
+            Misc::hashCombine(result, v.mLength);
+            Misc::hashCombine(result, v.mMinHeight);
+            Misc::hashCombine(result, v.mMaxHeight);
+            hashCombineRange(result, v.mHeights);
+            Misc::hashCombine(result, v.mOriginalSize);
+            Misc::hashCombine(result, v.mMinX);
+            Misc::hashCombine(result, v.mMinY);
+        }
+        for (const FlatHeightfield& v : flatHeightfields)
+        {
+            hashCombine(result, v.mCellPosition);
+            Misc::hashCombine(result, v.mCellSize);
+            Misc::hashCombine(result, v.mHeight);
+        }
+        return result;
+    }
 }
@@ -10,6 +10,7 @@
 #include <osg/Vec2i>
 #include <osg/Vec3f>
 
+#include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <tuple>
@@ -39,6 +40,12 @@ namespace DetourNavigator
                 < std::tie(rhs.mIndices, rhs.mVertices, rhs.mAreaTypes);
         }
 
+        friend inline bool operator==(const Mesh& lhs, const Mesh& rhs) noexcept
+        {
+            return std::tie(lhs.mIndices, lhs.mVertices, lhs.mAreaTypes)
+                == std::tie(rhs.mIndices, rhs.mVertices, rhs.mAreaTypes);
+        }
+
         friend inline std::size_t getSize(const Mesh& value) noexcept
         {
             return value.mIndices.size() * sizeof(int) + value.mVertices.size() * sizeof(float)
@@ -58,6 +65,12 @@ namespace DetourNavigator
         return tie(lhs) < tie(rhs);
     }
 
+    inline bool operator==(const Water& lhs, const Water& rhs) noexcept
+    {
+        const auto tie = [](const Water& v) { return std::tie(v.mCellSize, v.mLevel); };
+        return tie(lhs) == tie(rhs);
+    }
+
     struct CellWater
     {
         osg::Vec2i mCellPosition;
@@ -70,6 +83,12 @@ namespace DetourNavigator
         return tie(lhs) < tie(rhs);
     }
 
+    inline bool operator==(const CellWater& lhs, const CellWater& rhs) noexcept
+    {
+        const auto tie = [](const CellWater& v) { return std::tie(v.mCellPosition, v.mWater); };
+        return tie(lhs) == tie(rhs);
+    }
+
     inline osg::Vec2f getWaterShift2d(const osg::Vec2i& cellPosition, int cellSize)
     {
         return osg::Vec2f((cellPosition.x() + 0.5f) * cellSize, (cellPosition.y() + 0.5f) * cellSize);
@@ -104,6 +123,11 @@ namespace DetourNavigator
         return makeTuple(lhs) < makeTuple(rhs);
     }
 
+    inline bool operator==(const Heightfield& lhs, const Heightfield& rhs) noexcept
+    {
+        return makeTuple(lhs) == makeTuple(rhs);
+    }
+
     struct FlatHeightfield
     {
         osg::Vec2i mCellPosition;
@@ -117,6 +141,15 @@ namespace DetourNavigator
         return tie(lhs) < tie(rhs);
     }
 
+    inline bool operator==(const FlatHeightfield& lhs, const FlatHeightfield& rhs) noexcept
+    {
+        const auto tie = [](const FlatHeightfield& v) { return std::tie(v.mCellPosition, v.mCellSize, v.mHeight); };
+        return tie(lhs) == tie(rhs);
+    }
+
+    std::size_t getHash(const Mesh& mesh, const std::vector<CellWater>& water,
+        const std::vector<Heightfield>& heightfields, const std::vector<FlatHeightfield>& flatHeightfields);
+
     struct MeshSource
     {
         osg::ref_ptr<const Resource::BulletShape> mShape;
@@ -143,6 +176,9 @@ namespace DetourNavigator
 
         const std::vector<MeshSource>& getMeshSources() const noexcept { return mMeshSources; }
 
+        /// Hash of the geometry: mesh, water, heightfields and flat heightfields. Computed once on construction.
+        std::size_t getHash() const noexcept { return mHash; }
+
     private:
         Version mVersion;
         Mesh mMesh;
@@ -150,6 +186,7 @@ namespace DetourNavigator
         std::vector<Heightfield> mHeightfields;
         std::vector<FlatHeightfield> mFlatHeightfields;
         std::vector<MeshSource> mMeshSources;
+        std::size_t mHash;
 
         friend inline std::size_t getSize(const RecastMesh& value) noexcept
         {
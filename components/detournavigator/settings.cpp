@@ -95,7 +95,9 @@ namespace DetourNavigator
         result.mMaxTilesNumber = std::min(limits.mMaxTiles, ::Settings::navigator().mMaxTilesNumber.get());
         result.mWaitUntilMinDistanceToPlayer = ::Settings::navigator().mWaitUntilMinDistanceToPlayer;
         result.mAsyncNavMeshUpdaterThreads = ::Settings::navigator().mAsyncNavMeshUpdaterThreads;
+        result.mBatchPathFinderThreads = ::Settings::navigator().mBatchPathFinderThreads;
         result.mMaxNavMeshTilesCacheSize = ::Settings::navigator().mMaxNavMeshTilesCacheSize;
+        result.mMaxNavMeshTileLayersCacheSize = ::Settings::navigator().mMaxNavMeshTileLayersCacheSize;
         result.mEnableWriteRecastMeshToFile = ::Settings::navigator().mEnableWriteRecastMeshToFile;
         result.mEnableWriteNavMeshToFile = ::Settings::navigator().mEnableWriteNavMeshToFile;
         result.mRecastMeshPathPrefix = ::Settings::navigator().mRecastMeshPathPrefix;
@@ -106,6 +108,10 @@ namespace DetourNavigator
         result.mEnableNavMeshDiskCache = ::Settings::navigator().mEnableNavMeshDiskCache;
         result.mWriteToNavMeshDb = ::Settings::navigator().mWriteToNavmeshdb;
         result.mMaxDbFileSize = ::Settings::navigator().mMaxNavmeshdbFileSize;
+        result.mDbWriteBatchSize = ::Settings::navigator().mNavmeshdbWriteBatchSize;
+        result.mDbWalAutoCheckpoint = ::Settings::navigator().mNavmeshdbWalAutocheckpoint;
+        result.mMaxDbTileCacheSize = ::Settings::navigator().mMaxNavmeshdbTileCacheSize;
+        result.mCompressDbTiles = ::Settings::navigator().mCompressNavmeshdbTiles;
 
         if (result.mMaxTilesNumber < ::Settings::navigator().mMaxTilesNumber.get())
             Log(Debug::Warning)
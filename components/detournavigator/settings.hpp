@@ -49,14 +49,20 @@ namespace DetourNavigator
         int mWaitUntilMinDistanceToPlayer = 0;
         int mMaxTilesNumber = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
+        std::size_t mBatchPathFinderThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        std::size_t mMaxNavMeshTileLayersCacheSize = 0;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
         std::uint64_t mMaxDbFileSize = 0;
+        std::size_t mDbWriteBatchSize = 0;
+        int mDbWalAutoCheckpoint = 0;
+        std::size_t mMaxDbTileCacheSize = 0;
+        bool mCompressDbTiles = false;
     };
 
-    inline constexpr std::int64_t navMeshFormatVersion = 2;
+    inline constexpr std::int64_t navMeshFormatVersion = 3;
 
     Settings makeSettingsFromSettingsManager(Debug::Level maxLogLevel);
 }
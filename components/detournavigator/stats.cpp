@@ -25,6 +25,21 @@ namespace DetourNavigator
 
                 out.setAttribute(frameNumber, "NavMesh DbCache Get", static_cast<double>(stats.mDb->mGetTileCount));
                 out.setAttribute(frameNumber, "NavMesh DbCache Hit", static_cast<double>(stats.mDbGetTileHits));
+                out.setAttribute(
+                    frameNumber, "NavMesh DbCache Shared", static_cast<double>(stats.mDb->mGetSharedTileCount));
+                out.setAttribute(frameNumber, "NavMesh DbCache Memory",
+                    static_cast<double>(stats.mDb->mNavMeshDb.mTileDataCacheHitCount));
+
+                const NavMeshDbStats& db = stats.mDb->mNavMeshDb;
+                if (db.mEncodedDataSize > 0)
+                    out.setAttribute(frameNumber, "NavMesh DbData Ratio",
+                        static_cast<double>(db.mDecodedDataSize) / static_cast<double>(db.mEncodedDataSize));
+                if (db.mDecodeCount > 0)
+                    out.setAttribute(frameNumber, "NavMesh DbData DecodeUs",
+                        std::chrono::duration<double, std::micro>(db.mDecodeTime).count()
+                            / static_cast<double>(db.mDecodeCount));
+                out.setAttribute(
+                    frameNumber, "NavMesh DbJobs Commit", static_cast<double>(stats.mDb->mWriteTransactionCount));
             }
 
             out.setAttribute(frameNumber, "NavMesh CacheSize", static_cast<double>(stats.mCache.mNavMeshCacheSize));
@@ -32,6 +47,10 @@ namespace DetourNavigator
             out.setAttribute(frameNumber, "NavMesh CachedTiles", static_cast<double>(stats.mCache.mCachedNavMeshTiles));
             out.setAttribute(frameNumber, "NavMesh Cache Get", static_cast<double>(stats.mCache.mGetCount));
             out.setAttribute(frameNumber, "NavMesh Cache Hit", static_cast<double>(stats.mCache.mHitCount));
+            out.setAttribute(frameNumber, "NavMesh Layers Size", static_cast<double>(stats.mLayers.mSize));
+            out.setAttribute(frameNumber, "NavMesh Layers Count", static_cast<double>(stats.mLayers.mLayers));
+            out.setAttribute(frameNumber, "NavMesh Layers Get", static_cast<double>(stats.mLayers.mGetCount));
+            out.setAttribute(frameNumber, "NavMesh Layers Hit", static_cast<double>(stats.mLayers.mHitCount));
         }
 
         void reportStats(const TileCachedRecastMeshManagerStats& stats, unsigned int frameNumber, osg::Stats& out)
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_STATS_H
 
+#include <chrono>
 #include <cstddef>
 #include <optional>
 
@@ -24,10 +25,25 @@ namespace DetourNavigator
         std::size_t mWritingJobs = 0;
     };
 
+    struct NavMeshDbStats
+    {
+        std::size_t mTileDataCacheSize = 0;
+        std::size_t mTileDataCacheGetCount = 0;
+        std::size_t mTileDataCacheHitCount = 0;
+        // Sizes of written and read tiles data as stored in the database and after decoding
+        std::size_t mEncodedDataSize = 0;
+        std::size_t mDecodedDataSize = 0;
+        std::size_t mDecodeCount = 0;
+        std::chrono::nanoseconds mDecodeTime{ 0 };
+    };
+
     struct DbWorkerStats
     {
         DbJobQueueStats mJobs;
         std::size_t mGetTileCount = 0;
+        std::size_t mGetSharedTileCount = 0;
+        std::size_t mWriteTransactionCount = 0;
+        NavMeshDbStats mNavMeshDb;
     };
 
     struct NavMeshTilesCacheStats
@@ -39,6 +55,14 @@ namespace DetourNavigator
         std::size_t mGetCount = 0;
     };
 
+    struct TileLayersCacheStats
+    {
+        std::size_t mSize = 0;
+        std::size_t mLayers = 0;
+        std::size_t mHitCount = 0;
+        std::size_t mGetCount = 0;
+    };
+
     struct AsyncNavMeshUpdaterStats
     {
         std::size_t mJobs = 0;
@@ -49,6 +73,7 @@ namespace DetourNavigator
         std::size_t mPosted = 0;
         std::optional<DbWorkerStats> mDb;
         NavMeshTilesCacheStats mCache;
+        TileLayersCacheStats mLayers;
     };
 
     struct TileCachedRecastMeshManagerStats
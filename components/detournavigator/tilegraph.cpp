@@ -0,0 +1,283 @@
+#include "tilegraph.hpp"
+#include "navmeshcacheitem.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <osg/Vec2f>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        constexpr std::size_t maxCachedRoutes = 1024;
+
+        auto tie(const TileGraphEdge& value)
+        {
+            return std::tie(value.mTarget, value.mSourceFlags, value.mTargetFlags);
+        }
+
+        bool isPassable(const TileGraphEdge& edge, Flags includeFlags)
+        {
+            return (edge.mSourceFlags & includeFlags) != 0 && (edge.mTargetFlags & includeFlags) != 0;
+        }
+
+        float getDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return osg::Vec2f(static_cast<float>(lhs.x() - rhs.x()), static_cast<float>(lhs.y() - rhs.y())).length();
+        }
+
+        osg::Vec2f getCenter(const dtMeshHeader& header)
+        {
+            return osg::Vec2f((header.bmin[0] + header.bmax[0]) / 2, (header.bmin[2] + header.bmax[2]) / 2);
+        }
+
+        osg::Vec3f getPortal(const dtMeshTile& tile, const dtPoly& poly, const dtLink& link)
+        {
+            const float* const va = &tile.verts[poly.verts[link.edge] * 3];
+            const float* const vb = &tile.verts[poly.verts[(link.edge + 1) % poly.vertCount] * 3];
+            const osg::Vec3f a(va[0], va[1], va[2]);
+            const osg::Vec3f b(vb[0], vb[1], vb[2]);
+            // External link may cover only a part of the polygon edge defined in 1/255 of the edge length
+            return a + (b - a) * ((link.bmin + link.bmax) / (2 * 255.0f));
+        }
+
+        std::vector<TileGraphEdge> makeEdges(const dtNavMesh& navMesh, const dtMeshTile& tile)
+        {
+            std::vector<TileGraphEdge> result;
+            // Squared distance from the portal to the center of the border between tiles for each result item
+            std::vector<float> distances;
+
+            for (int i = 0; i < tile.header->polyCount; ++i)
+            {
+                const dtPoly& poly = tile.polys[i];
+                if (poly.getType() != DT_POLYTYPE_GROUND)
+                    continue;
+
+                for (unsigned k = poly.firstLink; k != DT_NULL_LINK; k = tile.links[k].next)
+                {
+                    const dtLink& link = tile.links[k];
+                    // Internal links have no side
+                    if (link.side == 0xff)
+                        continue;
+
+                    const dtMeshTile* targetTile = nullptr;
+                    const dtPoly* targetPoly = nullptr;
+                    navMesh.getTileAndPolyByRefUnsafe(link.ref, &targetTile, &targetPoly);
+                    if (targetPoly->getType() != DT_POLYTYPE_GROUND)
+                        continue;
+
+                    TileGraphEdge edge{
+                        .mTarget = TilePosition(targetTile->header->x, targetTile->header->y),
+                        .mSourceFlags = poly.flags,
+                        .mTargetFlags = targetPoly->flags,
+                        .mPortal = getPortal(tile, poly, link),
+                    };
+                    const osg::Vec2f border = (getCenter(*tile.header) + getCenter(*targetTile->header)) / 2;
+                    const float distance = (osg::Vec2f(edge.mPortal.x(), edge.mPortal.z()) - border).length2();
+
+                    const auto it = std::find_if(
+                        result.begin(), result.end(), [&](const TileGraphEdge& v) { return tie(v) == tie(edge); });
+                    if (it == result.end())
+                    {
+                        result.push_back(edge);
+                        distances.push_back(distance);
+                        continue;
+                    }
+                    float& existingDistance = distances[static_cast<std::size_t>(it - result.begin())];
+                    if (distance < existingDistance)
+                    {
+                        it->mPortal = edge.mPortal;
+                        existingDistance = distance;
+                    }
+                }
+            }
+
+            std::sort(result.begin(), result.end(),
+                [](const TileGraphEdge& lhs, const TileGraphEdge& rhs) { return tie(lhs) < tie(rhs); });
+
+            return result;
+        }
+
+        bool hasSameConnectivity(const std::vector<TileGraphEdge>& lhs, const std::vector<TileGraphEdge>& rhs)
+        {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                [](const TileGraphEdge& l, const TileGraphEdge& r) { return tie(l) == tie(r); });
+        }
+    }
+
+    void TileGraph::invalidate(const TilePosition& position)
+    {
+        // Links of the neighbour tiles are changed too
+        for (int x = -1; x <= 1; ++x)
+            for (int y = -1; y <= 1; ++y)
+                mInvalidated.insert(position + TilePosition(x, y));
+    }
+
+    Status TileGraph::findRoute(const dtNavMesh& navMesh, const TilePosition& start, const TilePosition& end,
+        Flags includeFlags, std::vector<osg::Vec3f>& portals)
+    {
+        update(navMesh);
+
+        const auto key = std::make_tuple(start, end, includeFlags);
+        const std::size_t initialSize = portals.size();
+        if (const auto it = mRoutes.find(key); it != mRoutes.end())
+        {
+            if (addPortals(it->second, includeFlags, portals))
+                return it->second.mStatus;
+            // Cached routes are dropped when connectivity changes so this is not expected, find a new one
+            mRoutes.erase(it);
+            portals.resize(initialSize);
+        }
+
+        if (mRoutes.size() >= maxCachedRoutes)
+            mRoutes.clear();
+
+        const auto it = mRoutes.emplace(key, findRouteImpl(start, end, includeFlags)).first;
+        if (addPortals(it->second, includeFlags, portals))
+            return it->second.mStatus;
+
+        // New route is built over existing edges so this is not expected too, use the route up to the missing edge
+        mRoutes.erase(it);
+        return Status::PartialPath;
+    }
+
+    void TileGraph::update(const dtNavMesh& navMesh)
+    {
+        bool changed = false;
+
+        for (const TilePosition& position : mInvalidated)
+        {
+            const dtMeshTile* const tile = getTile(navMesh, position);
+            const auto it = mEdges.find(position);
+
+            if (tile == nullptr)
+            {
+                if (it != mEdges.end())
+                {
+                    mEdges.erase(it);
+                    changed = true;
+                }
+                continue;
+            }
+
+            std::vector<TileGraphEdge> edges = makeEdges(navMesh, *tile);
+
+            if (it == mEdges.end())
+            {
+                mEdges.emplace(position, std::move(edges));
+                changed = true;
+                continue;
+            }
+
+            changed = changed || !hasSameConnectivity(it->second, edges);
+            it->second = std::move(edges);
+        }
+
+        mInvalidated.clear();
+
+        if (changed)
+            mRoutes.clear();
+    }
+
+    TileGraph::Route TileGraph::findRouteImpl(
+        const TilePosition& start, const TilePosition& end, Flags includeFlags) const
+    {
+        if (mEdges.find(start) == mEdges.end())
+            return Route{ .mStatus = Status::StartPolygonNotFound, .mTiles = {} };
+
+        struct Node
+        {
+            float mCost;
+            TilePosition mPrevious;
+            bool mClosed;
+        };
+
+        std::map<TilePosition, Node> nodes;
+        std::priority_queue<std::pair<float, TilePosition>, std::vector<std::pair<float, TilePosition>>,
+            std::greater<>>
+            open;
+
+        nodes.emplace(start, Node{ .mCost = 0, .mPrevious = start, .mClosed = false });
+        open.emplace(getDistance(start, end), start);
+
+        // When end is not reachable the route leads to the closest reachable tile
+        TilePosition closest = start;
+        float closestDistance = getDistance(start, end);
+
+        while (!open.empty())
+        {
+            const TilePosition position = open.top().second;
+            open.pop();
+
+            Node& node = nodes.find(position)->second;
+            if (node.mClosed)
+                continue;
+            node.mClosed = true;
+
+            if (const float distance = getDistance(position, end); distance < closestDistance)
+            {
+                closest = position;
+                closestDistance = distance;
+            }
+
+            if (position == end)
+                break;
+
+            for (const TileGraphEdge& edge : mEdges.find(position)->second)
+            {
+                if (!isPassable(edge, includeFlags) || mEdges.find(edge.mTarget) == mEdges.end())
+                    continue;
+
+                const float cost = node.mCost + getDistance(position, edge.mTarget);
+                const auto [it, inserted]
+                    = nodes.emplace(edge.mTarget, Node{ .mCost = cost, .mPrevious = position, .mClosed = false });
+                if (!inserted)
+                {
+                    if (it->second.mClosed || it->second.mCost <= cost)
+                        continue;
+                    it->second.mCost = cost;
+                    it->second.mPrevious = position;
+                }
+                open.emplace(cost + getDistance(edge.mTarget, end), edge.mTarget);
+            }
+        }
+
+        Route result{ .mStatus = closest == end ? Status::Success : Status::PartialPath, .mTiles = {} };
+        for (TilePosition position = closest; position != start; position = nodes.find(position)->second.mPrevious)
+            result.mTiles.push_back(position);
+        result.mTiles.push_back(start);
+        std::reverse(result.mTiles.begin(), result.mTiles.end());
+
+        return result;
+    }
+
+    bool TileGraph::addPortals(const Route& route, Flags includeFlags, std::vector<osg::Vec3f>& portals) const
+    {
+        for (std::size_t i = 1; i < route.mTiles.size(); ++i)
+        {
+            const TileGraphEdge* const edge = findEdge(route.mTiles[i - 1], route.mTiles[i], includeFlags);
+            if (edge == nullptr)
+                return false;
+            portals.push_back(edge->mPortal);
+        }
+        return true;
+    }
+
+    const TileGraphEdge* TileGraph::findEdge(
+        const TilePosition& source, const TilePosition& target, Flags includeFlags) const
+    {
+        const auto edges = mEdges.find(source);
+        if (edges == mEdges.end())
+            return nullptr;
+        const auto it = std::find_if(edges->second.begin(), edges->second.end(),
+            [&](const TileGraphEdge& v) { return v.mTarget == target && isPassable(v, includeFlags); });
+        if (it == edges->second.end())
+            return nullptr;
+        return &*it;
+    }
+}
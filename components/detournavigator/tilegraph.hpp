@@ -0,0 +1,66 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILEGRAPH_H
+
+#include "flags.hpp"
+#include "status.hpp"
+#include "tileposition.hpp"
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+class dtNavMesh;
+
+namespace DetourNavigator
+{
+    struct TileGraphEdge
+    {
+        TilePosition mTarget;
+        Flags mSourceFlags;
+        Flags mTargetFlags;
+        // Point on the border between tiles in navmesh coordinates
+        osg::Vec3f mPortal;
+    };
+
+    /// Coarse graph with navmesh tiles as nodes and links between polygons of neighbour tiles as edges. Allows to find
+    /// a route over many tiles without searching over polygons. Connectivity inside a tile is not checked so a route
+    /// is an approximation to be refined by polygon level search near the actor. Found routes are cached until
+    /// connectivity between tiles changes.
+    class TileGraph
+    {
+    public:
+        void invalidate(const TilePosition& position);
+
+        Status findRoute(const dtNavMesh& navMesh, const TilePosition& start, const TilePosition& end,
+            Flags includeFlags, std::vector<osg::Vec3f>& portals);
+
+        std::size_t getCachedRoutesCount() const { return mRoutes.size(); }
+
+    private:
+        struct Route
+        {
+            Status mStatus;
+            std::vector<TilePosition> mTiles;
+        };
+
+        std::map<TilePosition, std::vector<TileGraphEdge>> mEdges;
+        std::set<TilePosition> mInvalidated;
+        std::map<std::tuple<TilePosition, TilePosition, Flags>, Route> mRoutes;
+
+        void update(const dtNavMesh& navMesh);
+
+        Route findRouteImpl(const TilePosition& start, const TilePosition& end, Flags includeFlags) const;
+
+        /// Append portals of the route until an edge is not found.
+        /// @return false if an edge is not found.
+        bool addPortals(const Route& route, Flags includeFlags, std::vector<osg::Vec3f>& portals) const;
+
+        const TileGraphEdge* findEdge(const TilePosition& source, const TilePosition& target, Flags includeFlags) const;
+    };
+}
+
+#endif
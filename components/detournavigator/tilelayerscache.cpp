@@ -0,0 +1,57 @@
+#include "tilelayerscache.hpp"
+#include "stats.hpp"
+
+namespace DetourNavigator
+{
+    TileLayersCache::TileLayersCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::shared_ptr<const TileLayer> TileLayersCache::get(
+        const AgentBounds& agentBounds, const TilePosition& tilePosition)
+    {
+        const std::lock_guard lock(mMutex);
+        ++mGetCount;
+        const auto it = mIndex.find(std::tie(agentBounds, tilePosition));
+        if (it == mIndex.end())
+            return nullptr;
+        ++mHitCount;
+        mItems.splice(mItems.begin(), mItems, it->second);
+        return it->second->mValue;
+    }
+
+    void TileLayersCache::set(
+        const AgentBounds& agentBounds, const TilePosition& tilePosition, std::shared_ptr<const TileLayer> value)
+    {
+        const std::size_t size = getSize(*value);
+        const std::lock_guard lock(mMutex);
+        if (const auto it = mIndex.find(std::tie(agentBounds, tilePosition)); it != mIndex.end())
+            eraseUnsafe(it->second);
+        if (size > mMaxSize)
+            return;
+        while (!mItems.empty() && mSize + size > mMaxSize)
+            eraseUnsafe(std::prev(mItems.end()));
+        mItems.push_front(Item{ agentBounds, tilePosition, std::move(value), size });
+        mIndex.emplace(std::make_tuple(agentBounds, tilePosition), mItems.begin());
+        mSize += size;
+    }
+
+    TileLayersCacheStats TileLayersCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return TileLayersCacheStats{
+            .mSize = mSize,
+            .mLayers = mItems.size(),
+            .mHitCount = mHitCount,
+            .mGetCount = mGetCount,
+        };
+    }
+
+    void TileLayersCache::eraseUnsafe(std::list<Item>::iterator it)
+    {
+        mSize -= it->mSize;
+        mIndex.erase(std::tie(it->mAgentBounds, it->mTilePosition));
+        mItems.erase(it);
+    }
+}
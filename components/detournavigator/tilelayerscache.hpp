@@ -0,0 +1,80 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_TILELAYERSCACHE_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_TILELAYERSCACHE_H
+
+#include "agentbounds.hpp"
+#include "recastmesh.hpp"
+#include "tileposition.hpp"
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace DetourNavigator
+{
+    struct TileLayersCacheStats;
+
+    /// Rasterized solid heightfield of a tile before filtering. Spans are stored compressed. Allows next update of
+    /// the same tile to rasterize only the region affected by changed triangles and to copy the rest.
+    struct TileLayer
+    {
+        // Geometry the spans are rasterized from. Mesh sources are not stored to not keep collision shapes alive.
+        Mesh mMesh{ {}, {}, {} };
+        std::vector<CellWater> mWater;
+        std::vector<Heightfield> mHeightfields;
+        std::vector<FlatHeightfield> mFlatHeightfields;
+        float mMinZ = 0;
+        float mMaxZ = 0;
+        int mWidth = 0;
+        int mHeight = 0;
+        std::vector<std::byte> mSpans;
+    };
+
+    inline std::size_t getSize(const TileLayer& value)
+    {
+        std::size_t result = sizeof(value) + value.mSpans.size() + getSize(value.mMesh)
+            + value.mWater.size() * sizeof(CellWater) + value.mHeightfields.size() * sizeof(Heightfield)
+            + value.mFlatHeightfields.size() * sizeof(FlatHeightfield);
+        for (const Heightfield& heightfield : value.mHeightfields)
+            result += heightfield.mHeights.size() * sizeof(float);
+        return result;
+    }
+
+    class TileLayersCache
+    {
+    public:
+        explicit TileLayersCache(std::size_t maxSize);
+
+        std::shared_ptr<const TileLayer> get(const AgentBounds& agentBounds, const TilePosition& tilePosition);
+
+        void set(
+            const AgentBounds& agentBounds, const TilePosition& tilePosition, std::shared_ptr<const TileLayer> value);
+
+        TileLayersCacheStats getStats() const;
+
+    private:
+        struct Item
+        {
+            AgentBounds mAgentBounds;
+            TilePosition mTilePosition;
+            std::shared_ptr<const TileLayer> mValue;
+            std::size_t mSize;
+        };
+
+        mutable std::mutex mMutex;
+        const std::size_t mMaxSize;
+        std::size_t mSize = 0;
+        std::size_t mHitCount = 0;
+        std::size_t mGetCount = 0;
+        // Most recently used items are at the beginning
+        std::list<Item> mItems;
+        std::map<std::tuple<AgentBounds, TilePosition>, std::list<Item>::iterator> mIndex;
+
+        void eraseUnsafe(std::list<Item>::iterator it);
+    };
+}
+
+#endif
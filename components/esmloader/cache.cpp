@@ -0,0 +1,396 @@
+#include "cache.hpp"
+#include "esmdata.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/esm3/loadacti.hpp>
+#include <components/esm3/loadcell.hpp>
+#include <components/esm3/loadcont.hpp>
+#include <components/esm3/loaddoor.hpp>
+#include <components/esm3/loadgmst.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/esm3/loadstat.hpp>
+#include <components/esm3/variant.hpp>
+#include <components/files/conversion.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace EsmLoader
+{
+    namespace
+    {
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::string>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, static_cast<std::uint64_t>(value.size()));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::uint64_t size = 0;
+                    visitor(*this, size);
+                    value.resize(static_cast<std::size_t>(size));
+                }
+                visitor(*this, value.data(), value.size());
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::filesystem::path>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, Files::pathToUnicodeString(value));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::string path;
+                    visitor(*this, path);
+                    value = Files::pathFromUnicodeString(std::move(path));
+                }
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::RefId>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, value.serializeText());
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::string text;
+                    visitor(*this, text);
+                    value = ESM::RefId::deserializeText(text);
+                }
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::NAME>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, value.toInt());
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::uint32_t name = 0;
+                    visitor(*this, name);
+                    value = ESM::NAME(name);
+                }
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::Variant>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                {
+                    visitor(*this, static_cast<std::uint32_t>(value.getType()));
+                    switch (value.getType())
+                    {
+                        case ESM::VT_Unknown:
+                        case ESM::VT_None:
+                            break;
+                        case ESM::VT_String:
+                            visitor(*this, value.getString());
+                            break;
+                        case ESM::VT_Short:
+                        case ESM::VT_Int:
+                        case ESM::VT_Long:
+                            visitor(*this, value.getInteger());
+                            break;
+                        case ESM::VT_Float:
+                            visitor(*this, value.getFloat());
+                            break;
+                    }
+                }
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::uint32_t type = 0;
+                    visitor(*this, type);
+                    switch (type)
+                    {
+                        case ESM::VT_Unknown:
+                        case ESM::VT_None:
+                            value.setType(static_cast<ESM::VarType>(type));
+                            break;
+                        case ESM::VT_String:
+                        {
+                            value.setType(ESM::VT_String);
+                            std::string string;
+                            visitor(*this, string);
+                            value.setString(std::move(string));
+                            break;
+                        }
+                        case ESM::VT_Short:
+                        case ESM::VT_Int:
+                        case ESM::VT_Long:
+                        {
+                            value.setType(static_cast<ESM::VarType>(type));
+                            std::int32_t integer = 0;
+                            visitor(*this, integer);
+                            value.setInteger(integer);
+                            break;
+                        }
+                        case ESM::VT_Float:
+                        {
+                            value.setType(ESM::VT_Float);
+                            float real = 0;
+                            visitor(*this, real);
+                            value.setFloat(real);
+                            break;
+                        }
+                        default:
+                            throw std::runtime_error("Invalid variant type: " + std::to_string(type));
+                    }
+                }
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::ESM_Context>>
+            {
+                visitor(*this, value.filename);
+                visitor(*this, value.leftRec);
+                visitor(*this, value.leftSub);
+                visitor(*this, value.leftFile);
+                visitor(*this, value.recName);
+                visitor(*this, value.subName);
+                visitor(*this, value.index);
+                visitor(*this, value.parentFileIndices);
+                visitor(*this, value.subCached);
+                visitor(*this, value.filePos);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::ContItem>>
+            {
+                visitor(*this, value.mCount);
+                visitor(*this, value.mItem);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::Activator>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mScript);
+                visitor(*this, value.mName);
+                visitor(*this, value.mModel);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::Cell>>
+            {
+                visitor(*this, value.mId);
+                visitor(*this, value.mName);
+                visitor(*this, value.mRegion);
+                visitor(*this, value.mContextList);
+                visitor(*this, value.mData.mFlags);
+                visitor(*this, value.mData.mX);
+                visitor(*this, value.mData.mY);
+                visitor(*this, value.mAmbi.mAmbient);
+                visitor(*this, value.mAmbi.mSunlight);
+                visitor(*this, value.mAmbi.mFog);
+                visitor(*this, value.mAmbi.mFogDensity);
+                visitor(*this, value.mHasAmbi);
+                visitor(*this, value.mWater);
+                visitor(*this, value.mHasWaterHeightSub);
+                visitor(*this, value.mMapColor);
+                visitor(*this, value.mRefNumCounter);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::Container>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mScript);
+                visitor(*this, value.mName);
+                visitor(*this, value.mModel);
+                visitor(*this, value.mWeight);
+                visitor(*this, value.mFlags);
+                visitor(*this, value.mInventory.mList);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::Door>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mScript);
+                visitor(*this, value.mOpenSound);
+                visitor(*this, value.mCloseSound);
+                visitor(*this, value.mName);
+                visitor(*this, value.mModel);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::GameSetting>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mValue);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::Land>>
+            {
+                visitor(*this, value.mFlags);
+                visitor(*this, value.mX);
+                visitor(*this, value.mY);
+                visitor(*this, value.mContext);
+                visitor(*this, value.mDataTypes);
+                visitor(*this, value.mWnam.data(), value.mWnam.size());
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ESM::Static>>
+            {
+                visitor(*this, value.mRecordFlags);
+                visitor(*this, value.mId);
+                visitor(*this, value.mModel);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, RefIdWithType>>
+            {
+                visitor(*this, value.mId);
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, static_cast<std::uint32_t>(value.mType));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::uint32_t type = 0;
+                    visitor(*this, type);
+                    value.mType = static_cast<ESM::RecNameInts>(type);
+                }
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, Query>>
+            {
+                visitor(*this, value.mLoadActivators);
+                visitor(*this, value.mLoadCells);
+                visitor(*this, value.mLoadContainers);
+                visitor(*this, value.mLoadDoors);
+                visitor(*this, value.mLoadGameSettings);
+                visitor(*this, value.mLoadLands);
+                visitor(*this, value.mLoadStatics);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, ContentFileState>>
+            {
+                visitor(*this, value.mPath);
+                visitor(*this, value.mSize);
+                visitor(*this, value.mLastModified);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CacheKey>>
+            {
+                visitor(*this, value.mQuery);
+                visitor(*this, value.mEncoding);
+                visitor(*this, value.mContentFiles);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, EsmData>>
+            {
+                visitor(*this, value.mActivators);
+                visitor(*this, value.mCells);
+                visitor(*this, value.mContainers);
+                visitor(*this, value.mDoors);
+                visitor(*this, value.mGameSettings);
+                visitor(*this, value.mLands);
+                visitor(*this, value.mStatics);
+                visitor(*this, value.mRefIdTypes);
+            }
+        };
+
+        bool operator==(const Query& l, const Query& r)
+        {
+            return l.mLoadActivators == r.mLoadActivators && l.mLoadCells == r.mLoadCells
+                && l.mLoadContainers == r.mLoadContainers && l.mLoadDoors == r.mLoadDoors
+                && l.mLoadGameSettings == r.mLoadGameSettings && l.mLoadLands == r.mLoadLands
+                && l.mLoadStatics == r.mLoadStatics;
+        }
+
+        template <class Visitor>
+        void visitHeader(Visitor& visitor, const Format<Serialization::Mode::Write>& format, const CacheKey& key)
+        {
+            visitor(format, esmDataCacheMagic);
+            visitor(format, esmDataCacheVersion);
+            visitor(format, key);
+        }
+    }
+
+    std::vector<std::byte> serialize(const CacheKey& key, const EsmData& value)
+    {
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        visitHeader(sizeAccumulator, format, key);
+        sizeAccumulator(format, value);
+        std::vector<std::byte> result(sizeAccumulator.value());
+        Serialization::BinaryWriter writer(result.data(), result.data() + result.size());
+        visitHeader(writer, format, key);
+        writer(format, value);
+        return result;
+    }
+
+    std::optional<EsmData> deserialize(std::span<const std::byte> data, const CacheKey& key)
+    {
+        try
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            Serialization::BinaryReader reader(data.data(), data.data() + data.size());
+            char magic[std::size(esmDataCacheMagic)];
+            reader(format, magic);
+            if (std::memcmp(magic, esmDataCacheMagic, sizeof(magic)) != 0)
+                return std::nullopt;
+            std::uint32_t version = 0;
+            reader(format, version);
+            if (version != esmDataCacheVersion)
+                return std::nullopt;
+            CacheKey cachedKey;
+            reader(format, cachedKey);
+            if (!(cachedKey.mQuery == key.mQuery) || cachedKey.mEncoding != key.mEncoding
+                || cachedKey.mContentFiles != key.mContentFiles)
+                return std::nullopt;
+            EsmData result;
+            reader(format, result);
+            return result;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to deserialize ESM data cache: " << e.what();
+            return std::nullopt;
+        }
+    }
+}
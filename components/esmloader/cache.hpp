@@ -0,0 +1,47 @@
+#ifndef OPENMW_COMPONENTS_ESMLOADER_CACHE_H
+#define OPENMW_COMPONENTS_ESMLOADER_CACHE_H
+
+#include "load.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace EsmLoader
+{
+    struct EsmData;
+
+    constexpr char esmDataCacheMagic[] = { 'e', 's', 'm', 'd' };
+    constexpr std::uint32_t esmDataCacheVersion = 2;
+
+    constexpr std::int32_t noEncoding = -1;
+
+    struct ContentFileState
+    {
+        /// Path of the content file in UTF-8
+        std::string mPath;
+        std::uint64_t mSize;
+        std::int64_t mLastModified;
+
+        friend bool operator==(const ContentFileState& l, const ContentFileState& r) = default;
+    };
+
+    /// Identifies the loaded data. Cached data can be used only when all fields are equal.
+    struct CacheKey
+    {
+        Query mQuery;
+        /// ToUTF8::FromType used to convert strings or noEncoding when they are not converted
+        std::int32_t mEncoding = noEncoding;
+        std::vector<ContentFileState> mContentFiles;
+    };
+
+    std::vector<std::byte> serialize(const CacheKey& key, const EsmData& value);
+
+    /// Returns nullopt if data is broken, has different version or was serialized for a different key.
+    std::optional<EsmData> deserialize(std::span<const std::byte> data, const CacheKey& key);
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "load.hpp"
+#include "cache.hpp"
 #include "esmdata.hpp"
 #include "lessbyid.hpp"
 #include "record.hpp"
@@ -21,15 +22,30 @@
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/lower.hpp>
+#include <components/platform/file.hpp>
+#include <components/toutf8/toutf8.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
 #include <map>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <set>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -64,6 +80,14 @@ namespace EsmLoader
             std::map<std::pair<int, int>, std::size_t> mByPosition;
         };
 
+        struct CellRecord
+        {
+            bool mDeleted;
+            ESM::Cell mValue;
+            // Position of the subrecords following NAME and DATA
+            ESM::ESM_Context mContext;
+        };
+
         template <class T, class = std::void_t<>>
         struct HasId : std::false_type
         {
@@ -97,47 +121,31 @@ namespace EsmLoader
             records.emplace_back(deleted, std::move(record));
         }
 
-        void loadRecord(ESM::ESMReader& reader, CellRecords& records)
+        // The rest of the subrecords is loaded when merging because an overridden cell may come from a file loaded by
+        // other thread
+        void loadRecord(ESM::ESMReader& reader, std::vector<CellRecord>& records)
         {
             ESM::Cell record;
             bool deleted = false;
             record.loadNameAndData(reader, deleted);
-
-            if ((record.mData.mFlags & ESM::Cell::Interior) != 0)
-            {
-                const auto it = records.mByName.find(record.mName);
-                if (it == records.mByName.end())
-                {
-                    record.loadCell(reader, true);
-                    records.mByName.emplace_hint(it, record.mName, records.mValues.size());
-                    records.mValues.emplace_back(deleted, std::move(record));
-                }
-                else
-                {
-                    Record<ESM::Cell>& old = records.mValues[it->second];
-                    old.mValue.mData = record.mData;
-                    old.mValue.loadCell(reader, true);
-                }
-            }
-            else
-            {
-                const std::pair<int, int> position(record.mData.mX, record.mData.mY);
-                const auto it = records.mByPosition.find(position);
-                if (it == records.mByPosition.end())
-                {
-                    record.loadCell(reader, true);
-                    records.mByPosition.emplace_hint(it, position, records.mValues.size());
-                    records.mValues.emplace_back(deleted, std::move(record));
-                }
-                else
-                {
-                    Record<ESM::Cell>& old = records.mValues[it->second];
-                    old.mValue.mData = record.mData;
-                    old.mValue.loadCell(reader, true);
-                }
-            }
+            ESM::ESM_Context context = reader.getContext();
+            reader.skipRecord();
+            records.push_back(CellRecord{ deleted, std::move(record), std::move(context) });
         }
 
+        // Records of a single content file staged before merging into the records of all files
+        struct FileContent
+        {
+            Records<ESM::Activator> mActivators;
+            std::vector<CellRecord> mCells;
+            Records<ESM::Container> mContainers;
+            Records<ESM::Door> mDoors;
+            Records<ESM::GameSetting> mGameSettings;
+            Records<ESM::Land> mLands;
+            Records<ESM::Static> mStatics;
+            std::chrono::steady_clock::duration mLoadDuration{};
+        };
+
         struct ShallowContent
         {
             Records<ESM::Activator> mActivators;
@@ -149,7 +157,7 @@ namespace EsmLoader
             Records<ESM::Static> mStatics;
         };
 
-        void loadRecord(const Query& query, const ESM::NAME& name, ESM::ESMReader& reader, ShallowContent& content)
+        void loadRecord(const Query& query, const ESM::NAME& name, ESM::ESMReader& reader, FileContent& content)
         {
             switch (name.toInt())
             {
@@ -186,7 +194,7 @@ namespace EsmLoader
             reader.skipRecord();
         }
 
-        void loadEsm(const Query& query, ESM::ESMReader& reader, ShallowContent& content, Loading::Listener* listener)
+        void loadEsm(const Query& query, ESM::ESMReader& reader, FileContent& content, Loading::Listener* listener)
         {
             Log(Debug::Info) << "Loading ESM file " << reader.getName();
 
@@ -206,12 +214,147 @@ namespace EsmLoader
             }
         }
 
-        ShallowContent shallowLoad(const Query& query, const std::vector<std::string>& contentFiles,
-            const Files::Collections& fileCollections, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-            Loading::Listener* listener)
+        template <class T>
+        void append(Records<T>&& values, Records<T>& records)
         {
-            ShallowContent result;
+            records.insert(
+                records.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        }
+
+        class ShallowLoader
+        {
+        public:
+            explicit ShallowLoader(const Query& query, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder)
+                : mQuery(query)
+                , mReaders(readers)
+                , mEncoder(encoder)
+            {
+            }
+
+            void open(std::size_t index, const std::filesystem::path& path)
+            {
+                const std::lock_guard lock(mMutex);
+                const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
+                reader->setEncoder(mEncoder);
+                reader->setIndex(static_cast<int>(index));
+                reader->open(path);
+                if (mQuery.mLoadCells)
+                    reader->resolveParentFileIndices(mReaders);
+            }
+
+            // May be called from multiple threads for different files. Encoder has internal buffer so it's copied.
+            FileContent load(std::size_t index, Loading::Listener* listener)
+            {
+                std::optional<ToUTF8::Utf8Encoder> encoder;
+                if (mEncoder != nullptr)
+                    encoder.emplace(*mEncoder);
+                FileContent result;
+                withReader(index, [&](ESM::ESMReader& reader) {
+                    const auto start = std::chrono::steady_clock::now();
+                    reader.setEncoder(encoder.has_value() ? &*encoder : nullptr);
+                    loadEsm(mQuery, reader, result, listener);
+                    reader.setEncoder(mEncoder);
+                    result.mLoadDuration = std::chrono::steady_clock::now() - start;
+                });
+                return result;
+            }
+
+            // Merging is done in the load order so records from later files override records from earlier ones
+            // exactly like when the files are loaded one by one.
+            void merge(std::size_t index, FileContent&& content, ShallowContent& result)
+            {
+                append(std::move(content.mActivators), result.mActivators);
+                append(std::move(content.mContainers), result.mContainers);
+                append(std::move(content.mDoors), result.mDoors);
+                append(std::move(content.mGameSettings), result.mGameSettings);
+                append(std::move(content.mLands), result.mLands);
+                append(std::move(content.mStatics), result.mStatics);
+
+                if (content.mCells.empty())
+                    return;
+
+                withReader(index, [&](ESM::ESMReader& reader) {
+                    for (CellRecord& cell : content.mCells)
+                    {
+                        reader.restoreContext(cell.mContext);
+                        std::size_t* const position = findCell(cell.mValue, result.mCells);
+                        if (position == nullptr)
+                        {
+                            cell.mValue.loadCell(reader, true);
+                            addCell(std::move(cell), result.mCells);
+                            continue;
+                        }
+                        ESM::Cell& old = result.mCells.mValues[*position].mValue;
+                        old.mData = cell.mValue.mData;
+                        old.loadCell(reader, true);
+                    }
+                });
+            }
+
+        private:
+            const Query& mQuery;
+            ESM::ReadersCache& mReaders;
+            ToUTF8::Utf8Encoder* const mEncoder;
+            std::mutex mMutex;
+
+            template <class F>
+            void withReader(std::size_t index, F&& f)
+            {
+                std::unique_lock lock(mMutex);
+                const ESM::ReadersCache::BusyItem reader = mReaders.get(index);
+                lock.unlock();
+                try
+                {
+                    f(*reader);
+                }
+                catch (...)
+                {
+                    lock.lock();
+                    throw;
+                }
+                lock.lock();
+            }
+
+            static std::size_t* findCell(const ESM::Cell& cell, CellRecords& records)
+            {
+                if ((cell.mData.mFlags & ESM::Cell::Interior) != 0)
+                {
+                    const auto it = records.mByName.find(cell.mName);
+                    return it == records.mByName.end() ? nullptr : &it->second;
+                }
+                const auto it = records.mByPosition.find(std::pair(cell.mData.mX, cell.mData.mY));
+                return it == records.mByPosition.end() ? nullptr : &it->second;
+            }
+
+            static void addCell(CellRecord&& cell, CellRecords& records)
+            {
+                if ((cell.mValue.mData.mFlags & ESM::Cell::Interior) != 0)
+                    records.mByName.emplace(cell.mValue.mName, records.mValues.size());
+                else
+                    records.mByPosition.emplace(
+                        std::pair(cell.mValue.mData.mX, cell.mValue.mData.mY), records.mValues.size());
+                records.mValues.emplace_back(cell.mDeleted, std::move(cell.mValue));
+            }
+        };
 
+        struct ContentFile
+        {
+            std::size_t mIndex;
+            std::string_view mName;
+            std::filesystem::path mPath;
+        };
+
+        void logLoaded(const ContentFile& file, const FileContent& content)
+        {
+            Log(Debug::Info) << "Loaded content file " << file.mName << " in "
+                             << std::chrono::duration_cast<std::chrono::milliseconds>(content.mLoadDuration).count()
+                             << " ms";
+        }
+
+        // Opening reads only headers but has to be done in the load order to resolve parent files
+        std::vector<ContentFile> openContentFiles(const std::vector<std::string>& contentFiles,
+            const Files::Collections& fileCollections, ShallowLoader& loader)
+        {
             const std::set<std::string_view, Misc::StringUtils::CiComp> supportedFormats{
                 "esm",
                 "esp",
@@ -220,6 +363,8 @@ namespace EsmLoader
                 "project",
             };
 
+            std::vector<ContentFile> files;
+
             for (std::size_t i = 0; i < contentFiles.size(); ++i)
             {
                 const std::string& file = contentFiles[i];
@@ -231,24 +376,95 @@ namespace EsmLoader
                     continue;
                 }
 
-                if (listener != nullptr)
+                const Files::MultiDirCollection& collection = fileCollections.getCollection(extension);
+
+                std::filesystem::path path = collection.getPath(file);
+                loader.open(i, path);
+                files.push_back(ContentFile{ i, file, std::move(path) });
+            }
+
+            return files;
+        }
+
+        ShallowContent shallowLoad(const std::vector<ContentFile>& files, ShallowLoader& loader,
+            Loading::Listener* listener, std::size_t threads)
+        {
+            ShallowContent result;
+
+            if (threads <= 1 || files.size() <= 1)
+            {
+                for (const ContentFile& file : files)
                 {
-                    listener->setLabel(file);
-                    listener->setProgressRange(fileProgress);
+                    if (listener != nullptr)
+                    {
+                        listener->setLabel(std::string(file.mName));
+                        listener->setProgressRange(fileProgress);
+                    }
+
+                    FileContent content = loader.load(file.mIndex, listener);
+                    logLoaded(file, content);
+                    loader.merge(file.mIndex, std::move(content), result);
                 }
 
-                const Files::MultiDirCollection& collection = fileCollections.getCollection(extension);
+                return result;
+            }
 
-                const ESM::ReadersCache::BusyItem reader = readers.get(i);
-                reader->setEncoder(encoder);
-                reader->setIndex(static_cast<int>(i));
-                reader->open(collection.getPath(file));
-                if (query.mLoadCells)
-                    reader->resolveParentFileIndices(readers);
+            std::vector<std::promise<FileContent>> promises(files.size());
+            std::atomic_size_t next = 0;
+            std::atomic_bool stop = false;
 
-                loadEsm(query, *reader, result, listener);
+            const auto work = [&] {
+                for (std::size_t i = next++; i < files.size() && !stop; i = next++)
+                {
+                    try
+                    {
+                        promises[i].set_value(loader.load(files[i].mIndex, nullptr));
+                    }
+                    catch (...)
+                    {
+                        promises[i].set_exception(std::current_exception());
+                    }
+                }
+            };
+
+            const std::size_t workersCount = std::min(threads, files.size());
+            std::vector<std::thread> workers;
+            workers.reserve(workersCount);
+            for (std::size_t i = 0; i < workersCount; ++i)
+                workers.emplace_back(work);
+
+            const auto joinWorkers = [&] {
+                for (std::thread& worker : workers)
+                    worker.join();
+            };
+
+            try
+            {
+                for (std::size_t i = 0; i < files.size(); ++i)
+                {
+                    if (listener != nullptr)
+                    {
+                        listener->setLabel(std::string(files[i].mName));
+                        listener->setProgressRange(fileProgress);
+                    }
+
+                    FileContent content = promises[i].get_future().get();
+                    logLoaded(files[i], content);
+                    loader.merge(files[i].mIndex, std::move(content), result);
+
+                    if (listener != nullptr)
+                        listener->setProgress(fileProgress);
+                }
+            }
+            catch (...)
+            {
+                stop = true;
+                joinWorkers();
+                throw;
             }
 
+            joinWorkers();
+
             return result;
         }
 
@@ -291,72 +507,160 @@ namespace EsmLoader
                     result.emplace_back(std::move(v.mValue));
             return result;
         }
+
+        EsmData prepareEsmData(
+            const Query& query, ShallowContent&& content, std::chrono::steady_clock::time_point start)
+        {
+            std::ostringstream loaded;
+
+            if (query.mLoadActivators)
+                loaded << ' ' << content.mActivators.size() << " activators,";
+            if (query.mLoadCells)
+                loaded << ' ' << content.mCells.mValues.size() << " cells,";
+            if (query.mLoadContainers)
+                loaded << ' ' << content.mContainers.size() << " containers,";
+            if (query.mLoadDoors)
+                loaded << ' ' << content.mDoors.size() << " doors,";
+            if (query.mLoadGameSettings)
+                loaded << ' ' << content.mGameSettings.size() << " game settings,";
+            if (query.mLoadLands)
+                loaded << ' ' << content.mLands.size() << " lands,";
+            if (query.mLoadStatics)
+                loaded << ' ' << content.mStatics.size() << " statics,";
+
+            Log(Debug::Info) << "Loaded" << loaded.str() << " in "
+                             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count()
+                             << " ms";
+
+            EsmData result;
+
+            if (query.mLoadActivators)
+                result.mActivators = prepareRecords(content.mActivators, GetKey{});
+            if (query.mLoadCells)
+                result.mCells = prepareCellRecords(content.mCells.mValues);
+            if (query.mLoadContainers)
+                result.mContainers = prepareRecords(content.mContainers, GetKey{});
+            if (query.mLoadDoors)
+                result.mDoors = prepareRecords(content.mDoors, GetKey{});
+            if (query.mLoadGameSettings)
+                result.mGameSettings = prepareRecords(content.mGameSettings, GetKey{});
+            if (query.mLoadLands)
+                result.mLands = prepareRecords(content.mLands, GetKey{});
+            if (query.mLoadStatics)
+                result.mStatics = prepareRecords(content.mStatics, GetKey{});
+
+            addRefIdsTypes(result);
+
+            std::ostringstream prepared;
+
+            if (query.mLoadActivators)
+                prepared << ' ' << result.mActivators.size() << " unique activators,";
+            if (query.mLoadCells)
+                prepared << ' ' << result.mCells.size() << " unique cells,";
+            if (query.mLoadContainers)
+                prepared << ' ' << result.mContainers.size() << " unique containers,";
+            if (query.mLoadDoors)
+                prepared << ' ' << result.mDoors.size() << " unique doors,";
+            if (query.mLoadGameSettings)
+                prepared << ' ' << result.mGameSettings.size() << " unique game settings,";
+            if (query.mLoadLands)
+                prepared << ' ' << result.mLands.size() << " unique lands,";
+            if (query.mLoadStatics)
+                prepared << ' ' << result.mStatics.size() << " unique statics,";
+
+            Log(Debug::Info) << "Prepared" << prepared.str();
+
+            return result;
+        }
     }
 
     EsmData loadEsmData(const Query& query, const std::vector<std::string>& contentFiles,
         const Files::Collections& fileCollections, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-        Loading::Listener* listener)
+        Loading::Listener* listener, std::size_t threads)
     {
         Log(Debug::Info) << "Loading ESM data...";
 
-        ShallowContent content = shallowLoad(query, contentFiles, fileCollections, readers, encoder, listener);
-
-        std::ostringstream loaded;
-
-        if (query.mLoadActivators)
-            loaded << ' ' << content.mActivators.size() << " activators,";
-        if (query.mLoadCells)
-            loaded << ' ' << content.mCells.mValues.size() << " cells,";
-        if (query.mLoadContainers)
-            loaded << ' ' << content.mContainers.size() << " containers,";
-        if (query.mLoadDoors)
-            loaded << ' ' << content.mDoors.size() << " doors,";
-        if (query.mLoadGameSettings)
-            loaded << ' ' << content.mGameSettings.size() << " game settings,";
-        if (query.mLoadLands)
-            loaded << ' ' << content.mLands.size() << " lands,";
-        if (query.mLoadStatics)
-            loaded << ' ' << content.mStatics.size() << " statics,";
-
-        Log(Debug::Info) << "Loaded" << loaded.str();
-
-        EsmData result;
-
-        if (query.mLoadActivators)
-            result.mActivators = prepareRecords(content.mActivators, GetKey{});
-        if (query.mLoadCells)
-            result.mCells = prepareCellRecords(content.mCells.mValues);
-        if (query.mLoadContainers)
-            result.mContainers = prepareRecords(content.mContainers, GetKey{});
-        if (query.mLoadDoors)
-            result.mDoors = prepareRecords(content.mDoors, GetKey{});
-        if (query.mLoadGameSettings)
-            result.mGameSettings = prepareRecords(content.mGameSettings, GetKey{});
-        if (query.mLoadLands)
-            result.mLands = prepareRecords(content.mLands, GetKey{});
-        if (query.mLoadStatics)
-            result.mStatics = prepareRecords(content.mStatics, GetKey{});
-
-        addRefIdsTypes(result);
-
-        std::ostringstream prepared;
-
-        if (query.mLoadActivators)
-            prepared << ' ' << result.mActivators.size() << " unique activators,";
-        if (query.mLoadCells)
-            prepared << ' ' << result.mCells.size() << " unique cells,";
-        if (query.mLoadContainers)
-            prepared << ' ' << result.mContainers.size() << " unique containers,";
-        if (query.mLoadDoors)
-            prepared << ' ' << result.mDoors.size() << " unique doors,";
-        if (query.mLoadGameSettings)
-            prepared << ' ' << result.mGameSettings.size() << " unique game settings,";
-        if (query.mLoadLands)
-            prepared << ' ' << result.mLands.size() << " unique lands,";
-        if (query.mLoadStatics)
-            prepared << ' ' << result.mStatics.size() << " unique statics,";
-
-        Log(Debug::Info) << "Prepared" << prepared.str();
+        const auto start = std::chrono::steady_clock::now();
+
+        ShallowLoader loader(query, readers, encoder);
+        const std::vector<ContentFile> files = openContentFiles(contentFiles, fileCollections, loader);
+        return prepareEsmData(query, shallowLoad(files, loader, listener, threads), start);
+    }
+
+    EsmData loadCachedEsmData(const std::filesystem::path& cachePath, const Query& query,
+        const std::vector<std::string>& contentFiles, const Files::Collections& fileCollections,
+        ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener, std::size_t threads)
+    {
+        Log(Debug::Info) << "Loading ESM data...";
+
+        const auto start = std::chrono::steady_clock::now();
+
+        ShallowLoader loader(query, readers, encoder);
+        const std::vector<ContentFile> files = openContentFiles(contentFiles, fileCollections, loader);
+
+        CacheKey key;
+        key.mQuery = query;
+        if (encoder != nullptr)
+            key.mEncoding = static_cast<std::int32_t>(encoder->getStatelessEncoder().getSourceEncoding());
+        key.mContentFiles.reserve(files.size());
+        for (const ContentFile& file : files)
+            key.mContentFiles.push_back(ContentFileState{
+                .mPath = Files::pathToUnicodeString(file.mPath),
+                .mSize = static_cast<std::uint64_t>(std::filesystem::file_size(file.mPath)),
+                .mLastModified = static_cast<std::int64_t>(
+                    std::filesystem::last_write_time(file.mPath).time_since_epoch().count()),
+            });
+
+        if (std::filesystem::exists(cachePath))
+        {
+            try
+            {
+                const Platform::File::MappedFile mapped(cachePath);
+                const std::span<const char> data = mapped.getData();
+                std::optional<EsmData> cached = deserialize(std::as_bytes(data), key);
+                if (cached.has_value())
+                {
+                    Log(Debug::Info) << "Loaded ESM data from cache " << cachePath << " in "
+                                     << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                            std::chrono::steady_clock::now() - start)
+                                            .count()
+                                     << " ms";
+                    return std::move(*cached);
+                }
+                Log(Debug::Info) << "ESM data cache " << cachePath << " is outdated";
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to read ESM data cache " << cachePath << ": " << e.what();
+            }
+        }
+
+        EsmData result = prepareEsmData(query, shallowLoad(files, loader, listener, threads), start);
+
+        // The name is random because multiple instances may write the same cache at the same time
+        std::filesystem::path tmpPath = cachePath;
+        tmpPath += "." + std::to_string(std::random_device()()) + ".tmp";
+
+        try
+        {
+            const std::vector<std::byte> data = serialize(key, result);
+            std::filesystem::create_directories(cachePath.parent_path());
+            {
+                std::ofstream stream(tmpPath, std::ios::binary);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            }
+            std::filesystem::rename(tmpPath, cachePath);
+            Log(Debug::Info) << "Written ESM data cache " << cachePath << " (" << data.size() << " bytes)";
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write ESM data cache " << cachePath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
 
         return result;
     }
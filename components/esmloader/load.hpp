@@ -3,6 +3,8 @@
 
 #include <components/esm3/esmreader.hpp>
 
+#include <cstddef>
+#include <filesystem>
 #include <string>
 #include <vector>
 
@@ -38,9 +40,19 @@ namespace EsmLoader
         bool mLoadStatics = false;
     };
 
+    /// @param threads number of threads to parse content files in parallel. Records are merged in the load order
+    /// on the calling thread so the result doesn't depend on it.
     EsmData loadEsmData(const Query& query, const std::vector<std::string>& contentFiles,
         const Files::Collections& fileCollections, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-        Loading::Listener* listener = nullptr);
+        Loading::Listener* listener = nullptr, std::size_t threads = 1);
+
+    /// Same as loadEsmData but reads the result from the cache file when it was written for the same query and
+    /// content files with the same paths, sizes and modification times. Otherwise loads content files and writes the
+    /// cache. Headers of content files are read in both cases to initialize the readers.
+    EsmData loadCachedEsmData(const std::filesystem::path& cachePath, const Query& query,
+        const std::vector<std::string>& contentFiles, const Files::Collections& fileCollections,
+        ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener = nullptr,
+        std::size_t threads = 1);
 }
 
 #endif
@@ -2,13 +2,27 @@
 
 #include <smhasher/MurmurHash3.h>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <istream>
 #include <string>
 
 namespace Files
 {
+    namespace
+    {
+        constexpr std::size_t blockSize = 4096;
+
+        std::array<std::uint64_t, 2> getNextHash(const std::array<std::uint64_t, 2>& hash, const char* data, int size)
+        {
+            std::array<std::uint64_t, 2> blockHash{ 0, 0 };
+            MurmurHash3_x64_128(data, size, hash.data(), blockHash.data());
+            return blockHash;
+        }
+    }
+
     std::array<std::uint64_t, 2> getHash(std::string_view fileName, std::istream& stream)
     {
         std::array<std::uint64_t, 2> hash{ 0, 0 };
@@ -19,14 +33,12 @@ namespace Files
             stream.exceptions(std::ios_base::badbit);
             while (stream)
             {
-                std::array<char, 4096> value;
+                std::array<char, blockSize> value;
                 stream.read(value.data(), value.size());
                 const std::streamsize read = stream.gcount();
                 if (read == 0)
                     break;
-                std::array<std::uint64_t, 2> blockHash{ 0, 0 };
-                MurmurHash3_x64_128(value.data(), static_cast<int>(read), hash.data(), blockHash.data());
-                hash = blockHash;
+                hash = getNextHash(hash, value.data(), static_cast<int>(read));
             }
             stream.clear();
             stream.exceptions(exceptions);
@@ -42,4 +54,12 @@ namespace Files
         }
         return hash;
     }
+
+    std::array<std::uint64_t, 2> getHash(std::span<const char> data)
+    {
+        std::array<std::uint64_t, 2> hash{ 0, 0 };
+        for (std::size_t offset = 0; offset < data.size(); offset += blockSize)
+            hash = getNextHash(hash, data.data() + offset, static_cast<int>(std::min(blockSize, data.size() - offset)));
+        return hash;
+    }
 }
@@ -4,11 +4,15 @@
 #include <array>
 #include <cstdint>
 #include <iosfwd>
+#include <span>
 #include <string_view>
 
 namespace Files
 {
     std::array<std::uint64_t, 2> getHash(std::string_view fileName, std::istream& stream);
+
+    /// Same as for the stream with the same content.
+    std::array<std::uint64_t, 2> getHash(std::span<const char> data);
 }
 
 #endif
@@ -0,0 +1,31 @@
+#ifndef OPENMW_COMPONENTS_FILES_MAPPEDFILESTREAM_H
+#define OPENMW_COMPONENTS_FILES_MAPPEDFILESTREAM_H
+
+#include "memorystream.hpp"
+
+#include <components/platform/file.hpp>
+
+#include <istream>
+#include <memory>
+#include <span>
+
+namespace Files
+{
+    /// @brief A variant of std::istream that reads a region of a memory mapped file without copying it.
+    /// @par The stream shares ownership of the mapping so it stays valid even if the owner of the file is gone.
+    class MappedFileStream final : private MemBuf, public std::istream
+    {
+    public:
+        explicit MappedFileStream(std::shared_ptr<const Platform::File::MappedFile> file, std::span<const char> data)
+            : MemBuf(data.data(), data.size())
+            , std::istream(static_cast<std::streambuf*>(this))
+            , mFile(std::move(file))
+        {
+        }
+
+    private:
+        std::shared_ptr<const Platform::File::MappedFile> mFile;
+    };
+}
+
+#endif
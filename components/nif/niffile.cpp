@@ -2,13 +2,17 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/files/hash.hpp>
+#include <components/files/utils.hpp>
 
 #include <algorithm>
 #include <array>
+#include <cerrno>
+#include <istream>
 #include <limits>
 #include <map>
 #include <sstream>
 #include <stdexcept>
+#include <system_error>
 
 #include "controller.hpp"
 #include "data.hpp"
@@ -537,15 +541,24 @@ namespace Nif
     }
 
     void Reader::parse(Files::IStreamPtr&& stream)
+    {
+        std::vector<char> data(static_cast<std::size_t>(Files::getStreamSizeLeft(*stream)));
+        stream->read(data.data(), static_cast<std::streamsize>(data.size()));
+        if (stream->fail())
+            throw Nif::Exception("Failed to read file: " + std::generic_category().message(errno), mFilename);
+        parse(std::span<const char>(data));
+    }
+
+    void Reader::parse(std::span<const char> data)
     {
         const bool writeDebug = sWriteNifDebugLog;
         if (writeDebug)
             Log(Debug::Verbose) << "NIF Debug: Reading file: '" << mFilename << "'";
 
-        const std::array<std::uint64_t, 2> fileHash = Files::getHash(mFilename, *stream);
+        const std::array<std::uint64_t, 2> fileHash = Files::getHash(data);
         mHash.append(reinterpret_cast<const char*>(fileHash.data()), fileHash.size() * sizeof(std::uint64_t));
 
-        NIFStream nif(*this, std::move(stream), mEncoder);
+        NIFStream nif(*this, data, mEncoder);
 
         // Check the header string
         std::string head = nif.getVersionString();
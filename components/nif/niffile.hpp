@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include <components/files/istreamptr.hpp>
@@ -131,9 +132,13 @@ namespace Nif
         /// Open a NIF stream. The name is used for error messages.
         explicit Reader(NIFFile& file, const ToUTF8::StatelessUtf8Encoder* encoder);
 
-        /// Parse the file
+        /// Parse the file. The whole stream is read into memory first, prefer the overload for the data already
+        /// available in memory when possible.
         void parse(Files::IStreamPtr&& stream);
 
+        /// Parse the file from the buffer with its whole content. The buffer is not used after return.
+        void parse(std::span<const char> data);
+
         /// Get a given record
         Record* getRecord(size_t index) const { return mRecords.at(index).get(); }
 
@@ -1,10 +1,10 @@
 #include "nifstream.hpp"
 
-#include <cerrno>
+#include <algorithm>
 #include <format>
 #include <span>
 #include <stdexcept>
-#include <system_error>
+#include <string_view>
 
 #include <components/toutf8/toutf8.hpp>
 
@@ -27,12 +27,12 @@ namespace
     // This one should be used if the type can be read contiguously as an array of a different type
     // (e.g. osg::VecXf can be read as a float array of X elements)
     template <class elementType, size_t numElements, class T>
-    void readAlignedRange(Files::IStreamPtr& stream, T* dest, size_t size)
+    void readAlignedRange(Nif::NIFStream& stream, T* dest, size_t size)
     {
         static_assert(std::is_standard_layout_v<T>);
         static_assert(std::alignment_of_v<T> == std::alignment_of_v<elementType>);
         static_assert(sizeof(T) == sizeof(elementType) * numElements);
-        Nif::readDynamicBufferOfType(stream, reinterpret_cast<elementType*>(dest), size * numElements);
+        stream.read(reinterpret_cast<elementType*>(dest), size * numElements);
     }
 
 }
@@ -58,14 +58,9 @@ namespace Nif
     std::string NIFStream::getSizedString(size_t length)
     {
         checkStreamSize(length);
-        std::string str(length, '\0');
-        mStream->read(str.data(), length);
-        if (mStream->fail())
-            throw std::runtime_error(std::format(
-                "Failed to read sized string of {} chars: {}", length, std::generic_category().message(errno)));
-        size_t end = str.find('\0');
-        if (end != std::string::npos)
-            str.erase(end);
+        const std::string_view value(mPosition, length);
+        mPosition += length;
+        std::string str(value.substr(0, value.find('\0')));
         if (mEncoder)
             str = mEncoder->getUtf8(str, ToUTF8::BufferAllocationPolicy::UseGrowFactor, mBuffer);
         return str;
@@ -81,11 +76,11 @@ namespace Nif
 
     std::string NIFStream::getVersionString()
     {
-        std::string result;
-        std::getline(*mStream, result);
-        if (mStream->fail())
-            throw std::runtime_error(
-                std::format("Failed to read version string: {}", std::generic_category().message(errno)));
+        if (mPosition == mEnd)
+            throw std::runtime_error("Failed to read version string: end of stream");
+        const char* const lineEnd = std::find(mPosition, mEnd, '\n');
+        std::string result(mPosition, lineEnd);
+        mPosition = lineEnd == mEnd ? mEnd : lineEnd + 1;
         return result;
     }
 
@@ -93,36 +88,33 @@ namespace Nif
     {
         size_t size = get<uint32_t>();
         checkStreamSize(size);
-        std::string str(size, '\0');
-        mStream->read(str.data(), size);
-        if (mStream->fail())
-            throw std::runtime_error(std::format(
-                "Failed to read string palette of {} chars: {}", size, std::generic_category().message(errno)));
+        std::string str(mPosition, size);
+        mPosition += size;
         return str;
     }
 
     template <>
     void NIFStream::read<osg::Vec2f>(osg::Vec2f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer(vec._v, osg::Vec2f::num_components);
     }
 
     template <>
     void NIFStream::read<osg::Vec3f>(osg::Vec3f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer(vec._v, osg::Vec3f::num_components);
     }
 
     template <>
     void NIFStream::read<osg::Vec4f>(osg::Vec4f& vec)
     {
-        readBufferOfType(mStream, vec._v);
+        readBuffer(vec._v, osg::Vec4f::num_components);
     }
 
     template <>
     void NIFStream::read<Matrix3>(Matrix3& mat)
     {
-        readBufferOfType<9>(mStream, reinterpret_cast<float*>(&mat.mValues));
+        readBuffer(reinterpret_cast<float*>(&mat.mValues), 9);
     }
 
     template <>
@@ -188,25 +180,25 @@ namespace Nif
     template <>
     void NIFStream::read<osg::Vec2f>(osg::Vec2f* dest, size_t size)
     {
-        readAlignedRange<float, 2>(mStream, dest, size);
+        readAlignedRange<float, 2>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<osg::Vec3f>(osg::Vec3f* dest, size_t size)
     {
-        readAlignedRange<float, 3>(mStream, dest, size);
+        readAlignedRange<float, 3>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<osg::Vec4f>(osg::Vec4f* dest, size_t size)
     {
-        readAlignedRange<float, 4>(mStream, dest, size);
+        readAlignedRange<float, 4>(*this, dest, size);
     }
 
     template <>
     void NIFStream::read<Matrix3>(Matrix3* dest, size_t size)
     {
-        readAlignedRange<float, 9>(mStream, dest, size);
+        readAlignedRange<float, 9>(*this, dest, size);
     }
 
     template <>
@@ -271,7 +263,8 @@ namespace Nif
 
     void NIFStream::checkStreamSize(std::size_t size)
     {
-        if (size > mStreamSize)
-            throw std::runtime_error(std::format("Trying to read more than stream size: {} max={}", size, mStreamSize));
+        if (size > getSizeLeft())
+            throw std::runtime_error(
+                std::format("Trying to read more than stream size: {} max={}", size, getSizeLeft()));
     }
 }
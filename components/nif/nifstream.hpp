@@ -3,20 +3,19 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <array>
 #include <cassert>
-#include <cerrno>
+#include <cstring>
 #include <format>
-#include <istream>
+#include <span>
 #include <stdexcept>
 #include <stdint.h>
 #include <string>
-#include <system_error>
 #include <type_traits>
+#include <typeinfo>
 #include <vector>
 
-#include <components/files/istreamptr.hpp>
-#include <components/files/utils.hpp>
 #include <components/misc/endianness.hpp>
 #include <components/misc/float16.hpp>
 
@@ -37,62 +36,27 @@ namespace Nif
 
     class Reader;
 
-    template <std::size_t numInstances, typename T>
-    inline void readBufferOfType(Files::IStreamPtr& pIStream, T* dest)
-    {
-        static_assert(
-            std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
-        static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->fail())
-            throw std::runtime_error(std::format("Failed to read typed ({}) dynamic buffer of {} instances: {}",
-                typeid(T).name(), numInstances, std::generic_category().message(errno)));
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-
-    template <std::size_t numInstances, typename T>
-    inline void readBufferOfType(Files::IStreamPtr& pIStream, T (&dest)[numInstances])
-    {
-        readBufferOfType<numInstances>(pIStream, static_cast<T*>(dest));
-    }
-
-    template <typename T>
-    inline void readDynamicBufferOfType(Files::IStreamPtr& pIStream, T* dest, std::size_t numInstances)
-    {
-        static_assert(
-            std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
-        static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->fail())
-            throw std::runtime_error(std::format("Failed to read typed ({}) dynamic buffer of {} instances: {}",
-                typeid(T).name(), numInstances, std::generic_category().message(errno)));
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-
     class NIFStream;
 
     template <class T>
     void readRecord(NIFStream& stream, T& value);
 
+    /// Reads from a contiguous buffer holding the whole file. The buffer must outlive the stream.
     class NIFStream
     {
         const Reader& mReader;
-        Files::IStreamPtr mStream;
+        const char* mPosition;
+        const char* const mEnd;
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
         std::string mBuffer;
-        std::size_t mStreamSize;
 
     public:
         explicit NIFStream(
-            const Reader& reader, Files::IStreamPtr&& stream, const ToUTF8::StatelessUtf8Encoder* encoder)
+            const Reader& reader, std::span<const char> data, const ToUTF8::StatelessUtf8Encoder* encoder)
             : mReader(reader)
-            , mStream(std::move(stream))
+            , mPosition(data.data())
+            , mEnd(data.data() + data.size())
             , mEncoder(encoder)
-            , mStreamSize(static_cast<std::size_t>(Files::getStreamSizeLeft(*mStream)))
         {
         }
 
@@ -108,27 +72,31 @@ namespace Nif
             return (major << 24) + (minor << 16) + (patch << 8) + rev;
         }
 
-        void skip(size_t size) { mStream->ignore(size); }
+        /// Number of bytes left to read
+        std::size_t getSizeLeft() const { return static_cast<std::size_t>(mEnd - mPosition); }
+
+        /// Skipping past the end is not an error but any following read will fail
+        void skip(size_t size) { mPosition += std::min(size, getSizeLeft()); }
 
         /// Read into a single instance of type
         template <class T>
         void read(T& data)
         {
-            readBufferOfType<1>(mStream, &data);
+            readBuffer(&data, 1);
         }
 
         /// Read multiple instances of type into an array
         template <class T, size_t size>
         void readArray(std::array<T, size>& arr)
         {
-            readBufferOfType<size>(mStream, arr.data());
+            readBuffer(arr.data(), size);
         }
 
         /// Read instances of type into a dynamic buffer
         template <class T>
         void read(T* dest, size_t size)
         {
-            readDynamicBufferOfType<T>(mStream, dest, size);
+            readBuffer(dest, size);
         }
 
         /// Read multiple instances of type into a vector
@@ -204,6 +172,23 @@ namespace Nif
 
     private:
         void checkStreamSize(std::size_t size);
+
+        /// Copy little-endian values with a single bounds check for the whole range
+        template <class T>
+        void readBuffer(T* dest, std::size_t numInstances)
+        {
+            static_assert(
+                std::is_arithmetic_v<T> || std::is_same_v<T, Misc::float16_t>, "Buffer element type is not arithmetic");
+            static_assert(!std::is_same_v<T, bool>, "Buffer element type is boolean");
+            if (numInstances > getSizeLeft() / sizeof(T))
+                throw std::runtime_error(std::format("Failed to read typed ({}) buffer of {} instances: {} bytes left",
+                    typeid(T).name(), numInstances, getSizeLeft()));
+            std::memcpy(dest, mPosition, numInstances * sizeof(T));
+            mPosition += numInstances * sizeof(T);
+            if constexpr (Misc::IS_BIG_ENDIAN)
+                for (std::size_t i = 0; i < numInstances; i++)
+                    Misc::swapEndiannessInplace(dest[i]);
+        }
     };
 
     template <class T>
@@ -0,0 +1,211 @@
+#include "compiledtrack.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace NifOsg
+{
+    namespace
+    {
+        struct SampleRange
+        {
+            float mStartTime;
+            float mDuration;
+            std::size_t mCount;
+
+            float getSampleRate() const { return mCount > 1 ? static_cast<float>(mCount - 1) / mDuration : 0; }
+
+            float getTime(std::size_t index) const
+            {
+                if (mCount < 2)
+                    return mStartTime;
+                return mStartTime + mDuration * static_cast<float>(index) / static_cast<float>(mCount - 1);
+            }
+        };
+
+        // The last sample is placed exactly at the last key
+        SampleRange makeSampleRange(std::span<const float> keyTimes, float sampleRate)
+        {
+            const float duration = keyTimes.back() - keyTimes.front();
+            if (!(duration > 0) || !(sampleRate > 0))
+                return SampleRange{ keyTimes.front(), 0, 1 };
+            const std::size_t count = static_cast<std::size_t>(std::ceil(duration * sampleRate)) + 1;
+            return SampleRange{ keyTimes.front(), duration, count };
+        }
+
+        struct SamplePosition
+        {
+            std::size_t mIndex;
+            float mFraction;
+        };
+
+        SamplePosition findSample(float startTime, float sampleRate, std::size_t count, float time)
+        {
+            assert(count > 0);
+            if (count < 2)
+                return SamplePosition{ 0, 0 };
+            const float position = std::clamp((time - startTime) * sampleRate, 0.0f, static_cast<float>(count - 1));
+            const std::size_t index = std::min(static_cast<std::size_t>(position), count - 2);
+            return SamplePosition{ index, position - static_cast<float>(index) };
+        }
+
+        // Compares the tracks at the key times, between them and between the samples
+        template <class T, class Compiled, class Distance>
+        float getMaxError(std::span<const float> keyTimes, const SampleRange& range,
+            const std::function<T(float)>& source, const Compiled& compiled, Distance&& distance)
+        {
+            float result = 0;
+            const auto update
+                = [&](float time) { result = std::max(result, distance(source(time), compiled.get(time))); };
+            for (std::size_t i = 0; i < keyTimes.size(); ++i)
+            {
+                update(keyTimes[i]);
+                if (i > 0)
+                    update((keyTimes[i - 1] + keyTimes[i]) * 0.5f);
+            }
+            for (std::size_t i = 1; i < range.mCount; ++i)
+                update((range.getTime(i - 1) + range.getTime(i)) * 0.5f);
+            return result;
+        }
+
+        double dot(const osg::Quat& lhs, const osg::Quat& rhs)
+        {
+            return lhs.x() * rhs.x() + lhs.y() * rhs.y() + lhs.z() * rhs.z() + lhs.w() * rhs.w();
+        }
+
+        float getAngle(const osg::Quat& lhs, const osg::Quat& rhs)
+        {
+            const double lengths = lhs.length() * rhs.length();
+            if (lengths == 0)
+                return std::numeric_limits<float>::max();
+            const double cos = std::min(std::abs(dot(lhs, rhs)) / lengths, 1.0);
+            return static_cast<float>(2 * std::acos(cos));
+        }
+
+        std::int16_t quantizeUnit(double value)
+        {
+            constexpr double max = std::numeric_limits<std::int16_t>::max();
+            return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0, 1.0) * max));
+        }
+
+        std::uint16_t quantizeRange(float value, float offset, float scale)
+        {
+            if (scale == 0)
+                return 0;
+            constexpr float max = std::numeric_limits<std::uint16_t>::max();
+            return static_cast<std::uint16_t>(std::lround(std::clamp((value - offset) / scale, 0.0f, max)));
+        }
+    }
+
+    osg::Quat CompiledRotationTrack::get(float time) const
+    {
+        const auto [index, fraction] = findSample(mStartTime, mSampleRate, mSamples.size(), time);
+        const std::array<std::int16_t, 4>& low = mSamples[index];
+        const std::array<std::int16_t, 4>& high = mSamples[std::min(index + 1, mSamples.size() - 1)];
+
+        // Normalized linear interpolation, the quantization scale is removed by normalization
+        float value[4];
+        float length2 = 0;
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            value[i] = low[i] + (high[i] - low[i]) * fraction;
+            length2 += value[i] * value[i];
+        }
+        if (length2 == 0)
+            return osg::Quat();
+        const float scale = 1 / std::sqrt(length2);
+        return osg::Quat(value[0] * scale, value[1] * scale, value[2] * scale, value[3] * scale);
+    }
+
+    osg::Vec3f CompiledTranslationTrack::get(float time) const
+    {
+        const auto [index, fraction] = findSample(mStartTime, mSampleRate, mSamples.size(), time);
+        const std::array<std::uint16_t, 3>& low = mSamples[index];
+        const std::array<std::uint16_t, 3>& high = mSamples[std::min(index + 1, mSamples.size() - 1)];
+
+        osg::Vec3f result;
+        for (std::size_t i = 0; i < 3; ++i)
+            result[i] = mOffset[i] + (low[i] + (high[i] - low[i]) * fraction) * mScale[i];
+        return result;
+    }
+
+    std::optional<CompiledRotationTrack> compileRotationTrack(std::span<const float> keyTimes,
+        const std::function<osg::Quat(float)>& source, const CompiledTrackSettings& settings)
+    {
+        assert(!keyTimes.empty());
+
+        const SampleRange range = makeSampleRange(keyTimes, settings.mSampleRate);
+
+        CompiledRotationTrack result;
+        result.mStartTime = range.mStartTime;
+        result.mSampleRate = range.getSampleRate();
+        result.mSamples.reserve(range.mCount);
+
+        osg::Quat previous;
+        for (std::size_t i = 0; i < range.mCount; ++i)
+        {
+            osg::Quat value = source(range.getTime(i));
+            const double length = value.length();
+            if (!(length > 0))
+                return std::nullopt;
+            value /= length;
+            // Keep neighbour samples in the same hemisphere to interpolate along the shorter arc
+            if (i > 0 && dot(previous, value) < 0)
+                value = -value;
+            previous = value;
+            result.mSamples.push_back(
+                { quantizeUnit(value.x()), quantizeUnit(value.y()), quantizeUnit(value.z()), quantizeUnit(value.w()) });
+        }
+
+        result.mMaxError = getMaxError(keyTimes, range, source, result, getAngle);
+        if (!(result.mMaxError <= settings.mMaxRotationError))
+            return std::nullopt;
+
+        return result;
+    }
+
+    std::optional<CompiledTranslationTrack> compileTranslationTrack(std::span<const float> keyTimes,
+        const std::function<osg::Vec3f(float)>& source, const CompiledTrackSettings& settings)
+    {
+        assert(!keyTimes.empty());
+
+        const SampleRange range = makeSampleRange(keyTimes, settings.mSampleRate);
+
+        std::vector<osg::Vec3f> values;
+        values.reserve(range.mCount);
+        for (std::size_t i = 0; i < range.mCount; ++i)
+            values.push_back(source(range.getTime(i)));
+
+        osg::Vec3f min = values.front();
+        osg::Vec3f max = values.front();
+        for (const osg::Vec3f& value : values)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                min[i] = std::min(min[i], value[i]);
+                max[i] = std::max(max[i], value[i]);
+            }
+        }
+
+        CompiledTranslationTrack result;
+        result.mStartTime = range.mStartTime;
+        result.mSampleRate = range.getSampleRate();
+        result.mOffset = min;
+        for (std::size_t i = 0; i < 3; ++i)
+            result.mScale[i] = (max[i] - min[i]) / std::numeric_limits<std::uint16_t>::max();
+        result.mSamples.reserve(values.size());
+        for (const osg::Vec3f& value : values)
+            result.mSamples.push_back({ quantizeRange(value.x(), min.x(), result.mScale.x()),
+                quantizeRange(value.y(), min.y(), result.mScale.y()),
+                quantizeRange(value.z(), min.z(), result.mScale.z()) });
+
+        result.mMaxError = getMaxError(keyTimes, range, source, result,
+            [](const osg::Vec3f& lhs, const osg::Vec3f& rhs) { return (lhs - rhs).length(); });
+        if (!(result.mMaxError <= settings.mMaxTranslationError))
+            return std::nullopt;
+
+        return result;
+    }
+}
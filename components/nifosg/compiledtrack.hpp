@@ -0,0 +1,66 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_COMPILEDTRACK_H
+#define OPENMW_COMPONENTS_NIFOSG_COMPILEDTRACK_H
+
+#include <osg/Quat>
+#include <osg/Vec3f>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace NifOsg
+{
+    struct CompiledTrackSettings
+    {
+        /// Samples per second.
+        float mSampleRate = 30;
+        /// Biggest allowed angle in radians between the compiled and the source rotation.
+        float mMaxRotationError = 0.005f;
+        /// Biggest allowed distance between the compiled and the source translation.
+        float mMaxTranslationError = 0.05f;
+    };
+
+    /// Rotation track sampled at uniform rate with quaternion components quantised to 16 bit.
+    struct CompiledRotationTrack
+    {
+        float mStartTime = 0;
+        float mSampleRate = 0;
+        std::vector<std::array<std::int16_t, 4>> mSamples;
+        /// The biggest angle between the compiled and the source rotation found when compiling.
+        float mMaxError = 0;
+
+        osg::Quat get(float time) const;
+
+        std::size_t getMemoryUsage() const { return mSamples.size() * sizeof(mSamples[0]); }
+    };
+
+    /// Translation track sampled at uniform rate with components quantised to 16 bit within the track bounds.
+    struct CompiledTranslationTrack
+    {
+        float mStartTime = 0;
+        float mSampleRate = 0;
+        osg::Vec3f mOffset;
+        osg::Vec3f mScale;
+        std::vector<std::array<std::uint16_t, 3>> mSamples;
+        /// The biggest distance between the compiled and the source translation found when compiling.
+        float mMaxError = 0;
+
+        osg::Vec3f get(float time) const;
+
+        std::size_t getMemoryUsage() const { return mSamples.size() * sizeof(mSamples[0]); }
+    };
+
+    /// Resamples the source over the range of key times. Returns nothing if the result differs from the source by
+    /// more than allowed at the key times or between them.
+    std::optional<CompiledRotationTrack> compileRotationTrack(std::span<const float> keyTimes,
+        const std::function<osg::Quat(float)>& source, const CompiledTrackSettings& settings);
+
+    std::optional<CompiledTranslationTrack> compileTranslationTrack(std::span<const float> keyTimes,
+        const std::function<osg::Vec3f(float)>& source, const CompiledTrackSettings& settings);
+}
+
+#endif
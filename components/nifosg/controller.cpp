@@ -12,6 +12,10 @@
 #include <components/nif/data.hpp>
 #include <components/sceneutil/morphgeometry.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 #include "matrixtransform.hpp"
 
 namespace NifOsg
@@ -87,6 +91,8 @@ namespace NifOsg
         , mTranslations(copy.mTranslations)
         , mScales(copy.mScales)
         , mAxisOrder(copy.mAxisOrder)
+        , mCompiledRotations(copy.mCompiledRotations)
+        , mCompiledTranslations(copy.mCompiledTranslations)
     {
     }
 
@@ -170,6 +176,8 @@ namespace NifOsg
 
     osg::Vec3f KeyframeController::getTranslation(float time) const
     {
+        if (mCompiledTranslations != nullptr)
+            return mCompiledTranslations->get(time);
         if (!mTranslations.empty())
             return mTranslations.interpKey(time);
         return osg::Vec3f();
@@ -206,12 +214,16 @@ namespace NifOsg
         {
             float time = getInputValue(nv);
 
-            if (!mRotations.empty())
+            if (mCompiledRotations != nullptr)
+                out.mRotation = mCompiledRotations->get(time);
+            else if (!mRotations.empty())
                 out.mRotation = mRotations.interpKey(time);
             else if (!mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
                 out.mRotation = getXYZRotation(time);
 
-            if (!mTranslations.empty())
+            if (mCompiledTranslations != nullptr)
+                out.mTranslation = mCompiledTranslations->get(time);
+            else if (!mTranslations.empty())
                 out.mTranslation = mTranslations.interpKey(time);
 
             if (!mScales.empty())
@@ -221,6 +233,55 @@ namespace NifOsg
         return out;
     }
 
+    void KeyframeController::compile(const CompiledTrackSettings& settings)
+    {
+        if (!mRotations.empty() || !mXRotations.empty() || !mYRotations.empty() || !mZRotations.empty())
+        {
+            const std::size_t memoryUsage = mRotations.getMemoryUsage() + mXRotations.getMemoryUsage()
+                + mYRotations.getMemoryUsage() + mZRotations.getMemoryUsage();
+
+            std::vector<float> keyTimes;
+            if (!mRotations.empty())
+                keyTimes.assign(mRotations.getKeyTimes().begin(), mRotations.getKeyTimes().end());
+            else
+            {
+                for (const FloatInterpolator* interpolator : { &mXRotations, &mYRotations, &mZRotations })
+                {
+                    const std::span<const float> times = interpolator->getKeyTimes();
+                    keyTimes.insert(keyTimes.end(), times.begin(), times.end());
+                }
+            }
+            std::sort(keyTimes.begin(), keyTimes.end());
+            keyTimes.erase(std::unique(keyTimes.begin(), keyTimes.end()), keyTimes.end());
+
+            std::optional<CompiledRotationTrack> compiled = compileRotationTrack(
+                keyTimes,
+                [&](float time) { return mRotations.empty() ? getXYZRotation(time) : mRotations.interpKey(time); },
+                settings);
+
+            if (compiled.has_value() && compiled->getMemoryUsage() < memoryUsage)
+            {
+                mCompiledRotations = std::make_shared<const CompiledRotationTrack>(std::move(*compiled));
+                mRotations = QuaternionInterpolator();
+                mXRotations = FloatInterpolator();
+                mYRotations = FloatInterpolator();
+                mZRotations = FloatInterpolator();
+            }
+        }
+
+        if (!mTranslations.empty())
+        {
+            std::optional<CompiledTranslationTrack> compiled = compileTranslationTrack(
+                mTranslations.getKeyTimes(), [&](float time) { return mTranslations.interpKey(time); }, settings);
+
+            if (compiled.has_value() && compiled->getMemoryUsage() < mTranslations.getMemoryUsage())
+            {
+                mCompiledTranslations = std::make_shared<const CompiledTranslationTrack>(std::move(*compiled));
+                mTranslations = Vec3Interpolator();
+            }
+        }
+    }
+
     GeomMorpherController::GeomMorpherController() {}
 
     GeomMorpherController::GeomMorpherController(const GeomMorpherController& copy, const osg::CopyOp& copyop)
@@ -1,8 +1,12 @@
 #ifndef COMPONENTS_NIFOSG_CONTROLLER_H
 #define COMPONENTS_NIFOSG_CONTROLLER_H
 
+#include <cstddef>
+#include <memory>
 #include <set>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 #include <osg/Texture2D>
 
@@ -13,6 +17,9 @@
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 
+#include "compiledtrack.hpp"
+#include "keyframetrack.hpp"
+
 namespace osg
 {
     class Material;
@@ -38,26 +45,6 @@ namespace NifOsg
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
-        {
-            // retrieve the current position in the map, optimized for the most common case
-            // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
-            {
-                if (time > mLastHighKey->first)
-                {
-                    // try if we're there by incrementing one
-                    ++mLastLowKey;
-                    ++mLastHighKey;
-                }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
-                    return mLastHighKey;
-            }
-
-            return std::lower_bound(mKeys->mKeys.begin(), mKeys->mKeys.end(), time,
-                [](const typename MapT::MapType::value_type& key, float t) { return key.first < t; });
-        }
-
     public:
         using ValueT = typename MapT::ValueType;
 
@@ -74,23 +61,13 @@ namespace NifOsg
         {
             if (interpolator->mData.empty())
                 return;
-            mKeys = interpolator->mData->mKeyList;
-            if (mKeys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
+            setKeys(interpolator->mData->mKeyList);
         }
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
-            : mKeys(keys)
-            , mDefaultVal(defaultVal)
+            : mDefaultVal(defaultVal)
         {
-            if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
+            setKeys(keys);
         }
 
         ValueT interpKey(float time) const
@@ -98,87 +75,107 @@ namespace NifOsg
             if (empty())
                 return mDefaultVal;
 
-            const typename MapT::MapType& keys = mKeys->mKeys;
+            // time moves linearly along the keyframe track in the most common case, so the keys used by the last
+            // evaluation and the next ones are checked before the binary search
+            if (!(time > mLastLowTime && time <= mLastHighTime))
+            {
+                const std::vector<float>& times = mTrack->mTimes;
 
-            if (time <= keys.front().first)
-                return keys.front().second.mValue;
+                if (time <= times.front())
+                    return mTrack->mValues.front();
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
+                if (time > times.back())
+                    return mTrack->mValues.back();
 
-            // now do the actual interpolation
-            if (it != keys.end())
-            {
                 // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+                if (time > mLastHighTime && mLastKey + 1 < times.size() && time <= times[mLastKey + 1])
+                    ++mLastKey;
+                else
+                    mLastKey = findKey(times, time);
+                mLastLowTime = times[mLastKey - 1];
+                mLastHighTime = times[mLastKey];
+            }
 
-                const float highTime = mLastHighKey->first;
-                const float lowTime = mLastLowKey->first;
-                if (highTime == lowTime)
-                    return mLastLowKey->second.mValue;
+            const float a = (time - mLastLowTime) / (mLastHighTime - mLastLowTime);
 
-                const float a = (time - lowTime) / (highTime - lowTime);
+            return interpolate(mLastKey - 1, mLastKey, a);
+        }
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
-            }
+        bool empty() const { return mTrack == nullptr; }
 
-            return keys.back().second.mValue;
+        std::span<const float> getKeyTimes() const
+        {
+            if (empty())
+                return {};
+            return mTrack->mTimes;
         }
 
-        bool empty() const { return !mKeys || mKeys->mKeys.empty(); }
+        std::size_t getMemoryUsage() const
+        {
+            if (empty())
+                return 0;
+            return mTrack->mTimes.size() * sizeof(float)
+                + (mTrack->mValues.size() + mTrack->mInTans.size() + mTrack->mOutTans.size()) * sizeof(ValueT);
+        }
 
     private:
-        template <typename ValueType>
-        ValueType interpolate(
-            const Nif::KeyT<ValueType>& a, const Nif::KeyT<ValueType>& b, float fraction, unsigned int type) const
+        void setKeys(const std::shared_ptr<const MapT>& keys)
         {
-            switch (type)
-            {
-                case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
-                case Nif::InterpolationType_Quadratic:
-                case Nif::InterpolationType_TCB:
-                {
-                    // Using a cubic Hermite spline.
-                    // b1(t) = 2t^3  - 3t^2 + 1
-                    // b2(t) = -2t^3 + 3t^2
-                    // b3(t) = t^3 - 2t^2 + t
-                    // b4(t) = t^3 - t^2
-                    // f(t) = a.mValue * b1(t) + b.mValue * b2(t) + a.mOutTan * b3(t) + b.mInTan * b4(t)
-                    const float t = fraction;
-                    const float t2 = t * t;
-                    const float t3 = t2 * t;
-                    const float b1 = 2.f * t3 - 3.f * t2 + 1;
-                    const float b2 = -2.f * t3 + 3.f * t2;
-                    const float b3 = t3 - 2.f * t2 + t;
-                    const float b4 = t3 - t2;
-                    return a.mValue * b1 + b.mValue * b2 + a.mOutTan * b3 + b.mInTan * b4;
-                }
-                default:
-                    return a.mValue + ((b.mValue - a.mValue) * fraction);
-            }
+            if (keys != nullptr && !keys->mKeys.empty())
+                mTrack = getKeyframeTrack(keys);
         }
-        osg::Quat interpolate(
-            const Nif::KeyT<osg::Quat>& a, const Nif::KeyT<osg::Quat>& b, float fraction, unsigned int type) const
+
+        ValueT interpolate(std::size_t low, std::size_t high, float fraction) const
         {
-            switch (type)
+            const KeyframeTrack<ValueT>& track = *mTrack;
+            const ValueT& a = track.mValues[low];
+            const ValueT& b = track.mValues[high];
+
+            if (track.mInterpolationType == Nif::InterpolationType_Constant)
+                return fraction > 0.5f ? b : a;
+
+            if constexpr (std::is_same_v<ValueT, osg::Quat>)
             {
-                case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
                 // TODO: Implement Quadratic and TBC interpolation
-                default:
+                osg::Quat result;
+                result.slerp(fraction, a, b);
+                return result;
+            }
+            else
+            {
+                switch (track.mInterpolationType)
                 {
-                    osg::Quat result;
-                    result.slerp(fraction, a.mValue, b.mValue);
-                    return result;
+                    case Nif::InterpolationType_Quadratic:
+                    case Nif::InterpolationType_TCB:
+                    {
+                        // Using a cubic Hermite spline.
+                        // b1(t) = 2t^3  - 3t^2 + 1
+                        // b2(t) = -2t^3 + 3t^2
+                        // b3(t) = t^3 - 2t^2 + t
+                        // b4(t) = t^3 - t^2
+                        // f(t) = a.mValue * b1(t) + b.mValue * b2(t) + a.mOutTan * b3(t) + b.mInTan * b4(t)
+                        const float t = fraction;
+                        const float t2 = t * t;
+                        const float t3 = t2 * t;
+                        const float b1 = 2.f * t3 - 3.f * t2 + 1;
+                        const float b2 = -2.f * t3 + 3.f * t2;
+                        const float b3 = t3 - 2.f * t2 + t;
+                        const float b4 = t3 - t2;
+                        return a * b1 + b * b2 + track.mOutTans[low] * b3 + track.mInTans[high] * b4;
+                    }
+                    default:
+                        return a + ((b - a) * fraction);
                 }
             }
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        // Index of the high key used by the last evaluation and the time range (mLastLowTime, mLastHighTime] where
+        // it is used, the initial range is empty
+        mutable std::size_t mLastKey = 0;
+        mutable float mLastLowTime = 0;
+        mutable float mLastHighTime = 0;
 
-        std::shared_ptr<const MapT> mKeys;
+        std::shared_ptr<const KeyframeTrack<ValueT>> mTrack;
 
         ValueT mDefaultVal = ValueT();
     };
@@ -248,6 +245,10 @@ namespace NifOsg
 
         void operator()(NifOsg::MatrixTransform*, osg::NodeVisitor*);
 
+        /// Replace rotation and translation keys by uniformly sampled quantised tracks when they are within the error
+        /// bounds and use less memory. Compiled tracks are shared by the copies of this controller.
+        void compile(const CompiledTrackSettings& settings);
+
     private:
         QuaternionInterpolator mRotations;
 
@@ -260,6 +261,9 @@ namespace NifOsg
 
         Nif::NiKeyframeData::AxisOrder mAxisOrder{ Nif::NiKeyframeData::AxisOrder::Order_XYZ };
 
+        std::shared_ptr<const CompiledRotationTrack> mCompiledRotations;
+        std::shared_ptr<const CompiledTranslationTrack> mCompiledTranslations;
+
         osg::Quat getXYZRotation(float time) const;
     };
 #ifdef _MSC_VER
@@ -0,0 +1,14 @@
+#include "keyframetrack.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace NifOsg
+{
+    std::size_t findKey(std::span<const float> times, float time)
+    {
+        assert(times.size() >= 2);
+
+        return static_cast<std::size_t>(std::lower_bound(times.begin() + 1, times.end(), time) - times.begin());
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef OPENMW_COMPONENTS_NIFOSG_KEYFRAMETRACK_H
+#define OPENMW_COMPONENTS_NIFOSG_KEYFRAMETRACK_H
+
+#include <components/nif/nifkey.hpp>
+
+#include <osg/Quat>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace NifOsg
+{
+    /// Keyframes of a single animated value in structure of arrays layout. Keeps key times contiguous to make the
+    /// search of the current key cache friendly.
+    template <class T>
+    struct KeyframeTrack
+    {
+        std::uint32_t mInterpolationType = Nif::InterpolationType_Unknown;
+        std::vector<float> mTimes;
+        std::vector<T> mValues;
+        // Only for Quadratic and TCB interpolation, never for quaternions
+        std::vector<T> mInTans;
+        std::vector<T> mOutTans;
+    };
+
+    template <class MapT>
+    KeyframeTrack<typename MapT::ValueType> makeKeyframeTrack(const MapT& keys)
+    {
+        using ValueT = typename MapT::ValueType;
+
+        KeyframeTrack<ValueT> result;
+        result.mInterpolationType = keys.mInterpolationType;
+
+        const bool withTangents = !std::is_same_v<ValueT, osg::Quat>
+            && (keys.mInterpolationType == Nif::InterpolationType_Quadratic
+                || keys.mInterpolationType == Nif::InterpolationType_TCB);
+
+        result.mTimes.reserve(keys.mKeys.size());
+        result.mValues.reserve(keys.mKeys.size());
+        if (withTangents)
+        {
+            result.mInTans.reserve(keys.mKeys.size());
+            result.mOutTans.reserve(keys.mKeys.size());
+        }
+
+        for (const auto& [time, key] : keys.mKeys)
+        {
+            result.mTimes.push_back(time);
+            result.mValues.push_back(key.mValue);
+            if (withTangents)
+            {
+                result.mInTans.push_back(key.mInTan);
+                result.mOutTans.push_back(key.mOutTan);
+            }
+        }
+
+        return result;
+    }
+
+    /// Returns the track built from the given keys. The track is built once and shared by all interpolators using
+    /// the same key map while any of them is alive.
+    template <class MapT>
+    std::shared_ptr<const KeyframeTrack<typename MapT::ValueType>> getKeyframeTrack(
+        const std::shared_ptr<const MapT>& keys)
+    {
+        using Track = KeyframeTrack<typename MapT::ValueType>;
+
+        struct Cache
+        {
+            std::mutex mMutex;
+            std::map<std::weak_ptr<const MapT>, std::weak_ptr<const Track>, std::owner_less<>> mTracks;
+            std::size_t mNextCleanupSize = 1024;
+        };
+
+        static Cache cache;
+
+        const std::lock_guard lock(cache.mMutex);
+
+        // Owner based ordering never matches an expired key map with a new one allocated at the same address
+        std::weak_ptr<const Track>& cached = cache.mTracks[keys];
+        if (std::shared_ptr<const Track> result = cached.lock())
+            return result;
+
+        auto result = std::make_shared<const Track>(makeKeyframeTrack(*keys));
+        cached = result;
+
+        if (cache.mTracks.size() >= cache.mNextCleanupSize)
+        {
+            std::erase_if(cache.mTracks, [](const auto& v) { return v.first.expired() || v.second.expired(); });
+            cache.mNextCleanupSize = std::max<std::size_t>(1024, 2 * cache.mTracks.size());
+        }
+
+        return result;
+    }
+
+    /// Finds the first key with time not less than the given one like std::lower_bound. Requires at least 2 keys and
+    /// times.front() < time <= times.back(), so the result is in range [1, times.size()).
+    std::size_t findKey(std::span<const float> times, float time);
+}
+
+#endif
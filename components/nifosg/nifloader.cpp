@@ -304,7 +304,8 @@ namespace NifOsg
         // This is used to queue emitters that weren't attached to their node yet.
         std::vector<std::pair<unsigned int, osg::ref_ptr<Emitter>>> mEmitterQueue;
 
-        void loadKf(Nif::FileView nif, SceneUtil::KeyframeHolder& target) const
+        void loadKf(
+            Nif::FileView nif, SceneUtil::KeyframeHolder& target, const CompiledTrackSettings* compileSettings) const
         {
             const Nif::NiSequenceStreamHelper* seq = nullptr;
             const size_t numRoots = nif.numRoots();
@@ -374,8 +375,10 @@ namespace NifOsg
                     continue;
                 }
 
-                osg::ref_ptr<SceneUtil::KeyframeController> callback = new NifOsg::KeyframeController(key);
+                osg::ref_ptr<NifOsg::KeyframeController> callback = new NifOsg::KeyframeController(key);
                 setupController(key, callback, /*animflags*/ 0);
+                if (compileSettings != nullptr)
+                    callback->compile(*compileSettings);
 
                 if (!target.mKeyframeControllers.emplace(strdata->mData, callback).second)
                     Log(Debug::Verbose) << "Controller " << strdata->mData << " present more than once in "
@@ -2932,10 +2935,11 @@ namespace NifOsg
         return impl.load(file);
     }
 
-    void Loader::loadKf(Nif::FileView kf, SceneUtil::KeyframeHolder& target)
+    void Loader::loadKf(
+        Nif::FileView kf, SceneUtil::KeyframeHolder& target, const CompiledTrackSettings* compileSettings)
     {
         LoaderImpl impl(kf.getFilename(), kf.getVersion(), kf.getUserVersion(), kf.getBethVersion());
-        impl.loadKf(kf, target);
+        impl.loadKf(kf, target, compileSettings);
     }
 
 }
@@ -23,6 +23,8 @@ namespace Resource
 
 namespace NifOsg
 {
+    struct CompiledTrackSettings;
+
     /// The main class responsible for loading NIF files into an OSG-Scenegraph.
     /// @par This scene graph is self-contained and can be cloned using osg::clone if desired. Particle emitters
     ///      and programs hold a pointer to their ParticleSystem, which would need to be manually updated when cloning.
@@ -35,7 +37,9 @@ namespace NifOsg
             Nif::FileView file, Resource::ImageManager* imageManager, Resource::BgsmFileManager* materialManager);
 
         /// Load keyframe controllers from the given kf file.
-        static void loadKf(Nif::FileView kf, SceneUtil::KeyframeHolder& target);
+        /// @param compileSettings When not null, rotation and translation tracks are compiled using these settings.
+        static void loadKf(Nif::FileView kf, SceneUtil::KeyframeHolder& target,
+            const CompiledTrackSettings* compileSettings = nullptr);
 
         /// Set whether or not nodes marked as "MRK" should be shown.
         /// These should be hidden ingame, but visible in the editor.
@@ -3,6 +3,8 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <memory>
+#include <span>
 
 namespace Platform::File
 {
@@ -63,6 +65,24 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    /// Read-only view of a whole file mapped into the address space of the process.
+    /// @note Platforms without memory mapping support fall back to reading the file into a buffer.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& filename);
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        ~MappedFile();
+
+        std::span<const char> getData() const { return { mData, mSize }; }
+
+    private:
+        const char* mData = nullptr;
+        std::size_t mSize = 0;
+        std::unique_ptr<char[]> mBuffer;
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
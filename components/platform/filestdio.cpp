@@ -93,4 +93,15 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        const ScopedHandle handle = open(filename);
+        mSize = size(handle);
+        mBuffer = std::make_unique<char[]>(mSize);
+        if (read(handle, mBuffer.get(), mSize) != mSize)
+            throw std::runtime_error("Failed to read '" + Files::pathToUnicodeString(filename) + "' into memory");
+        mData = mBuffer.get();
+    }
+
+    MappedFile::~MappedFile() = default;
 }
@@ -99,4 +99,31 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    MappedFile::MappedFile(const std::filesystem::path& filename)
+    {
+        const ScopedHandle handle = open(filename);
+        mSize = size(handle);
+        if (mSize == 0)
+            return;
+
+        HANDLE mapping = CreateFileMappingW(getNativeHandle(handle), nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+            throw std::runtime_error(std::string("Failed to create file mapping for '")
+                + Files::pathToUnicodeString(filename) + "': " + std::to_string(GetLastError()));
+
+        const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        // The view keeps a reference to the mapping object, so it's fine to close the handle here
+        CloseHandle(mapping);
+        if (data == nullptr)
+            throw std::runtime_error(std::string("Failed to map '") + Files::pathToUnicodeString(filename)
+                + "' into memory: " + std::to_string(GetLastError()));
+        mData = static_cast<const char*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (mData != nullptr)
+            UnmapViewOfFile(mData);
+    }
 }
@@ -1,6 +1,8 @@
 #include "keyframemanager.hpp"
 
 #include <array>
+#include <optional>
+#include <span>
 
 #include <components/vfs/manager.hpp>
 
@@ -12,6 +14,7 @@
 #include <components/misc/pathhelpers.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/misc/strings/conversion.hpp>
+#include <components/nifosg/compiledtrack.hpp>
 #include <components/nifosg/nifloader.hpp>
 #include <components/sceneutil/keyframe.hpp>
 #include <components/sceneutil/osgacontroller.hpp>
@@ -220,8 +223,12 @@ namespace Resource
         {
             auto file = std::make_shared<Nif::NIFFile>(name);
             Nif::Reader reader(*file, mEncoder);
-            reader.parse(mVFS->get(name));
-            NifOsg::Loader::loadKf(*file, *loaded.get());
+            if (const std::optional<std::span<const char>> data = mVFS->getData(name))
+                reader.parse(*data);
+            else
+                reader.parse(mVFS->get(name));
+            const NifOsg::CompiledTrackSettings compileSettings;
+            NifOsg::Loader::loadKf(*file, *loaded.get(), mCompileClips ? &compileSettings : nullptr);
         }
         else
         {
@@ -58,11 +58,17 @@ namespace Resource
         /// @note Throws an exception if the resource is not found.
         osg::ref_ptr<const SceneUtil::KeyframeHolder> get(VFS::Path::NormalizedView name);
 
+        /// Resample rotation and translation tracks of kf files into compact uniform rate tracks when the result is
+        /// close enough to the source. Loaded files are shared by all actors using them.
+        /// @note Should be set before any resource is loaded.
+        void setCompileClips(bool value) { mCompileClips = value; }
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
     private:
         SceneManager* mSceneManager;
         const ToUTF8::StatelessUtf8Encoder* mEncoder;
+        bool mCompileClips = false;
     };
 
 }
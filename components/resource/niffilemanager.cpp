@@ -1,6 +1,8 @@
 #include "niffilemanager.hpp"
 
 #include <iostream>
+#include <optional>
+#include <span>
 
 #include <osg/Object>
 
@@ -48,7 +50,11 @@ namespace Resource
 
         auto file = std::make_shared<Nif::NIFFile>(name);
         Nif::Reader reader(*file, mEncoder);
-        reader.parse(mVFS->get(name));
+        // Archives mapped into memory provide the data without copying
+        if (const std::optional<std::span<const char>> data = mVFS->getData(name))
+            reader.parse(*data);
+        else
+            reader.parse(mVFS->get(name));
         obj = new NifFileHolder(file);
         mCache->addEntryToObjectCache(name.value(), obj);
         return file;
@@ -3,6 +3,8 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - items can be split into independently locked shards.
+// - approximate memory usage is tracked and unreferenced items can be evicted in least recently used order.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -21,16 +23,22 @@
 #define OPENMW_COMPONENTS_RESOURCE_OBJECTCACHE
 
 #include "cachestats.hpp"
+#include "objectsize.hpp"
 
 #include <osg/Node>
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace osg
@@ -47,12 +55,33 @@ namespace Resource
     {
         osg::ref_ptr<osg::Object> mValue;
         double mLastUsage;
+        std::size_t mSize = 0;
     };
 
-    template <typename KeyType>
+    struct EvictionCandidate
+    {
+        double mLastUsage;
+        std::size_t mSize;
+    };
+
+    /*
+     * @brief Thread safe cache of objects with expiration.
+     *
+     * Items are split into shards by ShardHash. Each shard has own lock so lookups from different threads for
+     * different keys rarely contend. ShardHash has to produce the same value for keys considered equal by
+     * heterogeneous lookup. With void ShardHash there is always a single shard.
+     */
+    template <typename KeyType, class ShardHash = void>
     class GenericObjectCache : public osg::Referenced
     {
     public:
+        explicit GenericObjectCache(std::size_t shardsCount = 1)
+            : mShards(shardsCount)
+        {
+            assert(shardsCount >= 1);
+            assert(!std::is_void_v<ShardHash> || shardsCount == 1);
+        }
+
         /*
          * @brief Updates usage timestamps and removes expired items
          *
@@ -64,29 +93,34 @@ namespace Resource
          * Last usage might be updated from other places so nullptr items
          * that are not referenced elsewhere are not always removed.
          *
+         * \note
+         * Each call updates and removes expired items only in a single shard in round robin order to keep the work
+         * done per frame small. Non-nullptr items found by a lookup get the latest reference time instead. With
+         * multiple shards an item is removed by one of the next shards count calls after it has expired.
+         *
          * @param referenceTime the timestamp indicating when the item was most recently used
          * @param expiryDelay the delay after which the cache entry for an item expires
          */
         void update(double referenceTime, double expiryDelay)
         {
+            mLastReferenceTime.store(referenceTime, std::memory_order_relaxed);
+            Shard& shard = mShards[mNextUpdateShard.fetch_add(1, std::memory_order_relaxed) % mShards.size()];
             std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
             {
                 const double expiryTime = referenceTime - expiryDelay;
-                std::lock_guard<std::mutex> lock(mMutex);
+                std::lock_guard<std::mutex> lock(shard.mMutex);
 
-                std::erase_if(mItems, [&](auto& v) {
+                std::erase_if(shard.mItems, [&](auto& v) {
                     Item& item = v.second;
 
-                    // update last usage timestamp if item is being referenced externally
-                    // or initialize if not set
-                    if ((item.mValue != nullptr && item.mValue->referenceCount() > 1) || item.mLastUsage == 0)
-                        item.mLastUsage = referenceTime;
+                    updateLastUsage(item, referenceTime);
 
                     // skip items that have been accessed since expiryTime
                     if (item.mLastUsage > expiryTime)
                         return false;
 
-                    ++mExpired;
+                    ++shard.mExpired;
+                    shard.mMemory -= item.mSize;
 
                     // just mark for removal here so objects can be removed in bulk outside the lock
                     if (item.mValue != nullptr)
@@ -102,44 +136,102 @@ namespace Resource
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            mItems.clear();
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                shard.mItems.clear();
+                shard.mMemory = 0;
+            }
         }
 
+        /** Add last usage and size of each unreferenced item to out.*/
+        void collectEvictionCandidates(std::vector<EvictionCandidate>& out) const
+        {
+            for (const Shard& shard : mShards)
+            {
+                const std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    if (isEvictable(v))
+                        out.push_back(EvictionCandidate{ v.mLastUsage, v.mSize });
+            }
+        }
+
+        /** Remove unreferenced items which were not used after lastUsage regardless of expiry delay.*/
+        void evict(double lastUsage)
+        {
+            std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            for (Shard& shard : mShards)
+            {
+                const std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (auto it = shard.mItems.begin(); it != shard.mItems.end();)
+                {
+                    Item& item = it->second;
+                    if (!isEvictable(item) || item.mLastUsage > lastUsage)
+                    {
+                        ++it;
+                        continue;
+                    }
+                    ++shard.mEvicted;
+                    shard.mMemory -= item.mSize;
+                    objectsToRemove.push_back(std::move(item.mValue));
+                    it = shard.mItems.erase(it);
+                }
+            }
+            // unref outside the lock
+            objectsToRemove.clear();
+        }
+
+        /** Estimate memory used by added objects. It requires a scene graph traversal so is disabled by default.*/
+        void setTrackMemoryUsage(bool value) { mTrackMemoryUsage.store(value, std::memory_order_relaxed); }
+
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         template <class K>
         void addEntryToObjectCache(K&& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
-                mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp });
+            const std::size_t size = object == nullptr || !mTrackMemoryUsage.load(std::memory_order_relaxed)
+                ? 0
+                : estimateObjectSize(*object);
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            shard.mMemory += size;
+            const auto it = shard.mItems.find(key);
+            if (it == shard.mItems.end())
+                shard.mItems.emplace_hint(it, std::forward<K>(key), Item{ object, timestamp, size });
             else
-                it->second = Item{ object, timestamp };
+            {
+                shard.mMemory -= it->second.mSize;
+                it->second = Item{ object, timestamp, size };
+            }
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            const auto itr = mItems.find(key);
-            if (itr != mItems.end())
-                mItems.erase(itr);
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const auto itr = shard.mItems.find(key);
+            if (itr != shard.mItems.end())
+            {
+                shard.mMemory -= itr->second.mSize;
+                shard.mItems.erase(itr);
+            }
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const auto& key)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            if (Item* const item = find(shard, key))
                 return item->mValue;
             return nullptr;
         }
 
         std::optional<osg::ref_ptr<osg::Object>> getRefFromObjectCacheOrNone(const auto& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            const std::lock_guard<std::mutex> lock(shard.mMutex);
+            if (Item* const item = find(shard, key))
                 return item->mValue;
             return std::nullopt;
         }
@@ -147,8 +239,9 @@ namespace Resource
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const auto& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            if (Item* const item = find(key))
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            if (Item* const item = find(shard, key))
             {
                 item->mLastUsage = timeStamp;
                 return true;
@@ -159,68 +252,125 @@ namespace Resource
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                v.mValue->releaseGLObjects(state);
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    v.mValue->releaseGLObjects(state);
+            }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                if (osg::Object* const object = v.mValue.get())
-                    if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
-                        node->accept(nv);
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    if (osg::Object* const object = v.mValue.get())
+                        if (osg::Node* const node = dynamic_cast<osg::Node*>(object))
+                            node->accept(nv);
+            }
         }
 
         /** call operator()(KeyType, osg::Object*) for each object in the cache. */
         template <class Functor>
         void call(Functor&& f)
         {
-            std::lock_guard<std::mutex> lock(mMutex);
-            for (const auto& [k, v] : mItems)
-                f(k, v.mValue.get());
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [k, v] : shard.mItems)
+                    f(k, v.mValue.get());
+            }
         }
 
         template <class K>
         std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> lowerBound(K&& key)
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            const auto it = mItems.lower_bound(std::forward<K>(key));
-            if (it == mItems.end())
-                return std::nullopt;
-            return std::pair(it->first, it->second.mValue);
+            std::optional<std::pair<KeyType, osg::ref_ptr<osg::Object>>> result;
+            for (Shard& shard : mShards)
+            {
+                const std::lock_guard<std::mutex> lock(shard.mMutex);
+                const auto it = shard.mItems.lower_bound(key);
+                if (it != shard.mItems.end() && (!result.has_value() || it->first < result->first))
+                    result.emplace(it->first, it->second.mValue);
+            }
+            return result;
         }
 
         CacheStats getStats() const
         {
-            const std::lock_guard<std::mutex> lock(mMutex);
-            return CacheStats{
-                .mSize = mItems.size(),
-                .mGet = mGet,
-                .mHit = mHit,
-                .mExpired = mExpired,
-            };
+            CacheStats result{};
+            for (const Shard& shard : mShards)
+            {
+                const std::lock_guard<std::mutex> lock(shard.mMutex);
+                result.mSize += shard.mItems.size();
+                result.mGet += shard.mGet;
+                result.mHit += shard.mHit;
+                result.mExpired += shard.mExpired;
+                result.mEvicted += shard.mEvicted;
+                result.mMemory += shard.mMemory;
+            }
+            return result;
         }
 
     protected:
         using Item = GenericObjectCacheItem;
 
-        std::map<KeyType, Item, std::less<>> mItems;
-        mutable std::mutex mMutex;
-        std::size_t mGet = 0;
-        std::size_t mHit = 0;
-        std::size_t mExpired = 0;
+        struct Shard
+        {
+            std::map<KeyType, Item, std::less<>> mItems;
+            mutable std::mutex mMutex;
+            std::size_t mGet = 0;
+            std::size_t mHit = 0;
+            std::size_t mExpired = 0;
+            std::size_t mEvicted = 0;
+            std::size_t mMemory = 0;
+        };
+
+        std::vector<Shard> mShards;
+        std::atomic_size_t mNextUpdateShard{ 0 };
+        std::atomic<double> mLastReferenceTime{ 0 };
+        std::atomic_bool mTrackMemoryUsage{ false };
+
+        Shard& getShard(const auto& key)
+        {
+            if constexpr (std::is_void_v<ShardHash>)
+                return mShards.front();
+            else
+                return mShards[ShardHash{}(key) % mShards.size()];
+        }
+
+        static void updateLastUsage(Item& item, double referenceTime)
+        {
+            // update last usage timestamp if item is being referenced externally
+            // or initialize if not set
+            if ((item.mValue != nullptr && item.mValue->referenceCount() > 1) || item.mLastUsage == 0)
+                item.mLastUsage = referenceTime;
+        }
+
+        static bool isEvictable(const Item& item)
+        {
+            // Items with uninitialized time stamp are just added and not yet seen by update
+            return item.mSize != 0 && item.mLastUsage != 0
+                && (item.mValue == nullptr || item.mValue->referenceCount() == 1);
+        }
 
-        Item* find(const auto& key)
+        Item* find(Shard& shard, const auto& key)
         {
-            ++mGet;
-            const auto it = mItems.find(key);
-            if (it == mItems.end())
+            ++shard.mGet;
+            const auto it = shard.mItems.find(key);
+            if (it == shard.mItems.end())
                 return nullptr;
-            ++mHit;
-            return &it->second;
+            ++shard.mHit;
+            // returned object gets an external reference which update would notice only when reaching this shard
+            // keep uninitialized time stamp until the item is seen by update
+            Item& item = it->second;
+            if (const double lastReferenceTime = mLastReferenceTime.load(std::memory_order_relaxed);
+                item.mValue != nullptr && item.mLastUsage != 0 && lastReferenceTime > item.mLastUsage)
+                item.mLastUsage = lastReferenceTime;
+            return &item;
         }
     };
 }
@@ -0,0 +1,120 @@
+#include "objectsize.hpp"
+
+#include "bulletshape.hpp"
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/Node>
+#include <osg/NodeVisitor>
+
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
+
+#include <unordered_set>
+
+namespace Resource
+{
+    namespace
+    {
+        class EstimateNodeSizeVisitor : public osg::NodeVisitor
+        {
+        public:
+            EstimateNodeSizeVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                mSize += sizeof(node);
+                traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                mSize += sizeof(drawable);
+
+                const osg::Geometry* const geometry = drawable.asGeometry();
+                if (geometry == nullptr)
+                    return;
+
+                osg::Geometry::ArrayList arrays;
+                geometry->getArrayList(arrays);
+                for (const osg::ref_ptr<osg::Array>& array : arrays)
+                    add(*array);
+
+                osg::Geometry::DrawElementsList elements;
+                geometry->getDrawElementsList(elements);
+                for (const osg::DrawElements* element : elements)
+                    add(*element);
+            }
+
+            std::size_t getSize() const { return mSize; }
+
+        private:
+            std::unordered_set<const osg::BufferData*> mVisited;
+            std::size_t mSize = 0;
+
+            void add(const osg::BufferData& data)
+            {
+                // Arrays can be shared between drawables of the same scene graph
+                if (mVisited.insert(&data).second)
+                    mSize += data.getTotalDataSize();
+            }
+        };
+
+        std::size_t estimateCollisionShapeSize(const btCollisionShape* shape)
+        {
+            if (shape == nullptr)
+                return 0;
+
+            if (shape->isCompound())
+            {
+                const btCompoundShape& compound = static_cast<const btCompoundShape&>(*shape);
+                std::size_t result = sizeof(btCompoundShape);
+                for (int i = 0, n = compound.getNumChildShapes(); i < n; ++i)
+                    result += sizeof(btCompoundShapeChild) + estimateCollisionShapeSize(compound.getChildShape(i));
+                return result;
+            }
+
+            if (shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
+            {
+                const btBvhTriangleMeshShape& mesh = static_cast<const btBvhTriangleMeshShape&>(*shape);
+                std::size_t result = sizeof(btBvhTriangleMeshShape);
+                if (const auto* const array = dynamic_cast<const btTriangleIndexVertexArray*>(mesh.getMeshInterface()))
+                {
+                    const IndexedMeshArray& meshes = array->getIndexedMeshArray();
+                    for (int i = 0, n = meshes.size(); i < n; ++i)
+                        result += static_cast<std::size_t>(meshes[i].m_numTriangles) * meshes[i].m_triangleIndexStride
+                            + static_cast<std::size_t>(meshes[i].m_numVertices) * meshes[i].m_vertexStride;
+                }
+                return result;
+            }
+
+            return sizeof(btCollisionShape);
+        }
+    }
+
+    std::size_t estimateObjectSize(const osg::Object& object)
+    {
+        if (const osg::Image* const image = dynamic_cast<const osg::Image*>(&object))
+            return sizeof(osg::Image) + image->getTotalSizeInBytesIncludingMipmaps();
+
+        if (const osg::Node* const node = dynamic_cast<const osg::Node*>(&object))
+        {
+            EstimateNodeSizeVisitor visitor;
+            const_cast<osg::Node*>(node)->accept(visitor);
+            return visitor.getSize();
+        }
+
+        // Instances share vertex data with the source shape stored in the same cache
+        if (dynamic_cast<const BulletShapeInstance*>(&object) != nullptr)
+            return sizeof(BulletShapeInstance);
+
+        if (const BulletShape* const shape = dynamic_cast<const BulletShape*>(&object))
+            return sizeof(BulletShape) + estimateCollisionShapeSize(shape->mCollisionShape.get())
+                + estimateCollisionShapeSize(shape->mAvoidCollisionShape.get());
+
+        return 0;
+    }
+}
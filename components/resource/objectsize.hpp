@@ -0,0 +1,19 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_OBJECTSIZE_H
+#define OPENMW_COMPONENTS_RESOURCE_OBJECTSIZE_H
+
+#include <cstddef>
+
+namespace osg
+{
+    class Object;
+}
+
+namespace Resource
+{
+    /// Returns approximate number of bytes owned by the cached object. Images, scene graphs and collision shapes
+    /// are supported, other objects are considered to have zero size. Data shared with objects stored in other
+    /// caches (textures of scene graphs, vertices of collision shape instances) is not counted.
+    std::size_t estimateObjectSize(const osg::Object& object);
+}
+
+#endif
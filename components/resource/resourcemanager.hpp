@@ -3,6 +3,12 @@
 
 #include <osg/ref_ptr>
 
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <components/vfs/pathutil.hpp>
 
 #include "objectcache.hpp"
@@ -29,21 +35,42 @@ namespace Resource
         virtual void clearCache() = 0;
         virtual void setExpiryDelay(double expiryDelay) = 0;
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const = 0;
+        virtual std::size_t getMemoryUsage() const = 0;
+        virtual void setTrackMemoryUsage(bool value) = 0;
+        virtual void collectEvictionCandidates(std::vector<EvictionCandidate>& out) const = 0;
+        virtual void evict(double lastUsage) = 0;
         virtual void releaseGLObjects(osg::State* state) = 0;
     };
 
+    /// Distributes VFS paths over shards of the object cache.
+    struct PathShardHash
+    {
+        std::size_t operator()(std::string_view value) const { return std::hash<std::string_view>{}(value); }
+
+        std::size_t operator()(const char* value) const { return (*this)(std::string_view(value)); }
+
+        std::size_t operator()(const std::string& value) const { return (*this)(std::string_view(value)); }
+
+        std::size_t operator()(const VFS::Path::Normalized& value) const { return (*this)(value.view()); }
+
+        std::size_t operator()(VFS::Path::NormalizedView value) const { return (*this)(value.value()); }
+    };
+
+    /// Number of independently locked shards of the cache for managers accessed from multiple threads.
+    inline constexpr std::size_t resourceCacheShardsCount = 16;
+
     /// @brief Base class for managers that require a virtual file system and object cache.
     /// @par This base class implements clearing of the cache, but populating it and what it's used for is up to the
     /// individual sub classes.
-    template <class KeyType>
+    template <class KeyType, class ShardHash = void>
     class GenericResourceManager : public BaseResourceManager
     {
     public:
-        typedef GenericObjectCache<KeyType> CacheType;
+        typedef GenericObjectCache<KeyType, ShardHash> CacheType;
 
-        explicit GenericResourceManager(const VFS::Manager* vfs, double expiryDelay)
+        explicit GenericResourceManager(const VFS::Manager* vfs, double expiryDelay, std::size_t cacheShardsCount = 1)
             : mVFS(vfs)
-            , mCache(new CacheType)
+            , mCache(new CacheType(cacheShardsCount))
             , mExpiryDelay(expiryDelay)
         {
         }
@@ -64,6 +91,20 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override {}
 
+        /// Approximate number of bytes used by cached objects.
+        std::size_t getMemoryUsage() const override { return mCache->getStats().mMemory; }
+
+        /// Estimate memory used by objects added to the cache. Only needed when there is a memory budget.
+        void setTrackMemoryUsage(bool value) override { mCache->setTrackMemoryUsage(value); }
+
+        void collectEvictionCandidates(std::vector<EvictionCandidate>& out) const override
+        {
+            mCache->collectEvictionCandidates(out);
+        }
+
+        /// Clear unreferenced cache entries that have not been used after lastUsage.
+        void evict(double lastUsage) override { mCache->evict(lastUsage); }
+
         void releaseGLObjects(osg::State* state) override { mCache->releaseGLObjects(state); }
 
     protected:
@@ -72,11 +113,11 @@ namespace Resource
         double mExpiryDelay;
     };
 
-    class ResourceManager : public GenericResourceManager<std::string>
+    class ResourceManager : public GenericResourceManager<std::string, PathShardHash>
     {
     public:
         explicit ResourceManager(const VFS::Manager* vfs, double expiryDelay)
-            : GenericResourceManager(vfs, expiryDelay)
+            : GenericResourceManager(vfs, expiryDelay, resourceCacheShardsCount)
         {
         }
     };
@@ -1,12 +1,17 @@
 #include "resourcesystem.hpp"
 
 #include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <osg/Stats>
 
 #include "animblendrulesmanager.hpp"
 #include "bgsmfilemanager.hpp"
 #include "imagemanager.hpp"
 #include "keyframemanager.hpp"
 #include "niffilemanager.hpp"
+#include "resourcemanager.hpp"
 #include "scenemanager.hpp"
 
 namespace Resource
@@ -81,11 +86,57 @@ namespace Resource
         mNifFileManager->setExpiryDelay(0.0);
     }
 
+    void ResourceSystem::setMemoryBudget(std::size_t value)
+    {
+        mMemoryBudget = value;
+        for (BaseResourceManager* manager : mResourceManagers)
+            manager->setTrackMemoryUsage(mMemoryBudget != 0);
+    }
+
     void ResourceSystem::updateCache(double referenceTime)
     {
         for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end();
              ++it)
             (*it)->updateCache(referenceTime);
+
+        if (mMemoryBudget == 0)
+            return;
+
+        const std::size_t memoryUsage = getMemoryUsage();
+        if (memoryUsage > mMemoryBudget)
+            evictLeastRecentlyUsed(memoryUsage);
+    }
+
+    std::size_t ResourceSystem::getMemoryUsage() const
+    {
+        std::size_t result = 0;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            result += manager->getMemoryUsage();
+        return result;
+    }
+
+    void ResourceSystem::evictLeastRecentlyUsed(std::size_t memoryUsage)
+    {
+        std::vector<EvictionCandidate> candidates;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            manager->collectEvictionCandidates(candidates);
+
+        std::sort(candidates.begin(), candidates.end(),
+            [](const EvictionCandidate& l, const EvictionCandidate& r) { return l.mLastUsage < r.mLastUsage; });
+
+        // Find the last usage time such that evicting everything not used after it fits into the budget
+        const std::size_t excess = memoryUsage - mMemoryBudget;
+        std::size_t freed = 0;
+        auto it = candidates.begin();
+        for (; it != candidates.end() && freed < excess; ++it)
+            freed += it->mSize;
+
+        if (it == candidates.begin())
+            return;
+
+        const double lastUsage = std::prev(it)->mLastUsage;
+        for (BaseResourceManager* manager : mResourceManagers)
+            manager->evict(lastUsage);
     }
 
     void ResourceSystem::clearCache()
@@ -97,6 +148,7 @@ namespace Resource
 
     void ResourceSystem::addResourceManager(BaseResourceManager* resourceMgr)
     {
+        resourceMgr->setTrackMemoryUsage(mMemoryBudget != 0);
         mResourceManagers.push_back(resourceMgr);
     }
 
@@ -118,6 +170,9 @@ namespace Resource
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin();
              it != mResourceManagers.end(); ++it)
             (*it)->reportStats(frameNumber, stats);
+
+        stats->setAttribute(frameNumber, "Resource Memory", static_cast<double>(getMemoryUsage()));
+        stats->setAttribute(frameNumber, "Resource Memory Budget", static_cast<double>(mMemoryBudget));
     }
 
     void ResourceSystem::releaseGLObjects(osg::State* state)
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -49,7 +50,8 @@ namespace Resource
         AnimBlendRulesManager* getAnimBlendRulesManager();
 
         /// Indicates to each resource manager to clear the cache, i.e. to drop cached objects that are no longer
-        /// referenced.
+        /// referenced. When cached objects use more memory than the budget, least recently used unreferenced objects
+        /// are dropped regardless of expiry delay.
         /// @note May be called from any thread if you do not add or remove resource managers at that point.
         void updateCache(double referenceTime);
 
@@ -67,6 +69,12 @@ namespace Resource
         /// How long to keep objects in cache after no longer being referenced.
         void setExpiryDelay(double expiryDelay);
 
+        /// Approximate number of bytes cached objects are allowed to use. 0 means no limit.
+        void setMemoryBudget(std::size_t value);
+
+        /// Approximate number of bytes used by objects cached in all resource managers.
+        std::size_t getMemoryUsage() const;
+
         /// @note May be called from any thread.
         const VFS::Manager* getVFS() const;
 
@@ -88,6 +96,9 @@ namespace Resource
         std::vector<BaseResourceManager*> mResourceManagers;
 
         const VFS::Manager* mVFS;
+        std::size_t mMemoryBudget = 0;
+
+        void evictLeastRecentlyUsed(std::size_t memoryUsage);
 
         ResourceSystem(const ResourceSystem&);
         void operator=(const ResourceSystem&);
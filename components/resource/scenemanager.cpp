@@ -60,6 +60,7 @@
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
+#include "scenetemplatecache.hpp"
 
 namespace
 {
@@ -975,7 +976,7 @@ namespace Resource
             osg::ref_ptr<osg::Node> loaded;
             try
             {
-                loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+                loaded = loadTemplate(path);
             }
             catch (const std::exception& e)
             {
@@ -1017,6 +1018,28 @@ namespace Resource
         }
     }
 
+    osg::ref_ptr<osg::Node> SceneManager::loadTemplate(VFS::Path::NormalizedView path)
+    {
+        if (mTemplateCache == nullptr || Misc::getFileExtension(path.value()) != "nif")
+            return load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+
+        const std::array<std::uint64_t, 2> fileHash = Files::getHash(path.value(), *mVFS->get(path));
+
+        if (osg::ref_ptr<osg::Node> cached = mTemplateCache->read(path, fileHash, *mTemplateCacheReadOptions))
+            return cached;
+
+        osg::ref_ptr<osg::Node> loaded = load(path, mVFS, mImageManager, mNifFileManager, mBgsmFileManager);
+        mTemplateCache->write(path, fileHash, *loaded);
+        return loaded;
+    }
+
+    void SceneManager::setTemplateCachePath(const std::filesystem::path& path)
+    {
+        mTemplateCache = std::make_unique<SceneTemplateCache>(path);
+        mTemplateCacheReadOptions = new osgDB::Options;
+        mTemplateCacheReadOptions->setReadFileCallback(new ImageReadCallback(mImageManager));
+    }
+
     osg::ref_ptr<osg::Node> SceneManager::getInstance(VFS::Path::NormalizedView path)
     {
         return getInstance(getTemplate(path));
@@ -1208,6 +1231,12 @@ namespace Resource
                 frameNumber, "StateSet", static_cast<double>(mSharedStateManager->getNumSharedStateSets()));
         }
 
+        if (mTemplateCache != nullptr)
+        {
+            stats->setAttribute(frameNumber, "Template Cache Hit", static_cast<double>(mTemplateCache->getHits()));
+            stats->setAttribute(frameNumber, "Template Cache Miss", static_cast<double>(mTemplateCache->getMisses()));
+        }
+
         Resource::reportStats("Node", frameNumber, mCache->getStats(), *stats);
     }
 
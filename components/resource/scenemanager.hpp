@@ -34,6 +34,7 @@ namespace Resource
     class NifFileManager;
     class BgsmFileManager;
     class SharedStateManager;
+    class SceneTemplateCache;
 }
 
 namespace osgUtil
@@ -41,6 +42,11 @@ namespace osgUtil
     class IncrementalCompileOperation;
 }
 
+namespace osgDB
+{
+    class Options;
+}
+
 namespace Shader
 {
     class ShaderManager;
@@ -223,8 +229,14 @@ namespace Resource
 
         void setWeatherParticleOcclusion(bool value) { mWeatherParticleOcclusion = value; }
 
+        /// Store scene graphs converted from NIF files in the given directory and use them instead of converting the
+        /// same files again.
+        /// @note Not thread safe, should be called before loading any templates.
+        void setTemplateCachePath(const std::filesystem::path& path);
+
     private:
         osg::ref_ptr<Shader::ShaderVisitor> createShaderVisitor(const std::string& shaderPrefix = "objects");
+        osg::ref_ptr<osg::Node> loadTemplate(VFS::Path::NormalizedView path);
         osg::ref_ptr<osg::Node> loadErrorMarker();
         osg::ref_ptr<osg::Node> cloneErrorMarker();
 
@@ -242,6 +254,8 @@ namespace Resource
         Resource::NifFileManager* mNifFileManager;
         Resource::BgsmFileManager* mBgsmFileManager;
         osg::ref_ptr<osgUtil::IncrementalCompileOperation> mIncrementalCompileOperation;
+        std::unique_ptr<SceneTemplateCache> mTemplateCache;
+        osg::ref_ptr<osgDB::Options> mTemplateCacheReadOptions;
         mutable osg::ref_ptr<osg::Node> mErrorMarker;
         mutable std::once_flag mErrorMarkerFlag;
 
@@ -0,0 +1,348 @@
+#include "scenetemplatecache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/nifosg/nifloader.hpp>
+#include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/serialize.hpp>
+#include <components/version/version.hpp>
+
+#include <osg/Drawable>
+#include <osg/Image>
+#include <osg/Node>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+#include <osg/Texture>
+#include <osg/UserDataContainer>
+#include <osgDB/Registry>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <typeinfo>
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr char templateCacheMagic[] = { 'O', 'S', 'C', 'N', 'T', 'P', 'L', '\0' };
+        constexpr std::uint32_t templateCacheVersion = 1;
+
+        /// Everything except the source file affecting NifOsg::Loader result.
+        struct EntryHeader
+        {
+            std::string mEngineVersion;
+            std::array<std::uint64_t, 2> mFileHash;
+            std::uint32_t mHiddenNodeMask;
+            std::uint32_t mIntersectionDisabledNodeMask;
+            bool mShowMarkers;
+            bool mSoftEffectEnabled;
+            bool mReversedDepth;
+
+            friend bool operator==(const EntryHeader& l, const EntryHeader& r) = default;
+        };
+
+        EntryHeader makeEntryHeader(const std::array<std::uint64_t, 2>& fileHash)
+        {
+            std::string engineVersion(Version::getVersion());
+            engineVersion += ' ';
+            engineVersion += Version::getCommitHash();
+            return EntryHeader{
+                .mEngineVersion = std::move(engineVersion),
+                .mFileHash = fileHash,
+                .mHiddenNodeMask = NifOsg::Loader::getHiddenNodeMask(),
+                .mIntersectionDisabledNodeMask = NifOsg::Loader::getIntersectionDisabledNodeMask(),
+                .mShowMarkers = NifOsg::Loader::getShowMarkers(),
+                .mSoftEffectEnabled = NifOsg::Loader::getSoftEffectEnabled(),
+                .mReversedDepth = SceneUtil::AutoDepth::isReversed(),
+            };
+        }
+
+        template <class T>
+        void writeValue(std::ostream& stream, const T& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        template <class T>
+        void readValue(std::istream& stream, T& value)
+        {
+            stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+        }
+
+        void writeHeader(std::ostream& stream, const EntryHeader& header)
+        {
+            stream.write(templateCacheMagic, sizeof(templateCacheMagic));
+            writeValue(stream, templateCacheVersion);
+            writeValue(stream, static_cast<std::uint32_t>(header.mEngineVersion.size()));
+            stream.write(header.mEngineVersion.data(), static_cast<std::streamsize>(header.mEngineVersion.size()));
+            writeValue(stream, header.mFileHash);
+            writeValue(stream, header.mHiddenNodeMask);
+            writeValue(stream, header.mIntersectionDisabledNodeMask);
+            writeValue(stream, static_cast<std::uint8_t>(header.mShowMarkers));
+            writeValue(stream, static_cast<std::uint8_t>(header.mSoftEffectEnabled));
+            writeValue(stream, static_cast<std::uint8_t>(header.mReversedDepth));
+        }
+
+        EntryHeader readHeader(std::istream& stream)
+        {
+            char magic[std::size(templateCacheMagic)];
+            stream.read(magic, sizeof(magic));
+            if (std::memcmp(magic, templateCacheMagic, sizeof(magic)) != 0)
+                throw std::runtime_error("Bad scene template cache magic");
+            std::uint32_t version = 0;
+            readValue(stream, version);
+            if (version != templateCacheVersion)
+                throw std::runtime_error("Unsupported scene template cache version");
+            EntryHeader result;
+            std::uint32_t engineVersionSize = 0;
+            readValue(stream, engineVersionSize);
+            if (engineVersionSize > 1024)
+                throw std::runtime_error("Bad scene template cache engine version size");
+            result.mEngineVersion.resize(engineVersionSize);
+            stream.read(result.mEngineVersion.data(), engineVersionSize);
+            readValue(stream, result.mFileHash);
+            readValue(stream, result.mHiddenNodeMask);
+            readValue(stream, result.mIntersectionDisabledNodeMask);
+            std::uint8_t flags[3];
+            readValue(stream, flags);
+            result.mShowMarkers = flags[0] != 0;
+            result.mSoftEffectEnabled = flags[1] != 0;
+            result.mReversedDepth = flags[2] != 0;
+            return result;
+        }
+
+        osg::ref_ptr<osgDB::Options> makeWriteOptions()
+        {
+            osg::ref_ptr<osgDB::Options> options = new osgDB::Options;
+            options->setPluginStringData("fileType", "Binary");
+            options->setPluginStringData("WriteImageHint", "UseExternal");
+            return options;
+        }
+
+        osgDB::ReaderWriter& getReaderWriter()
+        {
+            osgDB::ReaderWriter* const result = osgDB::Registry::instance()->getReaderWriterForExtension("osgb");
+            if (result == nullptr)
+                throw std::runtime_error("No readerwriter for osgb found");
+            return *result;
+        }
+
+        bool isStorableObject(const osg::Object& object)
+        {
+            // osg::Depth is stored instead and replaced back on reading like for non NIF files
+            if (typeid(object) == typeid(SceneUtil::AutoDepth))
+                return true;
+            return SceneUtil::hasLosslessSerializer(object);
+        }
+
+        bool isStorableOptional(const osg::Object* object)
+        {
+            return object == nullptr || isStorableObject(*object);
+        }
+
+        bool isStorableCallback(const osg::Callback* callback)
+        {
+            for (; callback != nullptr; callback = callback->getNestedCallback())
+                if (!isStorableObject(*callback))
+                    return false;
+            return true;
+        }
+
+        bool isStorableAttribute(const osg::StateAttribute& attribute)
+        {
+            if (!isStorableObject(attribute) || !isStorableCallback(attribute.getUpdateCallback())
+                || !isStorableCallback(attribute.getEventCallback()))
+                return false;
+            if (const osg::Texture* const texture = attribute.asTexture())
+            {
+                for (unsigned i = 0; i < texture->getNumImages(); ++i)
+                {
+                    const osg::Image* const image = texture->getImage(i);
+                    if (image != nullptr && image->getFileName().empty())
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        bool isStorableStateSet(const osg::StateSet& stateSet)
+        {
+            if (!isStorableObject(stateSet) || !isStorableCallback(stateSet.getUpdateCallback())
+                || !isStorableCallback(stateSet.getEventCallback()))
+                return false;
+            for (const auto& [_, attribute] : stateSet.getAttributeList())
+                if (!isStorableAttribute(*attribute.first))
+                    return false;
+            for (const osg::StateSet::AttributeList& attributes : stateSet.getTextureAttributeList())
+                for (const auto& [_, attribute] : attributes)
+                    if (!isStorableAttribute(*attribute.first))
+                        return false;
+            for (const auto& [_, uniform] : stateSet.getUniformList())
+                if (!isStorableObject(*uniform.first) || !isStorableCallback(uniform.first->getUpdateCallback())
+                    || !isStorableCallback(uniform.first->getEventCallback()))
+                    return false;
+            return true;
+        }
+
+        bool isStorableUserData(const osg::UserDataContainer& container)
+        {
+            if (!isStorableObject(container))
+                return false;
+            for (unsigned i = 0; i < container.getNumUserObjects(); ++i)
+                if (const osg::Object* const object = container.getUserObject(i);
+                    object != nullptr && !isStorableObject(*object))
+                    return false;
+            return true;
+        }
+
+        class StorableTemplateVisitor : public osg::NodeVisitor
+        {
+        public:
+            bool mStorable = true;
+
+            StorableTemplateVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                if (!mStorable)
+                    return;
+                if (!isStorable(node))
+                {
+                    mStorable = false;
+                    return;
+                }
+                traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                if (!mStorable)
+                    return;
+                if (!isStorableOptional(drawable.getDrawCallback())
+                    || !isStorableOptional(drawable.getComputeBoundingBoxCallback())
+                    || !isStorableOptional(drawable.getShape()))
+                {
+                    mStorable = false;
+                    return;
+                }
+                apply(static_cast<osg::Node&>(drawable));
+            }
+
+        private:
+            static bool isStorable(const osg::Node& node)
+            {
+                return isStorableObject(node) && isStorableCallback(node.getUpdateCallback())
+                    && isStorableCallback(node.getEventCallback()) && isStorableCallback(node.getCullCallback())
+                    && isStorableOptional(node.getComputeBoundingSphereCallback())
+                    && (node.getStateSet() == nullptr || isStorableStateSet(*node.getStateSet()))
+                    && (node.getUserDataContainer() == nullptr || isStorableUserData(*node.getUserDataContainer()));
+            }
+        };
+    }
+
+    bool isStorableTemplate(const osg::Node& node)
+    {
+        SceneUtil::registerLosslessSerializers();
+        StorableTemplateVisitor visitor;
+        const_cast<osg::Node&>(node).accept(visitor);
+        return visitor.mStorable;
+    }
+
+    SceneTemplateCache::SceneTemplateCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        SceneUtil::registerLosslessSerializers();
+    }
+
+    osg::ref_ptr<osg::Node> SceneTemplateCache::read(VFS::Path::NormalizedView path,
+        const std::array<std::uint64_t, 2>& fileHash, const osgDB::Options& options)
+    {
+        const std::filesystem::path entryPath = getEntryPath(path);
+        std::ifstream stream(entryPath, std::ios::binary);
+        if (!stream.is_open())
+        {
+            ++mMisses;
+            return nullptr;
+        }
+
+        try
+        {
+            stream.exceptions(std::ios::failbit | std::ios::badbit);
+            if (readHeader(stream) != makeEntryHeader(fileHash))
+            {
+                ++mMisses;
+                return nullptr;
+            }
+            stream.exceptions(std::ios::goodbit);
+            osgDB::ReaderWriter::ReadResult result = getReaderWriter().readNode(stream, &options);
+            if (!result.success())
+                throw std::runtime_error(result.message());
+            osg::ref_ptr<osg::Node> node = result.getNode();
+            // Entry could be read with serializers for debug output missing some data
+            if (SceneUtil::hasLossySerializers() && !isStorableTemplate(*node))
+            {
+                ++mMisses;
+                return nullptr;
+            }
+            SceneUtil::ReplaceDepthVisitor replaceDepthVisitor;
+            node->accept(replaceDepthVisitor);
+            ++mHits;
+            return node;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read scene template cache entry " << entryPath << ": " << e.what();
+        }
+
+        ++mMisses;
+        return nullptr;
+    }
+
+    void SceneTemplateCache::write(
+        VFS::Path::NormalizedView path, const std::array<std::uint64_t, 2>& fileHash, const osg::Node& node)
+    {
+        if (!isStorableTemplate(node))
+            return;
+
+        const std::filesystem::path entryPath = getEntryPath(path);
+        // Same file may be loaded by multiple threads at the same time
+        std::filesystem::path tmpPath = entryPath;
+        tmpPath += "." + std::to_string(mNextTemporary.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(entryPath.parent_path());
+            {
+                std::ofstream stream(tmpPath, std::ios::binary);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                writeHeader(stream, makeEntryHeader(fileHash));
+                const osgDB::ReaderWriter::WriteResult result
+                    = getReaderWriter().writeNode(node, stream, makeWriteOptions());
+                if (!result.success())
+                    throw std::runtime_error(result.message());
+            }
+            std::filesystem::rename(tmpPath, entryPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write scene template cache entry " << entryPath << ": " << e.what();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+
+    std::filesystem::path SceneTemplateCache::getEntryPath(VFS::Path::NormalizedView path) const
+    {
+        std::filesystem::path result = mPath / Files::pathFromUnicodeString(path.value());
+        result += ".osgb";
+        return result;
+    }
+}
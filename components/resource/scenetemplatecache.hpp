@@ -0,0 +1,60 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_SCENETEMPLATECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_SCENETEMPLATECACHE_H
+
+#include <components/vfs/pathutil.hpp>
+
+#include <osg/ref_ptr>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace osg
+{
+    class Node;
+}
+
+namespace osgDB
+{
+    class Options;
+}
+
+namespace Resource
+{
+    /// Whether all objects of the scene graph can be written and read back by osgDB serializers without losing data.
+    /// Callbacks and classes without own serializer make it false, as well as images without a file name.
+    bool isStorableTemplate(const osg::Node& node);
+
+    /// @brief Persistent cache of scene graphs converted from NIF files. Each entry is stored in a separate osgb file
+    /// named after the source file. An entry is used only when the hash of the source file, the engine version and the
+    /// NIF loader settings match the ones it was written with. Images are stored as file names and read with the given
+    /// options so they are shared with other scene graphs.
+    class SceneTemplateCache
+    {
+    public:
+        explicit SceneTemplateCache(const std::filesystem::path& path);
+
+        /// Returns nullptr when there is no suitable entry.
+        osg::ref_ptr<osg::Node> read(VFS::Path::NormalizedView path, const std::array<std::uint64_t, 2>& fileHash,
+            const osgDB::Options& options);
+
+        /// Does nothing when the node is not storable.
+        void write(VFS::Path::NormalizedView path, const std::array<std::uint64_t, 2>& fileHash, const osg::Node& node);
+
+        std::size_t getHits() const { return mHits.load(std::memory_order_relaxed); }
+
+        std::size_t getMisses() const { return mMisses.load(std::memory_order_relaxed); }
+
+    private:
+        const std::filesystem::path mPath;
+        std::atomic_size_t mHits{ 0 };
+        std::atomic_size_t mMisses{ 0 };
+        std::atomic_size_t mNextTemporary{ 0 };
+
+        std::filesystem::path getEntryPath(VFS::Path::NormalizedView path) const;
+    };
+}
+
+#endif
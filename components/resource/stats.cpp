@@ -18,6 +18,7 @@
 #include <osgViewer/Renderer>
 #include <osgViewer/Viewer>
 
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/manager.hpp>
 
 #include "cachestats.hpp"
@@ -50,6 +51,7 @@ namespace Resource
         std::vector<std::string> generateAllStatNames()
         {
             constexpr std::size_t itemsPerPage = 24;
+            constexpr std::size_t cachesPerPage = 3;
 
             constexpr std::string_view firstPage[] = {
                 "FrameNumber",
@@ -104,6 +106,23 @@ namespace Resource
                 "CellPreloader Expired",
             };
 
+            constexpr std::string_view resourceMemory[] = {
+                "Resource Memory",
+                "Resource Memory Budget",
+            };
+
+            constexpr std::string_view templateCache[] = {
+                "Template Cache Hit",
+                "Template Cache Miss",
+            };
+
+            constexpr std::string_view animationLod[] = {
+                "Animation Full",
+                "Animation Half",
+                "Animation Quarter",
+                "Animation Skipped",
+            };
+
             constexpr std::string_view navMesh[] = {
                 "NavMesh Jobs",
                 "NavMesh Removing",
@@ -114,13 +133,22 @@ namespace Resource
                 "NavMesh Posted",
                 "NavMesh DbJobs Write",
                 "NavMesh DbJobs Read",
+                "NavMesh DbJobs Commit",
                 "NavMesh DbCache Get",
                 "NavMesh DbCache Hit",
+                "NavMesh DbCache Shared",
+                "NavMesh DbCache Memory",
+                "NavMesh DbData Ratio",
+                "NavMesh DbData DecodeUs",
                 "NavMesh CacheSize",
                 "NavMesh UsedTiles",
                 "NavMesh CachedTiles",
                 "NavMesh Cache Get",
                 "NavMesh Cache Hit",
+                "NavMesh Layers Size",
+                "NavMesh Layers Count",
+                "NavMesh Layers Get",
+                "NavMesh Layers Hit",
                 "NavMesh Recast Tiles",
                 "NavMesh Recast Objects",
                 "NavMesh Recast Heightfields",
@@ -135,19 +163,42 @@ namespace Resource
             for (std::size_t i = 0; i < std::size(caches); ++i)
             {
                 Resource::addCacheStatsAttibutes(caches[i], statNames);
-                if ((i + 1) % 5 != 0)
+                if ((i + 1) % cachesPerPage != 0)
                     statNames.emplace_back();
+                else
+                    while (statNames.size() % itemsPerPage != 0)
+                        statNames.emplace_back();
             }
 
             for (std::string_view name : cellPreloader)
                 statNames.emplace_back(name);
 
+            statNames.emplace_back();
+
+            for (std::string_view name : resourceMemory)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : templateCache)
+                statNames.emplace_back(name);
+
+            statNames.emplace_back();
+
+            for (std::string_view name : animationLod)
+                statNames.emplace_back(name);
+
             while (statNames.size() % itemsPerPage != 0)
                 statNames.emplace_back();
 
             for (std::string_view name : navMesh)
                 statNames.emplace_back(name);
 
+            while (statNames.size() % itemsPerPage != 0)
+                statNames.emplace_back();
+
+            SceneUtil::addWorkQueueStatsAttributes(statNames);
+
             return statNames;
         }
 
@@ -0,0 +1,28 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_COPYBOUNDSCALLBACK_H
+#define OPENMW_COMPONENTS_SCENEUTIL_COPYBOUNDSCALLBACK_H
+
+#include <osg/BoundingBox>
+#include <osg/BoundingSphere>
+#include <osg/Drawable>
+#include <osg/Node>
+
+namespace SceneUtil
+{
+    /// Returns a bounding box set by the owner instead of computing it from the vertices. Used by internal geometries
+    /// of deformed drawables which vertices may be written by another thread.
+    struct CopyBoundingBoxCallback : osg::Drawable::ComputeBoundingBoxCallback
+    {
+        osg::BoundingBox boundingBox;
+
+        osg::BoundingBox computeBound(const osg::Drawable&) const override { return boundingBox; }
+    };
+
+    struct CopyBoundingSphereCallback : osg::Node::ComputeBoundingSphereCallback
+    {
+        osg::BoundingSphere boundingSphere;
+
+        osg::BoundingSphere computeBound(const osg::Node&) const override { return boundingSphere; }
+    };
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "deformationqueue.hpp"
+
+#include <cassert>
+
+namespace SceneUtil
+{
+    void DeformationJob::wait()
+    {
+        if (tryRun() || mState == State::Done)
+            return;
+
+        std::unique_lock lock(mMutex);
+        mDone.wait(lock, [&] { return mState == State::Done; });
+    }
+
+    bool DeformationJob::tryRun()
+    {
+        // Worker thread and waiting thread may try to run the same job, only one of them does it
+        State expected = State::Queued;
+        if (!mState.compare_exchange_strong(expected, State::Running))
+            return false;
+
+        deform();
+
+        {
+            const std::lock_guard lock(mMutex);
+            mState = State::Done;
+        }
+        mDone.notify_all();
+
+        return true;
+    }
+
+    DeformationQueue* DeformationQueue::sInstance = nullptr;
+
+    DeformationQueue* DeformationQueue::getInstance()
+    {
+        return sInstance;
+    }
+
+    void DeformationQueue::submit(const osg::ref_ptr<DeformationJob>& job)
+    {
+        [[maybe_unused]] const DeformationJob::State previous = job->mState.exchange(DeformationJob::State::Queued);
+        assert(previous == DeformationJob::State::Done);
+
+        if (sInstance != nullptr && !sInstance->mThreads.empty())
+            sInstance->push(job);
+        else
+            job->tryRun();
+    }
+
+    DeformationQueue::DeformationQueue(std::size_t threadsCount)
+    {
+        assert(sInstance == nullptr);
+        sInstance = this;
+
+        mThreads.reserve(threadsCount);
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mThreads.emplace_back([this] { run(); });
+    }
+
+    DeformationQueue::~DeformationQueue()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasJob.notify_all();
+
+        for (std::thread& thread : mThreads)
+            thread.join();
+
+        // Jobs left in the queue are done by the threads waiting for them
+        sInstance = nullptr;
+    }
+
+    void DeformationQueue::push(const osg::ref_ptr<DeformationJob>& job)
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mJobs.push_back(job);
+        }
+        mHasJob.notify_one();
+    }
+
+    void DeformationQueue::run() noexcept
+    {
+        while (true)
+        {
+            osg::ref_ptr<DeformationJob> job;
+
+            {
+                std::unique_lock lock(mMutex);
+                mHasJob.wait(lock, [&] { return mShouldStop || !mJobs.empty(); });
+                if (mShouldStop)
+                    return;
+                job = std::move(mJobs.front());
+                mJobs.pop_front();
+            }
+
+            job->tryRun();
+        }
+    }
+
+    void DeformationDrawCallback::drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const
+    {
+        mJob->wait();
+        drawable->drawImplementation(renderInfo);
+    }
+}
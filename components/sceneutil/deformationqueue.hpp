@@ -0,0 +1,94 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_DEFORMATIONQUEUE_H
+#define OPENMW_COMPONENTS_SCENEUTIL_DEFORMATIONQUEUE_H
+
+#include <osg/Drawable>
+#include <osg/Referenced>
+#include <osg/ref_ptr>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    /// @brief Per frame vertex data update of a single drawable buffer, e.g. skinning or morphing.
+    /// @note The same job is submitted again every time the buffer is updated. Submitting requires the previous
+    /// submission to be done, so the owner calls wait() before changing the job input.
+    class DeformationJob : public osg::Referenced
+    {
+    public:
+        /// Wait until the last submitted work is completed. If it is not started yet, it is done on the calling thread.
+        void wait();
+
+    protected:
+        /// Override in a derived DeformationJob to write the vertex data.
+        virtual void deform() = 0;
+
+    private:
+        enum class State
+        {
+            Done,
+            Queued,
+            Running,
+        };
+
+        std::atomic<State> mState{ State::Done };
+        std::mutex mMutex;
+        std::condition_variable mDone;
+
+        bool tryRun();
+
+        friend class DeformationQueue;
+    };
+
+    /// @brief Runs deformation jobs on worker threads so the cull traversal only prepares their input.
+    /// @note Jobs are submitted during cull traversal and waited for by the draw traversal using
+    /// DeformationDrawCallback. Without a DeformationQueue instance or worker threads jobs are done immediately.
+    class DeformationQueue
+    {
+    public:
+        static DeformationQueue* getInstance();
+
+        /// Queue the job to the current instance or do it immediately on the calling thread.
+        static void submit(const osg::ref_ptr<DeformationJob>& job);
+
+        explicit DeformationQueue(std::size_t threadsCount);
+
+        ~DeformationQueue();
+
+    private:
+        static DeformationQueue* sInstance;
+
+        std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::deque<osg::ref_ptr<DeformationJob>> mJobs;
+        bool mShouldStop = false;
+        std::vector<std::thread> mThreads;
+
+        void push(const osg::ref_ptr<DeformationJob>& job);
+
+        void run() noexcept;
+    };
+
+    /// Waits for the job writing vertex data of the drawable before drawing it.
+    class DeformationDrawCallback : public osg::Drawable::DrawCallback
+    {
+    public:
+        explicit DeformationDrawCallback(osg::ref_ptr<DeformationJob> job)
+            : mJob(std::move(job))
+        {
+        }
+
+        void drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const override;
+
+    private:
+        osg::ref_ptr<DeformationJob> mJob;
+    };
+}
+
+#endif
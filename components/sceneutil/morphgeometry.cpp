@@ -2,14 +2,41 @@
 
 #include <osgUtil/CullVisitor>
 
+#include <algorithm>
 #include <cassert>
+#include <utility>
+#include <vector>
+
 #include <components/resource/scenemanager.hpp>
 
+#include "copyboundscallback.hpp"
+#include "deformationqueue.hpp"
+
 namespace SceneUtil
 {
+    class MorphGeometry::MorphJob : public DeformationJob
+    {
+    public:
+        osg::ref_ptr<const osg::Vec3Array> mSource;
+        // Only morph targets with non-zero weight
+        std::vector<std::pair<osg::ref_ptr<const osg::Vec3Array>, float>> mOffsets;
+        osg::Vec3Array* mPositions = nullptr;
+
+    protected:
+        void deform() override
+        {
+            osg::Vec3Array& positions = *mPositions;
+            std::copy(mSource->begin(), mSource->end(), positions.begin());
+
+            for (const auto& [offsets, weight] : mOffsets)
+                for (std::size_t vertex = 0; vertex < positions.size(); ++vertex)
+                    positions[vertex] += (*offsets)[vertex] * weight;
+        }
+    };
 
     MorphGeometry::MorphGeometry()
-        : mLastFrameNumber(0)
+        : mMorphJobs{ new MorphJob, new MorphJob }
+        , mLastFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
     {
@@ -18,6 +45,7 @@ namespace SceneUtil
     MorphGeometry::MorphGeometry(const MorphGeometry& copy, const osg::CopyOp& copyop)
         : osg::Drawable(copy, copyop)
         , mMorphTargets(copy.mMorphTargets)
+        , mMorphJobs{ new MorphJob, new MorphJob }
         , mLastFrameNumber(0)
         , mDirty(true)
         , mMorphedBoundingBox(false)
@@ -25,10 +53,20 @@ namespace SceneUtil
         setSourceGeometry(copy.getSourceGeometry());
     }
 
+    MorphGeometry::~MorphGeometry()
+    {
+        // Jobs write into arrays owned by this object
+        for (const osg::ref_ptr<MorphJob>& job : mMorphJobs)
+            job->wait();
+    }
+
     void MorphGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom)
     {
         for (unsigned int i = 0; i < 2; ++i)
+        {
+            mMorphJobs[i]->wait();
             mGeometry[i] = nullptr;
+        }
 
         mSourceGeometry = sourceGeom;
 
@@ -48,6 +86,9 @@ namespace SceneUtil
             to.setSupportsDisplayList(false);
             to.setUseVertexBufferObjects(true);
             to.setCullingActive(false); // make sure to disable culling since that's handled by this class
+            // vertices may be written by a DeformationQueue worker while the cull traversal computes the bounds
+            to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
+            to.setDrawCallback(new DeformationDrawCallback(mMorphJobs[i]));
 
             // vertices are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
@@ -62,6 +103,10 @@ namespace SceneUtil
                 to.setVertexArray(vertexArray);
             }
         }
+
+        dirtyBound();
+        for (const osg::ref_ptr<osg::Geometry>& geometry : mGeometry)
+            updateGeometryBound(*geometry);
     }
 
     void MorphGeometry::addMorphTarget(osg::Vec3Array* offsets, float weight)
@@ -111,6 +156,7 @@ namespace SceneUtil
 
     void MorphGeometry::accept(osg::PrimitiveFunctor& func) const
     {
+        mMorphJobs[mLastFrameNumber % 2]->wait();
         getGeometry(mLastFrameNumber)->accept(func);
     }
 
@@ -170,11 +216,24 @@ namespace SceneUtil
         }
     }
 
+    void MorphGeometry::updateGeometryBound(osg::Geometry& geometry)
+    {
+        // Recomputes the morph bounding box if it's dirty
+        const osg::BoundingBox& box = getBoundingBox();
+        CopyBoundingBoxCallback& callback
+            = static_cast<CopyBoundingBoxCallback&>(*geometry.getComputeBoundingBoxCallback());
+        if (callback.boundingBox == box)
+            return;
+        callback.boundingBox = box;
+        geometry.dirtyBound();
+    }
+
     void MorphGeometry::cull(osg::NodeVisitor* nv)
     {
         if (mLastFrameNumber == nv->getTraversalNumber() || !mDirty || mMorphTargets.size() == 0)
         {
             osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+            updateGeometryBound(geom);
             nv->pushOntoNodePath(&geom);
             nv->apply(geom);
             nv->popFromNodePath();
@@ -184,23 +243,29 @@ namespace SceneUtil
         mDirty = false;
         mLastFrameNumber = nv->getTraversalNumber();
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
+        updateGeometryBound(geom);
 
-        const osg::Vec3Array* positionSrc = mMorphTargets[0].getOffsets();
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        assert(positionSrc->size() == positionDst->size());
-        for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-            (*positionDst)[vertex] = (*positionSrc)[vertex];
+        MorphJob& job = *mMorphJobs[mLastFrameNumber % 2];
+        // The job may still be in progress since the last frame using the same Geometry
+        job.wait();
 
+        job.mSource = mMorphTargets[0].getOffsets();
+        job.mPositions = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+        assert(job.mSource->size() == job.mPositions->size());
+
+        // Weights are copied because update traversal of the next frame may change them while the job is running
+        job.mOffsets.clear();
         for (unsigned int i = 1; i < mMorphTargets.size(); ++i)
         {
             float weight = mMorphTargets[i].getWeight();
             if (weight == 0.f)
                 continue;
-            const osg::Vec3Array* offsets = mMorphTargets[i].getOffsets();
-            for (unsigned int vertex = 0; vertex < positionSrc->size(); ++vertex)
-                (*positionDst)[vertex] += (*offsets)[vertex] * weight;
+            job.mOffsets.emplace_back(mMorphTargets[i].getOffsets(), weight);
         }
 
+        DeformationQueue::submit(mMorphJobs[mLastFrameNumber % 2]);
+
+        osg::Vec3Array* positionDst = job.mPositions;
         positionDst->dirty();
 
         geom.osg::Drawable::dirtyGLObjects();
@@ -10,11 +10,13 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note Morphing is done by DeformationQueue worker threads, the draw traversal waits for it to complete.
     class MorphGeometry : public osg::Drawable
     {
     public:
         MorphGeometry();
         MorphGeometry(const MorphGeometry& copy, const osg::CopyOp& copyop);
+        ~MorphGeometry() override;
 
         META_Object(SceneUtil, MorphGeometry)
 
@@ -76,6 +78,9 @@ namespace SceneUtil
     private:
         void cull(osg::NodeVisitor* nv);
 
+        /// Copy the bounding box into the internal geometry
+        void updateGeometryBound(osg::Geometry& geometry);
+
         MorphTargetList mMorphTargets;
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
@@ -83,6 +88,10 @@ namespace SceneUtil
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
 
+        class MorphJob;
+        // One per internal Geometry
+        osg::ref_ptr<MorphJob> mMorphJobs[2];
+
         unsigned int mLastFrameNumber;
         bool mDirty; // Have any morph targets changed?
 
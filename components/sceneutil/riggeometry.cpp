@@ -8,13 +8,27 @@
 #include <components/misc/strings/algorithm.hpp>
 #include <components/resource/scenemanager.hpp>
 
+#include "copyboundscallback.hpp"
+#include "deformationqueue.hpp"
 #include "skeleton.hpp"
 #include "util.hpp"
 
 namespace SceneUtil
 {
+    class RigGeometry::SkinningJob : public DeformationJob
+    {
+    public:
+        osg::ref_ptr<const InfluenceData> mData;
+        std::vector<osg::Matrixf> mBoneMatrices;
+        osg::Matrixf mTransform;
+        SkinningArrays mArrays;
+
+    protected:
+        void deform() override { skin(mData->mSkinning, mBoneMatrices, mTransform, mArrays); }
+    };
 
     RigGeometry::RigGeometry()
+        : mSkinningJobs{ new SkinningJob, new SkinningJob }
     {
         setNumChildrenRequiringUpdateTraversal(1);
         // update done in accept(NodeVisitor&)
@@ -23,15 +37,28 @@ namespace SceneUtil
     RigGeometry::RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop)
         : Drawable(copy, copyop)
         , mData(copy.mData)
+        , mSkinningJobs{ new SkinningJob, new SkinningJob }
     {
         setSourceGeometry(copy.mSourceGeometry);
         setNumChildrenRequiringUpdateTraversal(1);
     }
 
+    RigGeometry::~RigGeometry()
+    {
+        // Jobs write into arrays owned by this object
+        for (const osg::ref_ptr<SkinningJob>& job : mSkinningJobs)
+            job->wait();
+    }
+
     void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
     {
         for (unsigned int i = 0; i < 2; ++i)
+        {
+            mSkinningJobs[i]->wait();
+            // New arrays have to be skinned regardless of the pose
+            mSkinningJobs[i]->mData = nullptr;
             mGeometry[i] = nullptr;
+        }
 
         mSourceGeometry = sourceGeometry;
 
@@ -54,6 +81,7 @@ namespace SceneUtil
             to.setCullingActive(false); // make sure to disable culling since that's handled by this class
             to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
             to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
+            to.setDrawCallback(new DeformationDrawCallback(mSkinningJobs[i]));
 
             // vertices and normals are modified every frame, so we need to deep copy them.
             // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
@@ -149,75 +177,71 @@ namespace SceneUtil
         unsigned int traversalNumber = nv->getTraversalNumber();
         if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
         {
-            osg::Geometry& geom = *getGeometry(mLastFrameNumber);
-            nv->pushOntoNodePath(&geom);
-            nv->apply(geom);
-            nv->popFromNodePath();
+            applyGeometry(*nv);
             return;
         }
         mLastFrameNumber = traversalNumber;
-        osg::Geometry& geom = *getGeometry(mLastFrameNumber);
 
         mSkeleton->updateBoneMatrices(traversalNumber);
 
-        // skinning
-        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
-        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
-        const osg::Vec4Array* tangentSrc = mSourceTangents;
-
-        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
-        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
-        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
+        // Skin into the Geometry that is not used by the previous frame
+        const std::size_t next = 1 - mCurrentGeometry;
+        SkinningJob& job = *mSkinningJobs[next];
+        // The job may still be in progress since the last frame using the same Geometry
+        job.wait();
 
-        std::vector<osg::Matrixf> boneMatrices(mNodes.size());
-        std::vector<Bone*>::const_iterator bone = mNodes.begin();
-        std::vector<BoneInfo>::const_iterator boneInfo = mData->mBones.begin();
-        for (osg::Matrixf& boneMat : boneMatrices)
+        job.mData = mData;
+        job.mBoneMatrices.resize(mNodes.size());
+        for (std::size_t i = 0; i < mNodes.size(); ++i)
         {
-            if (*bone != nullptr)
-                boneMat = boneInfo->mInvBindMatrix * (*bone)->mMatrixInSkeletonSpace;
-            ++bone;
-            ++boneInfo;
+            // Zero matrix makes the weight of a missing bone ignored
+            if (mNodes[i] != nullptr)
+                job.mBoneMatrices[i] = mData->mBones[i].mInvBindMatrix * mNodes[i]->mMatrixInSkeletonSpace;
+            else
+                job.mBoneMatrices[i] = osg::Matrixf(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
         }
 
-        osg::Matrixf transform;
         if (mSkinToSkelMatrix)
-            transform = (*mSkinToSkelMatrix) * mData->mTransform;
+            job.mTransform = (*mSkinToSkelMatrix) * mData->mTransform;
         else
-            transform = mData->mTransform;
+            job.mTransform = mData->mTransform;
 
-        for (const auto& [influences, vertices] : mData->mInfluences)
+        // Skeleton may be not updated by animation level of detail or may be not animated at all
+        const SkinningJob& current = *mSkinningJobs[mCurrentGeometry];
+        if (current.mData.get() == mData.get()
+            && isSameSkinningPose(current.mBoneMatrices, current.mTransform, job.mBoneMatrices, job.mTransform))
         {
-            osg::Matrixf resultMat(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1);
+            applyGeometry(*nv);
+            return;
+        }
 
-            for (const auto& [index, weight] : influences)
-            {
-                if (mNodes[index] == nullptr)
-                    continue;
-                const float* boneMatPtr = boneMatrices[index].ptr();
-                float* resultMatPtr = resultMat.ptr();
-                for (int i = 0; i < 16; ++i, ++resultMatPtr, ++boneMatPtr)
-                    if (i % 4 != 3)
-                        *resultMatPtr += *boneMatPtr * weight;
-            }
+        mCurrentGeometry = next;
+        osg::Geometry& geom = *mGeometry[mCurrentGeometry];
 
-            resultMat *= transform;
+        const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
+        const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
+        const osg::Vec4Array* tangentSrc = mSourceTangents;
 
-            for (unsigned short vertex : vertices)
-            {
-                (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
-                if (normalDst)
-                    (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+        osg::Vec3Array* positionDst = static_cast<osg::Vec3Array*>(geom.getVertexArray());
+        osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
+        osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-                if (tangentDst)
-                {
-                    const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                    osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(
-                        osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                    (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
-                }
-            }
+        job.mArrays = SkinningArrays{
+            .mSourcePositions = positionSrc->asVector(),
+            .mPositions = positionDst->asVector(),
+        };
+        if (normalDst)
+        {
+            job.mArrays.mSourceNormals = normalSrc->asVector();
+            job.mArrays.mNormals = normalDst->asVector();
         }
+        if (tangentDst)
+        {
+            job.mArrays.mSourceTangents = tangentSrc->asVector();
+            job.mArrays.mTangents = tangentDst->asVector();
+        }
+
+        DeformationQueue::submit(mSkinningJobs[mCurrentGeometry]);
 
         positionDst->dirty();
         if (normalDst)
@@ -227,9 +251,15 @@ namespace SceneUtil
 
         geom.osg::Drawable::dirtyGLObjects();
 
-        nv->pushOntoNodePath(&geom);
-        nv->apply(geom);
-        nv->popFromNodePath();
+        applyGeometry(*nv);
+    }
+
+    void RigGeometry::applyGeometry(osg::NodeVisitor& nv)
+    {
+        osg::Geometry& geom = *mGeometry[mCurrentGeometry];
+        nv.pushOntoNodePath(&geom);
+        nv.apply(geom);
+        nv.popFromNodePath();
     }
 
     void RigGeometry::updateBounds(osg::NodeVisitor* nv)
@@ -336,13 +366,7 @@ namespace SceneUtil
         if (!mData)
             mData = new InfluenceData;
 
-        std::map<BoneWeights, VertexList> influencesToVertices;
-        for (size_t i = 0; i < influences.size(); i++)
-            influencesToVertices[influences[i]].emplace_back(static_cast<VertexList::value_type>(i));
-        influencesToVertices.erase(BoneWeights());
-
-        mData->mInfluences.reserve(influencesToVertices.size());
-        mData->mInfluences.assign(influencesToVertices.begin(), influencesToVertices.end());
+        mData->mSkinning = makeSkinningData(influences);
     }
 
     void RigGeometry::setTransform(osg::Matrixf&& transform)
@@ -389,12 +413,8 @@ namespace SceneUtil
 
     void RigGeometry::accept(osg::PrimitiveFunctor& func) const
     {
-        getGeometry(mLastFrameNumber)->accept(func);
-    }
-
-    osg::Geometry* RigGeometry::getGeometry(unsigned int frame) const
-    {
-        return mGeometry[frame % 2].get();
+        mSkinningJobs[mCurrentGeometry]->wait();
+        mGeometry[mCurrentGeometry]->accept(func);
     }
 
 }
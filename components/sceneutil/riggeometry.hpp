@@ -4,7 +4,11 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <cstddef>
 #include <string_view>
+#include <vector>
+
+#include "skinning.hpp"
 
 namespace SceneUtil
 {
@@ -25,11 +29,13 @@ namespace SceneUtil
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread
     /// safe way while not compromising rendering performance. This is crucial when using osg's default threading model
     /// of DrawThreadPerContext.
+    /// @note Skinning is done by DeformationQueue worker threads, the draw traversal waits for it to complete.
     class RigGeometry : public osg::Drawable
     {
     public:
         RigGeometry();
         RigGeometry(const RigGeometry& copy, const osg::CopyOp& copyop);
+        ~RigGeometry() override;
 
         META_Object(SceneUtil, RigGeometry)
 
@@ -45,8 +51,8 @@ namespace SceneUtil
             osg::Matrixf mInvBindMatrix;
         };
 
-        using BoneWeight = std::pair<size_t, float>;
-        using BoneWeights = std::vector<BoneWeight>;
+        using BoneWeight = SceneUtil::BoneWeight;
+        using BoneWeights = SceneUtil::BoneWeights;
 
         void setBoneInfo(std::vector<BoneInfo>&& bones);
         // Convert influences in bone and weight list per vertex format
@@ -66,26 +72,15 @@ namespace SceneUtil
         bool supports(const osg::PrimitiveFunctor&) const override { return true; }
         void accept(osg::PrimitiveFunctor&) const override;
 
-        struct CopyBoundingBoxCallback : osg::Drawable::ComputeBoundingBoxCallback
-        {
-            osg::BoundingBox boundingBox;
-
-            osg::BoundingBox computeBound(const osg::Drawable&) const override { return boundingBox; }
-        };
-
-        struct CopyBoundingSphereCallback : osg::Node::ComputeBoundingSphereCallback
-        {
-            osg::BoundingSphere boundingSphere;
-
-            osg::BoundingSphere computeBound(const osg::Node&) const override { return boundingSphere; }
-        };
-
     private:
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
 
         osg::ref_ptr<osg::Geometry> mGeometry[2];
-        osg::Geometry* getGeometry(unsigned int frame) const;
+        // Index of the Geometry with the latest skinning result
+        std::size_t mCurrentGeometry{ 0 };
+
+        void applyGeometry(osg::NodeVisitor& nv);
 
         osg::ref_ptr<osg::Geometry> mSourceGeometry;
         osg::ref_ptr<const osg::Vec4Array> mSourceTangents;
@@ -93,17 +88,20 @@ namespace SceneUtil
 
         osg::ref_ptr<osg::RefMatrix> mSkinToSkelMatrix;
 
-        using VertexList = std::vector<unsigned short>;
         struct InfluenceData : public osg::Referenced
         {
             std::vector<BoneInfo> mBones;
-            std::vector<std::pair<BoneWeights, VertexList>> mInfluences;
+            SkinningData mSkinning;
             osg::Matrixf mTransform;
             std::string mRootBone;
         };
         osg::ref_ptr<InfluenceData> mData;
         std::vector<Bone*> mNodes;
 
+        class SkinningJob;
+        // One per internal Geometry
+        osg::ref_ptr<SkinningJob> mSkinningJobs[2];
+
         unsigned int mLastFrameNumber{ 0 };
         bool mBoundsFirstFrame{ true };
 
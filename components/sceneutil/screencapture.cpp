@@ -24,7 +24,8 @@ namespace
     public:
         ScreenCaptureWorkItem(const osg::ref_ptr<osgViewer::ScreenCaptureHandler::CaptureOperation>& impl,
             const osg::Image& image, unsigned int contextId)
-            : mImpl(impl)
+            : SceneUtil::WorkItem(SceneUtil::WorkCategory::ScreenCapture)
+            , mImpl(impl)
             , mImage(new osg::Image(image))
             , mContextId(contextId)
         {
@@ -147,7 +148,7 @@ namespace SceneUtil
     void AsyncScreenCaptureOperation::stop()
     {
         for (const osg::ref_ptr<SceneUtil::WorkItem>& item : *mWorkItems.lockConst())
-            item->abort();
+            item->cancel();
 
         for (const osg::ref_ptr<SceneUtil::WorkItem>& item : *mWorkItems.lockConst())
             item->waitTillDone();
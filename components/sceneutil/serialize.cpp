@@ -1,8 +1,17 @@
 #include "serialize.hpp"
 
+#include <osgDB/InputStream>
 #include <osgDB/ObjectWrapper>
+#include <osgDB/OutputStream>
 #include <osgDB/Registry>
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
 #include <components/nifosg/fog.hpp>
 #include <components/nifosg/matrixtransform.hpp>
 
@@ -122,6 +131,32 @@ namespace SceneUtil
             : osgDB::ObjectWrapper(createInstanceFunc<NifOsg::MatrixTransform>, "NifOsg::MatrixTransform",
                 "osg::Object osg::Node osg::Group osg::Transform osg::MatrixTransform NifOsg::MatrixTransform")
         {
+            // Decomposed components can't be restored from the matrix
+            addSerializer(new osgDB::UserSerializer<NifOsg::MatrixTransform>(
+                              "ScaleRotation", &hasScaleRotation, &readScaleRotation, &writeScaleRotation),
+                osgDB::BaseSerializer::RW_USER);
+        }
+
+    private:
+        static bool hasScaleRotation(const NifOsg::MatrixTransform& /*node*/) { return true; }
+
+        static bool readScaleRotation(osgDB::InputStream& stream, NifOsg::MatrixTransform& node)
+        {
+            stream >> node.mScale;
+            for (auto& row : node.mRotationScale.mValues)
+                for (float& value : row)
+                    stream >> value;
+            return true;
+        }
+
+        static bool writeScaleRotation(osgDB::OutputStream& stream, const NifOsg::MatrixTransform& node)
+        {
+            stream << node.mScale;
+            for (const auto& row : node.mRotationScale.mValues)
+                for (float value : row)
+                    stream << value;
+            stream << std::endl;
+            return true;
         }
     };
 
@@ -163,11 +198,59 @@ namespace SceneUtil
         }
     };
 
+    static std::atomic_bool sHasLossySerializers{ false };
+
+    void registerLosslessSerializers()
+    {
+        [[maybe_unused]] static const bool done = [] {
+            osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
+            mgr->addWrapper(new MatrixTransformSerializer);
+            mgr->addWrapper(new FogSerializer);
+            mgr->addWrapper(new TextureTypeSerializer);
+            return true;
+        }();
+    }
+
+    bool hasLossySerializers()
+    {
+        return sHasLossySerializers;
+    }
+
+    bool hasLosslessSerializer(const osg::Object& object)
+    {
+        std::string name = object.libraryName();
+        name += "::";
+        name += object.className();
+        if (sHasLossySerializers)
+        {
+            // Replaced or added by registerSerializers
+            constexpr std::string_view lossy[] = {
+                "osg::Geometry",
+                "SceneUtil::Skeleton",
+                "SceneUtil::RigGeometry",
+                "SceneUtil::RigGeometryHolder",
+                "SceneUtil::OsgaRigGeometry",
+                "SceneUtil::MorphGeometry",
+            };
+            if (std::find(std::begin(lossy), std::end(lossy), name) != std::end(lossy))
+                return false;
+        }
+        osgDB::ObjectWrapper* const wrapper = osgDB::Registry::instance()->getObjectWrapperManager()->findWrapper(name);
+        if (wrapper == nullptr)
+            return false;
+        // Classes without own META macro report names of their base classes and would be read as those
+        const osg::ref_ptr<osg::Object> instance = wrapper->createInstance();
+        return instance != nullptr && typeid(*instance) == typeid(object);
+    }
+
     void registerSerializers()
     {
         static bool done = false;
         if (!done)
         {
+            registerLosslessSerializers();
+            sHasLossySerializers = true;
+
             osgDB::ObjectWrapperManager* mgr = osgDB::Registry::instance()->getObjectWrapperManager();
             mgr->addWrapper(new PositionAttitudeTransformSerializer);
             mgr->addWrapper(new SkeletonSerializer);
@@ -177,9 +260,6 @@ namespace SceneUtil
             mgr->addWrapper(new MorphGeometrySerializer);
             mgr->addWrapper(new LightManagerSerializer);
             mgr->addWrapper(new CameraRelativeTransformSerializer);
-            mgr->addWrapper(new MatrixTransformSerializer);
-            mgr->addWrapper(new FogSerializer);
-            mgr->addWrapper(new TextureTypeSerializer);
 
             // Don't serialize Geometry data as we are more interested in the overall structure rather than tons of
             // vertex data that would make the file large and hard to read.
@@ -1,12 +1,29 @@
 #ifndef OPENMW_COMPONENTS_SCENEUTIL_SERIALIZE_H
 #define OPENMW_COMPONENTS_SCENEUTIL_SERIALIZE_H
 
+namespace osg
+{
+    class Object;
+}
+
 namespace SceneUtil
 {
 
     /// Register osg node serializers for certain SceneUtil classes if not already done so
+    /// @note Makes some serializers lossy to produce human readable output.
     void registerSerializers();
 
+    /// Register serializers for NifOsg and SceneUtil classes which can be stored and restored without losing data if
+    /// not already done so.
+    void registerLosslessSerializers();
+
+    /// Whether registerSerializers was called so some of the registered serializers lose data.
+    bool hasLossySerializers();
+
+    /// Whether the object can be written and read back by the registered serializer without losing data. Callbacks
+    /// and other objects referenced by the object are not checked.
+    bool hasLosslessSerializer(const osg::Object& object);
+
 }
 
 #endif
@@ -2,13 +2,85 @@
 
 #include <osg/MatrixTransform>
 
+#include <osgUtil/CullVisitor>
+#include <osgUtil/UpdateVisitor>
+
 #include <components/debug/debuglog.hpp>
 #include <components/misc/strings/lower.hpp>
 
 #include <algorithm>
+#include <atomic>
+
+#include "controller.hpp"
 
 namespace SceneUtil
 {
+    namespace
+    {
+        std::atomic_uint nextLodPhase{ 0 };
+
+        unsigned int getUpdateInterval(AnimationLod lod)
+        {
+            switch (lod)
+            {
+                case AnimationLod::Full:
+                    return 1;
+                case AnimationLod::Half:
+                    return 2;
+                case AnimationLod::Quarter:
+                    return 4;
+            }
+            return 1;
+        }
+
+        bool hasAnimationController(const osg::Callback* callback)
+        {
+            for (; callback != nullptr; callback = callback->getNestedCallback())
+                if (dynamic_cast<const Controller*>(callback) != nullptr)
+                    return true;
+            return false;
+        }
+
+        // Doesn't run update callbacks of bones with animation controllers, including the ones nested after them like
+        // head tracking which rotates the bone relative to the animated pose. Bones keep the previous pose while
+        // particles, lights and other callbacks are updated as usual.
+        class SkipBonesAnimationVisitor : public osgUtil::UpdateVisitor
+        {
+        public:
+            explicit SkipBonesAnimationVisitor(osg::NodeVisitor& nv)
+            {
+                setTraversalMask(nv.getTraversalMask());
+                setNodeMaskOverride(nv.getNodeMaskOverride());
+                setTraversalNumber(nv.getTraversalNumber());
+                setFrameStamp(const_cast<osg::FrameStamp*>(nv.getFrameStamp()));
+                getNodePath() = nv.getNodePath();
+            }
+
+            using osgUtil::UpdateVisitor::apply;
+
+            void apply(osg::Transform& node) override
+            {
+                if (hasAnimationController(node.getUpdateCallback()))
+                    traverse(node);
+                else
+                    osgUtil::UpdateVisitor::apply(node);
+            }
+        };
+    }
+
+    AnimationLod getAnimationLod(float screenSize, const AnimationLodSettings& settings)
+    {
+        if (screenSize >= settings.mHalfRateSize)
+            return AnimationLod::Full;
+        if (screenSize >= settings.mQuarterRateSize)
+            return AnimationLod::Half;
+        return AnimationLod::Quarter;
+    }
+
+    bool isSkippedByAnimationLod(AnimationLod lod, unsigned int phase, unsigned int traversalNumber)
+    {
+        return (traversalNumber + phase) % getUpdateInterval(lod) != 0;
+    }
 
     class InitBoneCacheVisitor : public osg::NodeVisitor
     {
@@ -39,6 +111,7 @@ namespace SceneUtil
         , mActive(Active)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLodPhase(nextLodPhase++)
     {
     }
 
@@ -49,6 +122,8 @@ namespace SceneUtil
         , mActive(copy.mActive)
         , mLastFrameNumber(0)
         , mLastCullFrameNumber(0)
+        , mLodSettings(copy.mLodSettings)
+        , mLodPhase(nextLodPhase++)
     {
     }
 
@@ -132,17 +207,62 @@ namespace SceneUtil
     {
         if (nv.getVisitorType() == osg::NodeVisitor::UPDATE_VISITOR)
         {
-            if (mActive == Inactive && mLastFrameNumber != 0)
+            mUpdateSkipped = shouldSkipUpdate(nv.getTraversalNumber());
+            if (mUpdateSkipped)
                 return;
-            if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber + 3 <= nv.getTraversalNumber())
+            mUpdateSkipped = shouldSkipAnimation(nv.getTraversalNumber());
+            if (mUpdateSkipped)
+            {
+                SkipBonesAnimationVisitor visitor(nv);
+                osg::Group::traverse(visitor);
                 return;
+            }
         }
         else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
+        {
             mLastCullFrameNumber = nv.getTraversalNumber();
+            if (mLodSettings.mEnabled)
+                updateLod(static_cast<osgUtil::CullVisitor&>(nv));
+        }
 
         osg::Group::traverse(nv);
     }
 
+    bool Skeleton::shouldSkipUpdate(unsigned int traversalNumber) const
+    {
+        if (mLastFrameNumber == 0)
+            return false;
+        if (mActive == Inactive)
+            return true;
+        return mActive == SemiActive && mLastCullFrameNumber + 3 <= traversalNumber;
+    }
+
+    bool Skeleton::shouldSkipAnimation(unsigned int traversalNumber) const
+    {
+        return mLastFrameNumber != 0 && mActive == SemiActive && mLodSettings.mEnabled
+            && isSkippedByAnimationLod(mLod, mLodPhase, traversalNumber);
+    }
+
+    void Skeleton::updateLod(osgUtil::CullVisitor& cv)
+    {
+        const osg::Viewport* const viewport = cv.getViewport();
+        if (viewport == nullptr || viewport->height() <= 0)
+            return;
+
+        const float screenSize = cv.clampedPixelSize(getBound()) / static_cast<float>(viewport->height());
+
+        // Shadow and reflection cameras may cull the same skeleton, the main camera gives the biggest size
+        if (mLodFrameNumber != cv.getTraversalNumber())
+        {
+            mLodFrameNumber = cv.getTraversalNumber();
+            mLodScreenSize = screenSize;
+        }
+        else
+            mLodScreenSize = std::max(mLodScreenSize, screenSize);
+
+        mLod = getAnimationLod(mLodScreenSize, mLodSettings);
+    }
+
     void Skeleton::childInserted(unsigned int)
     {
         markDirty();
@@ -3,11 +3,45 @@
 
 #include <osg/Group>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 
+namespace osgUtil
+{
+    class CullVisitor;
+}
+
 namespace SceneUtil
 {
+    /// Update rate level of detail of a skeleton.
+    enum class AnimationLod : std::uint8_t
+    {
+        /// Bones are updated every frame.
+        Full,
+        /// Bones are updated every second frame.
+        Half,
+        /// Bones are updated every fourth frame.
+        Quarter,
+    };
+
+    inline constexpr std::size_t animationLodCount = 3;
+
+    /// Screen sizes of a skeleton bounding sphere relative to the viewport height below which its update rate is
+    /// reduced.
+    struct AnimationLodSettings
+    {
+        bool mEnabled = false;
+        float mHalfRateSize = 0;
+        float mQuarterRateSize = 0;
+    };
+
+    /// Level of detail for a skeleton which bounding sphere has given screen size relative to the viewport height.
+    AnimationLod getAnimationLod(float screenSize, const AnimationLodSettings& settings);
+
+    /// Whether bones of a skeleton with given level of detail and update phase keep the previous pose in the frame.
+    bool isSkippedByAnimationLod(AnimationLod lod, unsigned int phase, unsigned int traversalNumber);
 
     /// @brief Defines a Bone hierarchy, used for updating of skeleton-space bone matrices.
     /// @note To prevent unnecessary updates, only bones that are used for skinning will be added to this hierarchy.
@@ -56,6 +90,16 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Set reduced update rate for SemiActive skeletons depending on their size on screen. Until the next update
+        /// the bones keep their previous pose.
+        void setLodSettings(const AnimationLodSettings& value) { mLodSettings = value; }
+
+        AnimationLod getLod() const { return mLod; }
+
+        /// Whether the last update traversal did not update the bones. When only the update rate is reduced, other
+        /// update callbacks of the skeleton children are still run.
+        bool isUpdateSkipped() const { return mUpdateSkipped; }
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -78,6 +122,21 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        AnimationLodSettings mLodSettings;
+        AnimationLod mLod = AnimationLod::Full;
+        // The biggest screen size over all cull traversals of the frame
+        float mLodScreenSize = 0;
+        unsigned int mLodFrameNumber = 0;
+        // Distributes updates of skeletons with reduced update rate over frames
+        unsigned int mLodPhase;
+        bool mUpdateSkipped = false;
+
+        bool shouldSkipUpdate(unsigned int traversalNumber) const;
+
+        bool shouldSkipAnimation(unsigned int traversalNumber) const;
+
+        void updateLod(osgUtil::CullVisitor& cv);
     };
 
 }
@@ -0,0 +1,250 @@
+#include "skinning.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPENMW_SCENEUTIL_SKINNING_SSE
+#include <emmintrin.h>
+#endif
+
+namespace SceneUtil
+{
+    namespace
+    {
+#ifdef OPENMW_SCENEUTIL_SKINNING_SSE
+        using Row = __m128;
+
+        Row zeroRow()
+        {
+            return _mm_setzero_ps();
+        }
+
+        Row loadRow(const float* value)
+        {
+            return _mm_loadu_ps(value);
+        }
+
+        Row broadcast(const float& value)
+        {
+            return _mm_load1_ps(&value);
+        }
+
+        template <int index>
+        Row broadcast(Row value)
+        {
+            return _mm_shuffle_ps(value, value, _MM_SHUFFLE(index, index, index, index));
+        }
+
+        Row add(Row lhs, Row rhs)
+        {
+            return _mm_add_ps(lhs, rhs);
+        }
+
+        Row mul(Row lhs, Row rhs)
+        {
+            return _mm_mul_ps(lhs, rhs);
+        }
+
+        // Sets the last component to the given value
+        Row withW(Row value, float w)
+        {
+            const Row mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+            return _mm_or_ps(_mm_and_ps(value, mask), _mm_set_ps(w, 0, 0, 0));
+        }
+
+        void store3(Row value, float* out)
+        {
+            _mm_storel_pi(reinterpret_cast<__m64*>(out), value);
+            _mm_store_ss(out + 2, _mm_movehl_ps(value, value));
+        }
+#else
+        struct Row
+        {
+            float mValue[4];
+        };
+
+        Row zeroRow()
+        {
+            return Row{ { 0, 0, 0, 0 } };
+        }
+
+        Row loadRow(const float* value)
+        {
+            return Row{ { value[0], value[1], value[2], value[3] } };
+        }
+
+        Row broadcast(const float& value)
+        {
+            return Row{ { value, value, value, value } };
+        }
+
+        template <int index>
+        Row broadcast(Row value)
+        {
+            return broadcast(value.mValue[index]);
+        }
+
+        Row add(Row lhs, Row rhs)
+        {
+            return Row{ { lhs.mValue[0] + rhs.mValue[0], lhs.mValue[1] + rhs.mValue[1], lhs.mValue[2] + rhs.mValue[2],
+                lhs.mValue[3] + rhs.mValue[3] } };
+        }
+
+        Row mul(Row lhs, Row rhs)
+        {
+            return Row{ { lhs.mValue[0] * rhs.mValue[0], lhs.mValue[1] * rhs.mValue[1], lhs.mValue[2] * rhs.mValue[2],
+                lhs.mValue[3] * rhs.mValue[3] } };
+        }
+
+        Row withW(Row value, float w)
+        {
+            value.mValue[3] = w;
+            return value;
+        }
+
+        void store3(Row value, float* out)
+        {
+            out[0] = value.mValue[0];
+            out[1] = value.mValue[1];
+            out[2] = value.mValue[2];
+        }
+#endif
+
+        // Row-major 4x4 matrix multiplied by a row vector on the left like osg::Matrixf
+        struct Matrix
+        {
+            Row mRows[4];
+        };
+
+        Matrix loadMatrix(const osg::Matrixf& value)
+        {
+            const float* const ptr = value.ptr();
+            return Matrix{ { loadRow(ptr), loadRow(ptr + 4), loadRow(ptr + 8), loadRow(ptr + 12) } };
+        }
+
+        Row transformPoint(const Matrix& matrix, const float* value)
+        {
+            return add(add(mul(broadcast(value[0]), matrix.mRows[0]), mul(broadcast(value[1]), matrix.mRows[1])),
+                add(mul(broadcast(value[2]), matrix.mRows[2]), matrix.mRows[3]));
+        }
+
+        Row transformVector(const Matrix& matrix, const float* value)
+        {
+            return add(add(mul(broadcast(value[0]), matrix.mRows[0]), mul(broadcast(value[1]), matrix.mRows[1])),
+                mul(broadcast(value[2]), matrix.mRows[2]));
+        }
+
+        Matrix multiply(const Matrix& lhs, const Matrix& rhs)
+        {
+            Matrix result;
+            for (int i = 0; i < 4; ++i)
+            {
+                const Row row = lhs.mRows[i];
+                result.mRows[i] = add(add(mul(broadcast<0>(row), rhs.mRows[0]), mul(broadcast<1>(row), rhs.mRows[1])),
+                    add(mul(broadcast<2>(row), rhs.mRows[2]), mul(broadcast<3>(row), rhs.mRows[3])));
+            }
+            return result;
+        }
+
+        Matrix blend(const SkinningData& data, std::size_t group, std::span<const osg::Matrixf> boneMatrices)
+        {
+            Matrix result{ { zeroRow(), zeroRow(), zeroRow(), zeroRow() } };
+            for (std::uint32_t i = data.mWeightsBegins[group], end = data.mWeightsBegins[group + 1]; i < end; ++i)
+            {
+                const float* const bone = boneMatrices[data.mBoneIndices[i]].ptr();
+                const Row weight = broadcast(data.mWeights[i]);
+                for (int j = 0; j < 4; ++j)
+                    result.mRows[j] = add(result.mRows[j], mul(loadRow(bone + 4 * j), weight));
+            }
+            // Keep the result affine regardless of the sum of weights like it is for bone matrices
+            for (int j = 0; j < 3; ++j)
+                result.mRows[j] = withW(result.mRows[j], 0);
+            result.mRows[3] = withW(result.mRows[3], 1);
+            return result;
+        }
+
+        template <bool withNormals, bool withTangents>
+        void skinImpl(const SkinningData& data, std::span<const osg::Matrixf> boneMatrices,
+            const osg::Matrixf& transform, const SkinningArrays& arrays)
+        {
+            const Matrix transformMatrix = loadMatrix(transform);
+
+            for (std::size_t group = 0, count = data.getGroupsCount(); group < count; ++group)
+            {
+                const Matrix matrix = multiply(blend(data, group, boneMatrices), transformMatrix);
+
+                for (std::uint32_t i = data.mVerticesBegins[group], end = data.mVerticesBegins[group + 1]; i < end; ++i)
+                {
+                    const std::uint32_t vertex = data.mVertices[i];
+
+                    store3(transformPoint(matrix, arrays.mSourcePositions[vertex].ptr()),
+                        arrays.mPositions[vertex].ptr());
+
+                    if constexpr (withNormals)
+                        store3(transformVector(matrix, arrays.mSourceNormals[vertex].ptr()),
+                            arrays.mNormals[vertex].ptr());
+
+                    if constexpr (withTangents)
+                    {
+                        const osg::Vec4f& source = arrays.mSourceTangents[vertex];
+                        osg::Vec4f& tangent = arrays.mTangents[vertex];
+                        store3(transformVector(matrix, source.ptr()), tangent.ptr());
+                        tangent.w() = source.w();
+                    }
+                }
+            }
+        }
+    }
+
+    SkinningData makeSkinningData(const std::vector<BoneWeights>& influences)
+    {
+        std::map<BoneWeights, std::vector<std::uint32_t>> influencesToVertices;
+        for (std::size_t i = 0; i < influences.size(); ++i)
+            if (!influences[i].empty())
+                influencesToVertices[influences[i]].push_back(static_cast<std::uint32_t>(i));
+
+        SkinningData result;
+        result.mWeightsBegins.reserve(influencesToVertices.size() + 1);
+        result.mVerticesBegins.reserve(influencesToVertices.size() + 1);
+        result.mVertices.reserve(influences.size());
+        for (const auto& [weights, vertices] : influencesToVertices)
+        {
+            for (const auto& [index, weight] : weights)
+            {
+                result.mBoneIndices.push_back(static_cast<std::uint32_t>(index));
+                result.mWeights.push_back(weight);
+            }
+            result.mWeightsBegins.push_back(static_cast<std::uint32_t>(result.mWeights.size()));
+            result.mVertices.insert(result.mVertices.end(), vertices.begin(), vertices.end());
+            result.mVerticesBegins.push_back(static_cast<std::uint32_t>(result.mVertices.size()));
+        }
+        return result;
+    }
+
+    void skin(const SkinningData& data, std::span<const osg::Matrixf> boneMatrices, const osg::Matrixf& transform,
+        const SkinningArrays& arrays)
+    {
+        assert(arrays.mNormals.empty() || arrays.mSourceNormals.size() == arrays.mNormals.size());
+        assert(arrays.mTangents.empty() || arrays.mSourceTangents.size() == arrays.mTangents.size());
+
+        const bool withNormals = !arrays.mNormals.empty();
+        const bool withTangents = !arrays.mTangents.empty();
+
+        if (withNormals && withTangents)
+            skinImpl<true, true>(data, boneMatrices, transform, arrays);
+        else if (withNormals)
+            skinImpl<true, false>(data, boneMatrices, transform, arrays);
+        else if (withTangents)
+            skinImpl<false, true>(data, boneMatrices, transform, arrays);
+        else
+            skinImpl<false, false>(data, boneMatrices, transform, arrays);
+    }
+
+    bool isSameSkinningPose(std::span<const osg::Matrixf> previousBoneMatrices, const osg::Matrixf& previousTransform,
+        std::span<const osg::Matrixf> boneMatrices, const osg::Matrixf& transform)
+    {
+        return previousTransform == transform && std::ranges::equal(previousBoneMatrices, boneMatrices);
+    }
+}
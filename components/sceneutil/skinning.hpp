@@ -0,0 +1,60 @@
+#ifndef OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+#define OPENMW_COMPONENTS_SCENEUTIL_SKINNING_H
+
+#include <osg/Matrixf>
+#include <osg/Vec3f>
+#include <osg/Vec4f>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace SceneUtil
+{
+    using BoneWeight = std::pair<std::size_t, float>;
+    using BoneWeights = std::vector<BoneWeight>;
+
+    /// Vertices grouped by the same bone weights in structure of arrays layout. All vertices of a group share a single
+    /// skinning matrix.
+    struct SkinningData
+    {
+        // Weights of the group i are in range [mWeightsBegins[i], mWeightsBegins[i + 1])
+        std::vector<std::uint32_t> mWeightsBegins{ 0 };
+        std::vector<std::uint32_t> mBoneIndices;
+        std::vector<float> mWeights;
+        // Vertices of the group i are in range [mVerticesBegins[i], mVerticesBegins[i + 1])
+        std::vector<std::uint32_t> mVerticesBegins{ 0 };
+        std::vector<std::uint32_t> mVertices;
+
+        std::size_t getGroupsCount() const { return mWeightsBegins.size() - 1; }
+    };
+
+    /// Groups vertices by equal bone weights, vertices without weights are ignored.
+    SkinningData makeSkinningData(const std::vector<BoneWeights>& influences);
+
+    /// Source and destination arrays of vertex attributes. Normals and tangents are optional, empty destination
+    /// disables skinning of the attribute.
+    struct SkinningArrays
+    {
+        std::span<const osg::Vec3f> mSourcePositions{};
+        std::span<osg::Vec3f> mPositions{};
+        std::span<const osg::Vec3f> mSourceNormals{};
+        std::span<osg::Vec3f> mNormals{};
+        std::span<const osg::Vec4f> mSourceTangents{};
+        std::span<osg::Vec4f> mTangents{};
+    };
+
+    /// Transforms vertices by weighted sum of bone matrices followed by transform. Bone matrices are treated as affine
+    /// transformations, a zero matrix can be used for a missing bone to ignore its weight.
+    void skin(const SkinningData& data, std::span<const osg::Matrixf> boneMatrices, const osg::Matrixf& transform,
+        const SkinningArrays& arrays);
+
+    /// Whether skinning with given bone matrices and transform gives the same vertices as with the previous ones. Allows
+    /// to keep the previous result when the skeleton is not updated.
+    bool isSameSkinningPose(std::span<const osg::Matrixf> previousBoneMatrices, const osg::Matrixf& previousTransform,
+        std::span<const osg::Matrixf> boneMatrices, const osg::Matrixf& transform);
+}
+
+#endif
@@ -11,7 +11,8 @@ namespace SceneUtil
             std::vector<osg::ref_ptr<osg::Referenced>> mObjects;
 
             explicit ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>&& objects)
-                : mObjects(std::move(objects))
+                : SceneUtil::WorkItem(SceneUtil::WorkCategory::Unref)
+                , mObjects(std::move(objects))
             {
             }
 
@@ -25,8 +26,9 @@ namespace SceneUtil
             return;
 
         // Move only objects to keep allocated storage in mObjects
-        workQueue.addWorkItem(new ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>(
+        osg::ref_ptr<ClearVector> item(new ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>(
             std::move_iterator(mObjects.begin()), std::move_iterator(mObjects.end()))));
+        workQueue.addWorkItem(std::move(item));
         mObjects.clear();
     }
 }
@@ -2,10 +2,71 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <osg/Stats>
+
+#include <algorithm>
 #include <numeric>
 
 namespace SceneUtil
 {
+    namespace
+    {
+        std::string makeAttribute(std::string_view category, std::string_view suffix)
+        {
+            std::string result("WorkQueue ");
+            result += category;
+            result += ' ';
+            result += suffix;
+            return result;
+        }
+
+        constexpr std::string_view statsSuffixes[] = {
+            "Queued",
+            "Done",
+            "Cancelled",
+        };
+    }
+
+    std::string_view getWorkCategoryName(WorkCategory value)
+    {
+        switch (value)
+        {
+            case WorkCategory::Other:
+                return "Other";
+            case WorkCategory::Preload:
+                return "Preload";
+            case WorkCategory::TerrainPreload:
+                return "TerrainPreload";
+            case WorkCategory::Map:
+                return "Map";
+            case WorkCategory::NavMesh:
+                return "NavMesh";
+            case WorkCategory::Unref:
+                return "Unref";
+            case WorkCategory::ScreenCapture:
+                return "ScreenCapture";
+        }
+        return "Unknown";
+    }
+
+    void addWorkQueueStatsAttributes(std::vector<std::string>& out)
+    {
+        for (std::size_t i = 0; i < workCategoriesCount; ++i)
+            for (std::string_view suffix : statsSuffixes)
+                out.push_back(makeAttribute(getWorkCategoryName(static_cast<WorkCategory>(i)), suffix));
+    }
+
+    void reportStats(const WorkQueueStats& stats, unsigned int frameNumber, osg::Stats& out)
+    {
+        for (std::size_t i = 0; i < stats.mCategories.size(); ++i)
+        {
+            const std::string_view name = getWorkCategoryName(static_cast<WorkCategory>(i));
+            const WorkCategoryStats& category = stats.mCategories[i];
+            out.setAttribute(frameNumber, makeAttribute(name, "Queued"), static_cast<double>(category.mQueued));
+            out.setAttribute(frameNumber, makeAttribute(name, "Done"), static_cast<double>(category.mDone));
+            out.setAttribute(frameNumber, makeAttribute(name, "Cancelled"), static_cast<double>(category.mCancelled));
+        }
+    }
 
     void WorkItem::waitTillDone()
     {
@@ -33,6 +94,12 @@ namespace SceneUtil
         return mDone;
     }
 
+    void WorkItem::cancel()
+    {
+        mCancelled = true;
+        abort();
+    }
+
     WorkQueue::WorkQueue(std::size_t workerThreads)
         : mIsReleased(false)
     {
@@ -50,16 +117,18 @@ namespace SceneUtil
             const std::lock_guard lock(mMutex);
             mIsReleased = false;
         }
+        // Keep at least one queue to be able to accept items
+        while (mQueues.size() < std::max<std::size_t>(workerThreads, 1))
+            mQueues.emplace_back(std::make_unique<ThreadQueue>());
         while (mThreads.size() < workerThreads)
-            mThreads.emplace_back(std::make_unique<WorkThread>(*this));
+            mThreads.emplace_back(std::make_unique<WorkThread>(*this, mThreads.size()));
     }
 
     void WorkQueue::stop()
     {
         {
             std::unique_lock<std::mutex> lock(mMutex);
-            while (!mQueue.empty())
-                mQueue.pop_back();
+            clearQueues();
             mIsReleased = true;
             mCondition.notify_all();
         }
@@ -67,7 +136,7 @@ namespace SceneUtil
         mThreads.clear();
     }
 
-    void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
+    void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority)
     {
         if (item->isDone())
         {
@@ -75,34 +144,97 @@ namespace SceneUtil
             return;
         }
 
-        std::unique_lock<std::mutex> lock(mMutex);
-        if (front)
-            mQueue.push_front(std::move(item));
-        else
-            mQueue.push_back(std::move(item));
+        ++mCounters[static_cast<std::size_t>(item->getCategory())].mQueued;
+        ++mNumItems;
+
+        {
+            ThreadQueue& queue = *mQueues[mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size()];
+            const std::lock_guard lock(queue.mMutex);
+            queue.mItems[static_cast<std::size_t>(priority)].push_back(std::move(item));
+        }
+
+        ++mAddedItems;
+
+        // Global lock is required only to wake up a waiting thread without losing the notification
+        if (mNumWaitingThreads == 0)
+            return;
+
+        {
+            const std::lock_guard lock(mMutex);
+        }
         mCondition.notify_one();
     }
 
-    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
+    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem(std::size_t threadIndex)
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty() && !mIsReleased)
+        while (true)
         {
-            mCondition.wait(lock);
+            // Any item added after this point changes the counter, so it's not missed even when it is put into
+            // a queue that is already checked
+            const std::uint64_t addedItems = mAddedItems;
+
+            if (osg::ref_ptr<WorkItem> item = takeWorkItem(threadIndex))
+            {
+                --mNumItems;
+                --mCounters[static_cast<std::size_t>(item->getCategory())].mQueued;
+                return item;
+            }
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            ++mNumWaitingThreads;
+            mCondition.wait(lock, [&] { return mIsReleased || mAddedItems != addedItems; });
+            --mNumWaitingThreads;
+            if (mIsReleased)
+                return nullptr;
         }
-        if (!mQueue.empty())
+    }
+
+    void WorkQueue::reportDone(const WorkItem& item)
+    {
+        CategoryCounters& counters = mCounters[static_cast<std::size_t>(item.getCategory())];
+        if (item.isCancelled())
+            ++counters.mCancelled;
+        else
+            ++counters.mDone;
+    }
+
+    osg::ref_ptr<WorkItem> WorkQueue::takeWorkItem(std::size_t threadIndex)
+    {
+        for (std::size_t priority = workPrioritiesCount; priority-- > 0;)
         {
-            osg::ref_ptr<WorkItem> item = std::move(mQueue.front());
-            mQueue.pop_front();
-            return item;
+            for (std::size_t i = 0; i < mQueues.size(); ++i)
+            {
+                ThreadQueue& queue = *mQueues[(threadIndex + i) % mQueues.size()];
+                const std::lock_guard lock(queue.mMutex);
+                std::deque<osg::ref_ptr<WorkItem>>& items = queue.mItems[priority];
+                if (items.empty())
+                    continue;
+                osg::ref_ptr<WorkItem> item = std::move(items.front());
+                items.pop_front();
+                return item;
+            }
         }
         return nullptr;
     }
 
+    void WorkQueue::clearQueues()
+    {
+        for (const std::unique_ptr<ThreadQueue>& queue : mQueues)
+        {
+            const std::lock_guard lock(queue->mMutex);
+            for (std::deque<osg::ref_ptr<WorkItem>>& items : queue->mItems)
+            {
+                for (const osg::ref_ptr<WorkItem>& item : items)
+                    --mCounters[static_cast<std::size_t>(item->getCategory())].mQueued;
+                mNumItems -= items.size();
+                items.clear();
+            }
+        }
+    }
+
     size_t WorkQueue::getNumItems() const
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        return mQueue.size();
+        return mNumItems;
     }
 
     size_t WorkQueue::getNumActiveThreads() const
@@ -111,8 +243,21 @@ namespace SceneUtil
             mThreads.begin(), mThreads.end(), 0u, [](auto r, const auto& t) { return r + t->isActive(); });
     }
 
-    WorkThread::WorkThread(WorkQueue& workQueue)
+    WorkQueueStats WorkQueue::getStats() const
+    {
+        WorkQueueStats result;
+        for (std::size_t i = 0; i < mCounters.size(); ++i)
+        {
+            result.mCategories[i].mQueued = mCounters[i].mQueued.load(std::memory_order_relaxed);
+            result.mCategories[i].mDone = mCounters[i].mDone.load(std::memory_order_relaxed);
+            result.mCategories[i].mCancelled = mCounters[i].mCancelled.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    WorkThread::WorkThread(WorkQueue& workQueue, std::size_t index)
         : mWorkQueue(&workQueue)
+        , mIndex(index)
         , mActive(false)
         , mThread([this] { run(); })
     {
@@ -127,11 +272,13 @@ namespace SceneUtil
     {
         while (true)
         {
-            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
+            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem(mIndex);
             if (!item)
                 return;
             mActive = true;
-            item->doWork();
+            if (!item->isCancelled())
+                item->doWork();
+            mWorkQueue->reportDone(*item);
             item->signalDone();
             mActive = false;
         }
@@ -4,19 +4,60 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace SceneUtil
 {
+    enum class WorkPriority : std::uint8_t
+    {
+        /// Speculative work which result may be never used.
+        Low,
+        Normal,
+        /// Work which result is required as soon as possible.
+        High,
+    };
+
+    inline constexpr std::size_t workPrioritiesCount = 3;
+
+    enum class WorkCategory : std::uint8_t
+    {
+        Other,
+        Preload,
+        TerrainPreload,
+        Map,
+        NavMesh,
+        Unref,
+        ScreenCapture,
+    };
+
+    inline constexpr std::size_t workCategoriesCount = 7;
+
+    std::string_view getWorkCategoryName(WorkCategory value);
 
     class WorkItem : public osg::Referenced
     {
     public:
+        explicit WorkItem(WorkCategory category = WorkCategory::Other)
+            : mCategory(category)
+        {
+        }
+
         /// Override in a derived WorkItem to perform actual work.
         virtual void doWork() {}
 
@@ -31,56 +72,113 @@ namespace SceneUtil
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// Mark the work item as no longer needed. If it is not started yet, the WorkQueue will skip it and only signal
+        /// done, otherwise abort() is called.
+        void cancel();
+
+        bool isCancelled() const { return mCancelled; }
+
+        WorkCategory getCategory() const { return mCategory; }
+
     private:
+        const WorkCategory mCategory;
+        std::atomic_bool mCancelled{ false };
         std::atomic_bool mDone{ false };
         std::mutex mMutex;
         std::condition_variable mCondition;
     };
 
+    struct WorkCategoryStats
+    {
+        std::size_t mQueued = 0;
+        std::size_t mDone = 0;
+        std::size_t mCancelled = 0;
+    };
+
+    struct WorkQueueStats
+    {
+        std::array<WorkCategoryStats, workCategoriesCount> mCategories;
+    };
+
+    void addWorkQueueStatsAttributes(std::vector<std::string>& out);
+
+    void reportStats(const WorkQueueStats& stats, unsigned int frameNumber, osg::Stats& out);
+
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @note Each thread has own queue to take items from. Items are distributed over queues in round robin order and
+    /// a thread with empty queue steals work from the others. Items with higher priority are always taken first, items
+    /// with the same priority are taken in the order that they were given in. With multiple work threads it is
+    /// possible for a later item to complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
     public:
         WorkQueue(std::size_t workerThreads);
         ~WorkQueue();
 
+        /// @note Must not be called when there are running worker threads.
         void start(std::size_t workerThreads);
 
         void stop();
 
-        /// Add a new work item to the back of the queue.
+        /// Add a new work item to the queue.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
-        /// @param front If true, add item to the front of the queue. If false (default), add to the back.
-        void addWorkItem(osg::ref_ptr<WorkItem> item, bool front = false);
+        void addWorkItem(osg::ref_ptr<WorkItem> item, WorkPriority priority = WorkPriority::Normal);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
-        /// If the workqueue is in the process of being destroyed, may return nullptr.
+        /// Get the next work item with the highest priority preferring the queue of given thread. If all queues are
+        /// empty, waits until a new item is added. If the workqueue is in the process of being destroyed, may return
+        /// nullptr.
         /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
+        osg::ref_ptr<WorkItem> removeWorkItem(std::size_t threadIndex);
+
+        /// Internal use by the WorkThread.
+        void reportDone(const WorkItem& item);
 
         size_t getNumItems() const;
 
         size_t getNumActiveThreads() const;
 
+        WorkQueueStats getStats() const;
+
     private:
+        struct ThreadQueue
+        {
+            std::mutex mMutex;
+            std::array<std::deque<osg::ref_ptr<WorkItem>>, workPrioritiesCount> mItems;
+        };
+
+        struct CategoryCounters
+        {
+            std::atomic_size_t mQueued{ 0 };
+            std::atomic_size_t mDone{ 0 };
+            std::atomic_size_t mCancelled{ 0 };
+        };
+
         bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem>> mQueue;
+        std::atomic_size_t mNumItems{ 0 };
+        // Incremented for each added item to let a waiting thread know that there may be new items to take
+        std::atomic_uint64_t mAddedItems{ 0 };
+        std::atomic_size_t mNumWaitingThreads{ 0 };
+        std::vector<std::unique_ptr<ThreadQueue>> mQueues;
+        std::atomic_size_t mNextQueue{ 0 };
+        std::array<CategoryCounters, workCategoriesCount> mCounters;
 
         mutable std::mutex mMutex;
         std::condition_variable mCondition;
 
         std::vector<std::unique_ptr<WorkThread>> mThreads;
+
+        osg::ref_ptr<WorkItem> takeWorkItem(std::size_t threadIndex);
+
+        void clearQueues();
     };
 
     /// Internally used by WorkQueue.
     class WorkThread
     {
     public:
-        WorkThread(WorkQueue& workQueue);
+        WorkThread(WorkQueue& workQueue, std::size_t index);
 
         ~WorkThread();
 
@@ -88,6 +186,7 @@ namespace SceneUtil
 
     private:
         WorkQueue* mWorkQueue;
+        std::size_t mIndex;
         std::atomic<bool> mActive;
         std::thread mThread;
 
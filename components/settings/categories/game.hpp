@@ -40,6 +40,13 @@ namespace Settings
         SettingValue<bool> mRebalanceSoulGemValues{ mIndex, "Game", "rebalance soul gem values" };
         SettingValue<bool> mUseAdditionalAnimSources{ mIndex, "Game", "use additional anim sources" };
         SettingValue<bool> mSmoothAnimTransitions{ mIndex, "Game", "smooth animation transitions" };
+        SettingValue<int> mSkinningThreads{ mIndex, "Game", "skinning threads", makeMaxSanitizerInt(0) };
+        SettingValue<bool> mAnimationLod{ mIndex, "Game", "animation lod" };
+        SettingValue<float> mAnimationLodHalfRateSize{ mIndex, "Game", "animation lod half rate size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<float> mAnimationLodQuarterRateSize{ mIndex, "Game", "animation lod quarter rate size",
+            makeMaxSanitizerFloat(0) };
+        SettingValue<bool> mCompileAnimationClips{ mIndex, "Game", "compile animation clips" };
         SettingValue<bool> mBarterDispositionChangeIsPermanent{ mIndex, "Game",
             "barter disposition change is permanent" };
         SettingValue<int> mStrengthInfluencesHandToHand{ mIndex, "Game", "strength influences hand to hand",
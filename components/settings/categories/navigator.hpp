@@ -42,7 +42,10 @@ namespace Settings
         SettingValue<int> mRegionMinArea{ mIndex, "Navigator", "region min area", makeMaxSanitizerInt(0) };
         SettingValue<std::size_t> mAsyncNavMeshUpdaterThreads{ mIndex, "Navigator", "async nav mesh updater threads",
             makeMaxSanitizerSize(1) };
+        SettingValue<std::size_t> mBatchPathFinderThreads{ mIndex, "Navigator", "batch path finder threads" };
         SettingValue<std::size_t> mMaxNavMeshTilesCacheSize{ mIndex, "Navigator", "max nav mesh tiles cache size" };
+        SettingValue<std::size_t> mMaxNavMeshTileLayersCacheSize{ mIndex, "Navigator",
+            "max nav mesh tile layers cache size" };
         SettingValue<std::size_t> mMaxPolygonPathSize{ mIndex, "Navigator", "max polygon path size" };
         SettingValue<std::size_t> mMaxSmoothPathSize{ mIndex, "Navigator", "max smooth path size" };
         SettingValue<bool> mEnableWriteRecastMeshToFile{ mIndex, "Navigator", "enable write recast mesh to file" };
@@ -63,6 +66,12 @@ namespace Settings
         SettingValue<bool> mEnableNavMeshDiskCache{ mIndex, "Navigator", "enable nav mesh disk cache" };
         SettingValue<bool> mWriteToNavmeshdb{ mIndex, "Navigator", "write to navmeshdb" };
         SettingValue<std::uint64_t> mMaxNavmeshdbFileSize{ mIndex, "Navigator", "max navmeshdb file size" };
+        SettingValue<std::size_t> mNavmeshdbWriteBatchSize{ mIndex, "Navigator", "navmeshdb write batch size",
+            makeMaxSanitizerSize(1) };
+        SettingValue<int> mNavmeshdbWalAutocheckpoint{ mIndex, "Navigator", "navmeshdb wal autocheckpoint",
+            makeMaxSanitizerInt(1) };
+        SettingValue<std::size_t> mMaxNavmeshdbTileCacheSize{ mIndex, "Navigator", "max navmeshdb tile cache size" };
+        SettingValue<bool> mCompressNavmeshdbTiles{ mIndex, "Navigator", "compress navmeshdb tiles" };
         SettingValue<bool> mWaitForAllJobsOnExit{ mIndex, "Navigator", "wait for all jobs on exit" };
     };
 }
@@ -55,4 +55,12 @@ namespace Sqlite3
                 + std::to_string(ec) + ")");
         (void)mDb.release();
     }
+
+    void Transaction::rollback()
+    {
+        if (const int ec = sqlite3_exec(mDb.get(), "ROLLBACK", nullptr, nullptr, nullptr); ec != SQLITE_OK)
+            throw std::runtime_error("Failed to rollback transaction: " + std::string(sqlite3_errmsg(mDb.get()))
+                + " (" + std::to_string(ec) + ")");
+        (void)mDb.release();
+    }
 }
@@ -27,6 +27,8 @@ namespace Sqlite3
 
         void commit();
 
+        void rollback();
+
     private:
         std::unique_ptr<sqlite3, Rollback> mDb;
     };
@@ -98,7 +98,8 @@ namespace
 }
 
 StatelessUtf8Encoder::StatelessUtf8Encoder(FromType sourceEncoding)
-    : mTranslationArray(getTranslationArray(sourceEncoding))
+    : mSourceEncoding(sourceEncoding)
+    , mTranslationArray(getTranslationArray(sourceEncoding))
 {
 }
 
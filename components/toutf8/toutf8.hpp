@@ -44,6 +44,8 @@ namespace ToUTF8
         std::string_view getLegacyEnc(
             std::string_view input, BufferAllocationPolicy bufferAllocationPolicy, std::string& buffer) const;
 
+        FromType getSourceEncoding() const { return mSourceEncoding; }
+
     private:
         inline std::pair<std::size_t, bool> getLength(std::string_view input) const;
         inline void copyFromArray(unsigned char chp, char*& out) const;
@@ -51,6 +53,7 @@ namespace ToUTF8
         inline void copyFromArrayLegacyEnc(
             std::string_view::iterator& chp, std::string_view::iterator end, char*& out) const;
 
+        const FromType mSourceEncoding;
         const std::span<const signed char> mTranslationArray;
     };
 
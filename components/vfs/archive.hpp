@@ -3,18 +3,19 @@
 
 #include <string>
 
-#include "filemap.hpp"
 #include "pathutil.hpp"
 
 namespace VFS
 {
+    class FileIndex;
+
     class Archive
     {
     public:
         virtual ~Archive() = default;
 
         /// List all resources contained in this archive.
-        virtual void listResources(FileMap& out) = 0;
+        virtual void listResources(FileIndex& out) = 0;
 
         /// True if this archive contains the provided normalized file.
         virtual bool contains(Path::NormalizedView file) const = 0;
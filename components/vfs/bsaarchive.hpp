@@ -3,6 +3,7 @@
 
 #include "archive.hpp"
 #include "file.hpp"
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
 #include <components/bsa/ba2dx10file.hpp>
@@ -33,6 +34,8 @@ namespace VFS
 
         Files::IStreamPtr open() override { return mFile->getFile()->getFile(mInfo); }
 
+        std::optional<std::span<const char>> getData() const override { return mFile->getFile()->getFileData(mInfo); }
+
         std::filesystem::file_time_type getLastModified() const override
         {
             return std::filesystem::last_write_time(mFile->getFile()->getPath());
@@ -64,12 +67,13 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::filesystem::path& filename, const ToUTF8::StatelessUtf8Encoder* encoder)
+        BsaArchive(
+            const std::filesystem::path& filename, const ToUTF8::StatelessUtf8Encoder* encoder, bool memoryMapped)
             : Archive()
             , mEncoder(encoder)
         {
             mFile = std::make_unique<BSAFileType>();
-            mFile->open(filename);
+            mFile->open(filename, memoryMapped);
 
             std::string buffer;
             for (const Bsa::BSAFile::FileStruct& file : mFile->getList())
@@ -81,14 +85,11 @@ namespace VFS
             std::sort(mFiles.begin(), mFiles.end());
         }
 
-        void listResources(FileMap& out) override
+        void listResources(FileIndex& out) override
         {
             std::string buffer;
             for (auto& resource : mResources)
-            {
-                std::string_view path = getUtf8(resource.mInfo->name(), buffer);
-                out[VFS::Path::Normalized(path)] = &resource;
-            }
+                out.insert(getUtf8(resource.mInfo->name(), buffer), &resource);
         }
 
         bool contains(Path::NormalizedView file) const override
@@ -115,20 +116,20 @@ namespace VFS
     };
 
     inline std::unique_ptr<VFS::Archive> makeBsaArchive(
-        const std::filesystem::path& path, const ToUTF8::StatelessUtf8Encoder* encoder)
+        const std::filesystem::path& path, const ToUTF8::StatelessUtf8Encoder* encoder, bool memoryMapped = false)
     {
         switch (Bsa::BSAFile::detectVersion(path))
         {
             case Bsa::BsaVersion::Unknown:
                 break;
             case Bsa::BsaVersion::Uncompressed:
-                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::BSAFile>>(path, encoder, memoryMapped);
             case Bsa::BsaVersion::Compressed:
-                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::CompressedBSAFile>>(path, encoder, memoryMapped);
             case Bsa::BsaVersion::BA2GNRL:
-                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::BA2GNRLFile>>(path, encoder, memoryMapped);
             case Bsa::BsaVersion::BA2DX10:
-                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path, encoder);
+                return std::make_unique<BsaArchive<Bsa::BA2DX10File>>(path, encoder, memoryMapped);
         }
 
         throw std::runtime_error("Unknown archive type '" + Files::pathToUnicodeString(path) + "'");
@@ -2,6 +2,8 @@
 #define OPENMW_COMPONENTS_VFS_FILE_H
 
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <string>
 
 #include <components/files/istreamptr.hpp>
@@ -15,6 +17,9 @@ namespace VFS
 
         virtual Files::IStreamPtr open() = 0;
 
+        /// Get file contents when they are already available in memory, e.g. from a memory mapped archive.
+        virtual std::optional<std::span<const char>> getData() const { return std::nullopt; }
+
         virtual std::filesystem::file_time_type getLastModified() const = 0;
 
         virtual std::string getStem() const = 0;
@@ -0,0 +1,101 @@
+#include "fileindex.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace VFS
+{
+    void FileIndex::clear()
+    {
+        mPaths.clear();
+        mEntries.clear();
+        mBuckets.clear();
+    }
+
+    void FileIndex::insert(std::string_view path, File* file)
+    {
+        const std::size_t offset = mPaths.size();
+        if (path.size() > std::numeric_limits<std::uint32_t>::max() - offset)
+            throw std::length_error("VFS file index paths size limit is reached");
+        mPaths.append(path);
+        const auto [begin, end] = Path::normalizeFilenameInPlace(mPaths.begin() + offset, mPaths.end());
+        mPaths.erase(end, mPaths.end());
+        mEntries.push_back(Entry{
+            .mOffset = static_cast<std::uint32_t>(begin - mPaths.begin()),
+            .mSize = static_cast<std::uint32_t>(end - begin),
+            .mFile = file,
+        });
+    }
+
+    void FileIndex::build()
+    {
+        std::stable_sort(mEntries.begin(), mEntries.end(),
+            [&](const Entry& lhs, const Entry& rhs) { return getView(lhs) < getView(rhs); });
+
+        // Files added later have priority, so keep only the last one out of each group with the same path
+        std::size_t count = 0;
+        for (std::size_t i = 0, n = mEntries.size(); i < n; ++i)
+        {
+            if (i + 1 < n && getView(mEntries[i]) == getView(mEntries[i + 1]))
+                continue;
+            mEntries[count++] = mEntries[i];
+        }
+        mEntries.resize(count);
+        mEntries.shrink_to_fit();
+
+        // Store paths in the sorted order without duplicates so prefix scans touch contiguous memory
+        std::size_t pathsSize = 0;
+        for (const Entry& entry : mEntries)
+            pathsSize += entry.mSize;
+        std::string paths;
+        paths.reserve(pathsSize);
+        for (Entry& entry : mEntries)
+        {
+            const std::string_view path = getView(entry);
+            entry.mOffset = static_cast<std::uint32_t>(paths.size());
+            paths.append(path);
+        }
+        mPaths = std::move(paths);
+
+        // Keep load factor not greater than 0.5 to make probe sequences short
+        mBuckets.assign(std::bit_ceil(std::max<std::size_t>(mEntries.size() * 2, 1)),
+            Bucket{ .mHash = 0, .mIndex = sEmptyBucket });
+        const std::size_t mask = mBuckets.size() - 1;
+        for (std::size_t i = 0; i < mEntries.size(); ++i)
+        {
+            const std::size_t hash = std::hash<std::string_view>{}(getView(mEntries[i]));
+            std::size_t position = hash & mask;
+            while (mBuckets[position].mIndex != sEmptyBucket)
+                position = (position + 1) & mask;
+            mBuckets[position] = Bucket{ .mHash = hash, .mIndex = static_cast<std::uint32_t>(i) };
+        }
+    }
+
+    File* FileIndex::find(std::string_view normalizedPath) const
+    {
+        assert(Path::isNormalized(normalizedPath));
+        if (mBuckets.empty())
+            return nullptr;
+        const std::size_t hash = std::hash<std::string_view>{}(normalizedPath);
+        const std::size_t mask = mBuckets.size() - 1;
+        for (std::size_t position = hash & mask;; position = (position + 1) & mask)
+        {
+            const Bucket& bucket = mBuckets[position];
+            if (bucket.mIndex == sEmptyBucket)
+                return nullptr;
+            const Entry& entry = mEntries[bucket.mIndex];
+            if (bucket.mHash == hash && getView(entry) == normalizedPath)
+                return entry.mFile;
+        }
+    }
+
+    std::size_t FileIndex::lowerBound(std::string_view normalizedPath) const
+    {
+        const auto it = std::partition_point(mEntries.begin(), mEntries.end(),
+            [&](const Entry& entry) { return getView(entry) < normalizedPath; });
+        return static_cast<std::size_t>(it - mEntries.begin());
+    }
+}
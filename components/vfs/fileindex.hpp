@@ -0,0 +1,79 @@
+#ifndef OPENMW_COMPONENTS_VFS_FILEINDEX_H
+#define OPENMW_COMPONENTS_VFS_FILEINDEX_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "pathutil.hpp"
+
+namespace VFS
+{
+    class File;
+
+    /// @brief Flat index of files sorted by normalized path.
+    /// @par All paths are stored in a single buffer in the same order as files. Sorted order allows prefix scans and
+    /// exact lookups use an open addressing hash table over the same entries.
+    /// @par Files are added with insert() and become available for lookups after build().
+    class FileIndex
+    {
+    public:
+        void clear();
+
+        /// Add a file to the index replacing any previously added file with the same path. The path is normalized.
+        void insert(std::string_view path, File* file);
+
+        /// Sort and deduplicate added files and prepare the lookup table.
+        void build();
+
+        std::size_t size() const { return mEntries.size(); }
+
+        /// Find a file by normalized path. Returns nullptr if there is no such file.
+        File* find(std::string_view normalizedPath) const;
+
+        /// Position of the first file with path not less than the given one.
+        std::size_t lowerBound(std::string_view normalizedPath) const;
+
+        Path::NormalizedView getPath(std::size_t index) const
+        {
+            assert(index < mEntries.size());
+            return Path::NormalizedView::fromNormalized(getView(mEntries[index]));
+        }
+
+        File* getFile(std::size_t index) const
+        {
+            assert(index < mEntries.size());
+            return mEntries[index].mFile;
+        }
+
+    private:
+        struct Entry
+        {
+            std::uint32_t mOffset;
+            std::uint32_t mSize;
+            File* mFile;
+        };
+
+        struct Bucket
+        {
+            std::size_t mHash;
+            std::uint32_t mIndex;
+        };
+
+        static constexpr std::uint32_t sEmptyBucket = static_cast<std::uint32_t>(-1);
+
+        std::string mPaths;
+        std::vector<Entry> mEntries;
+        std::vector<Bucket> mBuckets;
+
+        std::string_view getView(const Entry& entry) const
+        {
+            return std::string_view(mPaths.data() + entry.mOffset, entry.mSize);
+        }
+    };
+}
+
+#endif
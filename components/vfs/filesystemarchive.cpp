@@ -2,6 +2,7 @@
 
 #include <filesystem>
 
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
 #include <components/debug/debuglog.hpp>
@@ -31,14 +32,7 @@ namespace VFS
             {
                 const std::filesystem::path& filePath = entry.path();
                 const std::string proper = Files::pathToUnicodeString(filePath);
-                VFS::Path::Normalized searchable(std::string_view{ proper }.substr(prefix));
-                FileSystemArchiveFile file(filePath);
-
-                const auto inserted = mIndex.emplace(std::move(searchable), std::move(file));
-                if (!inserted.second)
-                    Log(Debug::Warning)
-                        << "Found duplicate file for '" << proper
-                        << "', please check your file system for two files with the same name in different cases.";
+                addFile(filePath, std::string_view{ proper }.substr(prefix));
             }
 
             // Exception thrown by the operator++ may not contain the context of the error like what exact path caused
@@ -54,10 +48,26 @@ namespace VFS
         }
     }
 
-    void FileSystemArchive::listResources(FileMap& out)
+    FileSystemArchive::FileSystemArchive(const std::filesystem::path& path, std::span<const std::string> files)
+        : mPath(path)
+    {
+        for (const std::string& file : files)
+            addFile(mPath / Files::pathFromUnicodeString(file), file);
+    }
+
+    void FileSystemArchive::addFile(const std::filesystem::path& filePath, std::string_view relative)
+    {
+        const auto inserted = mIndex.emplace(VFS::Path::Normalized(relative), FileSystemArchiveFile(filePath));
+        if (!inserted.second)
+            Log(Debug::Warning)
+                << "Found duplicate file for '" << Files::pathToUnicodeString(filePath)
+                << "', please check your file system for two files with the same name in different cases.";
+    }
+
+    void FileSystemArchive::listResources(FileIndex& out)
     {
         for (auto& [k, v] : mIndex)
-            out[k] = &v;
+            out.insert(k.view(), &v);
     }
 
     bool FileSystemArchive::contains(Path::NormalizedView file) const
@@ -5,6 +5,8 @@
 #include "file.hpp"
 
 #include <filesystem>
+#include <map>
+#include <span>
 #include <string>
 
 namespace VFS
@@ -30,13 +32,18 @@ namespace VFS
     public:
         FileSystemArchive(const std::filesystem::path& path);
 
-        void listResources(FileMap& out) override;
+        /// Create archive from the already known list of files paths relative to the given directory.
+        explicit FileSystemArchive(const std::filesystem::path& path, std::span<const std::string> files);
+
+        void listResources(FileIndex& out) override;
 
         bool contains(Path::NormalizedView file) const override;
 
         std::string getDescription() const override;
 
     private:
+        void addFile(const std::filesystem::path& filePath, std::string_view relative);
+
         std::map<VFS::Path::Normalized, FileSystemArchiveFile, std::less<>> mIndex;
         std::filesystem::path mPath;
     };
@@ -0,0 +1,246 @@
+#include "indexcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace VFS
+{
+    namespace
+    {
+        constexpr char indexCacheMagic[] = { 'O', 'V', 'F', 'S', 'I', 'D', 'X', '\0' };
+        constexpr std::uint32_t indexCacheVersion = 1;
+
+        template <Serialization::Mode mode>
+        struct Format : Serialization::Format<mode, Format<mode>>
+        {
+            using Serialization::Format<mode, Format<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::string>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                    visitor(*this, static_cast<std::uint64_t>(value.size()));
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    std::uint64_t size = 0;
+                    visitor(*this, size);
+                    value.resize(static_cast<std::size_t>(size));
+                }
+                visitor(*this, value.data(), value.size());
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CachedDirectory>>
+            {
+                visitor(*this, value.mPath);
+                visitor(*this, value.mLastModified);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, DataDirectoryIndex>>
+            {
+                visitor(*this, value.mPath);
+                visitor(*this, value.mDirectories);
+                visitor(*this, value.mFiles);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::vector<DataDirectoryIndex>>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                {
+                    visitor(*this, indexCacheMagic);
+                    visitor(*this, indexCacheVersion);
+                }
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    char magic[std::size(indexCacheMagic)];
+                    visitor(*this, magic);
+                    if (std::memcmp(magic, indexCacheMagic, sizeof(magic)) != 0)
+                        throw std::runtime_error("Bad VFS index cache magic");
+                    std::uint32_t version = 0;
+                    visitor(*this, version);
+                    if (version != indexCacheVersion)
+                        throw std::runtime_error("Unsupported VFS index cache version");
+                }
+                Serialization::Format<mode, Format<mode>>::operator()(visitor, value);
+            }
+        };
+
+        std::int64_t toCachedTime(std::filesystem::file_time_type value)
+        {
+            return static_cast<std::int64_t>(value.time_since_epoch().count());
+        }
+
+        bool isUpToDate(const DataDirectoryIndex& index, const std::filesystem::path& dataDir)
+        {
+            for (const CachedDirectory& directory : index.mDirectories)
+            {
+                std::error_code ec;
+                const auto lastModified
+                    = std::filesystem::last_write_time(dataDir / Files::pathFromUnicodeString(directory.mPath), ec);
+                if (ec != std::error_code() || toCachedTime(lastModified) != directory.mLastModified)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    DataDirectoryIndex indexDataDirectory(const std::filesystem::path& path)
+    {
+        DataDirectoryIndex result;
+        result.mPath = Files::pathToUnicodeString(path);
+        result.mDirectories.push_back(
+            CachedDirectory{ .mPath = {}, .mLastModified = toCachedTime(std::filesystem::last_write_time(path)) });
+
+        const auto str = path.u8string();
+        std::size_t prefix = str.size();
+
+        if (prefix > 0 && str[prefix - 1] != '\\' && str[prefix - 1] != '/')
+            ++prefix;
+
+        std::filesystem::recursive_directory_iterator iterator(
+            path, std::filesystem::directory_options::follow_directory_symlink);
+
+        for (auto it = std::filesystem::begin(iterator), end = std::filesystem::end(iterator); it != end;)
+        {
+            const std::filesystem::directory_entry& entry = *it;
+            const std::string proper = Files::pathToUnicodeString(entry.path());
+            std::string relative(std::string_view{ proper }.substr(prefix));
+
+            if (entry.is_directory())
+                result.mDirectories.push_back(CachedDirectory{
+                    .mPath = std::move(relative), .mLastModified = toCachedTime(entry.last_write_time()) });
+            else
+                result.mFiles.push_back(std::move(relative));
+
+            const std::filesystem::path prevPath = entry.path();
+            std::error_code ec;
+            it.increment(ec);
+            if (ec != std::error_code())
+                throw std::runtime_error("Failed to recursively iterate over \"" + Files::pathToUnicodeString(path)
+                    + "\" when incrementing to the next item from \"" + Files::pathToUnicodeString(prevPath)
+                    + "\": " + ec.message());
+        }
+
+        return result;
+    }
+
+    IndexCache::IndexCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::ifstream stream(mPath, std::ios::binary);
+        if (!stream.is_open())
+            return;
+
+        const std::vector<char> data{ std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>() };
+
+        try
+        {
+            constexpr Format<Serialization::Mode::Read> format;
+            const std::byte* const begin = reinterpret_cast<const std::byte*>(data.data());
+            format(Serialization::BinaryReader(begin, begin + data.size()), mIndices);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to load VFS index cache " << mPath << ": " << e.what();
+            mIndices.clear();
+        }
+
+        mUsed.assign(mIndices.size(), false);
+    }
+
+    const DataDirectoryIndex* IndexCache::find(const std::filesystem::path& dataDir)
+    {
+        const std::string path = Files::pathToUnicodeString(dataDir);
+        const auto it = std::find_if(mIndices.begin(), mIndices.end(),
+            [&](const DataDirectoryIndex& index) { return index.mPath == path; });
+        if (it == mIndices.end() || !isUpToDate(*it, dataDir))
+            return nullptr;
+        mUsed[it - mIndices.begin()] = true;
+        return &*it;
+    }
+
+    const DataDirectoryIndex& IndexCache::insert(DataDirectoryIndex&& index)
+    {
+        mChanged = true;
+        const auto it = std::find_if(mIndices.begin(), mIndices.end(),
+            [&](const DataDirectoryIndex& v) { return v.mPath == index.mPath; });
+        if (it != mIndices.end())
+        {
+            *it = std::move(index);
+            mUsed[it - mIndices.begin()] = true;
+            return *it;
+        }
+        mUsed.push_back(true);
+        return mIndices.emplace_back(std::move(index));
+    }
+
+    void IndexCache::save()
+    {
+        if (!mChanged && std::find(mUsed.begin(), mUsed.end(), false) == mUsed.end())
+            return;
+
+        std::vector<DataDirectoryIndex> used;
+        for (std::size_t i = 0; i < mIndices.size(); ++i)
+            if (mUsed[i])
+                used.push_back(std::move(mIndices[i]));
+        mIndices = std::move(used);
+        mUsed.assign(mIndices.size(), true);
+        mChanged = false;
+
+        constexpr Format<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, mIndices);
+        std::vector<std::byte> data(sizeAccumulator.value());
+        format(Serialization::BinaryWriter(data.data(), data.data() + data.size()), mIndices);
+
+        std::error_code ec;
+        std::filesystem::create_directories(mPath.parent_path(), ec);
+        if (ec != std::error_code())
+        {
+            Log(Debug::Warning) << "Failed to create directory for VFS index cache " << mPath << ": " << ec.message();
+            return;
+        }
+
+        // Write to a separate file and replace the cache atomically to never leave a truncated file after a crash.
+        // The name is random because multiple instances may be launched at the same time.
+        std::filesystem::path tmpPath = mPath;
+        tmpPath += "." + std::to_string(std::random_device()()) + ".tmp";
+
+        try
+        {
+            {
+                std::ofstream stream(tmpPath, std::ios::binary);
+                stream.exceptions(std::ios::failbit | std::ios::badbit);
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            }
+            std::filesystem::rename(tmpPath, mPath);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write VFS index cache " << mPath << ": " << e.what();
+            std::filesystem::remove(tmpPath, ec);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef OPENMW_COMPONENTS_VFS_INDEXCACHE_H
+#define OPENMW_COMPONENTS_VFS_INDEXCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    struct CachedDirectory
+    {
+        /// Path relative to the data directory in UTF-8, empty for the data directory itself
+        std::string mPath;
+        std::int64_t mLastModified;
+    };
+
+    /// Listing of a loose files data directory.
+    struct DataDirectoryIndex
+    {
+        /// Path of the data directory in UTF-8
+        std::string mPath;
+        /// All directories of the data directory. Modification time of a directory changes when an entry is added,
+        /// removed or renamed inside it so comparing them is enough to tell whether the list of files is still valid.
+        std::vector<CachedDirectory> mDirectories;
+        /// Paths of all files relative to the data directory in UTF-8
+        std::vector<std::string> mFiles;
+    };
+
+    /// Walk the data directory recursively collecting files and states of directories.
+    DataDirectoryIndex indexDataDirectory(const std::filesystem::path& path);
+
+    /// @brief Persistent cache of data directory listings which allows to skip walking over loose files on startup.
+    class IndexCache
+    {
+    public:
+        /// Load the cache from the given file. Missing, outdated or broken file results in an empty cache.
+        explicit IndexCache(const std::filesystem::path& path);
+
+        /// Get the index of the data directory if none of its directories were modified since it was cached.
+        const DataDirectoryIndex* find(const std::filesystem::path& dataDir);
+
+        /// Add or replace the index of the data directory.
+        const DataDirectoryIndex& insert(DataDirectoryIndex&& index);
+
+        /// Write the cache to the file if it has changed. Only the data directories requested or inserted since the
+        /// cache was loaded are written.
+        void save();
+
+    private:
+        std::filesystem::path mPath;
+        std::vector<DataDirectoryIndex> mIndices;
+        std::vector<bool> mUsed;
+        bool mChanged = false;
+    };
+}
+
+#endif
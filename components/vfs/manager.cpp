@@ -35,6 +35,8 @@ namespace VFS
 
         for (const auto& archive : mArchives)
             archive->listResources(mIndex);
+
+        mIndex.build();
     }
 
     Files::IStreamPtr Manager::find(Path::NormalizedView name) const
@@ -52,6 +54,14 @@ namespace VFS
         return getNormalized(name.value());
     }
 
+    std::optional<std::span<const char>> Manager::getData(Path::NormalizedView name) const
+    {
+        const File* const file = mIndex.find(name.value());
+        if (file == nullptr)
+            return std::nullopt;
+        return file->getData();
+    }
+
     Files::IStreamPtr Manager::getNormalized(std::string_view normalizedName) const
     {
         assert(Path::isNormalized(normalizedName));
@@ -63,12 +73,12 @@ namespace VFS
 
     bool Manager::exists(const Path::Normalized& name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mIndex.find(name.view()) != nullptr;
     }
 
     bool Manager::exists(Path::NormalizedView name) const
     {
-        return mIndex.find(name) != mIndex.end();
+        return mIndex.find(name.value()) != nullptr;
     }
 
     std::string Manager::getArchive(const Path::Normalized& name) const
@@ -83,55 +93,52 @@ namespace VFS
 
     std::filesystem::file_time_type Manager::getLastModified(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = mIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getLastModified();
+        return file->getLastModified();
     }
 
     std::string Manager::getStem(VFS::Path::NormalizedView name) const
     {
-        const auto found = mIndex.find(name);
-        if (found == mIndex.end())
+        const File* const file = mIndex.find(name.value());
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + std::string(name.value()) + "' not found");
-        return found->second->getStem();
+        return file->getStem();
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(std::string_view path) const
     {
-        if (path.empty())
-            return { mIndex.begin(), mIndex.end() };
-        std::string normalized = Path::normalizeFilename(path);
-        const auto it = mIndex.lower_bound(normalized);
-        if (it == mIndex.end() || !it->first.view().starts_with(normalized))
-            return { it, it };
-        ++normalized.back();
-        return { it, mIndex.lower_bound(normalized) };
+        return getRecursiveDirectoryRange(Path::normalizeFilename(path));
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator(VFS::Path::NormalizedView path) const
     {
-        if (path.value().empty())
-            return { mIndex.begin(), mIndex.end() };
-        const auto it = mIndex.lower_bound(path);
-        if (it == mIndex.end() || !it->first.view().starts_with(path.value()))
-            return { it, it };
-        std::string copy(path.value());
-        ++copy.back();
-        return { it, mIndex.lower_bound(copy) };
+        return getRecursiveDirectoryRange(std::string(path.value()));
     }
 
     RecursiveDirectoryRange Manager::getRecursiveDirectoryIterator() const
     {
-        return { mIndex.begin(), mIndex.end() };
+        return { { mIndex, 0 }, { mIndex, mIndex.size() } };
+    }
+
+    RecursiveDirectoryRange Manager::getRecursiveDirectoryRange(std::string&& prefix) const
+    {
+        if (prefix.empty())
+            return getRecursiveDirectoryIterator();
+        const std::size_t begin = mIndex.lowerBound(prefix);
+        if (begin == mIndex.size() || !mIndex.getPath(begin).value().starts_with(prefix))
+            return { { mIndex, begin }, { mIndex, begin } };
+        ++prefix.back();
+        return { { mIndex, begin }, { mIndex, mIndex.lowerBound(prefix) } };
     }
 
     Files::IStreamPtr Manager::findNormalized(std::string_view normalizedPath) const
     {
         assert(Path::isNormalized(normalizedPath));
-        const auto it = mIndex.find(normalizedPath);
-        if (it == mIndex.end())
+        File* const file = mIndex.find(normalizedPath);
+        if (file == nullptr)
             return nullptr;
-        return it->second->open();
+        return file->open();
     }
 }
@@ -5,11 +5,13 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
-#include "filemap.hpp"
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
 namespace VFS
@@ -55,6 +57,12 @@ namespace VFS
 
         Files::IStreamPtr get(Path::NormalizedView name) const;
 
+        /// Retrieve file contents without opening a stream and copying them.
+        /// @return nothing if the file doesn't exist or its contents are not available in memory, use get() then.
+        /// @note The result is valid until the manager is reset.
+        /// @note May be called from any thread once the index has been built.
+        std::optional<std::span<const char>> getData(Path::NormalizedView name) const;
+
         std::string getArchive(const Path::Normalized& name) const;
 
         /// Recursively iterate over the elements of the given path
@@ -74,10 +82,12 @@ namespace VFS
     private:
         std::vector<std::unique_ptr<Archive>> mArchives;
 
-        FileMap mIndex;
+        FileIndex mIndex;
 
         inline Files::IStreamPtr findNormalized(std::string_view normalizedPath) const;
 
+        RecursiveDirectoryRange getRecursiveDirectoryRange(std::string&& prefix) const;
+
         /// Retrieve a file by name (name is already normalized).
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
@@ -162,6 +162,16 @@ namespace VFS::Path
 
         NormalizedView(const Normalized& value) noexcept;
 
+        /// Make a view of a value known to be normalized, for example stored by a path index. Normalization is
+        /// checked only in debug builds.
+        static constexpr NormalizedView fromNormalized(std::string_view value) noexcept
+        {
+            assert(isNormalized(value));
+            NormalizedView result;
+            result.mValue = value;
+            return result;
+        }
+
         explicit NormalizedView(const std::string&) = delete;
 
         explicit NormalizedView(std::string&&) = delete;
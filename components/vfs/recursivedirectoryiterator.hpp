@@ -1,9 +1,9 @@
 #ifndef OPENMW_COMPONENTS_VFS_RECURSIVEDIRECTORYITERATOR_H
 #define OPENMW_COMPONENTS_VFS_RECURSIVEDIRECTORYITERATOR_H
 
-#include <string>
+#include <cstddef>
 
-#include "filemap.hpp"
+#include "fileindex.hpp"
 #include "pathutil.hpp"
 
 namespace VFS
@@ -11,25 +11,25 @@ namespace VFS
     class RecursiveDirectoryIterator
     {
     public:
-        RecursiveDirectoryIterator(FileMap::const_iterator it)
-            : mIt(it)
+        RecursiveDirectoryIterator(const FileIndex& index, std::size_t position)
+            : mIndex(&index)
+            , mPosition(position)
         {
         }
 
-        const Path::Normalized& operator*() const { return mIt->first; }
-
-        const Path::Normalized* operator->() const { return &mIt->first; }
+        Path::NormalizedView operator*() const { return mIndex->getPath(mPosition); }
 
         RecursiveDirectoryIterator& operator++()
         {
-            ++mIt;
+            ++mPosition;
             return *this;
         }
 
         friend bool operator==(const RecursiveDirectoryIterator& lhs, const RecursiveDirectoryIterator& rhs) = default;
 
     private:
-        FileMap::const_iterator mIt;
+        const FileIndex* mIndex;
+        std::size_t mPosition;
     };
 
     class RecursiveDirectoryRange
@@ -8,13 +8,15 @@
 
 #include <components/vfs/bsaarchive.hpp>
 #include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/indexcache.hpp>
 #include <components/vfs/manager.hpp>
 
 namespace VFS
 {
 
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder)
+        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder,
+        bool memoryMapArchives, IndexCache* indexCache)
     {
         const Files::PathContainer& dataDirs = collections.getPaths();
 
@@ -25,7 +27,7 @@ namespace VFS
                 // Last BSA has the highest priority
                 const auto archivePath = collections.getPath(*archive);
                 Log(Debug::Info) << "Adding BSA archive " << archivePath;
-                vfs->addArchive(makeBsaArchive(archivePath, encoder));
+                vfs->addArchive(makeBsaArchive(archivePath, encoder, memoryMapArchives));
             }
             else
             {
@@ -42,7 +44,18 @@ namespace VFS
                 {
                     Log(Debug::Info) << "Adding data directory " << dataDir;
                     // Last data dir has the highest priority
-                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir));
+                    if (indexCache == nullptr)
+                    {
+                        vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir));
+                        continue;
+                    }
+                    const DataDirectoryIndex* index = indexCache->find(dataDir);
+                    if (index == nullptr)
+                    {
+                        Log(Debug::Verbose) << "Data directory " << dataDir << " is not cached or modified, reindexing";
+                        index = &indexCache->insert(indexDataDirectory(dataDir));
+                    }
+                    vfs->addArchive(std::make_unique<FileSystemArchive>(dataDir, index->mFiles));
                 }
                 else
                     Log(Debug::Info) << "Ignoring duplicate data directory " << dataDir;
@@ -11,10 +11,14 @@ namespace ToUTF8
 namespace VFS
 {
     class Manager;
+    class IndexCache;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param memoryMapArchives map BSA archives into memory to read uncompressed files without copying
+    /// @param indexCache optional cache of data directories listings to avoid walking over unmodified directories
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder);
+        const std::vector<std::string>& archives, bool useLooseFiles, const ToUTF8::StatelessUtf8Encoder* encoder,
+        bool memoryMapArchives = false, IndexCache* indexCache = nullptr);
 }
 
 #endif